@@ -0,0 +1,244 @@
+; ------------------------------------------------------------------------------
+; LZ4 BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lz4.s - LZ4 decompression routine, for comparison with LZSA
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lz4_decompress_block(void *dst, const void *src, size_t src_len)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+;     src_len = length of source compressed data
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; This routine is structured in the same way as the LZSA decompression routines
+; (i.e. byte-by-byte copy loops, with lengths held in static word variables), so
+; that a comparison of decompression speed between the formats is like-for-like.
+;
+; LZ4 block format documentation:
+; https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+
+.module lz4
+.globl _lz4_decompress_block
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+src_end: .blkw 1
+
+lit_len: .blkw 1
+lit_len_msb .equ (lit_len+0)
+lit_len_lsb .equ (lit_len+1)
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+match_len: .blkw 1
+match_len_msb .equ (match_len+0)
+match_len_lsb .equ (match_len+1)
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lz4_decompress_block:
+	; Calculate the end of the source data by adding the length to the source
+	; pointer, and save it in a variable for comparison later.
+	ldw x, (ARGS_SP_OFFSET+4, sp)
+	addw x, (ARGS_SP_OFFSET+2, sp)
+	ldw src_end, x
+
+	; Load source pointer to X reg and destination pointer to Y reg.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+
+lz4_token:
+	; Token format: LLLL|MMMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LLLL literal length from token in A. Branch if no literals
+	; (length is zero). Shift literal count right by 4 bits, by simply swapping
+	; nibbles, and set as LSB of literal length word variable (clearing MSB).
+	and a, #0xF0
+	jreq lz4_no_lit
+	swap a
+	clr lit_len_msb
+	ld lit_len_lsb, a
+
+	; Check if there are extra literal length bytes (i.e. length is 15). If
+	; not, we have final count, so go ahead and copy literals.
+	cp a, #15
+	jrne lz4_copy_lit_loop
+
+lz4_extra_lit_len:
+	; Load an extra literal length byte and add it to the literal length word
+	; variable. If the byte was 255, another one follows, so loop around.
+	ld a, (x)
+	incw x
+	push a
+	add a, lit_len_lsb
+	ld lit_len_lsb, a
+	ld a, lit_len_msb
+	adc a, #0
+	ld lit_len_msb, a
+	pop a
+	inc a
+	jreq lz4_extra_lit_len
+
+lz4_copy_lit_loop:
+	; Test if literal length variable value is zero. If so, proceed to handling
+	; match offset. Otherwise, continue to copy next literal byte.
+	tnz lit_len_msb
+	jrne lz4_copy_lit
+	tnz lit_len_lsb
+	jrne lz4_copy_lit
+	jra lz4_no_lit
+
+lz4_copy_lit:
+	; Decrement literal length word variable in-place (without using X/Y
+	; registers and DECW instruction).
+	ld a, lit_len_lsb
+	sub a, #1
+	ld lit_len_lsb, a
+	ld a, lit_len_msb
+	sbc a, #0
+	ld lit_len_msb, a
+
+	; Copy a single byte from source to destination.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Loop around to next byte.
+	jra lz4_copy_lit_loop
+
+lz4_no_lit:
+	; There is no end-of-data marker; the final sequence of a block consists of
+	; only literals. So, if the source pointer has reached the end of the source
+	; data, we're done.
+	cpw x, src_end
+	jrne lz4_match_off
+
+	; Discard token from the stack and return current destination pointer in X
+	; reg.
+	pop a
+	ldw x, y
+	return
+
+lz4_match_off:
+	; Load match offset from source and set as match offset word variable,
+	; converting from little- to big-endian as we go.
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+
+	; Retrieve token from stack (popping it), mask off MMMM match length bits,
+	; and place in LSB of match length word variable (clearing MSB).
+	pop a
+	and a, #0x0F
+	clr match_len_msb
+	ld match_len_lsb, a
+
+	; Check if there are extra match length bytes (i.e. length is 15). If not,
+	; we have final length, so proceed to add minimum match length.
+	cp a, #15
+	jrne lz4_add_min_match_len
+
+lz4_extra_match_len:
+	; Load an extra match length byte and add it to the match length word
+	; variable. If the byte was 255, another one follows, so loop around.
+	ld a, (x)
+	incw x
+	push a
+	add a, match_len_lsb
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	adc a, #0
+	ld match_len_msb, a
+	pop a
+	inc a
+	jreq lz4_extra_match_len
+
+lz4_add_min_match_len:
+	; Add the minimum match length (4) to the match length word variable.
+	ld a, match_len_lsb
+	add a, #4
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	adc a, #0
+	ld match_len_msb, a
+
+	; Save current source pointer on stack. Copy current destination pointer to
+	; X reg and subtract match offset from it.
+	pushw x
+	ldw x, y
+	subw x, match_off
+
+lz4_copy_match:
+	; Decrement match length word variable in-place (without using X/Y registers
+	; and DECW instruction). Match length is always at least 4, so there is no
+	; need to test for zero before the first byte.
+	ld a, match_len_lsb
+	sub a, #1
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	sbc a, #0
+	ld match_len_msb, a
+
+	; Copy a single byte from source to destination.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Test if match length variable value is zero. If not, loop around to copy
+	; next matched byte.
+	tnz match_len_msb
+	jrne lz4_copy_match
+	tnz match_len_lsb
+	jrne lz4_copy_match
+
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lz4_token
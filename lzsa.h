@@ -42,7 +42,103 @@
 #define __stack_args
 #endif
 
+// Output filters that may be applied by lzsa2_decompress_block_filter() to
+// each byte as it is emitted. The layout of lzsa_filter_t is relied upon by
+// the assembly code, so do not re-order its members.
+typedef enum {
+	LZSA_FILTER_NONE = 0,
+	LZSA_FILTER_DELTA8 = 1,
+	LZSA_FILTER_DELTA16 = 2,
+	LZSA_FILTER_XOR = 3,
+	LZSA_FILTER_LUT = 4
+} lzsa_filter_type_t;
+
+typedef struct {
+	uint8_t type;       // One of lzsa_filter_type_t
+	uint8_t key;        // XOR key (LZSA_FILTER_XOR only)
+	const uint8_t *lut; // 256-entry lookup table (LZSA_FILTER_LUT only)
+} lzsa_filter_t;
+
+// Table entry giving source and destination of one block for decompression by
+// lzsa1_decompress_batch() or lzsa2_decompress_batch(). The layout is relied
+// upon by the assembly code, so do not re-order its members.
+typedef struct {
+	const void *src;
+	void *dst;
+} lzsa_batch_entry_t;
+
 extern void * lzsa1_decompress_block(void *dst, const void *src) __stack_args;
 extern void * lzsa2_decompress_block(void *dst, const void *src) __stack_args;
+extern void * lzsa2_decompress_block_filter(void *dst, const void *src, const lzsa_filter_t *filter) __stack_args;
+extern void * lzsa1_decompress_block_strided(void *dst, const void *src, uint8_t width, uint16_t stride) __stack_args;
+extern void * lzsa2_decompress_block_strided(void *dst, const void *src, uint8_t width, uint16_t stride) __stack_args;
+extern void * lzsa1_decompress_batch(const lzsa_batch_entry_t *entries, uint8_t count, void **ends) __stack_args;
+extern void * lzsa2_decompress_batch(const lzsa_batch_entry_t *entries, uint8_t count, void **ends) __stack_args;
+
+// Compare a block's decompressed data against the given target memory (e.g.
+// flash) without writing it anywhere, taking matches from the target itself.
+// Returns the offset of the first byte of the target that differs, or the
+// length of the decompressed data if none do.
+extern uint16_t lzsa1_compare_block(const void *target, const void *src) __stack_args;
+extern uint16_t lzsa2_compare_block(const void *target, const void *src) __stack_args;
+
+// Versions of lzsa1_decompress_block() and lzsa2_decompress_block() where
+// matches reaching back before the start of the destination are taken from a
+// dictionary, given as the far address of its end. Used for applying delta
+// patches against an old firmware image in flash (see lzsa_patch.c).
+extern void * lzsa1_decompress_block_dict(void *dst, const void *src, uint32_t dict) __stack_args;
+extern void * lzsa2_decompress_block_dict(void *dst, const void *src, uint32_t dict) __stack_args;
+
+// Copy data from a far address (e.g. in flash above 64 KB, which can not be
+// reached with an ordinary pointer) to the destination. Used for reading
+// archives in far memory (see lzsa_archive.c).
+extern void lzsa_far_read(void *dst, uint32_t src, uint16_t len) __stack_args;
+
+// Versions of lzsa1_decompress_block() and lzsa2_decompress_block() for blocks
+// that decompress to no more than LZSA_SMALL_PLAIN_MAX bytes, which are faster
+// by keeping lengths in a single byte. Other blocks are decompressed wrongly,
+// or when the libraries are built with LZSA_DEBUG set, rejected by returning
+// NULL.
+#define LZSA_SMALL_PLAIN_MAX 255
+extern void * lzsa1_decompress_small(void *dst, const void *src) __stack_args;
+extern void * lzsa2_decompress_small(void *dst, const void *src) __stack_args;
+
+// Decompression of the STM8-native block format, transcoded from an LZSA1 or
+// LZSA2 block by the lzsa_native host tool. Byte-aligned fields and lengths of
+// no more than 256 make it faster to decode than either, at some cost in size.
+extern void * lzsa_native_decompress_block(void *dst, const void *src) __stack_args;
+
+// Versions of lzsa1_decompress_block() and lzsa2_decompress_block() that run
+// from RAM, avoiding flash wait states at higher clock speeds. Only provided by
+// the RAM libraries (lzsa-ram.lib and lzsa-large-ram.lib). The code of each must
+// first be copied to RAM by calling the matching init function.
+extern void lzsa1_ram_init(void) __stack_args;
+extern void lzsa2_ram_init(void) __stack_args;
+extern void * lzsa1_decompress_block_ram(void *dst, const void *src) __stack_args;
+extern void * lzsa2_decompress_block_ram(void *dst, const void *src) __stack_args;
+
+// Compressed data and metadata for an asset generated by the lzsa_assets host
+// tool. Decompress with lzsa_asset_decompress(), which calls the routine for
+// the format the asset was compressed with.
+typedef struct {
+	const uint8_t *data;
+	uint16_t comp_len;
+	uint16_t plain_len;
+	uint8_t format;    // 1 = LZSA1, 2 = LZSA2
+	uint16_t checksum; // CRC-16/CCITT-FALSE of decompressed data
+	uint32_t cycles;   // Predicted decompression cycles
+} lzsa_asset_t;
+
+#define lzsa_asset_decompress(dst, asset) \
+	((asset)->format == 1 ? lzsa1_decompress_block((dst), (asset)->data) : lzsa2_decompress_block((dst), (asset)->data))
+
+// LZ4 block decompression, provided for comparison against the LZSA formats.
+// Unlike LZSA, a raw LZ4 block has no end-of-data marker, so the length of the
+// compressed data must also be given.
+extern void * lz4_decompress_block(void *dst, const void *src, size_t src_len) __stack_args;
+
+// ZX0 block decompression. Gives a better compression ratio than LZSA2, at the
+// expense of slower decompression.
+extern void * zx0_decompress_block(void *dst, const void *src) __stack_args;
 
 #endif // LZSA_H_
@@ -37,6 +37,14 @@
 ;
 ; NOTE: this function is not re-entrant, due to use of static variables.
 ;
+; When built with LZSA_RAM set (see lzsa_medium_ram.s and lzsa_large_ram.s), the
+; following are also provided:
+;     void lzsa1_ram_init(void)
+;     void * lzsa1_decompress_block_ram(void *dst, const void *src)
+; The first copies the code of this function to a buffer in RAM, which is the
+; second. The second is then called in the same way as this function, but must
+; not be called before the first has been.
+;
 ; Inspiration for algorithm and structure taken from decompression routine for
 ; 6809 microprocessor by Emmanuel Marty.
 ; https://github.com/emmanuel-marty/lzsa
@@ -46,6 +54,11 @@
 
 .module lzsa1
 .globl _lzsa1_decompress_block
+.globl lzsa1_decompress
+.if LZSA_RAM
+.globl _lzsa1_ram_init
+.globl _lzsa1_decompress_block_ram
+.endif
 
 ; ------------------------------------------------------------------------------
 ; Static global variables (plus MSB/LSB aliases for convenience)
@@ -76,6 +89,11 @@ _lzsa1_decompress_block:
 	ldw x, (ARGS_SP_OFFSET+2, sp)
 	ldw y, (ARGS_SP_OFFSET+0, sp)
 
+lzsa1_decompress:
+	; Entry point for use by other routines (e.g. lzsa1_decompress_batch), with
+	; source pointer already in X reg and destination pointer in Y reg. Returns
+	; in the same manner as this function.
+
 lzsa1_token:
 	; Token format: O|LLL|MMMM
 
@@ -175,6 +193,15 @@ lzsa1_no_lit:
 	mov match_off_msb, #0xFF
 	jra lzsa1_got_match_off
 
+.if LZSA_RAM
+lzsa1_no_match:
+	; Restore source pointer from stack. Proceed to next token. When built to
+	; run from RAM, this is located here instead, so that the start of the token
+	; loop is within reach of a relative jump.
+	popw x
+	jra lzsa1_token
+.endif
+
 lzsa1_big_match_off:
 	; Load second high match offset byte from source. Set as MSB of match offset
 	; word variable.
@@ -278,7 +305,36 @@ lzsa1_copy_match:
 	; Loop around to next byte.
 	jra lzsa1_copy_match_loop
 
+.if LZSA_RAM
+	; (Located above when built to run from RAM.)
+.else
 lzsa1_no_match:
 	; Restore source pointer from stack. Proceed to next token.
 	popw x
 	jump_abs lzsa1_token
+.endif
+
+.if LZSA_RAM
+
+; ------------------------------------------------------------------------------
+; Loader for running from RAM
+; ------------------------------------------------------------------------------
+
+_lzsa1_ram_init:
+	; Copy the code of the above function (i.e. everything from its start up to
+	; here) to its RAM buffer, one byte at a time. A far load is used so that the
+	; code may be anywhere in flash with the large memory model.
+	clrw x
+0$:
+	ldf a, (_lzsa1_decompress_block, x)
+	ld (_lzsa1_decompress_block_ram, x), a
+	incw x
+	cpw x, #(_lzsa1_ram_init - _lzsa1_decompress_block)
+	jrne 0$
+	return
+
+.area DATA
+
+_lzsa1_decompress_block_ram: .blkb (_lzsa1_ram_init - _lzsa1_decompress_block)
+
+.endif
@@ -0,0 +1,60 @@
+; ------------------------------------------------------------------------------
+; LZSA1 BATCH DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa1_batch.s - LZSA1 decompression of multiple blocks in one call
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lzsa1_decompress_batch(const lzsa_batch_entry_t *entries, uint8_t count, void **ends)
+; Arguments:
+;     entries = pointer to table of entries, each giving pointers to source
+;               compressed data and destination decompression buffer
+;     count = number of entries in table (0-255)
+;     ends = pointer to array of 'count' pointers, which is filled in with the
+;            position in each entry's destination buffer after the last byte of
+;            decompressed data (may be NULL if not needed)
+; Returns:
+;     Pointer to a position in the last entry's destination buffer after the
+;     last byte of decompressed data, or NULL if count is zero.
+;
+; NOTE: this function is not re-entrant, due to use of static variables by
+; lzsa1_decompress_block.
+;
+; The decompression loop is shared with lzsa2_decompress_batch (see
+; lzsa_batch.s).
+
+.module lzsa1_batch
+.globl _lzsa1_decompress_batch
+.globl lzsa1_decompress
+
+.include "lzsa_batch.s"
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+decompress_batch _lzsa1_decompress_batch, lzsa1_decompress
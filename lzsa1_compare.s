@@ -0,0 +1,314 @@
+; ------------------------------------------------------------------------------
+; LZSA1 BLOCK DECOMPRESS-AND-COMPARE FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa1_compare.s - LZSA1 decompress-and-compare routine
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     uint16_t lzsa1_compare_block(const void *target, const void *src)
+; Arguments:
+;     target = pointer to memory to compare against decompressed data
+;     src = pointer to source compressed data
+; Returns:
+;     Offset of the first byte of the target that differs from the decompressed
+;     data, or if there is no difference, the length of the decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; Nothing is written. Each byte of decompressed data is compared against the
+; target instead, and matches are copied from the target itself, which is
+; valid because everything before the current position has already been found
+; to be the same. So a region of any size (e.g. flash) may be verified against
+; a compressed image of it without a buffer.
+;
+; LZSA1 block format documentation:
+; https://github.com/emmanuel-marty/lzsa/blob/master/BlockFormat_LZSA1.md
+
+.module lzsa1_compare
+.globl _lzsa1_compare_block
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+lit_len: .blkw 1
+lit_len_msb .equ (lit_len+0)
+lit_len_lsb .equ (lit_len+1)
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+match_len: .blkw 1
+match_len_msb .equ (match_len+0)
+match_len_lsb .equ (match_len+1)
+
+target: .blkw 1
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa1_compare_block:
+	; Load source pointer to X reg and target pointer to Y reg. Also keep the
+	; start of the target, for working out the offset to return.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+	ldw target, y
+
+lzsa1c_token:
+	; Token format: O|LLL|MMMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LLL literal length from token in A. Branch if no literals (length
+	; is zero). Check if there is optional extra literal length byte (i.e.
+	; length is 7). If not, we have final count, so go ahead and compare
+	; literals.
+	and a, #0x70
+	jreq lzsa1c_no_lit
+	cp a, #0x70
+	jrne lzsa1c_decode_lit_len
+
+	; Load extra literal length byte. Add 7 to it and if there is no carry,
+	; value was 0-248 (final literal length). If carry but now non-zero, value
+	; was 250 (one more byte). Otherwise, value was 249 (two more bytes).
+	ld a, (x)
+	incw x
+	add a, #7
+	jrnc lzsa1c_small_lit_len
+	jrne lzsa1c_medium_lit_len
+
+	; Load two more bytes and set as length word var, converting from little- to
+	; big-endian as we go. Then go ahead and compare literals.
+	ld a, (x)
+	incw x
+	ld lit_len_lsb, a
+	ld a, (x)
+	incw x
+	ld lit_len_msb, a
+	jra lzsa1c_got_lit_len
+
+lzsa1c_medium_lit_len:
+	; Load second literal length byte. Add 256 to it by setting MSB of literal
+	; length word variable to 1 and setting LSB to loaded value. Then go ahead
+	; and compare literals.
+	ld a, (x)
+	incw x
+	mov lit_len_msb, #0x01
+	ld lit_len_lsb, a
+	jra lzsa1c_got_lit_len
+
+lzsa1c_decode_lit_len:
+	; Shift literal count right by 4 bits, by simply swapping nibbles.
+	swap a
+
+lzsa1c_small_lit_len:
+	; Clear MSB of literal length word variable, set current value of A to LSB.
+	clr lit_len_msb
+	ld lit_len_lsb, a
+
+lzsa1c_got_lit_len:
+lzsa1c_cmp_lit_loop:
+	; Test if literal length variable value is zero. If so, proceed to handling
+	; match offset. Otherwise, continue to compare next literal byte.
+	tnz lit_len_msb
+	jrne lzsa1c_cmp_lit
+	tnz lit_len_lsb
+	jrne lzsa1c_cmp_lit
+	jra lzsa1c_no_lit
+
+lzsa1c_lit_mismatch:
+	; Discard token from stack. Return offset of mismatching target byte from
+	; start of target in X reg. (The common exit below is out of reach of a
+	; relative jump from here.)
+	pop a
+	ldw x, y
+	subw x, target
+	return
+
+lzsa1c_cmp_lit:
+	; Decrement literal length word variable in-place (without using X/Y
+	; registers and DECW instruction).
+	ld a, lit_len_lsb
+	sub a, #1
+	ld lit_len_lsb, a
+	ld a, lit_len_msb
+	sbc a, #0
+	ld lit_len_msb, a
+
+	; Compare a single literal byte from source against the target. Stop if it
+	; differs.
+	ld a, (x)
+	incw x
+	cp a, (y)
+	jrne lzsa1c_lit_mismatch
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa1c_cmp_lit_loop
+
+lzsa1c_no_lit:
+	; Load match offset low byte from source and set as LSB of match offset var.
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+
+	; Retrieve token from stack (without popping it) and check O flag bit.
+	; If set, proceed to load optional high match offset byte.
+	ld a, (1, sp)
+	jrmi lzsa1c_big_match_off
+
+	; Otherwise, we don't have optional high match offset byte, so default MSB
+	; of var to 0xFF.
+	mov match_off_msb, #0xFF
+	jra lzsa1c_got_match_off
+
+lzsa1c_big_match_off:
+	; Load second high match offset byte from source. Set as MSB of match offset
+	; word variable.
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+
+lzsa1c_got_match_off:
+	; Retrieve token from stack (popping this time), mask off MMMM match length
+	; bits, add the minimum match length (3) to the value. Place in LSB of match
+	; length word variable (and clear MSB).
+	pop a
+	and a, #0x0F
+	add a, #3
+	clr match_len_msb
+	ld match_len_lsb, a
+
+	; Check if we have optional extra match length bytes (i.e. match length was
+	; 15 before addition). Otherwise, we have final length, so proceed to
+	; compare matched bytes.
+	cp a, #18
+	jrne lzsa1c_got_match_len
+
+	; Read another byte from source and add to current match length (18). If
+	; there is no carry, value was 0-237 and we now have the final match length.
+	; If carry but now non-zero, value was 239 (one more byte). Otherwise, value
+	; was 238 (two more bytes).
+	add a, (x)
+	incw x
+	jrnc lzsa1c_small_match_len
+	tnz a
+	jrne lzsa1c_medium_match_len
+
+	; Load two more bytes and set as match length word variable, converting from
+	; little- to big-endian as we go. Then proceed to compare matched bytes.
+	ld a, (x)
+	incw x
+	ld match_len_lsb, a
+	ld a, (x)
+	incw x
+	ld match_len_msb, a
+
+	; Check if the two-byte match length is zero, which indicates end-of-data
+	; (EOD) for the block. If it is, we're done, so carry on and exit.
+	tnz match_len_msb
+	jrne lzsa1c_got_match_len
+	tnz match_len_lsb
+	jrne lzsa1c_got_match_len
+
+	; Everything matched, so return length of decompressed data.
+	jra lzsa1c_done
+
+lzsa1c_medium_match_len:
+	; Load second match length byte. Add 256 to it by setting MSB of match
+	; length word variable to 1 and setting LSB to loaded value. Then proceed to
+	; compare matched bytes.
+	ld a, (x)
+	incw x
+	mov match_len_msb, #0x01
+	ld match_len_lsb, a
+	jra lzsa1c_got_match_len
+
+lzsa1c_small_match_len:
+	; Clear MSB of match length word variable, set current value of A to LSB.
+	clr match_len_msb
+	ld match_len_lsb, a
+
+lzsa1c_got_match_len:
+	; Save current source pointer on stack. Copy current target pointer to X reg
+	; and add match offset to it.
+	pushw x
+	ldw x, y
+	addw x, match_off
+
+lzsa1c_cmp_match_loop:
+	; Test if match length variable value is zero. If not, continue to compare
+	; next matched byte. Otherwise, exit loop.
+	tnz match_len_msb
+	jrne lzsa1c_cmp_match
+	tnz match_len_lsb
+	jrne lzsa1c_cmp_match
+	jra lzsa1c_no_match
+
+lzsa1c_cmp_match:
+	; Decrement match length word variable in-place (without using X/Y registers
+	; and DECW instruction).
+	ld a, match_len_lsb
+	sub a, #1
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	sbc a, #0
+	ld match_len_msb, a
+
+	; Compare a single matched byte, from earlier in the target, against the
+	; target. Stop if it differs.
+	ld a, (x)
+	incw x
+	cp a, (y)
+	jrne lzsa1c_match_mismatch
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa1c_cmp_match_loop
+
+lzsa1c_no_match:
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsa1c_token
+
+lzsa1c_match_mismatch:
+	; Discard saved source pointer from stack.
+	popw x
+
+lzsa1c_done:
+	; Return offset of current target position from start of target in X reg.
+	ldw x, y
+	subw x, target
+	return
+
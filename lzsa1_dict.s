@@ -0,0 +1,377 @@
+; ------------------------------------------------------------------------------
+; LZSA1 BLOCK DECOMPRESSION WITH DICTIONARY FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa1_dict.s - LZSA1 decompression with far dictionary
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lzsa1_decompress_block_dict(void *dst, const void *src, uint32_t dict)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+;     dict = far address of the end of the dictionary (i.e. one past its last
+;            byte)
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; The dictionary is treated as if it came immediately before the destination
+; buffer, so matches with an offset reaching back past the start of the buffer
+; are copied from it instead. It is read with far loads, so may be anywhere in
+; the 24-bit address space (e.g. a firmware image in flash above 64 KB). A match
+; that starts in the dictionary may run on into the start of the output.
+;
+; LZSA1 block format documentation:
+; https://github.com/emmanuel-marty/lzsa/blob/master/BlockFormat_LZSA1.md
+
+.module lzsa1_dict
+.globl _lzsa1_decompress_block_dict
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+lit_len: .blkw 1
+lit_len_msb .equ (lit_len+0)
+lit_len_lsb .equ (lit_len+1)
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+match_len: .blkw 1
+match_len_msb .equ (match_len+0)
+match_len_lsb .equ (match_len+1)
+
+dst_start: .blkw 1
+
+dict_end: .blkb 3
+dict_end_ext .equ (dict_end+0)
+dict_end_msb .equ (dict_end+1)
+dict_end_lsb .equ (dict_end+2)
+
+dict_ptr: .blkb 3
+dict_ptr_ext .equ (dict_ptr+0)
+dict_ptr_msb .equ (dict_ptr+1)
+dict_ptr_lsb .equ (dict_ptr+2)
+
+dict_left: .blkw 1
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa1_decompress_block_dict:
+	; Store the low 24 bits of the dictionary end address (which is a 32-bit
+	; big-endian argument). Ignore the top byte.
+	ld a, (ARGS_SP_OFFSET+5, sp)
+	ld dict_end_ext, a
+	ldw x, (ARGS_SP_OFFSET+6, sp)
+	ldw dict_end_msb, x
+
+	; Load source pointer to X reg and destination pointer to Y reg. Also keep
+	; the start of the destination, for telling which matches are in the
+	; dictionary.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+	ldw dst_start, y
+
+lzsa1d_token:
+	; Token format: O|LLL|MMMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LLL literal length from token in A. Branch if no literals (length
+	; is zero). Check if there is optional extra literal length byte (i.e.
+	; length is 7). If not, we have final count, so go ahead and copy literals.
+	and a, #0x70
+	jreq lzsa1d_no_lit
+	cp a, #0x70
+	jrne lzsa1d_decode_lit_len
+
+	; Load extra literal length byte. Add 7 to it and if there is no carry,
+	; value was 0-248 (final literal length). If carry but now non-zero, value
+	; was 250 (one more byte). Otherwise, value was 249 (two more bytes).
+	ld a, (x)
+	incw x
+	add a, #7
+	jrnc lzsa1d_small_lit_len
+	jrne lzsa1d_medium_lit_len
+
+	; Load two more bytes and set as length word var, converting from little- to
+	; big-endian as we go. Then go ahead and copy literals.
+	ld a, (x)
+	incw x
+	ld lit_len_lsb, a
+	ld a, (x)
+	incw x
+	ld lit_len_msb, a
+	jra lzsa1d_got_lit_len
+
+lzsa1d_medium_lit_len:
+	; Load second literal length byte. Add 256 to it by setting MSB of literal
+	; length word variable to 1 and setting LSB to loaded value. Then go ahead
+	; and copy literals.
+	ld a, (x)
+	incw x
+	mov lit_len_msb, #0x01
+	ld lit_len_lsb, a
+	jra lzsa1d_got_lit_len
+
+lzsa1d_decode_lit_len:
+	; Shift literal count right by 4 bits, by simply swapping nibbles.
+	swap a
+
+lzsa1d_small_lit_len:
+	; Clear MSB of literal length word variable, set current value of A to LSB.
+	clr lit_len_msb
+	ld lit_len_lsb, a
+
+lzsa1d_got_lit_len:
+lzsa1d_copy_lit_loop:
+	; Test if literal length variable value is zero. If so, proceed to handling
+	; match offset. Otherwise, continue to copy next literal byte.
+	tnz lit_len_msb
+	jrne lzsa1d_copy_lit
+	tnz lit_len_lsb
+	jrne lzsa1d_copy_lit
+	jra lzsa1d_no_lit
+
+lzsa1d_copy_lit:
+	; Decrement literal length word variable in-place (without using X/Y
+	; registers and DECW instruction).
+	ld a, lit_len_lsb
+	sub a, #1
+	ld lit_len_lsb, a
+	ld a, lit_len_msb
+	sbc a, #0
+	ld lit_len_msb, a
+
+	; Copy a single byte from source to destination.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa1d_copy_lit_loop
+
+lzsa1d_no_lit:
+	; Load match offset low byte from source and set as LSB of match offset var.
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+
+	; Retrieve token from stack (without popping it) and check O flag bit.
+	; If set, proceed to load optional high match offset byte.
+	ld a, (1, sp)
+	jrmi lzsa1d_big_match_off
+
+	; Otherwise, we don't have optional high match offset byte, so default MSB
+	; of var to 0xFF.
+	mov match_off_msb, #0xFF
+	jra lzsa1d_got_match_off
+
+lzsa1d_big_match_off:
+	; Load second high match offset byte from source. Set as MSB of match offset
+	; word variable.
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+
+lzsa1d_got_match_off:
+	; Retrieve token from stack (popping this time), mask off MMMM match length
+	; bits, add the minimum match length (3) to the value. Place in LSB of match
+	; length word variable (and clear MSB).
+	pop a
+	and a, #0x0F
+	add a, #3
+	clr match_len_msb
+	ld match_len_lsb, a
+
+	; Check if we have optional extra match length bytes (i.e. match length was
+	; 15 before addition). Otherwise, we have final length, so proceed to copy
+	; matched bytes.
+	cp a, #18
+	jrne lzsa1d_got_match_len
+
+	; Read another byte from source and add to current match length (18). If
+	; there is no carry, value was 0-237 and we now have the final match length.
+	; If carry but now non-zero, value was 239 (one more byte). Otherwise, value
+	; was 238 (two more bytes).
+	add a, (x)
+	incw x
+	jrnc lzsa1d_small_match_len
+	tnz a
+	jrne lzsa1d_medium_match_len
+
+	; Load two more bytes and set as match length word variable, converting from
+	; little- to big-endian as we go. Then proceed to copy matched bytes.
+	ld a, (x)
+	incw x
+	ld match_len_lsb, a
+	ld a, (x)
+	incw x
+	ld match_len_msb, a
+
+	; Check if the two-byte match length is zero, which indicates end-of-data
+	; (EOD) for the block. If it is, we're done, so carry on and exit.
+	tnz match_len_msb
+	jrne lzsa1d_got_match_len
+	tnz match_len_lsb
+	jrne lzsa1d_got_match_len
+
+	; Return current destination pointer in X reg.
+	ldw x, y
+	return
+
+lzsa1d_medium_match_len:
+	; Load second match length byte. Add 256 to it by setting MSB of match
+	; length word variable to 1 and setting LSB to loaded value. Then proceed to
+	; copy matched bytes.
+	ld a, (x)
+	incw x
+	mov match_len_msb, #0x01
+	ld match_len_lsb, a
+	jra lzsa1d_got_match_len
+
+lzsa1d_small_match_len:
+	; Clear MSB of match length word variable, set current value of A to LSB.
+	clr match_len_msb
+	ld match_len_lsb, a
+
+lzsa1d_got_match_len:
+	; Save current source pointer on stack. Work out the position of the match
+	; relative to the start of the destination, by subtracting that from the
+	; current destination pointer (in a copy in X reg) and adding the match
+	; offset. If there is no carry from the addition, the match is before the
+	; start, so is in the dictionary. Otherwise, add the start back to get the
+	; match's address in the destination.
+	pushw x
+	ldw x, y
+	subw x, dst_start
+	addw x, match_off
+	jrnc lzsa1d_dict_match
+	addw x, dst_start
+
+lzsa1d_copy_match_loop:
+	; Test if match length variable value is zero. If not, continue to copy next
+	; matched byte. Otherwise, exit loop.
+	tnz match_len_msb
+	jrne lzsa1d_copy_match
+	tnz match_len_lsb
+	jrne lzsa1d_copy_match
+	jra lzsa1d_no_match
+
+lzsa1d_copy_match:
+	; Decrement match length word variable in-place (without using X/Y registers
+	; and DECW instruction).
+	ld a, match_len_lsb
+	sub a, #1
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	sbc a, #0
+	ld match_len_msb, a
+
+	; Copy a single byte from source to destination.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa1d_copy_match_loop
+
+lzsa1d_no_match:
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsa1d_token
+
+lzsa1d_dict_match:
+	; The match position in X reg is a negative offset from the end of the
+	; dictionary. Add it (sign-extended to 24 bits) to the dictionary end
+	; address to get the far address of the match.
+	ld a, xl
+	add a, dict_end_lsb
+	ld dict_ptr_lsb, a
+	ld a, xh
+	adc a, dict_end_msb
+	ld dict_ptr_msb, a
+	ld a, dict_end_ext
+	adc a, #0xFF
+	ld dict_ptr_ext, a
+
+	; Negate the match position to get the count of bytes left in the
+	; dictionary. Then use X reg as index from the far address.
+	negw x
+	ldw dict_left, x
+	clrw x
+
+lzsa1d_dict_match_loop:
+	; Test if match length variable value is zero. If not, continue to copy next
+	; matched byte. Otherwise, exit loop.
+	tnz match_len_msb
+	jrne lzsa1d_dict_match_copy
+	tnz match_len_lsb
+	jreq lzsa1d_no_match
+
+lzsa1d_dict_match_copy:
+	; If the end of the dictionary has been reached, carry on copying from the
+	; start of the destination instead.
+	cpw x, dict_left
+	jreq lzsa1d_dict_match_span
+
+	; Decrement match length word variable in-place.
+	ld a, match_len_lsb
+	sub a, #1
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	sbc a, #0
+	ld match_len_msb, a
+
+	; Copy a single byte from the dictionary to destination.
+	ldf a, ([dict_ptr].e, x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa1d_dict_match_loop
+
+lzsa1d_dict_match_span:
+	; Load start of destination into X reg as the match source pointer, then go
+	; back to copy the remainder of the match (whose length is known non-zero)
+	; by the normal means.
+	ldw x, dst_start
+	jra lzsa1d_copy_match
@@ -0,0 +1,230 @@
+; ------------------------------------------------------------------------------
+; LZSA1 BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa1_small.s - LZSA1 decompression routine for blocks of under 256 bytes
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lzsa1_decompress_small(void *dst, const void *src)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data. When built with LZSA_DEBUG set, NULL if the block
+;     can not be decompressed by this function.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; A version of lzsa1_decompress_block() for blocks that decompress to fewer
+; than 256 bytes, so that no literal or match length can be 256 or more. Each
+; length is kept in a single byte, decremented in place, and the paths for
+; lengths given by two extra bytes are omitted. Any extra match length byte of
+; 238 or more is taken as the end-of-data marker. Other blocks are decompressed
+; incorrectly, unless built with LZSA_DEBUG set (see lzsa_medium.s, etc.), in
+; which case a block with a length needing two extra bytes, or a block that
+; decompresses to 256 bytes or more, is rejected. Note that a rejected block
+; may already have been partly decompressed.
+;
+; LZSA1 block format documentation:
+; https://github.com/emmanuel-marty/lzsa/blob/master/BlockFormat_LZSA1.md
+
+.module lzsa1_small
+.globl _lzsa1_decompress_small
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+len: .blkb 1
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+.if LZSA_DEBUG
+dst_start: .blkw 1
+.endif
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa1_decompress_small:
+	; Load source pointer to X reg and destination pointer to Y reg. Keep the
+	; destination pointer for checking the decompressed length at the end.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+.if LZSA_DEBUG
+	ldw dst_start, y
+.endif
+
+lzsa1sm_token:
+	; Token format: O|LLL|MMMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LLL literal length from token in A. Branch if no literals (length
+	; is zero). Check if there is optional extra literal length byte (i.e.
+	; length is 7). If not, we have final count, so go ahead and copy literals.
+	and a, #0x70
+	jreq lzsa1sm_no_lit
+	cp a, #0x70
+	jrne lzsa1sm_decode_lit_len
+
+	; Load extra literal length byte and add 7 to it, giving the final literal
+	; length. A carry means the value was 249 or 250 (more bytes follow), which
+	; can only be for a length of 256 or more.
+	ld a, (x)
+	incw x
+	add a, #7
+.if LZSA_DEBUG
+	jrc lzsa1sm_reject_lit
+.endif
+	jra lzsa1sm_got_lit_len
+
+lzsa1sm_decode_lit_len:
+	; Shift literal count right by 4 bits, by simply swapping nibbles.
+	swap a
+
+lzsa1sm_got_lit_len:
+	; Set literal length variable. It is never zero here.
+	ld len, a
+
+lzsa1sm_copy_lit:
+	; Copy a single byte from source to destination. Decrement literal length
+	; and loop around to next byte until it reaches zero.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	dec len
+	jrne lzsa1sm_copy_lit
+
+lzsa1sm_no_lit:
+	; Load match offset low byte from source and set as LSB of match offset var.
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+
+	; Retrieve token from stack (without popping it) and check O flag bit.
+	; If set, proceed to load optional high match offset byte.
+	ld a, (1, sp)
+	jrmi lzsa1sm_big_match_off
+
+	; Otherwise, we don't have optional high match offset byte, so default MSB
+	; of var to 0xFF.
+	mov match_off_msb, #0xFF
+	jra lzsa1sm_got_match_off
+
+lzsa1sm_big_match_off:
+	; Load second high match offset byte from source. Set as MSB of match offset
+	; word variable.
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+
+lzsa1sm_got_match_off:
+	; Retrieve token from stack (popping this time), mask off MMMM match length
+	; bits, add the minimum match length (3) to the value.
+	pop a
+	and a, #0x0F
+	add a, #3
+
+	; Check if we have optional extra match length byte (i.e. match length was
+	; 15 before addition). Otherwise, we have final length, so proceed to copy
+	; matched bytes.
+	cp a, #18
+	jrne lzsa1sm_got_match_len
+
+	; Read another byte from source and add to current match length (18). If
+	; there is no carry, value was 0-237 and we now have the final match length.
+	; Otherwise, take it as end-of-data (EOD).
+	add a, (x)
+	incw x
+	jrc lzsa1sm_end
+
+lzsa1sm_got_match_len:
+	; Set match length variable. It is never zero here. Save current source
+	; pointer on stack. Copy current destination pointer to X reg and add match
+	; offset to it.
+	ld len, a
+	pushw x
+	ldw x, y
+	addw x, match_off
+
+lzsa1sm_copy_match:
+	; Copy a single byte from source to destination. Decrement match length and
+	; loop around to next byte until it reaches zero.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	dec len
+	jrne lzsa1sm_copy_match
+
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsa1sm_token
+
+lzsa1sm_end:
+.if LZSA_DEBUG
+	; The byte read was 238 for EOD, or a two-byte length, and 239 for a length
+	; of 256 or more (i.e. A is now 0 or 1). Reject anything other than EOD,
+	; which is followed by two zero bytes.
+	tnz a
+	jrne lzsa1sm_reject
+	ld a, (x)
+	or a, (1, x)
+	jrne lzsa1sm_reject
+
+	; Reject if 256 bytes or more were decompressed.
+	ldw x, y
+	subw x, dst_start
+	cpw x, #0x0100
+	jruge lzsa1sm_reject
+.endif
+
+	; Return current destination pointer in X reg.
+	ldw x, y
+	return
+
+.if LZSA_DEBUG
+lzsa1sm_reject_lit:
+	; Discard the token saved on the stack.
+	pop a
+
+lzsa1sm_reject:
+	; Return NULL.
+	clrw x
+	return
+.endif
@@ -37,6 +37,14 @@
 ;
 ; NOTE: this function is not re-entrant, due to use of static variables.
 ;
+; When built with LZSA_RAM set (see lzsa_medium_ram.s and lzsa_large_ram.s), the
+; following are also provided:
+;     void lzsa2_ram_init(void)
+;     void * lzsa2_decompress_block_ram(void *dst, const void *src)
+; The first copies the code of this function to a buffer in RAM, which is the
+; second. The second is then called in the same way as this function, but must
+; not be called before the first has been.
+;
 ; Inspiration for algorithm and structure taken from decompression routine for
 ; 6809 microprocessor by Emmanuel Marty.
 ; https://github.com/emmanuel-marty/lzsa
@@ -46,6 +54,11 @@
 
 .module lzsa2
 .globl _lzsa2_decompress_block
+.globl lzsa2_decompress
+.if LZSA_RAM
+.globl _lzsa2_ram_init
+.globl _lzsa2_decompress_block_ram
+.endif
 
 ; ------------------------------------------------------------------------------
 ; Static global variables (plus MSB/LSB aliases for convenience)
@@ -68,6 +81,59 @@ match_len_lsb .equ (match_len+1)
 nibbles: .blkb 1
 nibbles_rdy: .blkb 1
 
+; ------------------------------------------------------------------------------
+; Macros
+; ------------------------------------------------------------------------------
+
+; Call of, and return from, the nibble fetching routine. When built to run from
+; RAM, these are relative and near (respectively), so that the code remains
+; position-independent.
+
+.macro call_fetch_nibble
+	.if LZSA_RAM
+	callr lzsa2_fetch_nibble
+	.else
+	call_abs lzsa2_fetch_nibble
+	.endif
+.endm
+
+.macro return_fetch_nibble
+	.if LZSA_RAM
+	ret
+	.else
+	return
+	.endif
+.endm
+
+; The nibble fetching routine itself, which is placed at the end of the
+; function, or in the middle when built to run from RAM.
+;
+; NOTE: we must be careful in this routine not to alter the carry flag! Calling
+; code relies on the value of the carry flag being maintained.
+
+.macro fetch_nibble_routine
+lzsa2_fetch_nibble:
+	; Toggle the ready flag.
+	bcpl nibbles_rdy, #0
+	tnz nibbles_rdy        ; }
+	jreq lzsa2_nib_not_rdy ; } Can't use btjf here as it changes carry.
+
+	; We have nibbles ready. Mask off the low nibble and return in A reg.
+	ld a, nibbles
+	and a, #0x0F
+	return_fetch_nibble
+
+lzsa2_nib_not_rdy:
+	; Load a new pair of nibbles (i.e. a byte) from input and store. Mask off
+	; the high nibble, shift over and return the value in A reg.
+	ld a, (x)
+	incw x
+	ld nibbles, a
+	and a, #0xF0
+	swap a
+	return_fetch_nibble
+.endm
+
 ; ------------------------------------------------------------------------------
 ; Function code
 ; ------------------------------------------------------------------------------
@@ -79,6 +145,11 @@ _lzsa2_decompress_block:
 	ldw x, (ARGS_SP_OFFSET+2, sp)
 	ldw y, (ARGS_SP_OFFSET+0, sp)
 
+lzsa2_decompress:
+	; Entry point for use by other routines (e.g. lzsa2_decompress_batch), with
+	; source pointer already in X reg and destination pointer in Y reg. Returns
+	; in the same manner as this function.
+
 	mov nibbles_rdy, #0x01
 
 lzsa2_token:
@@ -100,7 +171,7 @@ lzsa2_token:
 	; Fetch a nibble in to A reg. Add the existing literal length (3) to it and
 	; if it's now 18, an optional extra literal length byte follows. Otherwise,
 	; we have final length.
-	call_abs lzsa2_fetch_nibble
+	call_fetch_nibble
 	add a, #3
 	cp a, #18
 	jrne lzsa2_small_lit_len
@@ -177,7 +248,7 @@ lzsa2_no_lit:
 	; Z bit from mode (in carry) to bit 0. Then XOR with a mask to set bits 5-7
 	; of the offset to 1 and flip the Z bit. Also set MSB of offset to all 1s.
 	sll a
-	call_abs lzsa2_fetch_nibble
+	call_fetch_nibble
 	rlc a
 	xor a, #0xE1
 	ld match_off_lsb, a
@@ -197,6 +268,21 @@ lzsa2_match_off_9b:
 	ld match_off_lsb, a
 	jra lzsa2_got_match_off
 
+.if LZSA_RAM
+lzsa2_no_match:
+	; Restore source pointer from stack. Proceed to next token. When built to
+	; run from RAM, this is located here instead, the only place within reach
+	; of a relative jump both from the end of the match copying loop and to the
+	; start of the token loop.
+	popw x
+	jra lzsa2_token
+
+	; When built to run from RAM, the nibble fetching routine follows, in the
+	; middle of the function, so that it is within reach of a relative call from
+	; everywhere it is called from.
+	fetch_nibble_routine
+.endif
+
 lzsa2_match_off_13b_16b:
 	; Shift off Y bit into carry. If set, we have a 16-bit match offset.
 	sll a
@@ -209,7 +295,7 @@ lzsa2_match_off_13b_16b:
 	; subtracting 2 from MSB. Finally, read a new byte and set as LSB (bits 0-7)
 	; of offset.
 	sll a
-	call_abs lzsa2_fetch_nibble
+	call_fetch_nibble
 	rlc a
 	xor a, #0xE1
 	sub a, #2
@@ -248,7 +334,7 @@ lzsa2_got_match_off:
 	; Read a nibble (into A) and add the current match length (9) to it. If the
 	; nibble value was 0-14 (before addition), we have final match length, so
 	; proceed to copy matched bytes.
-	call_abs lzsa2_fetch_nibble
+	call_fetch_nibble
 	add a, #9
 	cp a, #24
 	jrne lzsa2_small_match_len
@@ -313,38 +399,51 @@ lzsa2_copy_match:
 	; Loop around to next byte.
 	jra lzsa2_copy_match_loop
 
+.if LZSA_RAM
+	; (Located above when built to run from RAM.)
+.else
 lzsa2_no_match:
 	; Restore source pointer from stack. Proceed to next token.
 	popw x
 	jump_abs lzsa2_token
+.endif
 
 lzsa2_end:
 	; Return current destination pointer in X reg.
 	ldw x, y
 	return
 
+.if LZSA_RAM
+	; (Nibble fetching routine located above when built to run from RAM.)
+.else
+
 ; ------------------------------------------------------------------------------
 
-; NOTE: we must be careful in this function not to alter the carry flag! Calling
-; code relies on the value of the carry flag being maintained.
+	fetch_nibble_routine
 
-lzsa2_fetch_nibble:
-	; Toggle the ready flag.
-	bcpl nibbles_rdy, #0
-	tnz nibbles_rdy        ; }
-	jreq lzsa2_nib_not_rdy ; } Can't use btjf here as it changes carry.
+.endif
 
-	; We have nibbles ready. Mask off the low nibble and return in A reg.
-	ld a, nibbles
-	and a, #0x0F
-	return
+.if LZSA_RAM
 
-lzsa2_nib_not_rdy:
-	; Load a new pair of nibbles (i.e. a byte) from input and store. Mask off
-	; the high nibble, shift over and return the value in A reg.
-	ld a, (x)
+; ------------------------------------------------------------------------------
+; Loader for running from RAM
+; ------------------------------------------------------------------------------
+
+_lzsa2_ram_init:
+	; Copy the code of the above function (i.e. everything from its start up to
+	; here) to its RAM buffer, one byte at a time. A far load is used so that the
+	; code may be anywhere in flash with the large memory model.
+	clrw x
+0$:
+	ldf a, (_lzsa2_decompress_block, x)
+	ld (_lzsa2_decompress_block_ram, x), a
 	incw x
-	ld nibbles, a
-	and a, #0xF0
-	swap a
+	cpw x, #(_lzsa2_ram_init - _lzsa2_decompress_block)
+	jrne 0$
 	return
+
+.area DATA
+
+_lzsa2_decompress_block_ram: .blkb (_lzsa2_ram_init - _lzsa2_decompress_block)
+
+.endif
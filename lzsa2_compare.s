@@ -0,0 +1,371 @@
+; ------------------------------------------------------------------------------
+; LZSA2 BLOCK DECOMPRESS-AND-COMPARE FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa2_compare.s - LZSA2 decompress-and-compare routine
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     uint16_t lzsa2_compare_block(const void *target, const void *src)
+; Arguments:
+;     target = pointer to memory to compare against decompressed data
+;     src = pointer to source compressed data
+; Returns:
+;     Offset of the first byte of the target that differs from the decompressed
+;     data, or if there is no difference, the length of the decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; Works in the same way as lzsa1_compare_block (see lzsa1_compare.s).
+;
+; LZSA2 block format documentation:
+; https://github.com/emmanuel-marty/lzsa/blob/master/BlockFormat_LZSA2.md
+
+.module lzsa2_compare
+.globl _lzsa2_compare_block
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+lit_len: .blkw 1
+lit_len_msb .equ (lit_len+0)
+lit_len_lsb .equ (lit_len+1)
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+match_len: .blkw 1
+match_len_msb .equ (match_len+0)
+match_len_lsb .equ (match_len+1)
+
+nibbles: .blkb 1
+nibbles_rdy: .blkb 1
+
+target: .blkw 1
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa2_compare_block:
+	; Load source pointer to X reg and target pointer to Y reg. Also keep the
+	; start of the target, for working out the offset to return.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+	ldw target, y
+
+	mov nibbles_rdy, #0x01
+
+lzsa2c_token:
+	; Token format: XYZ|LL|MMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LL literal length from token in A. Branch if no literals (length
+	; is zero). Check if there is optional extra literal length byte (i.e.
+	; length is 3). If not, we have final count, so go ahead and compare
+	; literals.
+	and a, #0x18
+	jreq lzsa2c_no_lit
+	cp a, #0x18
+	jrne lzsa2c_decode_lit_len
+
+	; Fetch a nibble in to A reg. Add the existing literal length (3) to it and
+	; if it's now 18, an optional extra literal length byte follows. Otherwise,
+	; we have final length.
+	call_abs lzsa2c_fetch_nibble
+	add a, #3
+	cp a, #18
+	jrne lzsa2c_small_lit_len
+
+	; Load extra literal length byte and add to existing value. If there was no
+	; carry (i.e. byte read was 0-237), we have final length. Otherwise, value
+	; was 239, signifying two more bytes.
+	add a, (x)
+	incw x
+	jrnc lzsa2c_small_lit_len
+
+	; Load two more bytes and set as length word var, converting from little- to
+	; big-endian as we go. Then go ahead and compare literals.
+	ld a, (x)
+	incw x
+	ld lit_len_lsb, a
+	ld a, (x)
+	incw x
+	ld lit_len_msb, a
+	jra lzsa2c_got_lit_len
+
+lzsa2c_decode_lit_len:
+	; Shift literal length over 3 places.
+	srl a
+	srl a
+	srl a
+
+lzsa2c_small_lit_len:
+	; Clear MSB of literal length word variable, set current value of A to LSB.
+	clr lit_len_msb
+	ld lit_len_lsb, a
+
+lzsa2c_got_lit_len:
+lzsa2c_cmp_lit_loop:
+	; Test if literal length variable value is zero. If so, proceed to handling
+	; match offset. Otherwise, continue to compare next literal byte.
+	tnz lit_len_msb
+	jrne lzsa2c_cmp_lit
+	tnz lit_len_lsb
+	jrne lzsa2c_cmp_lit
+	jra lzsa2c_no_lit
+
+lzsa2c_lit_mismatch:
+	; Discard token from stack. Return offset of mismatching target byte from
+	; start of target in X reg. (The common exit below is out of reach of a
+	; relative jump from here.)
+	pop a
+	ldw x, y
+	subw x, target
+	return
+
+lzsa2c_cmp_lit:
+	; Decrement literal length word variable in-place (without using X/Y
+	; registers and DECW instruction).
+	ld a, lit_len_lsb
+	sub a, #1
+	ld lit_len_lsb, a
+	ld a, lit_len_msb
+	sbc a, #0
+	ld lit_len_msb, a
+
+	; Compare a single literal byte from source against the target. Stop if it
+	; differs.
+	ld a, (x)
+	incw x
+	cp a, (y)
+	jrne lzsa2c_lit_mismatch
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa2c_cmp_lit_loop
+
+lzsa2c_no_lit:
+	; Retrieve token from stack (without popping it). Shift off the match offset
+	; mode X bit into carry. If set, we have 13- or 16-bit match offset. If not,
+	; then shift off Y bit into carry. If set, we have 9-bit match offset.
+	ld a, (1, sp)
+	sll a
+	jrc lzsa2c_match_off_13b_16b
+	sll a
+	jrc lzsa2c_match_off_9b
+
+	; Otherwise, we have a 5-bit match offset. Shift off Z bit of mode to carry.
+	; Read a nibble (into A) and rotate the value of that to offset bits 1-4 and
+	; Z bit from mode (in carry) to bit 0. Then XOR with a mask to set bits 5-7
+	; of the offset to 1 and flip the Z bit. Also set MSB of offset to all 1s.
+	sll a
+	call_abs lzsa2c_fetch_nibble
+	rlc a
+	xor a, #0xE1
+	ld match_off_lsb, a
+	mov match_off_msb, #0xFF
+	jra lzsa2c_got_match_off
+
+; NOTE: we must be careful in this function not to alter the carry flag! Calling
+; code relies on the value of the carry flag being maintained.
+
+lzsa2c_fetch_nibble:
+	; Toggle the ready flag.
+	bcpl nibbles_rdy, #0
+	tnz nibbles_rdy        ; }
+	jreq lzsa2c_nib_not_rdy ; } Can't use btjf here as it changes carry.
+
+	; We have nibbles ready. Mask off the low nibble and return in A reg.
+	ld a, nibbles
+	and a, #0x0F
+	return
+
+lzsa2c_nib_not_rdy:
+	; Load a new pair of nibbles (i.e. a byte) from input and store. Mask off
+	; the high nibble, shift over and return the value in A reg.
+	ld a, (x)
+	incw x
+	ld nibbles, a
+	and a, #0xF0
+	swap a
+	return
+
+lzsa2c_match_off_9b:
+	; We have a 9-bit match offset. Shift off Z bit of mode to carry and invert.
+	; Set MSB of offset to all 1s, then rotate Z bit in to bit 8. Load another
+	; byte and set as LSB (bits 0-7) of offset.
+	sll a
+	ccf
+	mov match_off_msb, #0xFF
+	rlc match_off_msb
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	jra lzsa2c_got_match_off
+
+lzsa2c_match_off_13b_16b:
+	; Shift off Y bit into carry. If set, we have a 16-bit match offset.
+	sll a
+	jrc lzsa2c_match_off_16b
+
+	; Otherwise, we have a 13-bit offset. Shift off Z bit of mode to carry. Read
+	; a nibble (into A) and rotate the value of that to offset bits 9-12 and Z
+	; bit from mode (in carry) to bit 8. Then XOR with a mask to set bits 13-15
+	; of the offset to 1 and flip the Z bit. Subtract 512 from final offset by
+	; subtracting 2 from MSB. Finally, read a new byte and set as LSB (bits 0-7)
+	; of offset.
+	sll a
+	call_abs lzsa2c_fetch_nibble
+	rlc a
+	xor a, #0xE1
+	sub a, #2
+	ld match_off_msb, a
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	jra lzsa2c_got_match_off
+
+lzsa2c_match_off_16b:
+	; If Z bit of mode is set, we repeat the previous offset value.
+	jrmi lzsa2c_got_match_off
+
+	; Otherwise, we have a 16-bit offset. Read two bytes containing the final
+	; match offset value, already in big-endian format.
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+
+lzsa2c_got_match_off:
+	; Retrieve token from stack (popping this time), mask off MMM match length
+	; bits, add the minimum match length (2) to the value.
+	pop a
+	and a, #0x07
+	add a, #2
+
+	; Check if we have optional extra match length bytes (i.e. match length was
+	; 7 before addition). Otherwise, we have final length, so proceed to
+	; compare matched bytes.
+	cp a, #9
+	jrne lzsa2c_small_match_len
+
+	; Read a nibble (into A) and add the current match length (9) to it. If the
+	; nibble value was 0-14 (before addition), we have final match length, so
+	; proceed to compare matched bytes.
+	call_abs lzsa2c_fetch_nibble
+	add a, #9
+	cp a, #24
+	jrne lzsa2c_small_match_len
+
+	; Read another byte from source and add to current match length. If there is
+	; no carry, value was 0-231 and we have final length. If carry, but length
+	; is zero, value was 232, signifying end-of-data (EOD), so quit. Otherwise,
+	; value was 233, meaning two more bytes.
+	add a, (x)
+	incw x
+	jrnc lzsa2c_small_match_len
+	tnz a
+	jreq lzsa2c_end
+
+	; Load two more bytes and set as match length word variable, converting from
+	; little- to big-endian as we go. Then proceed to compare matched bytes.
+	ld a, (x)
+	incw x
+	ld match_len_lsb, a
+	ld a, (x)
+	incw x
+	ld match_len_msb, a
+	jra lzsa2c_got_match_len
+
+lzsa2c_small_match_len:
+	; Place match length value in LSB of length word variable and clear MSB.
+	ld match_len_lsb, a
+	clr match_len_msb
+
+lzsa2c_got_match_len:
+	; Save current source pointer on stack. Copy current target pointer to X reg
+	; and add match offset to it.
+	pushw x
+	ldw x, y
+	addw x, match_off
+
+lzsa2c_cmp_match_loop:
+	; Test if match length variable value is zero. If not, continue to compare
+	; next matched byte. Otherwise, exit loop.
+	tnz match_len_msb
+	jrne lzsa2c_cmp_match
+	tnz match_len_lsb
+	jrne lzsa2c_cmp_match
+	jra lzsa2c_no_match
+
+lzsa2c_cmp_match:
+	; Decrement match length word variable in-place (without using X/Y registers
+	; and DECW instruction).
+	ld a, match_len_lsb
+	sub a, #1
+	ld match_len_lsb, a
+	ld a, match_len_msb
+	sbc a, #0
+	ld match_len_msb, a
+
+	; Compare a single matched byte, from earlier in the target, against the
+	; target. Stop if it differs.
+	ld a, (x)
+	incw x
+	cp a, (y)
+	jrne lzsa2c_match_mismatch
+	incw y
+
+	; Loop around to next byte.
+	jra lzsa2c_cmp_match_loop
+
+lzsa2c_no_match:
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsa2c_token
+
+lzsa2c_match_mismatch:
+	; Discard saved source pointer from stack.
+	popw x
+
+lzsa2c_end:
+	; Return offset of current target position from start of target in X reg.
+	; This is the length of decompressed data if everything matched.
+	ldw x, y
+	subw x, target
+	return
+
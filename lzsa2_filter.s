@@ -0,0 +1,627 @@
+; ------------------------------------------------------------------------------
+; LZSA2 BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa2_filter.s - LZSA2 decompression routine with fused output filter
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lzsa2_decompress_block_filter(void *dst, const void *src, const lzsa_filter_t *filter)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+;     filter = pointer to filter descriptor (type, XOR key, LUT pointer)
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; The decompressed ('raw') byte stream is passed through the given filter as
+; each byte is emitted, and only the filtered bytes are ever written to the
+; destination buffer. The destination buffer is therefore both the output and
+; the history that matches refer to, so match bytes are handled as follows:
+;
+;   - XOR and LUT filters are applied per byte with no state, so filtered
+;     history is equivalent to filtering the raw history. Matched bytes are
+;     copied verbatim.
+;   - Delta filters carry state from one byte to the next, so the raw value of
+;     each matched byte is first recovered from the filtered history (i.e. the
+;     delta is re-encoded) before being emitted (i.e. delta decoded) again.
+;
+; Delta-16 filtering treats the output as little-endian 16-bit words, with a
+; carry from low to high byte. Bytes before the start of the destination buffer
+; are taken to be zero for all delta filters.
+;
+; LZSA2 block format documentation:
+; https://github.com/emmanuel-marty/lzsa/blob/master/BlockFormat_LZSA2.md
+
+.module lzsa2_filter
+.globl _lzsa2_decompress_block_filter
+
+; ------------------------------------------------------------------------------
+; Constants (must match lzsa_filter_type_t in lzsa.h)
+; ------------------------------------------------------------------------------
+
+FILTER_NONE .equ 0
+FILTER_DELTA8 .equ 1
+FILTER_DELTA16 .equ 2
+FILTER_XOR .equ 3
+FILTER_LUT .equ 4
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+lit_len: .blkw 1
+lit_len_msb .equ (lit_len+0)
+lit_len_lsb .equ (lit_len+1)
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+match_len: .blkw 1
+match_len_msb .equ (match_len+0)
+match_len_lsb .equ (match_len+1)
+
+nibbles: .blkb 1
+nibbles_rdy: .blkb 1
+
+filter_type: .blkb 1
+filter_key: .blkb 1
+filter_lut: .blkw 1
+
+dst_start: .blkw 1
+
+; Last two bytes written to output, odd/even position of next output byte, and
+; carry from delta-16 low byte.
+out_prev1: .blkb 1
+out_prev2: .blkb 1
+out_phase: .blkb 1
+out_carry: .blkb 1
+
+; Same as above, but for bytes read from history during match copy.
+src_prev1: .blkb 1
+src_prev2: .blkb 1
+src_phase: .blkb 1
+src_borrow: .blkb 1
+
+; ------------------------------------------------------------------------------
+; Macros
+; ------------------------------------------------------------------------------
+
+; Test the given length word variable and branch to the exit label if it is
+; zero. Otherwise, decrement the variable in-place (without using X/Y registers
+; and DECW instruction).
+.macro dec_len_or_exit len_msb, len_lsb, exit, ?nz
+	tnz len_msb
+	jrne nz
+	tnz len_lsb
+	jreq exit
+nz:
+	ld a, len_lsb
+	sub a, #1
+	ld len_lsb, a
+	ld a, len_msb
+	sbc a, #0
+	ld len_msb, a
+.endm
+
+; Delta-8 decode the raw byte in A and write the result to destination.
+.macro delta8_emit
+	add a, out_prev1
+	ld out_prev1, a
+	ld (y), a
+	incw y
+.endm
+
+; Delta-16 decode the raw byte in A and write the result to destination. For the
+; low byte of a word, add the low byte of the previous word and keep the carry;
+; for the high byte, add the high byte of the previous word plus that carry.
+; Using BTJT to a following label is simply a way of loading a bit into carry.
+.macro delta16_emit ?odd, ?ldc, ?done
+	btjt out_phase, #0, odd
+	add a, out_prev2
+	bccm out_carry, #0
+	jra done
+odd:
+	btjt out_carry, #0, ldc
+ldc:
+	adc a, out_prev2
+done:
+	mov out_prev2, out_prev1
+	ld out_prev1, a
+	bcpl out_phase, #0
+	ld (y), a
+	incw y
+.endm
+
+; Read a filtered byte from history at X and recover its raw delta-8 value in A.
+.macro delta8_raw
+	ld a, (x)
+	incw x
+	push a
+	sub a, src_prev1
+	pop src_prev1
+.endm
+
+; Read a filtered byte from history at X and recover its raw delta-16 value in
+; A. The mirror image of delta16_emit, subtracting with borrow instead.
+.macro delta16_raw ?odd, ?ldb, ?done
+	ld a, (x)
+	incw x
+	push a
+	btjt src_phase, #0, odd
+	sub a, src_prev2
+	bccm src_borrow, #0
+	jra done
+odd:
+	btjt src_borrow, #0, ldb
+ldb:
+	sbc a, src_prev2
+done:
+	mov src_prev2, src_prev1
+	pop src_prev1
+	bcpl src_phase, #0
+.endm
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa2_decompress_block_filter:
+	; Copy filter type, XOR key and LUT pointer from descriptor to static vars.
+	ldw x, (ARGS_SP_OFFSET+4, sp)
+	ld a, (x)
+	ld filter_type, a
+	ld a, (1, x)
+	ld filter_key, a
+	ldw x, (2, x)
+	ldw filter_lut, x
+
+	; Load source pointer to X reg and destination pointer to Y reg. Keep a copy
+	; of the destination pointer so the start of history can be recognised.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+	ldw dst_start, y
+
+	; Reset nibble and delta filter state. Bytes preceding output are zero.
+	mov nibbles_rdy, #0x01
+	clr out_prev1
+	clr out_prev2
+	clr out_phase
+
+lzsa2f_token:
+	; Token format: XYZ|LL|MMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LL literal length from token in A. Branch if no literals (length
+	; is zero). Check if there is optional extra literal length byte (i.e.
+	; length is 3). If not, we have final count, so go ahead and copy literals.
+	and a, #0x18
+	jreq lzsa2f_no_lit
+	cp a, #0x18
+	jrne lzsa2f_decode_lit_len
+
+	; Fetch a nibble in to A reg. Add the existing literal length (3) to it and
+	; if it's now 18, an optional extra literal length byte follows. Otherwise,
+	; we have final length.
+	call_abs lzsa2f_fetch_nibble
+	add a, #3
+	cp a, #18
+	jrne lzsa2f_small_lit_len
+
+	; Load extra literal length byte and add to existing value. If there was no
+	; carry (i.e. byte read was 0-237), we have final length. Otherwise, value
+	; was 239, signifying two more bytes.
+	add a, (x)
+	incw x
+	jrnc lzsa2f_small_lit_len
+
+	; Load two more bytes and set as length word var, converting from little- to
+	; big-endian as we go. Then go ahead and copy literals.
+	ld a, (x)
+	incw x
+	ld lit_len_lsb, a
+	ld a, (x)
+	incw x
+	ld lit_len_msb, a
+	jra lzsa2f_got_lit_len
+
+lzsa2f_decode_lit_len:
+	; Shift literal length over 3 places.
+	srl a
+	srl a
+	srl a
+
+lzsa2f_small_lit_len:
+	; Clear MSB of literal length word variable, set current value of A to LSB.
+	clr lit_len_msb
+	ld lit_len_lsb, a
+
+lzsa2f_got_lit_len:
+	; Copy literal bytes to destination, passing them through the filter.
+	call_abs lzsa2f_copy_lit
+
+lzsa2f_no_lit:
+	; Retrieve token from stack (without popping it). Shift off the match offset
+	; mode X bit into carry. If set, we have 13- or 16-bit match offset. If not,
+	; then shift off Y bit into carry. If set, we have 9-bit match offset.
+	ld a, (1, sp)
+	sll a
+	jrc lzsa2f_match_off_13b_16b
+	sll a
+	jrc lzsa2f_match_off_9b
+
+	; Otherwise, we have a 5-bit match offset. Shift off Z bit of mode to carry.
+	; Read a nibble (into A) and rotate the value of that to offset bits 1-4 and
+	; Z bit from mode (in carry) to bit 0. Then XOR with a mask to set bits 5-7
+	; of the offset to 1 and flip the Z bit. Also set MSB of offset to all 1s.
+	sll a
+	call_abs lzsa2f_fetch_nibble
+	rlc a
+	xor a, #0xE1
+	ld match_off_lsb, a
+	mov match_off_msb, #0xFF
+	jra lzsa2f_got_match_off
+
+lzsa2f_match_off_9b:
+	; We have a 9-bit match offset. Shift off Z bit of mode to carry and invert.
+	; Set MSB of offset to all 1s, then rotate Z bit in to bit 8. Load another
+	; byte and set as LSB (bits 0-7) of offset.
+	sll a
+	ccf
+	mov match_off_msb, #0xFF
+	rlc match_off_msb
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	jra lzsa2f_got_match_off
+
+lzsa2f_match_off_13b_16b:
+	; Shift off Y bit into carry. If set, we have a 16-bit match offset.
+	sll a
+	jrc lzsa2f_match_off_16b
+
+	; Otherwise, we have a 13-bit offset. Shift off Z bit of mode to carry. Read
+	; a nibble (into A) and rotate the value of that to offset bits 9-12 and Z
+	; bit from mode (in carry) to bit 8. Then XOR with a mask to set bits 13-15
+	; of the offset to 1 and flip the Z bit. Subtract 512 from final offset by
+	; subtracting 2 from MSB. Finally, read a new byte and set as LSB (bits 0-7)
+	; of offset.
+	sll a
+	call_abs lzsa2f_fetch_nibble
+	rlc a
+	xor a, #0xE1
+	sub a, #2
+	ld match_off_msb, a
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	jra lzsa2f_got_match_off
+
+lzsa2f_match_off_16b:
+	; If Z bit of mode is set, we repeat the previous offset value.
+	jrmi lzsa2f_got_match_off
+
+	; Otherwise, we have a 16-bit offset. Read two bytes containing the final
+	; match offset value, already in big-endian format.
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+
+lzsa2f_got_match_off:
+	; Retrieve token from stack (popping this time), mask off MMM match length
+	; bits, add the minimum match length (2) to the value.
+	pop a
+	and a, #0x07
+	add a, #2
+
+	; Check if we have optional extra match length bytes (i.e. match length was
+	; 7 before addition). Otherwise, we have final length, so proceed to copy
+	; matched bytes.
+	cp a, #9
+	jrne lzsa2f_small_match_len
+
+	; Read a nibble (into A) and add the current match length (9) to it. If the
+	; nibble value was 0-14 (before addition), we have final match length, so
+	; proceed to copy matched bytes.
+	call_abs lzsa2f_fetch_nibble
+	add a, #9
+	cp a, #24
+	jrne lzsa2f_small_match_len
+
+	; Read another byte from source and add to current match length. If there is
+	; no carry, value was 0-231 and we have final length. If carry, but length
+	; is zero, value was 232, signifying end-of-data (EOD), so quit. Otherwise,
+	; value was 233, meaning two more bytes.
+	add a, (x)
+	incw x
+	jrnc lzsa2f_small_match_len
+	tnz a
+	jreq lzsa2f_end
+
+	; Load two more bytes and set as match length word variable, converting from
+	; little- to big-endian as we go. Then proceed to copy matched bytes.
+	ld a, (x)
+	incw x
+	ld match_len_lsb, a
+	ld a, (x)
+	incw x
+	ld match_len_msb, a
+	jra lzsa2f_got_match_len
+
+lzsa2f_small_match_len:
+	; Place match length value in LSB of length word variable and clear MSB.
+	ld match_len_lsb, a
+	clr match_len_msb
+
+lzsa2f_got_match_len:
+	; Save current source pointer on stack. Copy current destination pointer to
+	; X reg and add match offset to it. Copy matched bytes, passing them through
+	; the filter.
+	pushw x
+	ldw x, y
+	addw x, match_off
+	call_abs lzsa2f_copy_match
+
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsa2f_token
+
+lzsa2f_end:
+	; Return current destination pointer in X reg.
+	ldw x, y
+	return
+
+; ------------------------------------------------------------------------------
+
+; Copy literal bytes from source (X) to destination (Y), applying the selected
+; filter. Each filter has its own loop so that selection is only done once per
+; run of literals, not per byte.
+
+lzsa2f_copy_lit:
+	ld a, filter_type
+	cp a, #FILTER_DELTA8
+	jrne lzsa2f_lit_not_delta8
+
+lzsa2f_lit_delta8:
+	dec_len_or_exit lit_len_msb, lit_len_lsb, lzsa2f_lit_delta8_done
+	ld a, (x)
+	incw x
+	delta8_emit
+	jra lzsa2f_lit_delta8
+lzsa2f_lit_delta8_done:
+	return
+
+lzsa2f_lit_not_delta8:
+	cp a, #FILTER_DELTA16
+	jrne lzsa2f_lit_not_delta16
+
+lzsa2f_lit_delta16:
+	dec_len_or_exit lit_len_msb, lit_len_lsb, lzsa2f_lit_delta16_done
+	ld a, (x)
+	incw x
+	delta16_emit
+	jra lzsa2f_lit_delta16
+lzsa2f_lit_delta16_done:
+	return
+
+lzsa2f_lit_not_delta16:
+	cp a, #FILTER_XOR
+	jrne lzsa2f_lit_not_xor
+
+lzsa2f_lit_xor:
+	dec_len_or_exit lit_len_msb, lit_len_lsb, lzsa2f_lit_xor_done
+	ld a, (x)
+	incw x
+	xor a, filter_key
+	ld (y), a
+	incw y
+	jra lzsa2f_lit_xor
+lzsa2f_lit_xor_done:
+	return
+
+lzsa2f_lit_not_xor:
+	cp a, #FILTER_LUT
+	jrne lzsa2f_lit_none
+
+lzsa2f_lit_lut:
+	; Look up the byte in the table by using it as an index added to the table
+	; pointer. Source pointer must be saved while X reg is used for this.
+	dec_len_or_exit lit_len_msb, lit_len_lsb, lzsa2f_lit_lut_done
+	ld a, (x)
+	incw x
+	pushw x
+	clrw x
+	ld xl, a
+	addw x, filter_lut
+	ld a, (x)
+	popw x
+	ld (y), a
+	incw y
+	jra lzsa2f_lit_lut
+lzsa2f_lit_lut_done:
+	return
+
+lzsa2f_lit_none:
+	dec_len_or_exit lit_len_msb, lit_len_lsb, lzsa2f_lit_none_done
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	jra lzsa2f_lit_none
+lzsa2f_lit_none_done:
+	return
+
+; ------------------------------------------------------------------------------
+
+; Copy matched bytes from history (X) to destination (Y), applying the selected
+; filter. Only delta filters need special handling; output of all others is
+; copied as-is.
+
+lzsa2f_copy_match:
+	ld a, filter_type
+	cp a, #FILTER_DELTA8
+	jrne lzsa2f_match_not_delta8
+
+	call_abs lzsa2f_src_init
+lzsa2f_match_delta8:
+	dec_len_or_exit match_len_msb, match_len_lsb, lzsa2f_match_delta8_done
+	delta8_raw
+	delta8_emit
+	jra lzsa2f_match_delta8
+lzsa2f_match_delta8_done:
+	return
+
+lzsa2f_match_not_delta8:
+	cp a, #FILTER_DELTA16
+	jrne lzsa2f_match_plain
+
+	call_abs lzsa2f_src_init
+lzsa2f_match_delta16:
+	dec_len_or_exit match_len_msb, match_len_lsb, lzsa2f_match_delta16_done
+	delta16_raw
+	delta16_emit
+	jra lzsa2f_match_delta16
+lzsa2f_match_delta16_done:
+	return
+
+lzsa2f_match_plain:
+	dec_len_or_exit match_len_msb, match_len_lsb, lzsa2f_match_plain_done
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	jra lzsa2f_match_plain
+lzsa2f_match_plain_done:
+	return
+
+; ------------------------------------------------------------------------------
+
+; Initialise the delta state for reading history from the match source pointer
+; in X reg (which is preserved), given by three bytes preceding it, any of which
+; that lie before the start of the destination buffer being taken as zero:
+;   src_prev1 = hist[-1]
+;   src_prev2 = hist[-2]
+;   src_borrow = (hist[-1] < hist[-3]), i.e. borrow from delta-16 low byte
+;   src_phase = odd/even position of match source relative to destination
+
+lzsa2f_src_init:
+	; Save match source pointer. Work out its position in the destination buffer
+	; and take odd/even phase from bit 0.
+	pushw x
+	subw x, dst_start
+	ld a, xl
+	and a, #0x01
+	ld src_phase, a
+
+	; Clear all previous bytes. A reg holds hist[-3] throughout.
+	clr src_prev1
+	clr src_prev2
+	clr a
+
+	; Depending on how far into the buffer we are, read however many of the
+	; previous three bytes are available.
+	cpw x, #1
+	jrult lzsa2f_src_init_borrow
+	jreq lzsa2f_src_init_1
+	cpw x, #3
+	jrult lzsa2f_src_init_2
+
+	ldw x, (1, sp)
+	subw x, #3
+	ld a, (1, x)
+	ld src_prev2, a
+	ld a, (2, x)
+	ld src_prev1, a
+	ld a, (x)
+	jra lzsa2f_src_init_borrow
+
+lzsa2f_src_init_2:
+	ldw x, (1, sp)
+	subw x, #2
+	ld a, (x)
+	ld src_prev2, a
+	ld a, (1, x)
+	ld src_prev1, a
+	clr a
+	jra lzsa2f_src_init_borrow
+
+lzsa2f_src_init_1:
+	ldw x, (1, sp)
+	decw x
+	ld a, (x)
+	ld src_prev1, a
+	clr a
+
+lzsa2f_src_init_borrow:
+	; Compare hist[-1] with hist[-3] (in A) and store the resulting borrow.
+	push a
+	ld a, src_prev1
+	cp a, (1, sp)
+	bccm src_borrow, #0
+	pop a
+
+	; Restore match source pointer.
+	popw x
+	return
+
+; ------------------------------------------------------------------------------
+
+; NOTE: we must be careful in this function not to alter the carry flag! Calling
+; code relies on the value of the carry flag being maintained.
+
+lzsa2f_fetch_nibble:
+	; Toggle the ready flag.
+	bcpl nibbles_rdy, #0
+	tnz nibbles_rdy         ; }
+	jreq lzsa2f_nib_not_rdy ; } Can't use btjf here as it changes carry.
+
+	; We have nibbles ready. Mask off the low nibble and return in A reg.
+	ld a, nibbles
+	and a, #0x0F
+	return
+
+lzsa2f_nib_not_rdy:
+	; Load a new pair of nibbles (i.e. a byte) from input and store. Mask off
+	; the high nibble, shift over and return the value in A reg.
+	ld a, (x)
+	incw x
+	ld nibbles, a
+	and a, #0xF0
+	swap a
+	return
@@ -0,0 +1,322 @@
+; ------------------------------------------------------------------------------
+; LZSA2 BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa2_small.s - LZSA2 decompression routine for blocks of under 256 bytes
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lzsa2_decompress_small(void *dst, const void *src)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data. When built with LZSA_DEBUG set, NULL if the block
+;     can not be decompressed by this function.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; A version of lzsa2_decompress_block() for blocks that decompress to fewer
+; than 256 bytes, so that no literal or match length can be 256 or more. Each
+; length is kept in a single byte, decremented in place, and the paths for
+; lengths given by two extra bytes are omitted. Any extra literal length byte
+; of 238 or more is not checked for, and any extra match length byte of 232 or
+; more is taken as the end-of-data marker. Other blocks are decompressed
+; incorrectly, unless built with LZSA_DEBUG set (see lzsa_medium.s, etc.), in
+; which case a block with a length needing two extra bytes, or a block that
+; decompresses to 256 bytes or more, is rejected. Note that a rejected block
+; may already have been partly decompressed.
+;
+; LZSA2 block format documentation:
+; https://github.com/emmanuel-marty/lzsa/blob/master/BlockFormat_LZSA2.md
+
+.module lzsa2_small
+.globl _lzsa2_decompress_small
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+len: .blkb 1
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+nibbles: .blkb 1
+nibbles_rdy: .blkb 1
+
+.if LZSA_DEBUG
+dst_start: .blkw 1
+.endif
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa2_decompress_small:
+	; Load source pointer to X reg and destination pointer to Y reg. Keep the
+	; destination pointer for checking the decompressed length at the end.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+.if LZSA_DEBUG
+	ldw dst_start, y
+.endif
+
+	mov nibbles_rdy, #0x01
+
+lzsa2sm_token:
+	; Token format: XYZ|LL|MMM
+
+	; Load next token into A. Also save it on the stack for later.
+	ld a, (x)
+	incw x
+	push a
+
+	; Mask off LL literal length from token in A. Branch if no literals (length
+	; is zero). Check if there is optional extra literal length byte (i.e.
+	; length is 3). If not, we have final count, so go ahead and copy literals.
+	and a, #0x18
+	jreq lzsa2sm_no_lit
+	cp a, #0x18
+	jrne lzsa2sm_decode_lit_len
+
+	; Fetch a nibble in to A reg. Add the existing literal length (3) to it and
+	; if it's now 18, an optional extra literal length byte follows. Otherwise,
+	; we have final length.
+	call_abs lzsa2sm_fetch_nibble
+	add a, #3
+	cp a, #18
+	jrne lzsa2sm_got_lit_len
+
+	; Load extra literal length byte and add to existing value, giving the final
+	; literal length. A carry means the value was 239 (two more bytes follow),
+	; which can only be for a length of 256 or more.
+	add a, (x)
+	incw x
+.if LZSA_DEBUG
+	jrnc lzsa2sm_got_lit_len
+	jump_abs lzsa2sm_reject_lit ; (Out of reach of a relative jump.)
+.else
+	jra lzsa2sm_got_lit_len
+.endif
+
+lzsa2sm_decode_lit_len:
+	; Shift literal length over 3 places.
+	srl a
+	srl a
+	srl a
+
+lzsa2sm_got_lit_len:
+	; Set literal length variable. It is never zero here.
+	ld len, a
+
+lzsa2sm_copy_lit:
+	; Copy a single byte from source to destination. Decrement literal length
+	; and loop around to next byte until it reaches zero.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	dec len
+	jrne lzsa2sm_copy_lit
+
+lzsa2sm_no_lit:
+	; Retrieve token from stack (without popping it). Shift off the match offset
+	; mode X bit into carry. If set, we have 13- or 16-bit match offset. If not,
+	; then shift off Y bit into carry. If set, we have 9-bit match offset.
+	ld a, (1, sp)
+	sll a
+	jrc lzsa2sm_match_off_13b_16b
+	sll a
+	jrc lzsa2sm_match_off_9b
+
+	; Otherwise, we have a 5-bit match offset. Shift off Z bit of mode to carry.
+	; Read a nibble (into A) and rotate the value of that to offset bits 1-4 and
+	; Z bit from mode (in carry) to bit 0. Then XOR with a mask to set bits 5-7
+	; of the offset to 1 and flip the Z bit. Also set MSB of offset to all 1s.
+	sll a
+	call_abs lzsa2sm_fetch_nibble
+	rlc a
+	xor a, #0xE1
+	ld match_off_lsb, a
+	mov match_off_msb, #0xFF
+	jra lzsa2sm_got_match_off
+
+; NOTE: we must be careful in this function not to alter the carry flag! Calling
+; code relies on the value of the carry flag being maintained.
+
+lzsa2sm_fetch_nibble:
+	; Toggle the ready flag.
+	bcpl nibbles_rdy, #0
+	tnz nibbles_rdy          ; }
+	jreq lzsa2sm_nib_not_rdy ; } Can't use btjf here as it changes carry.
+
+	; We have nibbles ready. Mask off the low nibble and return in A reg.
+	ld a, nibbles
+	and a, #0x0F
+	return
+
+lzsa2sm_nib_not_rdy:
+	; Load a new pair of nibbles (i.e. a byte) from input and store. Mask off
+	; the high nibble, shift over and return the value in A reg.
+	ld a, (x)
+	incw x
+	ld nibbles, a
+	and a, #0xF0
+	swap a
+	return
+
+lzsa2sm_match_off_9b:
+	; We have a 9-bit match offset. Shift off Z bit of mode to carry and invert.
+	; Set MSB of offset to all 1s, then rotate Z bit in to bit 8. Load another
+	; byte and set as LSB (bits 0-7) of offset.
+	sll a
+	ccf
+	mov match_off_msb, #0xFF
+	rlc match_off_msb
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	jra lzsa2sm_got_match_off
+
+lzsa2sm_match_off_13b_16b:
+	; Shift off Y bit into carry. If set, we have a 16-bit match offset.
+	sll a
+	jrc lzsa2sm_match_off_16b
+
+	; Otherwise, we have a 13-bit offset. Shift off Z bit of mode to carry. Read
+	; a nibble (into A) and rotate the value of that to offset bits 9-12 and Z
+	; bit from mode (in carry) to bit 8. Then XOR with a mask to set bits 13-15
+	; of the offset to 1 and flip the Z bit. Subtract 512 from final offset by
+	; subtracting 2 from MSB. Finally, read a new byte and set as LSB (bits 0-7)
+	; of offset.
+	sll a
+	call_abs lzsa2sm_fetch_nibble
+	rlc a
+	xor a, #0xE1
+	sub a, #2
+	ld match_off_msb, a
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+	jra lzsa2sm_got_match_off
+
+lzsa2sm_match_off_16b:
+	; If Z bit of mode is set, we repeat the previous offset value.
+	jrmi lzsa2sm_got_match_off
+
+	; Otherwise, we have a 16-bit offset. Read two bytes containing the final
+	; match offset value, already in big-endian format.
+	ld a, (x)
+	incw x
+	ld match_off_msb, a
+	ld a, (x)
+	incw x
+	ld match_off_lsb, a
+
+lzsa2sm_got_match_off:
+	; Retrieve token from stack (popping this time), mask off MMM match length
+	; bits, add the minimum match length (2) to the value.
+	pop a
+	and a, #0x07
+	add a, #2
+
+	; Check if we have optional extra match length bytes (i.e. match length was
+	; 7 before addition). Otherwise, we have final length, so proceed to copy
+	; matched bytes.
+	cp a, #9
+	jrne lzsa2sm_got_match_len
+
+	; Read a nibble (into A) and add the current match length (9) to it. If the
+	; nibble value was 0-14 (before addition), we have final match length, so
+	; proceed to copy matched bytes.
+	call_abs lzsa2sm_fetch_nibble
+	add a, #9
+	cp a, #24
+	jrne lzsa2sm_got_match_len
+
+	; Read another byte from source and add to current match length. If there is
+	; no carry, value was 0-231 and we have final length. Otherwise, take it as
+	; end-of-data (EOD).
+	add a, (x)
+	incw x
+	jrc lzsa2sm_end
+
+lzsa2sm_got_match_len:
+	; Set match length variable. It is never zero here. Save current source
+	; pointer on stack. Copy current destination pointer to X reg and add match
+	; offset to it.
+	ld len, a
+	pushw x
+	ldw x, y
+	addw x, match_off
+
+lzsa2sm_copy_match:
+	; Copy a single byte from source to destination. Decrement match length and
+	; loop around to next byte until it reaches zero.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	dec len
+	jrne lzsa2sm_copy_match
+
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsa2sm_token
+
+lzsa2sm_end:
+.if LZSA_DEBUG
+	; The byte read was 232 for EOD, or 233 for a two-byte length (i.e. A is
+	; now 0 or 1). Reject a two-byte length.
+	cp a, #1
+	jreq lzsa2sm_reject
+
+	; Reject if 256 bytes or more were decompressed.
+	ldw x, y
+	subw x, dst_start
+	cpw x, #0x0100
+	jruge lzsa2sm_reject
+.endif
+
+	; Return current destination pointer in X reg.
+	ldw x, y
+	return
+
+.if LZSA_DEBUG
+lzsa2sm_reject_lit:
+	; Discard the token saved on the stack.
+	pop a
+
+lzsa2sm_reject:
+	; Return NULL.
+	clrw x
+	return
+.endif
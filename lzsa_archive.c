@@ -0,0 +1,183 @@
+/*******************************************************************************
+ *
+ * lzsa_archive.c - Archive of compressed resources
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Gives access by ID to compressed resources packed into a single archive by
+// the lzsa_archive host tool. The archive's directory is sorted by ID, so an
+// entry is found by binary search, and is then decompressed with the routine
+// for the format it was compressed with.
+//
+// The archive is read in place through ordinary data pointers, so must be
+// located in the 16-bit data address space. With SDCC, this is where const
+// data is placed, in both the medium and large memory models (in the large
+// model, only code may be placed in far memory above 64 KB).
+//
+// An archive elsewhere (e.g. written to flash above 64 KB separately from the
+// program) is instead read through the _far functions, which take its address
+// as a 32-bit value and read it with far loads, using lzsa_far_read(). The
+// directory entries are read one at a time as they are searched, and the
+// compressed data of an entry is copied into a buffer in RAM, from which the
+// decompression routines can read it.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "lzsa.h"
+#include "lzsa_archive.h"
+
+#define lzsa_archive_read16(p) (((uint16_t)(p)[0] << 8) | (p)[1])
+
+/******************************************************************************/
+
+// Find the directory entry with the given ID, returning NULL if there is none.
+static const uint8_t * lzsa_archive_find(const lzsa_archive_t *archive, const uint16_t id) {
+	const uint8_t *entry;
+	uint16_t lo = 0, hi = archive->count, mid, entry_id;
+
+	while(lo < hi) {
+		mid = lo + ((hi - lo) >> 1);
+		entry = archive->dir + (mid * LZSA_ARCHIVE_ENTRY_LEN);
+		entry_id = lzsa_archive_read16(entry);
+		if(entry_id == id) return entry;
+		if(entry_id < id) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return NULL;
+}
+
+// Find the directory entry with the given ID in a far archive, and copy it to
+// the given buffer. Returns false if there is none.
+static bool lzsa_archive_find_far(const lzsa_archive_far_t *archive, const uint16_t id, uint8_t *entry) {
+	uint32_t addr;
+	uint16_t lo = 0, hi = archive->count, mid, entry_id;
+
+	while(lo < hi) {
+		mid = lo + ((hi - lo) >> 1);
+		addr = archive->dir + ((uint32_t)mid * LZSA_ARCHIVE_ENTRY_LEN);
+		lzsa_far_read(entry, addr, 2);
+		entry_id = lzsa_archive_read16(entry);
+		if(entry_id == id) {
+			lzsa_far_read(entry + 2, addr + 2, LZSA_ARCHIVE_ENTRY_LEN - 2);
+			return true;
+		}
+		if(entry_id < id) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return false;
+}
+
+// Open the archive at the given address. Returns false if it does not begin
+// with a valid header.
+bool lzsa_archive_open(lzsa_archive_t *archive, const void *data) {
+	const uint8_t *header = (const uint8_t *)data;
+
+	if(memcmp(header, LZSA_ARCHIVE_MAGIC, 4) != 0 || header[4] != LZSA_ARCHIVE_VERSION) return false;
+
+	archive->base = header;
+	archive->dir = header + LZSA_ARCHIVE_HEADER_LEN;
+	archive->count = lzsa_archive_read16(header + 6);
+
+	return true;
+}
+
+// Get the length of the decompressed data of the entry with the given ID, or
+// zero if there is no such entry.
+uint16_t lzsa_archive_length(const lzsa_archive_t *archive, const uint16_t id) {
+	const uint8_t *entry = lzsa_archive_find(archive, id);
+	return (entry != NULL ? lzsa_archive_read16(entry + 8) : 0);
+}
+
+// Decompress the entry with the given ID to the destination buffer, which must
+// be at least as large as given by lzsa_archive_length(). Returns a pointer to
+// the position after the last byte of decompressed data, or NULL if there is
+// no such entry.
+void * lzsa_archive_get(const lzsa_archive_t *archive, const uint16_t id, void *dst) {
+	const uint8_t *entry = lzsa_archive_find(archive, id);
+	const uint8_t *src;
+
+	if(entry == NULL) return NULL;
+
+	src = archive->base + lzsa_archive_read16(entry + 4);
+
+	switch(entry[2]) {
+		case LZSA_ARCHIVE_FORMAT_LZSA1: return lzsa1_decompress_block(dst, src);
+		case LZSA_ARCHIVE_FORMAT_LZSA2: return lzsa2_decompress_block(dst, src);
+		default: return NULL;
+	}
+}
+
+// Open the archive at the given far address, with the given buffer for the
+// compressed data of entries. Returns false if it does not begin with a valid
+// header.
+bool lzsa_archive_open_far(lzsa_archive_far_t *archive, const uint32_t addr, void *buf, const uint16_t buf_len) {
+	uint8_t header[LZSA_ARCHIVE_HEADER_LEN];
+
+	lzsa_far_read(header, addr, LZSA_ARCHIVE_HEADER_LEN);
+	if(memcmp(header, LZSA_ARCHIVE_MAGIC, 4) != 0 || header[4] != LZSA_ARCHIVE_VERSION) return false;
+
+	archive->base = addr;
+	archive->dir = addr + LZSA_ARCHIVE_HEADER_LEN;
+	archive->count = lzsa_archive_read16(header + 6);
+	archive->buf = (uint8_t *)buf;
+	archive->buf_len = buf_len;
+
+	return true;
+}
+
+// Get the length of the decompressed data of the entry with the given ID in a
+// far archive, or zero if there is no such entry.
+uint16_t lzsa_archive_length_far(const lzsa_archive_far_t *archive, const uint16_t id) {
+	uint8_t entry[LZSA_ARCHIVE_ENTRY_LEN];
+	return (lzsa_archive_find_far(archive, id, entry) ? lzsa_archive_read16(entry + 8) : 0);
+}
+
+// Decompress the entry with the given ID in a far archive to the destination
+// buffer, as for lzsa_archive_get(). Also returns NULL if the entry's
+// compressed data does not fit in the archive's buffer.
+void * lzsa_archive_get_far(const lzsa_archive_far_t *archive, const uint16_t id, void *dst) {
+	uint8_t entry[LZSA_ARCHIVE_ENTRY_LEN];
+	uint16_t src_len;
+
+	if(!lzsa_archive_find_far(archive, id, entry)) return NULL;
+
+	src_len = lzsa_archive_read16(entry + 6);
+	if(src_len > archive->buf_len) return NULL;
+	lzsa_far_read(archive->buf, archive->base + lzsa_archive_read16(entry + 4), src_len);
+
+	switch(entry[2]) {
+		case LZSA_ARCHIVE_FORMAT_LZSA1: return lzsa1_decompress_block(dst, archive->buf);
+		case LZSA_ARCHIVE_FORMAT_LZSA2: return lzsa2_decompress_block(dst, archive->buf);
+		default: return NULL;
+	}
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *
+ * lzsa_archive.h - Header for archive of compressed resources
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_ARCHIVE_H_
+#define LZSA_ARCHIVE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// An archive begins with a header of the magic bytes, a version byte, a
+// reserved byte and the 16-bit number of entries. A directory of that many
+// entries follows, sorted by ascending ID, and then the compressed data. Each
+// directory entry holds the 16-bit ID, the format, a reserved byte, and the
+// 16-bit offset (from the start of the archive) of the compressed data, its
+// length, and the length of the decompressed data. All 16-bit values are
+// big-endian.
+#define LZSA_ARCHIVE_MAGIC "LZAR"
+#define LZSA_ARCHIVE_VERSION 1
+#define LZSA_ARCHIVE_HEADER_LEN 8
+#define LZSA_ARCHIVE_ENTRY_LEN 10
+
+#define LZSA_ARCHIVE_FORMAT_LZSA1 1
+#define LZSA_ARCHIVE_FORMAT_LZSA2 2
+
+typedef struct {
+	const uint8_t *base;
+	const uint8_t *dir;
+	uint16_t count;
+} lzsa_archive_t;
+
+extern bool lzsa_archive_open(lzsa_archive_t *archive, const void *data);
+extern uint16_t lzsa_archive_length(const lzsa_archive_t *archive, uint16_t id);
+extern void * lzsa_archive_get(const lzsa_archive_t *archive, uint16_t id, void *dst);
+
+// An archive at a far address, read with far loads. The compressed data of an
+// entry is copied into the buffer before it is decompressed, so the buffer must
+// be at least as large as the largest compressed entry.
+typedef struct {
+	uint32_t base;
+	uint32_t dir;
+	uint16_t count;
+	uint8_t *buf;
+	uint16_t buf_len;
+} lzsa_archive_far_t;
+
+extern bool lzsa_archive_open_far(lzsa_archive_far_t *archive, uint32_t addr, void *buf, uint16_t buf_len);
+extern uint16_t lzsa_archive_length_far(const lzsa_archive_far_t *archive, uint16_t id);
+extern void * lzsa_archive_get_far(const lzsa_archive_far_t *archive, uint16_t id, void *dst);
+
+#endif // LZSA_ARCHIVE_H_
@@ -0,0 +1,101 @@
+; ------------------------------------------------------------------------------
+; LZSA BATCH DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa_batch.s - Loop shared by LZSA1 and LZSA2 batch decompression routines
+;
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; This file is not assembled on its own, but included by lzsa1_batch.s and
+; lzsa2_batch.s, which each expand the decompress_batch macro with the name of
+; their function and the entry point of their decompression routine. See
+; lzsa1_batch.s for the function declaration.
+;
+; Each block is decompressed by calling directly into the main loop of the
+; decompression routine, by way of its internal entry point, with source and
+; destination pointers already loaded into registers. This saves the overhead of
+; a separate call (and argument handling) for each block from C code.
+;
+; Loop state is kept in registers: the count of remaining entries in A, the
+; pointer to the current table entry in X, and the pointer to the next element
+; of the end pointer array in Y. As the decompression routine uses all of them,
+; they are pushed on to the stack for the duration of each call.
+
+.macro decompress_batch func, decompress
+
+func:
+	; Load count of entries into A reg. If it is zero, return NULL.
+	clrw x
+	ld a, (ARGS_SP_OFFSET+2, sp)
+	jreq lzsab_done
+
+	; Load pointer to table into X reg and pointer to end pointer array into Y
+	; reg.
+	ldw y, (ARGS_SP_OFFSET+3, sp)
+	ldw x, (ARGS_SP_OFFSET+0, sp)
+
+lzsab_entry:
+	; Save the loop state, with the end pointer array pointer on top, as it is
+	; needed first afterwards.
+	pushw x
+	push a
+	pushw y
+
+	; Load destination pointer (second word of entry) to Y reg and source pointer
+	; (first word) to X reg, then decompress the block. Returns with end pointer
+	; in X reg.
+	ldw y, x
+	ldw y, (2, y)
+	ldw x, (x)
+	call_abs decompress
+
+	; If an array for end pointers was given, store this block's end pointer in
+	; it, and advance to the next element.
+	popw y
+	tnzw y
+	jreq lzsab_count
+	ldw (y), x
+	incw y
+	incw y
+
+lzsab_count:
+	; Decrement count of remaining entries. If it is now zero, we're done, and
+	; the last block's end pointer is already in X reg to be returned. Otherwise,
+	; advance the table entry pointer to the next entry (each is 4 bytes) and
+	; loop around.
+	pop a
+	dec a
+	jreq lzsab_last
+	popw x
+	addw x, #4
+	jra lzsab_entry
+
+lzsab_last:
+	; Discard the saved table entry pointer.
+	popw y
+
+lzsab_done:
+	return
+
+.endm
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * lzsa_cache.c - LRU cache of decompressed LZSA blocks
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Caches the decompressed data of frequently accessed blocks in a fixed RAM
+// arena, which is divided into equal-sized slots. Blocks are looked up by the
+// address of their compressed data. On a hit, a pointer to the slot's data is
+// returned without decompressing anything; on a miss, the block is decompressed
+// into the least-recently used slot, evicting whatever that held.
+//
+// Rather than keep a separate recency list, the slot table itself is kept in
+// most- to least-recently used order: a lookup scans from the front (so the
+// hottest blocks are found soonest), the slot accessed is moved to the front,
+// and the slot to evict is always the last. Empty slots always sort to the end,
+// so are filled before anything is evicted. With the small number of slots
+// that fit in an STM8's RAM, this is cheaper than maintaining linked lists.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "lzsa.h"
+#include "lzsa_cache.h"
+
+/******************************************************************************/
+
+// Initialise a cache using the given table of slots, and an arena of at least
+// count * slot_size bytes. Each slot must be large enough to hold the largest
+// decompressed block that will be requested through the cache. Count must not
+// be zero.
+void lzsa_cache_init(lzsa_cache_t *cache, lzsa_cache_slot_t *slots, const uint8_t count, uint8_t *arena, const uint16_t slot_size) {
+	cache->slots = slots;
+	cache->count = count;
+	cache->hits = 0;
+	cache->misses = 0;
+	cache->evictions = 0;
+
+	for(uint8_t i = 0; i < count; i++) {
+		slots[i].src = NULL;
+		slots[i].data = arena;
+		slots[i].len = 0;
+		arena += slot_size;
+	}
+}
+
+// Empty all slots, e.g. if the compressed data they were decompressed from has
+// been changed. Counters are left unchanged.
+void lzsa_cache_flush(lzsa_cache_t *cache) {
+	for(uint8_t i = 0; i < cache->count; i++) cache->slots[i].src = NULL;
+}
+
+// Get a pointer to the decompressed data of the given compressed block of the
+// given format (LZSA_CACHE_FORMAT_LZSA1 or LZSA_CACHE_FORMAT_LZSA2). If len is
+// not NULL, the length of the decompressed data is written to it. The data
+// remains valid until the block is evicted by a later call, so should not be
+// held on to across other calls. Returns NULL if src is NULL, as that marks an
+// empty slot.
+const uint8_t * lzsa_cache_get(lzsa_cache_t *cache, const void *src, const uint8_t format, uint16_t *len) {
+	lzsa_cache_slot_t *slots = cache->slots;
+	lzsa_cache_slot_t slot;
+	uint8_t *end;
+	uint8_t i;
+
+	if(src == NULL) return NULL;
+
+	for(i = 0; i < cache->count; i++) {
+		if(slots[i].src == src) break;
+	}
+
+	if(i < cache->count) {
+		cache->hits++;
+	} else {
+		i = cache->count - 1;
+		cache->misses++;
+		if(slots[i].src != NULL) cache->evictions++;
+		if(format == LZSA_CACHE_FORMAT_LZSA1) {
+			end = lzsa1_decompress_block(slots[i].data, src);
+		} else {
+			end = lzsa2_decompress_block(slots[i].data, src);
+		}
+		slots[i].src = src;
+		slots[i].len = (uint16_t)(end - slots[i].data);
+	}
+
+	// Move the slot to the front, shifting the more-recently used slots back.
+	if(i > 0) {
+		memcpy(&slot, &slots[i], sizeof(slot));
+		memmove(&slots[1], &slots[0], i * sizeof(slot));
+		memcpy(&slots[0], &slot, sizeof(slot));
+	}
+
+	if(len != NULL) *len = slots[0].len;
+	return slots[0].data;
+}
@@ -0,0 +1,62 @@
+/*******************************************************************************
+ *
+ * lzsa_cache.h - Header for LRU cache of decompressed LZSA blocks
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_CACHE_H_
+#define LZSA_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LZSA_CACHE_FORMAT_LZSA1 1
+#define LZSA_CACHE_FORMAT_LZSA2 2
+
+// A slot holds the decompressed data of one block. The src member is the
+// address of the compressed block it was decompressed from (the cache key), or
+// NULL when the slot is empty.
+typedef struct {
+	const void *src;
+	uint8_t *data;
+	uint16_t len;
+} lzsa_cache_slot_t;
+
+// Slots are kept in order from most- to least-recently used. Counters wrap
+// around on overflow.
+typedef struct {
+	lzsa_cache_slot_t *slots;
+	uint8_t count;
+	uint16_t hits;
+	uint16_t misses;
+	uint16_t evictions;
+} lzsa_cache_t;
+
+extern void lzsa_cache_init(lzsa_cache_t *cache, lzsa_cache_slot_t *slots, uint8_t count, uint8_t *arena, uint16_t slot_size);
+extern void lzsa_cache_flush(lzsa_cache_t *cache);
+extern const uint8_t * lzsa_cache_get(lzsa_cache_t *cache, const void *src, uint8_t format, uint16_t *len);
+
+// Get the decompressed data of an asset generated by the lzsa_assets host tool.
+#define lzsa_cache_get_asset(cache, asset, len) lzsa_cache_get((cache), (asset)->data, (asset)->format, (len))
+
+#endif // LZSA_CACHE_H_
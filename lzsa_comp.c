@@ -0,0 +1,177 @@
+/*******************************************************************************
+ *
+ * lzsa_comp.c - Compact greedy LZSA1 compression
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Compresses data to a raw LZSA1 block on the device, for e.g. data logged to
+// EEPROM or sent over a slow link. The output is decompressed with any of the
+// LZSA1 decompression routines.
+//
+// Matches are found greedily with a single-entry hash table indexed by a hash
+// of the next three bytes, so the table holds only the most recent position
+// with each hash. At each position, one candidate is checked; if it matches,
+// the match is extended as far as it goes and taken, otherwise the byte is a
+// literal. Work per input byte is therefore bounded: a hash, a table access and
+// a three-byte compare for each literal, and a one-byte compare for each byte
+// of a match. Positions within a match are not added to the table.
+//
+// Matches at offsets over 256 need a two-byte offset, so are only taken when at
+// least four bytes long. Together with every other match being at least three
+// bytes long, this ensures the output never grows by more than the few bytes
+// of extended literal lengths and the end-of-data marker.
+
+#ifdef __SDCC
+#pragma opt_code_speed
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "lzsa_comp.h"
+
+#define LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK 0x80
+#define LZSA1_LITERAL_LEN_TOKEN_MAX 7
+#define LZSA1_MATCH_LEN_TOKEN_MAX 15
+#define LZSA1_MATCH_LEN_MIN 3
+#define LZSA1_MATCH_LEN_MIN_16B_OFFSET 4
+#define LZSA1_MATCH_LEN_MAX 65535
+#define LZSA1_OFFSET_8B_MAX 256
+
+// Hash of the three bytes at the given position, to an index into a table of
+// (1 << bits) entries. Uses only shifts and XORs, which are cheap on an 8-bit
+// core.
+#define lzsa1_comp_hash(p, bits) \
+	((((uint16_t)(p)[0] << 4) ^ ((uint16_t)(p)[1] << 2) ^ (p)[2]) & ((1U << (bits)) - 1))
+
+/******************************************************************************/
+
+// Write a sequence's literal length, within the token and extra bytes as needed.
+// A run of 7-255 is 7 in the token plus one byte (0-248); 256-511 is 7 plus 250
+// and one byte; anything longer is 7 plus 249 and a 16-bit little-endian length.
+static uint8_t * lzsa1_comp_literal_len(uint8_t *out, uint8_t *token, const uint16_t len) {
+	if(len < LZSA1_LITERAL_LEN_TOKEN_MAX) {
+		*token |= (uint8_t)(len << 4);
+	} else {
+		*token |= (LZSA1_LITERAL_LEN_TOKEN_MAX << 4);
+		if(len < 256) {
+			*out++ = (uint8_t)(len - LZSA1_LITERAL_LEN_TOKEN_MAX);
+		} else if(len < 512) {
+			*out++ = 250;
+			*out++ = (uint8_t)(len - 256);
+		} else {
+			*out++ = 249;
+			*out++ = (uint8_t)len;
+			*out++ = (uint8_t)(len >> 8);
+		}
+	}
+	return out;
+}
+
+// Write a sequence: token, literal length, literals, match offset and match
+// length. A match length of zero writes the end-of-data marker instead (with a
+// dummy one-byte offset). Match lengths of 3-17 are in the token; 18-255 are 15
+// in the token plus one byte (0-237); 256-511 are 15 plus 239 and one byte;
+// anything longer is 15 plus 238 and a 16-bit little-endian length (zero being
+// end of data).
+static uint8_t * lzsa1_comp_sequence(uint8_t *out, const uint8_t *lit, const uint16_t lit_len, const uint16_t offset, const uint16_t match_len) {
+	uint8_t *token = out++;
+
+	*token = 0;
+	out = lzsa1_comp_literal_len(out, token, lit_len);
+	memcpy(out, lit, lit_len);
+	out += lit_len;
+
+	// Offset is stored negated, as an LSB, plus an MSB only if it is not 0xFF.
+	*out++ = (uint8_t)(0 - offset);
+	if(offset > LZSA1_OFFSET_8B_MAX) {
+		*token |= LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK;
+		*out++ = (uint8_t)((0 - offset) >> 8);
+	}
+
+	if(match_len != 0 && match_len < LZSA1_MATCH_LEN_TOKEN_MAX + LZSA1_MATCH_LEN_MIN) {
+		*token |= (uint8_t)(match_len - LZSA1_MATCH_LEN_MIN);
+	} else {
+		*token |= LZSA1_MATCH_LEN_TOKEN_MAX;
+		if(match_len != 0 && match_len < 256) {
+			*out++ = (uint8_t)(match_len - LZSA1_MATCH_LEN_TOKEN_MAX - LZSA1_MATCH_LEN_MIN);
+		} else if(match_len != 0 && match_len < 512) {
+			*out++ = 239;
+			*out++ = (uint8_t)(match_len - 256);
+		} else {
+			*out++ = 238;
+			*out++ = (uint8_t)match_len;
+			*out++ = (uint8_t)(match_len >> 8);
+		}
+	}
+
+	return out;
+}
+
+/******************************************************************************/
+
+// Compress the given data into a raw LZSA1 block at the destination, which must
+// be at least LZSA1_COMPRESS_BOUND(src_len) bytes. Input may be up to 65535
+// bytes. Returns a pointer to the position after the last byte of compressed
+// data.
+void * lzsa1_compress_block(void *dst, const void *src, const size_t src_len, const lzsa1_comp_t *comp) {
+	const uint8_t *in = (const uint8_t *)src;
+	const uint8_t *end = in + src_len;
+	const uint8_t *lit = in;
+	const uint8_t *cand;
+	const uint8_t **entry;
+	uint8_t *out = (uint8_t *)dst;
+	uint16_t offset, len, max_len;
+
+	memset(comp->table, 0, sizeof(comp->table[0]) << comp->table_bits);
+
+	while(end - in >= LZSA1_MATCH_LEN_MIN) {
+		entry = &comp->table[lzsa1_comp_hash(in, comp->table_bits)];
+		cand = *entry;
+		*entry = in;
+
+		if(cand == NULL || (uint16_t)(in - cand) > comp->window || cand[0] != in[0] || cand[1] != in[1] || cand[2] != in[2]) {
+			in++;
+			continue;
+		}
+
+		offset = (uint16_t)(in - cand);
+		max_len = (end - in > LZSA1_MATCH_LEN_MAX ? LZSA1_MATCH_LEN_MAX : (uint16_t)(end - in));
+		len = LZSA1_MATCH_LEN_MIN;
+		while(len < max_len && cand[len] == in[len]) len++;
+
+		if(offset > LZSA1_OFFSET_8B_MAX && len < LZSA1_MATCH_LEN_MIN_16B_OFFSET) {
+			in++;
+			continue;
+		}
+
+		out = lzsa1_comp_sequence(out, lit, (uint16_t)(in - lit), offset, len);
+		in += len;
+		lit = in;
+	}
+
+	// Any remaining input is literals, followed by the end-of-data marker.
+	out = lzsa1_comp_sequence(out, lit, (uint16_t)(end - lit), 1, 0);
+
+	return out;
+}
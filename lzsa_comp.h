@@ -0,0 +1,53 @@
+/*******************************************************************************
+ *
+ * lzsa_comp.h - Header for compact greedy LZSA1 compression
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_COMP_H_
+#define LZSA_COMP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Maximum compressed length for the given input length. The destination buffer
+// must be at least this large.
+#define LZSA1_COMPRESS_BOUND(n) ((n) + ((n) >> 8) + 8)
+
+// Largest window, allowing matches at any offset LZSA1 can encode.
+#define LZSA1_COMP_WINDOW_MAX 65535
+
+// Compressor settings. The hash table holds (1 << table_bits) entries, and is
+// cleared at the start of every block, so may be shared with other uses between
+// calls. The window is the maximum match offset (1 to 65535); a smaller window
+// may be used for consistency with a decompressor that only keeps that much
+// history, but does not make compression any faster.
+typedef struct {
+	const uint8_t **table;
+	uint8_t table_bits;
+	uint16_t window;
+} lzsa1_comp_t;
+
+extern void * lzsa1_compress_block(void *dst, const void *src, size_t src_len, const lzsa1_comp_t *comp);
+
+#endif // LZSA_COMP_H_
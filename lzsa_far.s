@@ -0,0 +1,91 @@
+; ------------------------------------------------------------------------------
+; FAR MEMORY READING FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa_far.s - Copying of data from anywhere in the 24-bit address space
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void lzsa_far_read(void *dst, uint32_t src, uint16_t len)
+; Arguments:
+;     dst = pointer to destination buffer
+;     src = far address of source data
+;     len = number of bytes to copy
+; Returns:
+;     Nothing.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; Copies data from a far address, which SDCC can not reach with an ordinary
+; pointer (e.g. an archive in flash above 64 KB, see lzsa_archive.c), using far
+; loads. The data may also cross a 64 KB boundary.
+
+.module lzsa_far
+.globl _lzsa_far_read
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+src_ptr: .blkb 3
+src_ptr_ext .equ (src_ptr+0)
+src_ptr_msb .equ (src_ptr+1)
+src_ptr_lsb .equ (src_ptr+2)
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa_far_read:
+	; Store the low 24 bits of the source address (which is a 32-bit big-endian
+	; argument). Ignore the top byte.
+	ld a, (ARGS_SP_OFFSET+3, sp)
+	ld src_ptr_ext, a
+	ldw x, (ARGS_SP_OFFSET+4, sp)
+	ldw src_ptr_msb, x
+
+	; Load the length to X reg, to use as an index counting down to the first
+	; byte. Nothing to do if it is zero. Point Y reg at the end of the
+	; destination.
+	ldw x, (ARGS_SP_OFFSET+6, sp)
+	jreq lzsaf_done
+	ldw y, x
+	addw y, (ARGS_SP_OFFSET+0, sp)
+
+lzsaf_loop:
+	; Copy bytes backwards, from the last to the first, until the index reaches
+	; zero.
+	decw y
+	decw x
+	ldf a, ([src_ptr].e, x)
+	ld (y), a
+	tnzw x
+	jrne lzsaf_loop
+
+lzsaf_done:
+	return
@@ -0,0 +1,244 @@
+/*******************************************************************************
+ *
+ * lzsa_fast.c - Performance-tuned portable C LZSA decompression
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// These implementations are intended for use where the assembly routines can
+// not be (e.g. other 8/16-bit microcontrollers, or SDCC options that the
+// assembly does not support). Unlike the reference implementations, they are
+// written with speed in mind, particularly for compilers targeting 8-bit cores:
+//
+// - Lengths that fit in 8 bits (which is almost all of them) are kept in 8-bit
+//   variables and copies done with 8-bit loop counters. Only the rare 16-bit
+//   lengths use a 16-bit loop, which compares pointers rather than maintaining
+//   a separate counter.
+// - LZSA2 nibbles are cached in a single byte that also indicates whether a
+//   nibble is pending, instead of toggling a separate boolean flag.
+
+#ifdef __SDCC
+#pragma opt_code_speed
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lzsa_fast.h"
+
+#define LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK 0x80
+#define LZSA1_TOKEN_LITERAL_LEN_MASK 0x70
+#define LZSA1_TOKEN_MATCH_LEN_MASK 0x0F
+#define LZSA1_MATCH_LEN_MIN 3
+
+#define LZSA2_TOKEN_LITERAL_LEN_MASK 0x18
+#define LZSA2_TOKEN_MATCH_LEN_MASK 0x07
+#define LZSA2_TOKEN_MATCH_OFFSET_MODE_MASK 0xC0
+#define LZSA2_TOKEN_MATCH_OFFSET_MODE_5BIT 0x00
+#define LZSA2_TOKEN_MATCH_OFFSET_MODE_9BIT 0x40
+#define LZSA2_TOKEN_MATCH_OFFSET_MODE_13BIT 0x80
+#define LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT 0xC0
+#define LZSA2_TOKEN_Z_FLAG_MASK 0x20
+#define LZSA2_MATCH_LEN_MIN 2
+
+// Copy a run of bytes from source pointer to destination pointer, advancing
+// both. The first variant takes an 8-bit length; the second a 16-bit length,
+// for which an end pointer is used instead of a counter. Length must not be
+// zero.
+#define lzsa_fast_copy8(d, s, n) do { *(d)++ = *(s)++; } while(--(n))
+#define lzsa_fast_copy16(d, s, n) \
+	do { \
+		const uint8_t *end = (d) + (n); \
+		do { *(d)++ = *(s)++; } while((d) != end); \
+	} while(0)
+
+// Fetch the next nibble from the input into n. The cache variable c holds zero
+// when no nibble is pending, otherwise the pending low nibble with the upper
+// four bits set (so it is never zero).
+#define lzsa2_fast_fetch_nibble(n, c, p) \
+	do { \
+		if(c) { \
+			(n) = (c) & 0x0F; \
+			(c) = 0; \
+		} else { \
+			(c) = *(p)++; \
+			(n) = (c) >> 4; \
+			(c) |= 0xF0; \
+		} \
+	} while(0)
+
+/******************************************************************************/
+
+void * lzsa1_decompress_block_fast(void *dst, const void *src) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	const uint8_t *match_src;
+	uint16_t len16;
+	uint8_t token, len, n;
+
+	while(1) {
+		token = *in++;
+
+		// Literal length of 0-6 is in the token. For 7, an extra byte follows:
+		// 0-248 gives final length 7-255; 250 gives 256 plus a following byte;
+		// 249 gives a following 16-bit little-endian length.
+		len = (token & LZSA1_TOKEN_LITERAL_LEN_MASK) >> 4;
+		if(len == 7) {
+			n = *in++;
+			if(n < 249) {
+				len += n;
+				lzsa_fast_copy8(out, in, len);
+			} else {
+				if(n == 250) {
+					len16 = 256 + *in++;
+				} else {
+					len16 = in[0] | (in[1] << 8);
+					in += 2;
+				}
+				if(len16) lzsa_fast_copy16(out, in, len16);
+			}
+		} else if(len) {
+			lzsa_fast_copy8(out, in, len);
+		}
+
+		// Match offset LSB always follows literals. MSB follows if the token's
+		// flag is set, otherwise it is 0xFF. Resolve to a source pointer now.
+		n = *in++;
+		if(token & LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK) {
+			match_src = out + (int16_t)(n | (*in++ << 8));
+		} else {
+			match_src = out + (int16_t)(0xFF00 | n);
+		}
+
+		// Match length of 3-17 is in the token. For 18, an extra byte follows:
+		// 0-237 gives final length 18-255; 239 gives 256 plus a following byte;
+		// 238 gives a following 16-bit little-endian length, or EOD when zero.
+		len = (token & LZSA1_TOKEN_MATCH_LEN_MASK) + LZSA1_MATCH_LEN_MIN;
+		if(len == 15 + LZSA1_MATCH_LEN_MIN) {
+			n = *in++;
+			if(n < 238) {
+				len += n;
+			} else {
+				if(n == 239) {
+					len16 = 256 + *in++;
+				} else {
+					len16 = in[0] | (in[1] << 8);
+					in += 2;
+					if(len16 == 0) break;
+				}
+				lzsa_fast_copy16(out, match_src, len16);
+				continue;
+			}
+		}
+		lzsa_fast_copy8(out, match_src, len);
+	}
+
+	return out;
+}
+
+void * lzsa2_decompress_block_fast(void *dst, const void *src) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	const uint8_t *match_src;
+	int16_t match_off = 0;
+	uint16_t len16;
+	uint8_t token, len, n, nibbles = 0;
+
+	while(1) {
+		// Token format is XYZ|LL|MMM.
+		token = *in++;
+
+		// Literal length of 0-2 is in the token. For 3, a nibble follows: 0-14
+		// gives final length 3-17. For 15, an extra byte follows: 0-237 gives
+		// final length 18-255; 239 gives a following 16-bit little-endian length.
+		len = (token & LZSA2_TOKEN_LITERAL_LEN_MASK) >> 3;
+		if(len == 3) {
+			lzsa2_fast_fetch_nibble(n, nibbles, in);
+			len += n;
+			if(n == 15) {
+				n = *in++;
+				if(n < 238) {
+					len += n;
+				} else {
+					len16 = in[0] | (in[1] << 8);
+					in += 2;
+					if(len16) lzsa_fast_copy16(out, in, len16);
+					goto lzsa2_got_lit;
+				}
+			}
+			lzsa_fast_copy8(out, in, len);
+		} else if(len) {
+			lzsa_fast_copy8(out, in, len);
+		}
+
+lzsa2_got_lit:
+		// Decode match offset according to XY bits of the token, using the Z
+		// bit as either an offset bit (inverted) or the repeat offset flag.
+		switch(token & LZSA2_TOKEN_MATCH_OFFSET_MODE_MASK) {
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_5BIT:
+				lzsa2_fast_fetch_nibble(n, nibbles, in);
+				n = (n << 1) | ((token & LZSA2_TOKEN_Z_FLAG_MASK) ? 0 : 1);
+				match_off = (int16_t)(0xFFE0 | n);
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_9BIT:
+				match_off = (int16_t)(((token & LZSA2_TOKEN_Z_FLAG_MASK) ? 0xFE00 : 0xFF00) | *in++);
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_13BIT:
+				lzsa2_fast_fetch_nibble(n, nibbles, in);
+				n = (n << 1) | ((token & LZSA2_TOKEN_Z_FLAG_MASK) ? 0 : 1);
+				match_off = (int16_t)((0xE000 | ((uint16_t)n << 8) | *in++) - 512);
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT:
+				if(!(token & LZSA2_TOKEN_Z_FLAG_MASK)) {
+					match_off = (int16_t)((in[0] << 8) | in[1]);
+					in += 2;
+				}
+				break;
+		}
+		match_src = out + match_off;
+
+		// Match length of 2-8 is in the token. For 9, a nibble follows: 0-14
+		// gives final length 9-23. For 15, an extra byte follows: 0-231 gives
+		// final length 24-255; 233 gives a following 16-bit little-endian
+		// length; anything else is EOD.
+		len = (token & LZSA2_TOKEN_MATCH_LEN_MASK) + LZSA2_MATCH_LEN_MIN;
+		if(len == 7 + LZSA2_MATCH_LEN_MIN) {
+			lzsa2_fast_fetch_nibble(n, nibbles, in);
+			len += n;
+			if(n == 15) {
+				n = *in++;
+				if(n < 232) {
+					len += n;
+				} else if(n == 233) {
+					len16 = in[0] | (in[1] << 8);
+					in += 2;
+					lzsa_fast_copy16(out, match_src, len16);
+					continue;
+				} else {
+					break;
+				}
+			}
+		}
+		lzsa_fast_copy8(out, match_src, len);
+	}
+
+	return out;
+}
@@ -0,0 +1,101 @@
+; ------------------------------------------------------------------------------
+; LZSA1 DECOMPRESSION OF INITIALISED DATA AT STARTUP FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa_init.s - Startup hook to decompress LZSA-compressed initialised data
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     unsigned char __sdcc_external_startup(void)
+; Returns:
+;     Non-zero, to tell the SDCC startup code to skip its own initialisation of
+;     global and static variables.
+;
+; Replaces the SDCC startup code's initialisation of variables. The DATA area
+; is cleared, then the INITIALIZER area, which has been replaced after linking
+; by an LZSA1 block of its contents (see tools/lzsa_initpack.c), is decompressed
+; into the INITIALIZED area using lzsa1_decompress_block, by way of its
+; lzsa1_decompress entry point.
+;
+; This file is not part of the library. It must be assembled (with the prefix
+; file for the memory model, as for the library) and given to the linker as the
+; first object file, so that the area order below applies and the INITIALIZER
+; area is placed last in flash. The compressed block is shorter than the area,
+; so the end of the area can then be dropped from the image.
+;
+; NOTE: because the SDCC startup code is skipped entirely, any code placed in
+; the GSINIT area by other modules is not run. SDCC does not normally emit any
+; for C code targeting STM8, as initialisers are stored in INITIALIZER instead.
+
+.module lzsa_init
+.globl ___sdcc_external_startup
+.globl lzsa1_decompress
+.globl s_DATA
+.globl l_DATA
+.globl s_INITIALIZER
+.globl l_INITIALIZER
+.globl s_INITIALIZED
+
+; ------------------------------------------------------------------------------
+; Area order (INITIALIZER last, unlike the SDCC default of before CODE)
+; ------------------------------------------------------------------------------
+
+.area DATA
+.area INITIALIZED
+.area HOME
+.area GSINIT
+.area GSFINAL
+.area CONST
+.area CODE
+.area INITIALIZER
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+___sdcc_external_startup:
+	; Clear the DATA area, from the end backwards. Skip if it is empty.
+	ldw x, #l_DATA
+	jreq 1$
+0$:
+	clr (s_DATA-1, x)
+	decw x
+	jrne 0$
+1$:
+
+	; Decompress the INITIALIZER area's compressed block into the INITIALIZED
+	; area, if there is anything to decompress.
+	ldw x, #l_INITIALIZER
+	jreq 2$
+	ldw x, #s_INITIALIZER
+	ldw y, #s_INITIALIZED
+	call_abs lzsa1_decompress
+2$:
+
+	; Return non-zero so that the SDCC startup code's own initialisation is
+	; skipped.
+	ld a, #1
+	return
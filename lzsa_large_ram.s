@@ -0,0 +1,55 @@
+; ------------------------------------------------------------------------------
+; LZSA BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa_large_ram.s - Large memory model specific definitions and macros for
+;                    LZSA decompression routines run from RAM
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+
+; Would prefer to use .define directives here instead of macros, but SDAS
+; version of ASxxxx assembler (as of SDCC v4.1) doesn't support .define!
+
+ARGS_SP_OFFSET .equ 4
+
+; Build the decompression routines so that they can be copied to and run from
+; RAM. Their code is made position-independent (i.e. only relative branches and
+; calls are used internally), and each gets a buffer in RAM plus a function to
+; copy its code there.
+LZSA_RAM .equ 1
+
+; Whether to build the short-block decompression routines with checks that
+; reject blocks they can not handle (see lzsa1_small.s and lzsa2_small.s).
+LZSA_DEBUG .equ 0
+
+.macro call_abs lbl
+	callf lbl
+.endm
+
+.macro jump_abs lbl
+	jpf lbl
+.endm
+
+.macro return
+	retf
+.endm
@@ -32,6 +32,14 @@
 
 ARGS_SP_OFFSET .equ 3
 
+; Whether to build the decompression routines so that they can be copied to and
+; run from RAM (see lzsa_medium_ram.s).
+LZSA_RAM .equ 0
+
+; Whether to build the short-block decompression routines with checks that
+; reject blocks they can not handle (see lzsa1_small.s and lzsa2_small.s).
+LZSA_DEBUG .equ 0
+
 .macro call_abs lbl
 	call lbl
 .endm
@@ -0,0 +1,201 @@
+; ------------------------------------------------------------------------------
+; STM8-NATIVE LZSA BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa_native.s - STM8-native LZSA variant decompression routine
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * lzsa_native_decompress_block(void *dst, const void *src)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; Decompresses a block in the STM8-native format, as produced from an LZSA1 or
+; LZSA2 block by the tools/lzsa_native transcoder. The format is laid out for
+; this decoder: all fields are whole bytes, no length is more than 256 (so each
+; is counted down in a single byte), and 16-bit match offsets are big-endian,
+; the same as the match offset variable in memory.
+;
+; Each sequence is a token, LLLL|OMMM, followed by an optional literal length
+; byte, the literals, an optional match length byte, and the match offset:
+;
+; - LLLL: literal length of 0-14, or 15 when a length byte follows.
+; - MMM: match length of 2-7 when 1-6 (i.e. plus 1), or 7 when a length byte
+;   follows. When zero, O being clear means no match, and O being set means a
+;   length byte follows and the previous match offset is used again.
+; - O: match offset is one byte (with an MSB of 0xFF) when clear, or two when
+;   set.
+;
+; A length byte of zero means 256. A token of zero is the end-of-data marker.
+
+.module lzsa_native
+.globl _lzsa_native_decompress_block
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+len: .blkb 1
+
+token: .blkb 1
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_lzsa_native_decompress_block:
+	; Load source pointer to X reg and destination pointer to Y reg.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+
+lzsanat_token:
+	; Token format: LLLL|OMMM
+
+	; Load next token into A and save it in a variable for later.
+	ld a, (x)
+	incw x
+	ld token, a
+
+	; Shift LLLL literal length down by swapping nibbles and mask it off. Branch
+	; if no literals (length is zero). If length is 15, load the extra literal
+	; length byte, otherwise we have the final count.
+	swap a
+	and a, #0x0F
+	jreq lzsanat_no_lit
+	cp a, #0x0F
+	jrne lzsanat_got_lit_len
+	ld a, (x)
+	incw x
+
+lzsanat_got_lit_len:
+	; Set literal length variable. A value of zero here is a length of 256, as
+	; the decrement wraps around before it is tested.
+	ld len, a
+
+lzsanat_copy_lit:
+	; Copy a single byte from source to destination. Decrement literal length
+	; and loop around to next byte until it reaches zero.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	dec len
+	jrne lzsanat_copy_lit
+
+lzsanat_no_lit:
+	; Mask off MMM match length from token. If zero, there is either no match or
+	; a repeat offset match. Otherwise, add one to it, and if the result is 8,
+	; load the extra match length byte instead.
+	ld a, token
+	and a, #0x07
+	jreq lzsanat_rep_or_none
+	inc a
+	cp a, #8
+	jrne lzsanat_got_match_len
+	ld a, (x)
+	incw x
+
+lzsanat_got_match_len:
+	; Set match length variable (again, zero is 256). Check O flag bit of the
+	; token to see whether match offset is one byte or two.
+	ld len, a
+	btjt token, #3, lzsanat_big_match_off
+
+	; Load single match offset byte as LSB of match offset var, with an MSB of
+	; 0xFF. Save the updated source pointer on stack.
+	ld a, (x)
+	incw x
+	pushw x
+	ld match_off_lsb, a
+	mov match_off_msb, #0xFF
+	jra lzsanat_got_match_off
+
+lzsanat_big_match_off:
+	; Load two big-endian match offset bytes straight into the match offset var.
+	; Doing this a byte at a time through A is no slower than a single LDW,
+	; because X (the source pointer) would have to be saved and restored around
+	; it. Save the updated source pointer on stack.
+	ld a, (x)
+	ld match_off_msb, a
+	ld a, (1, x)
+	ld match_off_lsb, a
+	incw x
+	incw x
+	pushw x
+
+lzsanat_got_match_off:
+	; Copy current destination pointer to X reg and add match offset to it.
+	ldw x, y
+	addw x, match_off
+
+lzsanat_copy_match:
+	; Copy a single byte from source to destination. Decrement match length and
+	; loop around to next byte until it reaches zero.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+	dec len
+	jrne lzsanat_copy_match
+
+	; Restore source pointer from stack. Proceed to next token.
+	popw x
+	jump_abs lzsanat_token
+
+lzsanat_rep_or_none:
+	; With the O flag bit set, this is a repeat offset match: load the match
+	; length byte, save the source pointer on stack, and copy using the match
+	; offset var as it is.
+	btjf token, #3, lzsanat_no_match
+	ld a, (x)
+	incw x
+	ld len, a
+	pushw x
+	jra lzsanat_got_match_off
+
+lzsanat_no_match:
+	; Otherwise, there is no match. Unless the whole token was zero, which is
+	; the end-of-data (EOD) marker, proceed to next token.
+	tnz token
+	jreq lzsanat_end
+	jump_abs lzsanat_token
+
+lzsanat_end:
+	; Return current destination pointer in X reg.
+	ldw x, y
+	return
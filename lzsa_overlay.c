@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * lzsa_overlay.c - Compressed code overlays decompressed into RAM
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Runs rarely used code (e.g. calibration or self-test routines) from a region
+// of RAM, keeping it in flash only as LZSA1-compressed overlays packed into a
+// store by the lzsa_overlay host tool. Loading an overlay decompresses it into
+// the region, unless it is already resident there, and gives the address of
+// its entry point. Only one overlay is resident at a time; loading another
+// replaces it.
+//
+// Overlays are either linked to run at the region's address (and the region
+// must then be at that address), or are position-independent (and may be
+// loaded into a region anywhere). As with lzsa_archive, the store is read in
+// place through ordinary data pointers, so must be located in the 16-bit data
+// address space.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "lzsa.h"
+#include "lzsa_overlay.h"
+
+#define lzsa_overlay_read16(p) (((uint16_t)(p)[0] << 8) | (p)[1])
+
+/******************************************************************************/
+
+// Open the overlay store at the given address, to load its overlays into the
+// given region of RAM. Returns false if the store does not begin with a valid
+// header, the region is too small for the largest overlay, or the overlays
+// were linked to run at a different address to that of the region.
+bool lzsa_overlay_init(lzsa_overlays_t *overlays, const void *store, uint8_t *region, const uint16_t region_size) {
+	const uint8_t *header = (const uint8_t *)store;
+	const uint16_t addr = lzsa_overlay_read16(header + 6);
+
+	if(memcmp(header, LZSA_OVERLAY_MAGIC, 4) != 0 || header[4] != LZSA_OVERLAY_VERSION) return false;
+	if(region_size < lzsa_overlay_read16(header + 8)) return false;
+	if(addr != 0 && addr != (uint16_t)region) return false;
+
+	overlays->base = header;
+	overlays->region = region;
+	overlays->count = header[5];
+	overlays->resident = LZSA_OVERLAY_NONE;
+	overlays->loads = 0;
+
+	return true;
+}
+
+// Load the overlay with the given ID into the region, if it is not already
+// resident, and return the address of its entry point, or NULL if there is no
+// such overlay. The address must be cast to the overlay's function pointer type
+// to call it, e.g. ((void (*)(void))entry)().
+void * lzsa_overlay_load(lzsa_overlays_t *overlays, const uint8_t id) {
+	const uint8_t *entry;
+
+	if(id >= overlays->count) return NULL;
+
+	entry = overlays->base + LZSA_OVERLAY_HEADER_LEN + (id * LZSA_OVERLAY_ENTRY_LEN);
+
+	if(overlays->resident != id) {
+		lzsa1_decompress_block(overlays->region, overlays->base + lzsa_overlay_read16(entry));
+		overlays->resident = id;
+		overlays->loads++;
+	}
+
+	return overlays->region + lzsa_overlay_read16(entry + 4);
+}
+
+// Mark the region as holding no overlay, e.g. if it has been used for something
+// else, so that the next load decompresses again.
+void lzsa_overlay_evict(lzsa_overlays_t *overlays) {
+	overlays->resident = LZSA_OVERLAY_NONE;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * lzsa_overlay.h - Header for compressed code overlays decompressed into RAM
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_OVERLAY_H_
+#define LZSA_OVERLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// An overlay store begins with a header of the magic bytes, a version byte, the
+// 8-bit number of overlays, the 16-bit address of the RAM region the overlays
+// were linked to run at (zero if they are position-independent), and the
+// 16-bit size the region must be (the largest overlay). A table of that many
+// entries follows, in order of overlay ID, and then the compressed data. Each
+// entry holds the 16-bit offset (from the start of the store) of the overlay's
+// LZSA1 block, its decompressed length, and the offset of its entry point from
+// the start of the region. All 16-bit values are big-endian.
+#define LZSA_OVERLAY_MAGIC "LZOV"
+#define LZSA_OVERLAY_VERSION 1
+#define LZSA_OVERLAY_HEADER_LEN 10
+#define LZSA_OVERLAY_ENTRY_LEN 6
+
+// Value of the resident member when no overlay is loaded in the region.
+#define LZSA_OVERLAY_NONE 0xFF
+
+// The loads member counts the overlays actually decompressed (i.e. calls of
+// lzsa_overlay_load() when the overlay was not already resident), and wraps
+// around on overflow.
+typedef struct {
+	const uint8_t *base;
+	uint8_t *region;
+	uint8_t count;
+	uint8_t resident;
+	uint16_t loads;
+} lzsa_overlays_t;
+
+extern bool lzsa_overlay_init(lzsa_overlays_t *overlays, const void *store, uint8_t *region, uint16_t region_size);
+extern void * lzsa_overlay_load(lzsa_overlays_t *overlays, uint8_t id);
+extern void lzsa_overlay_evict(lzsa_overlays_t *overlays);
+
+#endif // LZSA_OVERLAY_H_
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * lzsa_patch.c - Delta firmware patching
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Applies a patch generated by the lzsa_patch host tool, which compresses a new
+// firmware image block by block using the old (installed) image as a
+// dictionary, so unchanged code and data are just back-references into it.
+// Each block is decompressed with lzsa1_decompress_block_dict() or
+// lzsa2_decompress_block_dict(), which read the old image with far loads, so it
+// may be anywhere in flash (e.g. above 64 KB with the large memory model).
+//
+// The new image must be written somewhere other than over the old one (e.g. a
+// second firmware slot), as every block may refer to any part of the old image.
+// The patch itself is read through ordinary data pointers, so must be located
+// in the 16-bit data address space (e.g. in RAM, as received).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "lzsa.h"
+#include "lzsa_patch.h"
+
+#define lzsa_patch_read16(p) (((uint16_t)(p)[0] << 8) | (p)[1])
+#define lzsa_patch_read32(p) (((uint32_t)lzsa_patch_read16(p) << 16) | lzsa_patch_read16((p) + 2))
+
+/******************************************************************************/
+
+// CRC-16/CCITT-FALSE (polynomial 0x1021), continuing from the given value.
+static uint16_t lzsa_patch_crc16(uint16_t crc, const uint8_t *data, uint16_t len) {
+	while(len--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for(uint8_t i = 0; i < 8; i++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+// Start applying the patch at the given address to the old image at the given
+// far address and of the given length. Returns false if the patch does not
+// begin with a valid header, or was not made from an image of that length.
+bool lzsa_patch_init(lzsa_patch_t *patch, const void *data, uint32_t old_image, uint32_t old_len) {
+	const uint8_t *header = (const uint8_t *)data;
+
+	if(memcmp(header, LZSA_PATCH_MAGIC, 4) != 0 || header[4] != LZSA_PATCH_VERSION) return false;
+	if(header[5] != LZSA_PATCH_FORMAT_LZSA1 && header[5] != LZSA_PATCH_FORMAT_LZSA2) return false;
+	if(lzsa_patch_read16(header + 6) == 0 || lzsa_patch_read32(header + 8) != old_len) return false;
+
+	patch->next = header + LZSA_PATCH_HEADER_LEN;
+	patch->old_image = old_image;
+	patch->old_len = old_len;
+	patch->new_len = lzsa_patch_read32(header + 12);
+	patch->offset = 0;
+	patch->done = 0;
+	patch->block_size = lzsa_patch_read16(header + 6);
+	patch->crc = 0xFFFF;
+	patch->new_crc = lzsa_patch_read16(header + 16);
+	patch->format = header[5];
+
+	return true;
+}
+
+// Decompress the next block of the new image to the given buffer, which must be
+// at least the block size. Its offset in the new image is then given by the
+// offset member. Returns the length of the block, or zero if there are no more
+// blocks or the block is invalid.
+uint16_t lzsa_patch_next(lzsa_patch_t *patch, uint8_t *buf) {
+	const uint8_t *record = patch->next;
+	uint32_t dict_end, left;
+	uint16_t expect, len;
+	uint8_t *end;
+
+	if(record == NULL || patch->done >= patch->new_len) return 0;
+
+	left = patch->new_len - patch->done;
+	expect = (left < patch->block_size ? (uint16_t)left : patch->block_size);
+
+	dict_end = lzsa_patch_read32(record);
+	if(dict_end > patch->old_len) {
+		patch->next = NULL;
+		return 0;
+	}
+	dict_end += patch->old_image;
+
+	if(patch->format == LZSA_PATCH_FORMAT_LZSA1) {
+		end = lzsa1_decompress_block_dict(buf, record + LZSA_PATCH_RECORD_LEN, dict_end);
+	} else {
+		end = lzsa2_decompress_block_dict(buf, record + LZSA_PATCH_RECORD_LEN, dict_end);
+	}
+
+	len = (uint16_t)(end - buf);
+	if(len != expect) {
+		patch->next = NULL;
+		return 0;
+	}
+
+	patch->crc = lzsa_patch_crc16(patch->crc, buf, len);
+	patch->offset = patch->done;
+	patch->done += len;
+	patch->next = record + LZSA_PATCH_RECORD_LEN + lzsa_patch_read16(record + 4);
+
+	return len;
+}
+
+// Check that the whole of the new image has been decompressed without error,
+// and that its CRC matches that in the patch header.
+bool lzsa_patch_verify(const lzsa_patch_t *patch) {
+	return (patch->next != NULL && patch->done == patch->new_len && patch->crc == patch->new_crc);
+}
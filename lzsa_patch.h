@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * lzsa_patch.h - Header for delta firmware patching
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_PATCH_H_
+#define LZSA_PATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// A patch begins with a header of the magic bytes, a version byte, the format
+// of the compressed blocks, the 16-bit block size, the 32-bit lengths of the
+// old and new images, and the 16-bit CRC-16/CCITT-FALSE of the new image. A
+// record for each block of the new image follows, in order, holding the 32-bit
+// offset into the old image of the end of the block's dictionary, the 16-bit
+// length of the compressed block, and then the block itself. Every block but
+// the last decompresses to the block size. All multi-byte values are
+// big-endian.
+#define LZSA_PATCH_MAGIC "LZPT"
+#define LZSA_PATCH_VERSION 1
+#define LZSA_PATCH_HEADER_LEN 18
+#define LZSA_PATCH_RECORD_LEN 6
+
+#define LZSA_PATCH_FORMAT_LZSA1 1
+#define LZSA_PATCH_FORMAT_LZSA2 2
+
+// The offset member is that in the new image of the block last returned by
+// lzsa_patch_next(), and the done member the length of the new image produced
+// so far. A next member of NULL means an error has occurred.
+typedef struct {
+	const uint8_t *next;
+	uint32_t old_image;
+	uint32_t old_len;
+	uint32_t new_len;
+	uint32_t offset;
+	uint32_t done;
+	uint16_t block_size;
+	uint16_t crc;
+	uint16_t new_crc;
+	uint8_t format;
+} lzsa_patch_t;
+
+extern bool lzsa_patch_init(lzsa_patch_t *patch, const void *data, uint32_t old_image, uint32_t old_len);
+extern uint16_t lzsa_patch_next(lzsa_patch_t *patch, uint8_t *buf);
+extern bool lzsa_patch_verify(const lzsa_patch_t *patch);
+
+#endif // LZSA_PATCH_H_
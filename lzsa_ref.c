@@ -44,6 +44,20 @@
 #define LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT 0xC0
 #define LZSA2_MATCH_LEN_MIN 2
 
+#define LZ4_TOKEN_LITERAL_LEN_MASK 0xF0
+#define LZ4_TOKEN_MATCH_LEN_MASK 0x0F
+#define LZ4_MATCH_LEN_MIN 4
+
+#define LZSA_NATIVE_TOKEN_LITERAL_LEN_MASK 0xF0
+#define LZSA_NATIVE_TOKEN_MATCH_MASK 0x0F
+#define LZSA_NATIVE_TOKEN_16B_MATCH_OFFSET_FLAG_MASK 0x08
+#define LZSA_NATIVE_TOKEN_MATCH_LEN_MASK 0x07
+#define LZSA_NATIVE_TOKEN_REPEAT_MATCH 0x08
+#define LZSA_NATIVE_MATCH_LEN_MIN 2
+
+#define ZX0_OFFSET_INITIAL 1
+#define ZX0_OFFSET_MSB_EOD 256
+
 // Macro to read a pair of nibbles (i.e. a byte) from given input pointer and
 // cache them. Upon first invocation, when a new byte is read, returns the high
 // nibble; subsequent invocation returns the low nibble. This sequence repeats.
@@ -51,6 +65,53 @@
 // second a uint8_t variable holding the cache, third the pointer to read from.
 #define lzsa2_fetch_nibble(r, n, p) (((r) = !(r)) ? ((n) & 0x0F) : ((((n) = *(p)++) & 0xF0) >> 4))
 
+// Macro to translate a position in the logical (unstrided) output stream to a
+// pointer within a strided destination buffer, given buffer start pointer,
+// position, row width and stride. Arguments are evaluated more than once.
+#define lzsa_stride_ptr(d, p, w, s) ((d) + ((p) / (w)) * (s) + ((p) % (w)))
+
+// State of bit reader for ZX0 data. Bits are read MSB-first from bytes that
+// are interleaved with other data in the input. When backtrack flag is set, the
+// next bit is instead taken from the LSB of the last byte read.
+typedef struct {
+	const uint8_t *in;
+	uint8_t last;
+	uint8_t bits;
+	uint8_t mask;
+	bool backtrack;
+} zx0_reader_t;
+
+/******************************************************************************/
+
+static uint8_t zx0_read_byte(zx0_reader_t *r) {
+	r->last = *r->in++;
+	return r->last;
+}
+
+static bool zx0_read_bit(zx0_reader_t *r) {
+	if(r->backtrack) {
+		r->backtrack = false;
+		return (r->last & 0x01);
+	}
+	r->mask >>= 1;
+	if(r->mask == 0) {
+		r->mask = 0x80;
+		r->bits = zx0_read_byte(r);
+	}
+	return (r->bits & r->mask);
+}
+
+// Read an interlaced Elias gamma coded value: starting from 1, each zero
+// control bit is followed by a data bit to shift in, until a control bit of
+// one. The data bits are optionally inverted.
+static uint16_t zx0_read_elias(zx0_reader_t *r, const bool inverted) {
+	uint16_t value = 1;
+	while(!zx0_read_bit(r)) {
+		value = (value << 1) | (zx0_read_bit(r) ^ inverted);
+	}
+	return value;
+}
+
 /******************************************************************************/
 
 void * lzsa1_decompress_block_ref(void *dst, const void *src) {
@@ -284,3 +345,1172 @@ void * lzsa2_decompress_block_ref(void *dst, const void *src) {
 
 	return out;
 }
+
+// Get the filtered output byte at the given position, or zero if it lies before
+// the start of the output buffer.
+static uint8_t lzsa_filter_hist(const uint8_t *start, const uint8_t *pos, const size_t back) {
+	return ((size_t)(pos - start) >= back ? *(pos - back) : 0);
+}
+
+// Apply the filter to the given raw byte and write it to the output.
+static uint8_t * lzsa_filter_emit(const lzsa_filter_t *filter, const uint8_t *start, uint8_t *out, const uint8_t raw) {
+	uint8_t carry;
+
+	switch(filter->type) {
+		case LZSA_FILTER_DELTA8:
+			*out = lzsa_filter_hist(start, out, 1) + raw;
+			break;
+		case LZSA_FILTER_DELTA16:
+			// Low byte of each little-endian word is added to low byte of the
+			// previous word; high byte to previous high byte plus the carry
+			// from the low byte addition. A carry occurred when the low byte
+			// result was less than the previous low byte.
+			if(((out - start) & 1) == 0) {
+				*out = lzsa_filter_hist(start, out, 2) + raw;
+			} else {
+				carry = (lzsa_filter_hist(start, out, 1) < lzsa_filter_hist(start, out, 3));
+				*out = lzsa_filter_hist(start, out, 2) + raw + carry;
+			}
+			break;
+		case LZSA_FILTER_XOR:
+			*out = raw ^ filter->key;
+			break;
+		case LZSA_FILTER_LUT:
+			*out = filter->lut[raw];
+			break;
+		default:
+			*out = raw;
+			break;
+	}
+
+	return out + 1;
+}
+
+// Recover the raw (unfiltered) byte that produced the filtered output byte at
+// the given position. Only meaningful for delta filters.
+static uint8_t lzsa_filter_unapply(const lzsa_filter_t *filter, const uint8_t *start, const uint8_t *pos) {
+	uint8_t borrow;
+
+	switch(filter->type) {
+		case LZSA_FILTER_DELTA8:
+			return *pos - lzsa_filter_hist(start, pos, 1);
+		case LZSA_FILTER_DELTA16:
+			if(((pos - start) & 1) == 0) {
+				return *pos - lzsa_filter_hist(start, pos, 2);
+			} else {
+				borrow = (lzsa_filter_hist(start, pos, 1) < lzsa_filter_hist(start, pos, 3));
+				return *pos - lzsa_filter_hist(start, pos, 2) - borrow;
+			}
+		default:
+			return *pos;
+	}
+}
+
+void * lzsa2_decompress_block_filter_ref(void *dst, const void *src, const lzsa_filter_t *filter) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	const uint8_t *start = out;
+	const bool delta = (filter->type == LZSA_FILTER_DELTA8 || filter->type == LZSA_FILTER_DELTA16);
+	bool nibble_rdy = true;
+	uint8_t n, nibbles = 0x00;
+	int16_t match_off = 0;
+
+	while(1) {
+		// Token parsing is exactly as lzsa2_decompress_block_ref(); see there
+		// for commentary.
+		const uint8_t token = *in++;
+		const uint8_t offset_mode = (token & LZSA2_TOKEN_MATCH_OFFSET_MODE_MASK);
+		uint16_t lit_len = ((token & LZSA2_TOKEN_LITERAL_LEN_MASK) >> 3);
+		uint16_t match_len = ((token & LZSA2_TOKEN_MATCH_LEN_MASK) >> 0);
+
+		if(lit_len == 3) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 237) {
+					lit_len += n + 15;
+				} else if(n == 239) {
+					lit_len = *in++;
+					lit_len |= (*in++ << 8);
+				} else {
+					// Value of 238 is not valid, so the block is malformed.
+					break;
+				}
+			} else {
+				lit_len += n;
+			}
+		}
+
+		// Filter each literal byte as it is copied to the output.
+		while(lit_len-- > 0) out = lzsa_filter_emit(filter, start, out, *in++);
+
+		switch(offset_mode) {
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_5BIT:
+				match_off = lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 1;
+				match_off |= (~token & 0x20) >> 5;
+				match_off |= 0xFFE0;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_9BIT:
+				match_off = *in++;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= 0xFE00;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_13BIT:
+				match_off = (int16_t)lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 9;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= *in++;
+				match_off |= 0xE000;
+				match_off -= 512;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT:
+				if(!(token & 0x20)) {
+					match_off = *in++ << 8;
+					match_off |= *in++;
+				}
+				break;
+		}
+
+		if(match_len == 7) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 231) {
+					match_len += n + 15 + LZSA2_MATCH_LEN_MIN;
+				} else if(n == 233) {
+					match_len = *in++;
+					match_len |= *in++ << 8;
+				} else {
+					break; // EOD
+				}
+			} else {
+				match_len += n + LZSA2_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA2_MATCH_LEN_MIN;
+		}
+
+		const uint8_t *match_src = out + match_off;
+
+		// The output holds filtered data, so for delta filters each matched
+		// byte must have its raw value recovered before being filtered again.
+		// For all other filters, the filtered bytes can be copied as-is.
+		if(delta) {
+			while(match_len-- > 0) {
+				out = lzsa_filter_emit(filter, start, out, lzsa_filter_unapply(filter, start, match_src));
+				match_src++;
+			}
+		} else {
+			while(match_len-- > 0) *out++ = *match_src++;
+		}
+	}
+
+	return out;
+}
+
+void * lzsa1_decompress_block_strided_ref(void *dst, const void *src, uint8_t width, uint16_t stride) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	uint16_t pos = 0;
+	uint8_t n;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa1_decompress_block_strided_ref(): in = %p, out = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values.
+		const uint8_t token = *in++;
+		uint16_t lit_len = ((token & LZSA1_TOKEN_LITERAL_LEN_MASK) >> 4);
+		uint16_t match_len = ((token & LZSA1_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_strided_ref(): token = %02x, lit_len = %u, match_len = %u\n", token, lit_len, match_len);
+#endif
+
+		// Handle optional extra literal length. Can either be a single extra
+		// byte which is added to the initial length, a second extra byte which
+		// sets the literal length to be 256 + <2nd byte>, or 2 extra bytes
+		// which form a little-endian 16-bit value which sets the length.
+		if(lit_len == 7) {
+			n = *in++;
+			if(n == 250) {
+				lit_len = 256 + *in++;
+			} else if(n == 249) {
+				lit_len = *in++;
+				lit_len |= (*in++ << 8);
+			} else {
+				lit_len += n;
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_strided_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Copy the specified number of literal bytes to the output.
+		while(lit_len-- > 0) {
+			*lzsa_stride_ptr(out, pos, width, stride) = *in++;
+			pos++;
+		}
+
+		// First match offset byte is LSB of offset. If flag in token is set, an
+		// optional second byte exists, so read and make MSB of offset.
+		// Otherwise, the MSB is 0xFF.
+		int16_t match_off = *in++;
+		if(token & LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK) {
+			match_off |= ((int16_t)*in++ << 8);
+		} else {
+			match_off |= 0xFF00;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_strided_ref(): match_off = %d\n", match_off);
+#endif
+
+		// When actual match length is 15 or more, an extra byte follows to
+		// represent the length, whose interpretation depends on its value. For
+		// a value of 0-237, final match length is the byte plus 15 from the
+		// token plus the minimum match length (e.g. <byte>+15+3). For a value
+		// of 239, another byte follows, and final match length is
+		// <2nd byte>+256. For a value of 238, two more bytes follow, forming a
+		// little-endian 16-bit value that is the final match length. If that
+		// length is zero, we have reached end-of-data (EOD), so quit.
+		if(match_len == 15) {
+			n = *in++;
+			if(n == 239) {
+				match_len = 256 + *in++;
+			} else if(n == 238) {
+				match_len = *in++;
+				match_len |= (*in++ << 8);
+				if(match_len == 0) break;
+			} else {
+				match_len += n + LZSA1_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA1_MATCH_LEN_MIN;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_strided_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the logical position for copy by adding negative match
+		// offset to current logical output position.
+		uint16_t match_pos = pos + match_off;
+
+		// Copy the specified number of bytes from previous output data to the
+		// output, translating logical positions to buffer positions.
+		while(match_len-- > 0) {
+			*lzsa_stride_ptr(out, pos, width, stride) = *lzsa_stride_ptr(out, match_pos, width, stride);
+			pos++;
+			match_pos++;
+		}
+	}
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa1_decompress_block_strided_ref(): pos = %u\n", pos);
+#endif
+
+	return lzsa_stride_ptr(out, pos, width, stride);
+}
+
+void * lzsa2_decompress_block_strided_ref(void *dst, const void *src, uint8_t width, uint16_t stride) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	uint16_t pos = 0;
+	bool nibble_rdy = true;
+	uint8_t n, nibbles = 0x00;
+	int16_t match_off = 0;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa2_decompress_block_strided_ref(): in = %p, out = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values. Token format is XYZ|LL|MMM.
+		const uint8_t token = *in++;
+		const uint8_t offset_mode = (token & LZSA2_TOKEN_MATCH_OFFSET_MODE_MASK);
+		uint16_t lit_len = ((token & LZSA2_TOKEN_LITERAL_LEN_MASK) >> 3);
+		uint16_t match_len = ((token & LZSA2_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_strided_ref(): token = %02x, offset_mode = %02x, lit_len = %u, match_len = %u\n", token, offset_mode, lit_len, match_len);
+#endif
+
+		// Handle optional extra literal length.
+		if(lit_len == 3) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 237) {
+					lit_len += n + 15;
+				} else if(n == 239) {
+					lit_len = *in++;
+					lit_len |= (*in++ << 8);
+				} else {
+					// Value of 238 is not valid, so the block is malformed.
+					break;
+				}
+			} else {
+				lit_len += n;
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_strided_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Copy the specified number of literal bytes to the output.
+		while(lit_len-- > 0) {
+			*lzsa_stride_ptr(out, pos, width, stride) = *in++;
+			pos++;
+		}
+
+		switch(offset_mode) {
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_5BIT:
+				// 5-bit offset:
+				// Read a nibble for offset bits 1-4 and use the inverted bit Z
+				// of the token as bit 0 of the offset. Set bits 5-15 of the
+				// offset to 1.
+				match_off = lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 1;
+				match_off |= (~token & 0x20) >> 5;
+				match_off |= 0xFFE0;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_9BIT:
+				// 9-bit offset:
+				// Read a byte for offset bits 0-7 and use the inverted bit Z
+				// for bit 8 of the offset. Set bits 9-15 of the offset to 1.
+				match_off = *in++;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= 0xFE00;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_13BIT:
+				// 13-bit offset:
+				// Read a nibble for offset bits 9-12 and use the inverted bit Z
+				// for bit 8 of the offset, then read a byte for offset bits
+				// 0-7. Set bits 13-15 of the offset to 1. Subtract 512 from the
+				// offset to get the final value.
+				match_off = (int16_t)lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 9;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= *in++;
+				match_off |= 0xE000;
+				match_off -= 512;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT:
+				// Either 16-bit offset or repeat offset:
+				// If Z bit not set, read a byte for offset bits 8-15, then
+				// another byte for offset bits 0-7. Otherwise, reuse the offset
+				// value of the previous match command.
+				if(!(token & 0x20)) {
+					match_off = *in++ << 8;
+					match_off |= *in++;
+				}
+				break;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_strided_ref(): match_off = %d\n", match_off);
+#endif
+
+		if(match_len == 7) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 231) {
+					match_len += n + 15 + LZSA2_MATCH_LEN_MIN;
+				} else if(n == 233) {
+					match_len = *in++;
+					match_len |= *in++ << 8;
+				} else {
+					break; // EOD
+				}
+			} else {
+				match_len += n + LZSA2_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA2_MATCH_LEN_MIN;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_strided_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the logical position for copy by adding negative match
+		// offset to current logical output position.
+		uint16_t match_pos = pos + match_off;
+
+		// Copy the specified number of bytes from previous output data to the
+		// output, translating logical positions to buffer positions.
+		while(match_len-- > 0) {
+			*lzsa_stride_ptr(out, pos, width, stride) = *lzsa_stride_ptr(out, match_pos, width, stride);
+			pos++;
+			match_pos++;
+		}
+	}
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa2_decompress_block_strided_ref(): pos = %u\n", pos);
+#endif
+
+	return lzsa_stride_ptr(out, pos, width, stride);
+}
+
+void * lzsa1_decompress_batch_ref(const lzsa_batch_entry_t *entries, uint8_t count, void **ends) {
+	void *end = NULL;
+
+	while(count--) {
+		end = lzsa1_decompress_block_ref(entries->dst, entries->src);
+		if(ends) *ends++ = end;
+		entries++;
+	}
+
+	return end;
+}
+
+void * lzsa2_decompress_batch_ref(const lzsa_batch_entry_t *entries, uint8_t count, void **ends) {
+	void *end = NULL;
+
+	while(count--) {
+		end = lzsa2_decompress_block_ref(entries->dst, entries->src);
+		if(ends) *ends++ = end;
+		entries++;
+	}
+
+	return end;
+}
+
+uint16_t lzsa1_compare_block_ref(const void *target, const void *src) {
+	const uint8_t *in = (const uint8_t *)src;
+	const uint8_t *start = (const uint8_t *)target;
+	const uint8_t *out = start;
+	uint8_t n;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa1_compare_block_ref(): in = %p, target = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values.
+		const uint8_t token = *in++;
+		uint16_t lit_len = ((token & LZSA1_TOKEN_LITERAL_LEN_MASK) >> 4);
+		uint16_t match_len = ((token & LZSA1_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_compare_block_ref(): token = %02x, lit_len = %u, match_len = %u\n", token, lit_len, match_len);
+#endif
+
+		// Handle optional extra literal length. Can either be a single extra
+		// byte which is added to the initial length, a second extra byte which
+		// sets the literal length to be 256 + <2nd byte>, or 2 extra bytes
+		// which form a little-endian 16-bit value which sets the length.
+		if(lit_len == 7) {
+			n = *in++;
+			if(n == 250) {
+				lit_len = 256 + *in++;
+			} else if(n == 249) {
+				lit_len = *in++;
+				lit_len |= (*in++ << 8);
+			} else {
+				lit_len += n;
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_compare_block_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Compare the specified number of literal bytes against the target,
+		// stopping at the first that differs.
+		while(lit_len-- > 0) {
+			if(*in++ != *out) goto mismatch;
+			out++;
+		}
+
+		// First match offset byte is LSB of offset. If flag in token is set, an
+		// optional second byte exists, so read and make MSB of offset.
+		// Otherwise, the MSB is 0xFF.
+		int16_t match_off = *in++;
+		if(token & LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK) {
+			match_off |= ((int16_t)*in++ << 8);
+		} else {
+			match_off |= 0xFF00;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_compare_block_ref(): match_off = %d\n", match_off);
+#endif
+
+		// When actual match length is 15 or more, an extra byte follows to
+		// represent the length, whose interpretation depends on its value. For
+		// a value of 0-237, final match length is the byte plus 15 from the
+		// token plus the minimum match length (e.g. <byte>+15+3). For a value
+		// of 239, another byte follows, and final match length is
+		// <2nd byte>+256. For a value of 238, two more bytes follow, forming a
+		// little-endian 16-bit value that is the final match length. If that
+		// length is zero, we have reached end-of-data (EOD), so quit.
+		if(match_len == 15) {
+			n = *in++;
+			if(n == 239) {
+				match_len = 256 + *in++;
+			} else if(n == 238) {
+				match_len = *in++;
+				match_len |= (*in++ << 8);
+				if(match_len == 0) break;
+			} else {
+				match_len += n + LZSA1_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA1_MATCH_LEN_MIN;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_compare_block_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the absolute position of the match by adding negative
+		// match offset to current target position. Everything before the
+		// current position is known to be the same as the decompressed data,
+		// so the match can be taken from the target.
+		const uint8_t *match_src = out + match_off;
+
+		// Compare the specified number of bytes from earlier in the target
+		// against the target, stopping at the first that differs.
+		while(match_len-- > 0) {
+			if(*match_src++ != *out) goto mismatch;
+			out++;
+		}
+	}
+
+mismatch:
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa1_compare_block_ref(): out = %p\n", out);
+#endif
+
+	return (uint16_t)(out - start);
+}
+
+uint16_t lzsa2_compare_block_ref(const void *target, const void *src) {
+	const uint8_t *in = (const uint8_t *)src;
+	const uint8_t *start = (const uint8_t *)target;
+	const uint8_t *out = start;
+	bool nibble_rdy = true;
+	uint8_t n, nibbles = 0x00;
+	int16_t match_off = 0;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa2_compare_block_ref(): in = %p, target = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values. Token format is XYZ|LL|MMM.
+		const uint8_t token = *in++;
+		const uint8_t offset_mode = (token & LZSA2_TOKEN_MATCH_OFFSET_MODE_MASK);
+		uint16_t lit_len = ((token & LZSA2_TOKEN_LITERAL_LEN_MASK) >> 3);
+		uint16_t match_len = ((token & LZSA2_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_compare_block_ref(): token = %02x, offset_mode = %02x, lit_len = %u, match_len = %u\n", token, offset_mode, lit_len, match_len);
+#endif
+
+		// Handle optional extra literal length.
+		if(lit_len == 3) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 237) {
+					lit_len += n + 15;
+				} else if(n == 239) {
+					lit_len = *in++;
+					lit_len |= (*in++ << 8);
+				} else {
+					// Value of 238 is not valid, so the block is malformed.
+					break;
+				}
+			} else {
+				lit_len += n;
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_compare_block_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Compare the specified number of literal bytes against the target,
+		// stopping at the first that differs.
+		while(lit_len-- > 0) {
+			if(*in++ != *out) goto mismatch;
+			out++;
+		}
+
+		switch(offset_mode) {
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_5BIT:
+				// 5-bit offset:
+				// Read a nibble for offset bits 1-4 and use the inverted bit Z
+				// of the token as bit 0 of the offset. Set bits 5-15 of the
+				// offset to 1.
+				match_off = lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 1;
+				match_off |= (~token & 0x20) >> 5;
+				match_off |= 0xFFE0;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_9BIT:
+				// 9-bit offset:
+				// Read a byte for offset bits 0-7 and use the inverted bit Z
+				// for bit 8 of the offset. Set bits 9-15 of the offset to 1.
+				match_off = *in++;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= 0xFE00;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_13BIT:
+				// 13-bit offset:
+				// Read a nibble for offset bits 9-12 and use the inverted bit Z
+				// for bit 8 of the offset, then read a byte for offset bits
+				// 0-7. Set bits 13-15 of the offset to 1. Subtract 512 from the
+				// offset to get the final value.
+				match_off = (int16_t)lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 9;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= *in++;
+				match_off |= 0xE000;
+				match_off -= 512;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT:
+				// Either 16-bit offset or repeat offset:
+				// If Z bit not set, read a byte for offset bits 8-15, then
+				// another byte for offset bits 0-7. Otherwise, reuse the offset
+				// value of the previous match command.
+				if(!(token & 0x20)) {
+					match_off = *in++ << 8;
+					match_off |= *in++;
+				}
+				break;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_compare_block_ref(): match_off = %d\n", match_off);
+#endif
+
+		if(match_len == 7) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 231) {
+					match_len += n + 15 + LZSA2_MATCH_LEN_MIN;
+				} else if(n == 233) {
+					match_len = *in++;
+					match_len |= *in++ << 8;
+				} else {
+					break; // EOD
+				}
+			} else {
+				match_len += n + LZSA2_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA2_MATCH_LEN_MIN;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_compare_block_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the absolute position of the match by adding negative
+		// match offset to current target position. Everything before the
+		// current position is known to be the same as the decompressed data,
+		// so the match can be taken from the target.
+		const uint8_t *match_src = out + match_off;
+
+		// Compare the specified number of bytes from earlier in the target
+		// against the target, stopping at the first that differs.
+		while(match_len-- > 0) {
+			if(*match_src++ != *out) goto mismatch;
+			out++;
+		}
+	}
+
+mismatch:
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa2_compare_block_ref(): out = %p\n", out);
+#endif
+
+	return (uint16_t)(out - start);
+}
+
+// Unlike the assembly versions, these take the end of the dictionary as an
+// ordinary pointer, as there is no portable way to use far pointers from C.
+void * lzsa1_decompress_block_dict_ref(void *dst, const void *src, const void *dict) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	const uint8_t *start = out;
+	const uint8_t *dict_end = (const uint8_t *)dict;
+	uint8_t n;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa1_decompress_block_dict_ref(): in = %p, out = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values.
+		const uint8_t token = *in++;
+		uint16_t lit_len = ((token & LZSA1_TOKEN_LITERAL_LEN_MASK) >> 4);
+		uint16_t match_len = ((token & LZSA1_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_dict_ref(): token = %02x, lit_len = %u, match_len = %u\n", token, lit_len, match_len);
+#endif
+
+		// Handle optional extra literal length. Can either be a single extra
+		// byte which is added to the initial length, a second extra byte which
+		// sets the literal length to be 256 + <2nd byte>, or 2 extra bytes
+		// which form a little-endian 16-bit value which sets the length.
+		if(lit_len == 7) {
+			n = *in++;
+			if(n == 250) {
+				lit_len = 256 + *in++;
+			} else if(n == 249) {
+				lit_len = *in++;
+				lit_len |= (*in++ << 8);
+			} else {
+				lit_len += n;
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_dict_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Copy the specified number of literal bytes to the output.
+		while(lit_len-- > 0) *out++ = *in++;
+
+		// First match offset byte is LSB of offset. If flag in token is set, an
+		// optional second byte exists, so read and make MSB of offset.
+		// Otherwise, the MSB is 0xFF.
+		int16_t match_off = *in++;
+		if(token & LZSA1_TOKEN_16B_MATCH_OFFSET_FLAG_MASK) {
+			match_off |= ((int16_t)*in++ << 8);
+		} else {
+			match_off |= 0xFF00;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_dict_ref(): match_off = %d\n", match_off);
+#endif
+
+		// When actual match length is 15 or more, an extra byte follows to
+		// represent the length, whose interpretation depends on its value. For
+		// a value of 0-237, final match length is the byte plus 15 from the
+		// token plus the minimum match length (e.g. <byte>+15+3). For a value
+		// of 239, another byte follows, and final match length is
+		// <2nd byte>+256. For a value of 238, two more bytes follow, forming a
+		// little-endian 16-bit value that is the final match length. If that
+		// length is zero, we have reached end-of-data (EOD), so quit.
+		if(match_len == 15) {
+			n = *in++;
+			if(n == 239) {
+				match_len = 256 + *in++;
+			} else if(n == 238) {
+				match_len = *in++;
+				match_len |= (*in++ << 8);
+				if(match_len == 0) break;
+			} else {
+				match_len += n + LZSA1_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA1_MATCH_LEN_MIN;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa1_decompress_block_dict_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the position for copy, relative to the start of the
+		// output, by subtracting the match offset from the current output
+		// position. The offset may be up to 65535 back, beyond the range of a
+		// signed 16-bit value, so is negated as unsigned.
+		int32_t match_pos = (int32_t)(out - start) - (int32_t)(0x10000UL - (uint16_t)match_off);
+
+		// Copy bytes from the dictionary while the position is before the start
+		// of the output, then the rest from previous output data.
+		while(match_len > 0 && match_pos < 0) {
+			*out++ = dict_end[match_pos++];
+			match_len--;
+		}
+		const uint8_t *match_src = start + match_pos;
+		while(match_len-- > 0) *out++ = *match_src++;
+	}
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa1_decompress_block_dict_ref(): out = %p\n", out);
+#endif
+
+	return out;
+}
+
+void * lzsa2_decompress_block_dict_ref(void *dst, const void *src, const void *dict) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	const uint8_t *start = out;
+	const uint8_t *dict_end = (const uint8_t *)dict;
+	bool nibble_rdy = true;
+	uint8_t n, nibbles = 0x00;
+	int16_t match_off = 0;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa2_decompress_block_dict_ref(): in = %p, out = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values. Token format is XYZ|LL|MMM.
+		const uint8_t token = *in++;
+		const uint8_t offset_mode = (token & LZSA2_TOKEN_MATCH_OFFSET_MODE_MASK);
+		uint16_t lit_len = ((token & LZSA2_TOKEN_LITERAL_LEN_MASK) >> 3);
+		uint16_t match_len = ((token & LZSA2_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_dict_ref(): token = %02x, offset_mode = %02x, lit_len = %u, match_len = %u\n", token, offset_mode, lit_len, match_len);
+#endif
+
+		// Handle optional extra literal length.
+		if(lit_len == 3) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 237) {
+					lit_len += n + 15;
+				} else if(n == 239) {
+					lit_len = *in++;
+					lit_len |= (*in++ << 8);
+				} else {
+					// Value of 238 is not valid, so the block is malformed.
+					break;
+				}
+			} else {
+				lit_len += n;
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_dict_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Copy the specified number of literal bytes to the output.
+		while(lit_len-- > 0) *out++ = *in++;
+
+		switch(offset_mode) {
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_5BIT:
+				// 5-bit offset:
+				// Read a nibble for offset bits 1-4 and use the inverted bit Z
+				// of the token as bit 0 of the offset. Set bits 5-15 of the
+				// offset to 1.
+				match_off = lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 1;
+				match_off |= (~token & 0x20) >> 5;
+				match_off |= 0xFFE0;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_9BIT:
+				// 9-bit offset:
+				// Read a byte for offset bits 0-7 and use the inverted bit Z
+				// for bit 8 of the offset. Set bits 9-15 of the offset to 1.
+				match_off = *in++;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= 0xFE00;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_13BIT:
+				// 13-bit offset:
+				// Read a nibble for offset bits 9-12 and use the inverted bit Z
+				// for bit 8 of the offset, then read a byte for offset bits
+				// 0-7. Set bits 13-15 of the offset to 1. Subtract 512 from the
+				// offset to get the final value.
+				match_off = (int16_t)lzsa2_fetch_nibble(nibble_rdy, nibbles, in) << 9;
+				match_off |= (int16_t)(~token & 0x20) << 3;
+				match_off |= *in++;
+				match_off |= 0xE000;
+				match_off -= 512;
+				break;
+			case LZSA2_TOKEN_MATCH_OFFSET_MODE_16BIT:
+				// Either 16-bit offset or repeat offset:
+				// If Z bit not set, read a byte for offset bits 8-15, then
+				// another byte for offset bits 0-7. Otherwise, reuse the offset
+				// value of the previous match command.
+				if(!(token & 0x20)) {
+					match_off = *in++ << 8;
+					match_off |= *in++;
+				}
+				break;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_dict_ref(): match_off = %d\n", match_off);
+#endif
+
+		if(match_len == 7) {
+			n = lzsa2_fetch_nibble(nibble_rdy, nibbles, in);
+			if(n == 15) {
+				n = *in++;
+				if(n <= 231) {
+					match_len += n + 15 + LZSA2_MATCH_LEN_MIN;
+				} else if(n == 233) {
+					match_len = *in++;
+					match_len |= *in++ << 8;
+				} else {
+					break; // EOD
+				}
+			} else {
+				match_len += n + LZSA2_MATCH_LEN_MIN;
+			}
+		} else {
+			match_len += LZSA2_MATCH_LEN_MIN;
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa2_decompress_block_dict_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the position for copy, relative to the start of the
+		// output, by subtracting the match offset from the current output
+		// position. The offset may be up to 65535 back, beyond the range of a
+		// signed 16-bit value, so is negated as unsigned.
+		int32_t match_pos = (int32_t)(out - start) - (int32_t)(0x10000UL - (uint16_t)match_off);
+
+		// Copy bytes from the dictionary while the position is before the start
+		// of the output, then the rest from previous output data.
+		while(match_len > 0 && match_pos < 0) {
+			*out++ = dict_end[match_pos++];
+			match_len--;
+		}
+		const uint8_t *match_src = start + match_pos;
+		while(match_len-- > 0) *out++ = *match_src++;
+	}
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa2_decompress_block_dict_ref(): out = %p\n", out);
+#endif
+
+	return out;
+}
+
+void * lz4_decompress_block_ref(void *dst, const void *src, size_t src_len) {
+	const uint8_t *in = (const uint8_t *)src;
+	const uint8_t *in_end = in + src_len;
+	uint8_t *out = (uint8_t *)dst;
+	uint8_t n;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lz4_decompress_block_ref(): in = %p, in_end = %p, out = %p\n", in, in_end, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values.
+		const uint8_t token = *in++;
+		uint16_t lit_len = ((token & LZ4_TOKEN_LITERAL_LEN_MASK) >> 4);
+		uint16_t match_len = ((token & LZ4_TOKEN_MATCH_LEN_MASK) >> 0);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lz4_decompress_block_ref(): token = %02x, lit_len = %u, match_len = %u\n", token, lit_len, match_len);
+#endif
+
+		// When literal length is 15, extra bytes follow which are added to the
+		// length. Continue adding bytes for as long as each is 255.
+		if(lit_len == 15) {
+			do {
+				n = *in++;
+				lit_len += n;
+			} while(n == 255);
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lz4_decompress_block_ref(): lit_len = %u\n", lit_len);
+#endif
+
+		// Copy the specified number of literal bytes to the output.
+		while(lit_len-- > 0) *out++ = *in++;
+
+		// LZ4 blocks have no end-of-data marker; the last sequence consists of
+		// literals only and finishes at the end of the block. So, if we have
+		// reached the end of the input, we're done.
+		if(in >= in_end) break;
+
+		// Match offset is a little-endian 16-bit value giving the distance
+		// backwards from the current output position.
+		uint16_t match_off = *in++;
+		match_off |= (*in++ << 8);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lz4_decompress_block_ref(): match_off = %u\n", match_off);
+#endif
+
+		// Handle extra match length bytes in the same manner as for literals,
+		// then add the minimum match length.
+		if(match_len == 15) {
+			do {
+				n = *in++;
+				match_len += n;
+			} while(n == 255);
+		}
+		match_len += LZ4_MATCH_LEN_MIN;
+
+#ifdef LZSA_REF_DEBUG
+		printf("lz4_decompress_block_ref(): match_len = %u\n", match_len);
+#endif
+
+		// Calculate the absolute position for copy by subtracting match offset
+		// from current output position.
+		const uint8_t *match_src = out - match_off;
+
+		// Copy the specified number of bytes from previous output data to the
+		// output.
+		while(match_len-- > 0) *out++ = *match_src++;
+	}
+
+#ifdef LZSA_REF_DEBUG
+	printf("lz4_decompress_block_ref(): out = %p\n", out);
+#endif
+
+	return out;
+}
+
+void * zx0_decompress_block_ref(void *dst, const void *src) {
+	zx0_reader_t r = { .in = (const uint8_t *)src, .last = 0, .bits = 0, .mask = 0, .backtrack = false };
+	uint8_t *out = (uint8_t *)dst;
+	uint16_t last_off = ZX0_OFFSET_INITIAL;
+	uint16_t len;
+	bool new_off;
+
+#ifdef LZSA_REF_DEBUG
+	printf("zx0_decompress_block_ref(): in = %p, out = %p\n", r.in, out);
+#endif
+
+	while(1) {
+		// Copy a run of literal bytes to the output. There is always at least
+		// one.
+		len = zx0_read_elias(&r, false);
+
+#ifdef LZSA_REF_DEBUG
+		printf("zx0_decompress_block_ref(): lit_len = %u\n", len);
+#endif
+
+		while(len-- > 0) *out++ = zx0_read_byte(&r);
+
+		// After literals, a bit indicates whether a match from a new offset
+		// (1) or a repeat of the last offset (0) follows.
+		new_off = zx0_read_bit(&r);
+
+		if(!new_off) {
+			len = zx0_read_elias(&r, false);
+
+#ifdef LZSA_REF_DEBUG
+			printf("zx0_decompress_block_ref(): rep match_len = %u, match_off = %u\n", len, last_off);
+#endif
+
+			const uint8_t *match_src = out - last_off;
+			while(len-- > 0) *out++ = *match_src++;
+
+			// After a repeat match, a bit indicates whether a match from a new
+			// offset (1) or literals (0) follow.
+			new_off = zx0_read_bit(&r);
+		}
+
+		while(new_off) {
+			// The MSB part of the offset is coded with inverted data bits. A
+			// value of 256 indicates end-of-data (EOD), so quit.
+			uint16_t off_msb = zx0_read_elias(&r, true);
+			if(off_msb == ZX0_OFFSET_MSB_EOD) goto end;
+
+			// Offset is the MSB part multiplied by 128, minus the top 7 bits of
+			// the following LSB byte. The bottom bit of that byte is the first
+			// bit of the Elias gamma coded match length, which is one less than
+			// the actual length.
+			last_off = (off_msb * 128) - (zx0_read_byte(&r) >> 1);
+			r.backtrack = true;
+			len = zx0_read_elias(&r, false) + 1;
+
+#ifdef LZSA_REF_DEBUG
+			printf("zx0_decompress_block_ref(): match_len = %u, match_off = %u\n", len, last_off);
+#endif
+
+			const uint8_t *match_src = out - last_off;
+			while(len-- > 0) *out++ = *match_src++;
+
+			// After a match from a new offset, a bit indicates whether another
+			// such match (1) or literals (0) follow.
+			new_off = zx0_read_bit(&r);
+		}
+	}
+
+end:
+#ifdef LZSA_REF_DEBUG
+	printf("zx0_decompress_block_ref(): out = %p\n", out);
+#endif
+
+	return out;
+}
+
+void * lzsa_native_decompress_block_ref(void *dst, const void *src) {
+	const uint8_t *in = (const uint8_t *)src;
+	uint8_t *out = (uint8_t *)dst;
+	int16_t match_off = 0;
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa_native_decompress_block_ref(): in = %p, out = %p\n", in, out);
+#endif
+
+	while(1) {
+		// Get next token byte and parse out values. A token of zero is
+		// end-of-data (EOD).
+		const uint8_t token = *in++;
+		uint16_t lit_len = ((token & LZSA_NATIVE_TOKEN_LITERAL_LEN_MASK) >> 4);
+		uint16_t match_len = (token & LZSA_NATIVE_TOKEN_MATCH_LEN_MASK);
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa_native_decompress_block_ref(): token = %02x, lit_len = %u, match_len = %u\n", token, lit_len, match_len);
+#endif
+
+		if(token == 0) break;
+
+		// A literal length of 15 means the length is instead given by the
+		// following byte, with zero meaning 256.
+		if(lit_len == 15) {
+			lit_len = *in++;
+			if(lit_len == 0) lit_len = 256;
+		}
+
+		// Copy the specified number of literal bytes to the output.
+		while(lit_len-- > 0) *out++ = *in++;
+
+		// With no match, go on to the next token. With the repeat match code,
+		// a length byte follows and the previous offset is used again.
+		// Otherwise, a match length of 1-6 in the token gives the final length
+		// when added to the minimum (2), and 7 means the length is given by the
+		// following byte (with zero meaning 256). Then follows either a single
+		// offset byte, with an MSB of 0xFF, or two bytes forming a big-endian
+		// 16-bit offset.
+		if((token & LZSA_NATIVE_TOKEN_MATCH_MASK) == 0) continue;
+
+		if(match_len == 0 || match_len == 7) {
+			match_len = *in++;
+			if(match_len == 0) match_len = 256;
+		} else {
+			match_len += LZSA_NATIVE_MATCH_LEN_MIN - 1;
+		}
+
+		if((token & LZSA_NATIVE_TOKEN_MATCH_MASK) != LZSA_NATIVE_TOKEN_REPEAT_MATCH) {
+			if(token & LZSA_NATIVE_TOKEN_16B_MATCH_OFFSET_FLAG_MASK) {
+				match_off = (int16_t)((in[0] << 8) | in[1]);
+				in += 2;
+			} else {
+				match_off = (int16_t)(0xFF00 | *in++);
+			}
+		}
+
+#ifdef LZSA_REF_DEBUG
+		printf("lzsa_native_decompress_block_ref(): match_len = %u, match_off = %d\n", match_len, match_off);
+#endif
+
+		// Copy the specified number of bytes from previous output data to the
+		// output.
+		const uint8_t *match_src = out + match_off;
+		while(match_len-- > 0) *out++ = *match_src++;
+	}
+
+#ifdef LZSA_REF_DEBUG
+	printf("lzsa_native_decompress_block_ref(): out = %p\n", out);
+#endif
+
+	return out;
+}
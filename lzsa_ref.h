@@ -29,8 +29,21 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "lzsa.h"
 
 extern void * lzsa1_decompress_block_ref(void *dst, const void *src);
 extern void * lzsa2_decompress_block_ref(void *dst, const void *src);
+extern void * lzsa2_decompress_block_filter_ref(void *dst, const void *src, const lzsa_filter_t *filter);
+extern void * lzsa1_decompress_block_strided_ref(void *dst, const void *src, uint8_t width, uint16_t stride);
+extern void * lzsa2_decompress_block_strided_ref(void *dst, const void *src, uint8_t width, uint16_t stride);
+extern void * lzsa1_decompress_batch_ref(const lzsa_batch_entry_t *entries, uint8_t count, void **ends);
+extern void * lzsa2_decompress_batch_ref(const lzsa_batch_entry_t *entries, uint8_t count, void **ends);
+extern uint16_t lzsa1_compare_block_ref(const void *target, const void *src);
+extern uint16_t lzsa2_compare_block_ref(const void *target, const void *src);
+extern void * lzsa1_decompress_block_dict_ref(void *dst, const void *src, const void *dict);
+extern void * lzsa2_decompress_block_dict_ref(void *dst, const void *src, const void *dict);
+extern void * lz4_decompress_block_ref(void *dst, const void *src, size_t src_len);
+extern void * zx0_decompress_block_ref(void *dst, const void *src);
+extern void * lzsa_native_decompress_block_ref(void *dst, const void *src);
 
 #endif // LZSA_REF_H_
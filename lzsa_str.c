@@ -0,0 +1,101 @@
+/*******************************************************************************
+ *
+ * lzsa_str.c - Compressed string table
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Prints individual strings from a string table generated by the lzsa_strings
+// host tool. The strings are grouped into small blocks, so printing one needs
+// only its block to be decompressed, taking bounded time and RAM.
+//
+// The block is decompressed into a RAM window, immediately after a copy of
+// the table's dictionary, so that matches in the block can refer back into
+// the dictionary. Decompression never writes over the dictionary, so it is
+// only copied into the window when a different table is used. Likewise, a
+// block is only decompressed if it is not the one already in the window, so
+// printing several strings from the same block in turn is quick.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "lzsa.h"
+#include "lzsa_str.h"
+
+#define LZSA_STR_NO_BLOCK 0xFFFF
+
+/******************************************************************************/
+
+static uint8_t lzsa_str_window[LZSA_STR_WINDOW_LEN];
+static const lzsa_str_table_t *lzsa_str_window_table = NULL;
+static uint16_t lzsa_str_window_block = LZSA_STR_NO_BLOCK;
+
+/******************************************************************************/
+
+// Print the string with the given ID from the given table with putchar().
+// Returns false if there is no such string, or the window is too small for
+// its block.
+bool lzsa_str_print(const lzsa_str_table_t *table, const uint16_t id) {
+	uint8_t *block = lzsa_str_window + table->dict_len;
+	uint16_t lo = 0, hi = table->block_count, mid, last;
+	uint8_t start, end;
+
+	if(id >= table->count) return false;
+
+	// Find the block holding the string, being the last whose first string is
+	// not after it.
+	while(hi - lo > 1) {
+		mid = lo + ((hi - lo) >> 1);
+		if(table->block_first[mid] <= id) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+
+	// The decompressed length of the block is the end of its last string.
+	last = (lo + 1 < table->block_count ? table->block_first[lo + 1] : table->count) - 1;
+	if(table->dict_len + table->ends[last] > LZSA_STR_WINDOW_LEN) return false;
+
+	if(table != lzsa_str_window_table) {
+		memcpy(lzsa_str_window, table->dict, table->dict_len);
+		lzsa_str_window_table = table;
+		lzsa_str_window_block = LZSA_STR_NO_BLOCK;
+	}
+
+	if(lo != lzsa_str_window_block) {
+		if(table->format == LZSA_STR_FORMAT_LZSA1) {
+			lzsa1_decompress_block(block, table->data + table->block_offsets[lo]);
+		} else {
+			lzsa2_decompress_block(block, table->data + table->block_offsets[lo]);
+		}
+		lzsa_str_window_block = lo;
+	}
+
+	start = (id == table->block_first[lo] ? 0 : table->ends[id - 1]);
+	end = table->ends[id];
+	while(start < end) putchar(block[start++]);
+
+	return true;
+}
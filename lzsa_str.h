@@ -0,0 +1,63 @@
+/*******************************************************************************
+ *
+ * lzsa_str.h - Header for compressed string table
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_STR_H_
+#define LZSA_STR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Size of the RAM window that a string's block is decompressed into, after a
+// copy of the dictionary. Must be at least the dictionary length plus the
+// longest block of any string table used (as given by the lzsa_strings tool).
+// Override by defining for the whole project.
+#ifndef LZSA_STR_WINDOW_LEN
+#define LZSA_STR_WINDOW_LEN 384
+#endif
+
+#define LZSA_STR_FORMAT_LZSA1 1
+#define LZSA_STR_FORMAT_LZSA2 2
+
+// String table generated by the lzsa_strings host tool. Strings are grouped
+// into blocks, each compressed separately, and each string's text is given by
+// its end offset within its block's decompressed data (the start being the end
+// of the previous string, or zero for the first in the block).
+typedef struct {
+	uint8_t format;
+	const uint8_t *dict;
+	uint16_t dict_len;
+	const uint8_t *data;
+	const uint16_t *block_offsets; // Offset of each block's compressed data
+	const uint16_t *block_first;   // ID of first string in each block
+	uint16_t block_count;
+	const uint8_t *ends;           // End offset of each string in its block
+	uint16_t count;
+} lzsa_str_table_t;
+
+extern bool lzsa_str_print(const lzsa_str_table_t *table, uint16_t id);
+
+#endif // LZSA_STR_H_
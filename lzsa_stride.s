@@ -0,0 +1,178 @@
+; ------------------------------------------------------------------------------
+; LZSA BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; lzsa_stride.s - Common support routines for strided (2D) output decompression
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; These routines are shared by lzsa1_decompress_block_strided() and
+; lzsa2_decompress_block_strided(). Decompressed data is considered as a
+; logical (unstrided) stream of bytes, which is laid out in the destination
+; buffer as rows of 'width' bytes, each row starting 'stride' bytes after the
+; previous one. Match offsets always refer to positions in the logical stream.
+;
+; NOTE: these routines are not re-entrant, due to use of static variables.
+
+.module lzsa_stride
+.globl lzsa_stride_init
+.globl lzsa_stride_match_src
+.globl str_width
+.globl str_gap
+.globl dst_rem
+.globl src_rem
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+; Row width, stride, and gap between end of one row and start of the next (i.e.
+; stride minus width).
+str_width: .blkb 1
+str_stride: .blkw 1
+str_gap: .blkw 1
+
+; Count of bytes remaining in the current row of destination and match source.
+dst_rem: .blkb 1
+src_rem: .blkb 1
+
+; Temporaries for match source calculation.
+str_quot: .blkw 1
+str_quot_msb .equ (str_quot+0)
+str_quot_lsb .equ (str_quot+1)
+
+str_rem: .blkw 1
+str_rem_msb .equ (str_rem+0)
+str_rem_lsb .equ (str_rem+1)
+
+str_prod: .blkw 1
+str_prod_msb .equ (str_prod+0)
+str_prod_lsb .equ (str_prod+1)
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+; Initialise strided output state. Width is given in A reg, stride in X reg.
+; Width must be non-zero and no greater than stride.
+
+lzsa_stride_init:
+	; Store width and stride, and start with a full row remaining.
+	ld str_width, a
+	ld dst_rem, a
+	ldw str_stride, x
+
+	; Calculate gap as stride minus width.
+	clr str_rem_msb
+	ld str_rem_lsb, a
+	subw x, str_rem
+	ldw str_gap, x
+	return
+
+; ------------------------------------------------------------------------------
+
+; Calculate the physical address in the destination buffer of a match source,
+; given the (negative) match offset in X reg and the current destination pointer
+; in Y reg (which is preserved). The address is returned in X reg, and the count
+; of bytes remaining in the source row is set accordingly.
+;
+; Going back 'n' bytes in the logical stream means going back q = n / width
+; whole rows plus r = n % width bytes. If r is more than the current column,
+; the source lies one further row back, so the gap must also be skipped.
+
+lzsa_stride_match_src:
+	; Negate offset to get distance. If distance is less than width (the most
+	; common case), we already have remainder and quotient is zero, so skip the
+	; division and multiplication.
+	negw x
+	ld a, xh
+	jrne lzsa_stride_src_far
+	ld a, xl
+	cp a, str_width
+	jruge lzsa_stride_src_far
+
+	; Set remainder from distance and start with destination pointer.
+	clr str_rem_msb
+	ld str_rem_lsb, a
+	ldw x, y
+	jra lzsa_stride_src_rem
+
+lzsa_stride_src_far:
+	; Divide distance by width, giving quotient in X reg and remainder in A.
+	ld a, str_width
+	div x, a
+	ldw str_quot, x
+	clr str_rem_msb
+	ld str_rem_lsb, a
+
+	; Multiply quotient by stride, keeping only the low 16 bits of product:
+	;   (q_lsb * s_lsb) + ((q_msb * s_lsb) << 8) + ((q_lsb * s_msb) << 8)
+	; MUL only uses the LSB of X reg, so the stride can be loaded as a whole
+	; word (and swapped to get the MSB).
+	ld a, str_quot_lsb
+	ldw x, str_stride
+	mul x, a
+	ldw str_prod, x
+	ld a, str_quot_msb
+	ldw x, str_stride
+	mul x, a
+	ld a, xl
+	add a, str_prod_msb
+	ld str_prod_msb, a
+	ld a, str_quot_lsb
+	ldw x, str_stride
+	swapw x
+	mul x, a
+	ld a, xl
+	add a, str_prod_msb
+	ld str_prod_msb, a
+
+	; Go back from destination by whole rows.
+	ldw x, y
+	subw x, str_prod
+
+lzsa_stride_src_rem:
+	; Go back by remainder.
+	subw x, str_rem
+
+	; Calculate the current destination column (width minus bytes remaining in
+	; row), and subtract remainder to get the source column. If that borrows,
+	; the source is in the previous row, so also skip back over the gap and
+	; wrap the column around.
+	ld a, str_width
+	sub a, dst_rem
+	sub a, str_rem_lsb
+	jrnc lzsa_stride_src_same_row
+	subw x, str_gap
+	add a, str_width
+
+lzsa_stride_src_same_row:
+	; Set bytes remaining in source row to width minus source column.
+	neg a
+	add a, str_width
+	ld src_rem, a
+	return
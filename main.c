@@ -34,10 +34,27 @@
 #include "uart.h"
 #include "ucsim.h"
 #include "lzsa_ref.h"
+#include "lzsa_fast.h"
+#include "lzsa_cache.h"
+#include "lzsa_archive.h"
+#include "lzsa_str.h"
+#include "lzsa_overlay.h"
+#include "lzsa_patch.h"
+#include "lzsa_comp.h"
 #include "lzsa.h"
 #include "tests.h"
+#include "tests_strings.h"
 
+#define CLK_CMSR (*(volatile uint8_t *)(0x50C3))
+#define CLK_SWR (*(volatile uint8_t *)(0x50C4))
+#define CLK_SWCR (*(volatile uint8_t *)(0x50C5))
+#define CLK_SWCR_SWEN 1
 #define CLK_CKDIVR (*(volatile uint8_t *)(0x50C6))
+#define CLK_SOURCE_HSE 0xB4
+
+// Option byte that configures a flash wait state, needed above 16 MHz.
+#define OPT7 (*(volatile uint8_t *)(0x480D))
+#define OPT7_WAITSTATE 0
 
 // PC5 is connected to the built-in LED on the STM8S208 Nucleo-64 board.
 // Toggling this pin is used for benchmarking.
@@ -48,6 +65,59 @@
 #define PC_CR1 (*(volatile uint8_t *)(0x500D))
 #define PC_CR1_C15 5
 
+// A timer is used as a free-running counter of CPU cycles in corpus mode and
+// for benchmarks, with its update (overflow) interrupt extending the count to
+// 32 bits. This is TIM2 unless CYCLES_TIM is defined as 1 or 3 (e.g.
+// -DCYCLES_TIM=3), to use TIM1 or TIM3 instead where TIM2 is not available.
+// Register addresses are those of the STM8S208 and similar devices.
+#ifndef CYCLES_TIM
+#define CYCLES_TIM 2
+#endif
+
+#if CYCLES_TIM == 1
+#define CYCLES_TIM_CR1 (*(volatile uint8_t *)(0x5250))
+#define CYCLES_TIM_IER (*(volatile uint8_t *)(0x5254))
+#define CYCLES_TIM_SR1 (*(volatile uint8_t *)(0x5255))
+#define CYCLES_TIM_EGR (*(volatile uint8_t *)(0x5257))
+#define CYCLES_TIM_CNTRH (*(volatile uint8_t *)(0x525E))
+#define CYCLES_TIM_CNTRL (*(volatile uint8_t *)(0x525F))
+#define CYCLES_TIM_PSCRH (*(volatile uint8_t *)(0x5260))
+#define CYCLES_TIM_PSCR (*(volatile uint8_t *)(0x5261))
+#define CYCLES_TIM_ARRH (*(volatile uint8_t *)(0x5262))
+#define CYCLES_TIM_ARRL (*(volatile uint8_t *)(0x5263))
+#define CYCLES_TIM_OVF_IRQ 11
+#elif CYCLES_TIM == 2
+#define CYCLES_TIM_CR1 (*(volatile uint8_t *)(0x5300))
+#define CYCLES_TIM_IER (*(volatile uint8_t *)(0x5303))
+#define CYCLES_TIM_SR1 (*(volatile uint8_t *)(0x5304))
+#define CYCLES_TIM_EGR (*(volatile uint8_t *)(0x5306))
+#define CYCLES_TIM_CNTRH (*(volatile uint8_t *)(0x530C))
+#define CYCLES_TIM_CNTRL (*(volatile uint8_t *)(0x530D))
+#define CYCLES_TIM_PSCR (*(volatile uint8_t *)(0x530E))
+#define CYCLES_TIM_ARRH (*(volatile uint8_t *)(0x530F))
+#define CYCLES_TIM_ARRL (*(volatile uint8_t *)(0x5310))
+#define CYCLES_TIM_OVF_IRQ 13
+#elif CYCLES_TIM == 3
+#define CYCLES_TIM_CR1 (*(volatile uint8_t *)(0x5320))
+#define CYCLES_TIM_IER (*(volatile uint8_t *)(0x5321))
+#define CYCLES_TIM_SR1 (*(volatile uint8_t *)(0x5322))
+#define CYCLES_TIM_EGR (*(volatile uint8_t *)(0x5324))
+#define CYCLES_TIM_CNTRH (*(volatile uint8_t *)(0x5328))
+#define CYCLES_TIM_CNTRL (*(volatile uint8_t *)(0x5329))
+#define CYCLES_TIM_PSCR (*(volatile uint8_t *)(0x532A))
+#define CYCLES_TIM_ARRH (*(volatile uint8_t *)(0x532B))
+#define CYCLES_TIM_ARRL (*(volatile uint8_t *)(0x532C))
+#define CYCLES_TIM_OVF_IRQ 15
+#else
+#error "CYCLES_TIM must be 1, 2 or 3"
+#endif
+#define CYCLES_TIM_CR1_CEN 0
+#define CYCLES_TIM_IER_UIE 0
+#define CYCLES_TIM_SR1_UIF 0
+#define CYCLES_TIM_EGR_UG 0
+
+#define enable_interrupts() __asm__("rim")
+
 /******************************************************************************/
 
 typedef struct {
@@ -55,6 +125,33 @@ typedef struct {
 	uint16_t fail_count;
 } test_result_t;
 
+// Decoders selectable for each block in corpus mode.
+typedef enum {
+	CORPUS_DECODER_LZSA1 = 0x01,
+	CORPUS_DECODER_LZSA2 = 0x02,
+	CORPUS_DECODER_LZ4 = 0x03,
+	CORPUS_DECODER_ZX0 = 0x04,
+	CORPUS_DECODER_NATIVE = 0x05,
+	CORPUS_DECODER_LZSA1_REF = 0x11,
+	CORPUS_DECODER_LZSA2_REF = 0x12,
+	CORPUS_DECODER_LZ4_REF = 0x13,
+	CORPUS_DECODER_ZX0_REF = 0x14,
+	CORPUS_DECODER_NATIVE_REF = 0x15,
+	CORPUS_DECODER_LZSA1_FAST = 0x21,
+	CORPUS_DECODER_LZSA2_FAST = 0x22,
+	CORPUS_DECODER_LZSA1_RAM = 0x31,
+	CORPUS_DECODER_LZSA2_RAM = 0x32,
+	CORPUS_DECODER_LZSA1_SMALL = 0x41,
+	CORPUS_DECODER_LZSA2_SMALL = 0x42,
+} corpus_decoder_t;
+
+typedef enum {
+	CORPUS_STATUS_OK = 0,
+	CORPUS_STATUS_BAD_DECODER = 1,
+	CORPUS_STATUS_BAD_LENGTH = 2,
+	CORPUS_STATUS_OVERRUN = 3,
+} corpus_status_t;
+
 // Use ANSI terminal escape codes for highlighting text.
 static const char pass_str[] = "\x1B[1m\x1B[32mPASS\x1B[0m"; // Bold green
 static const char fail_str[] = "\x1B[1m\x1B[31mFAIL\x1B[0m"; // Bold red
@@ -73,16 +170,181 @@ static const char hrule_str[] = "----------------------------------------";
 
 #define benchmark_marker_start() do { PC_ODR |= (1 << PC_ODR_ODR5); } while(0)
 #define benchmark_marker_end() do { PC_ODR &= ~(1 << PC_ODR_ODR5); } while(0)
-#define benchmark(s, i, o) \
+// Run a benchmark for the given number of iterations, timing each with a timer,
+// then print statistics of the cycle counts (see benchmark_report()). PC5 is
+// also set for the duration, for timing with a logic analyser. The second form
+// takes the number of bytes output by each iteration, for cycles per byte.
+#define benchmark(s, i, o) benchmark_bytes(s, i, o, 0)
+#define benchmark_bytes(s, i, o, b) \
 	do { \
 		printf("%s: " s "\n", bench_str); \
-		uint16_t n = (i); \
+		uint16_t n = 0; \
 		benchmark_marker_start(); \
-		while(n--) (o); \
+		while(n < (i)) { \
+			cycles_start(); \
+			(o); \
+			benchmark_cycles[n++] = cycles_stop(); \
+		} \
 		benchmark_marker_end(); \
+		benchmark_report(n, (b)); \
 	} while(0)
 
-static uint8_t test_out[TESTS_DATA_PLAIN_MAX_LEN];
+// Maximum number of iterations of a benchmark, each of which is timed
+// separately.
+#define BENCHMARK_ITERATIONS_MAX 100
+
+// Row width and stride used for strided output tests. Output buffer must be
+// large enough to hold largest test data when laid out with these.
+#define TEST_STRIDED_WIDTH 13
+#define TEST_STRIDED_STRIDE 16
+#define TEST_OUT_LEN ((TESTS_DATA_PLAIN_MAX_LEN / TEST_STRIDED_WIDTH + 1) * TEST_STRIDED_STRIDE)
+
+// Maximum compressed and decompressed block sizes for corpus mode. When the
+// decompression routines are run from RAM, the space for their code is taken
+// from the output buffer.
+#define CORPUS_IN_MAX 1536
+#ifdef LZSA_RAM
+#define CORPUS_OUT_MAX 2560
+#else
+#define CORPUS_OUT_MAX 3584
+#endif
+
+// Number and size of slots for cache tests. Slots must be large enough to hold
+// the largest test item accessed through the cache.
+#define TEST_CACHE_SLOTS 4
+#define TEST_CACHE_SLOT_SIZE 576
+
+// Hash table size for compression tests (256 entries, taking 512 bytes), and
+// the small window tested alongside the full one.
+#define TEST_COMP_TABLE_BITS 8
+#define TEST_COMP_WINDOW_SMALL 256
+
+// Buffers for tests and corpus mode are never used at the same time, so share
+// the same memory.
+static union {
+	struct {
+		uint8_t out[TEST_OUT_LEN];
+		uint8_t expect[TESTS_DATA_PLAIN_MAX_LEN];
+		uint8_t lut[256];
+	} test;
+	struct {
+		uint8_t in[CORPUS_IN_MAX];
+		uint8_t out[CORPUS_OUT_MAX];
+	} corpus;
+	struct {
+		uint8_t arena[TEST_CACHE_SLOTS * TEST_CACHE_SLOT_SIZE];
+	} cache;
+	struct {
+		uint8_t out[LZSA1_COMPRESS_BOUND(TESTS_DATA_PLAIN_MAX_LEN)];
+		uint8_t check[TESTS_DATA_PLAIN_MAX_LEN];
+		const uint8_t *table[1 << TEST_COMP_TABLE_BITS];
+	} comp;
+} buffers;
+
+static const lzsa_filter_t test_filters[] = {
+	{ .type = LZSA_FILTER_DELTA8, .key = 0x00, .lut = NULL },
+	{ .type = LZSA_FILTER_DELTA16, .key = 0x00, .lut = NULL },
+	{ .type = LZSA_FILTER_XOR, .key = 0xA5, .lut = NULL },
+	{ .type = LZSA_FILTER_LUT, .key = 0x00, .lut = buffers.test.lut },
+};
+
+// Number of test items decompressed together for batch tests. Decompressed
+// data for this many items must fit in the output buffer.
+#define TEST_BATCH_COUNT 8
+
+static lzsa_batch_entry_t test_batch_entries[TEST_BATCH_COUNT];
+static void *test_batch_ends[TEST_BATCH_COUNT];
+
+static lzsa_cache_t cache;
+static lzsa_cache_slot_t test_cache_slots[TEST_CACHE_SLOTS];
+
+// Sequence of test items accessed for cache tests. With four slots, B is the
+// least-recently used when E is accessed (not A, which was accessed since), and
+// so on, giving 2 hits, 7 misses and 3 evictions.
+static const uint8_t test_cache_seq[] = { 0, 1, 2, 3, 0, 4, 1, 2, 0 }; // A B C D A E B C A
+#define TEST_CACHE_HITS 2
+#define TEST_CACHE_MISSES 7
+#define TEST_CACHE_EVICTIONS 3
+
+// Access pattern for cache benchmark, modelling e.g. a UI that redraws a few
+// common elements (items 0 and 1) far more often than the rest.
+static const uint8_t bench_cache_seq[] = {
+	0, 1, 0, 2, 0, 1, 3, 0, 1, 2, 4, 0, 1, 5, 0, 2,
+	1, 0, 6, 1, 0, 2, 3, 0, 1, 7, 0, 1, 2, 0, 4, 1,
+};
+
+// IDs of the entries in the test archive, with the test item each holds.
+// Absent IDs are looked up too, including either side of every present one.
+static const struct {
+	uint16_t id;
+	uint8_t item;
+} test_archive_entries[] = {
+	{ 0, 6 }, { 7, 0 }, { 42, 1 }, { 300, 2 }, { 301, 3 }, { 4096, 4 }, { 65535, 5 },
+};
+static const uint16_t test_archive_absent_ids[] = { 1, 6, 8, 41, 43, 299, 302, 4095, 4097, 65534 };
+
+// Overlays in the test overlay store. The first is position-independent code
+// that returns a constant; the rest hold test items. The overlay region must be
+// large enough for the largest (item 7).
+#define TEST_OVERLAY_COUNT 4
+#define TEST_OVERLAY_CODE 0
+#define TEST_OVERLAY_CODE_RESULT 0x1234
+static const struct {
+	uint8_t id;
+	uint8_t item;
+} test_overlay_items[] = {
+	{ 1, 0 }, { 2, 3 }, { 3, 6 },
+};
+
+// Delta patches from the complex item (item 11) as the old image to a new image
+// with 6 bytes inserted at offset 700, 2 bytes changed at 900 and 10 bytes
+// deleted at 1300 (offsets in the old image), in both formats. The new image is
+// built by make_patch_expect().
+#define TEST_PATCH_BLOCK_SIZE 512
+#define TEST_PATCH_NEW_LEN 1692
+static const uint8_t * const test_patches[] = { tests_patch_lzsa1, tests_patch_lzsa2 };
+
+// Items decompressed by the routines generated by lzsa_unroll: tests_unroll()
+// is straight-line code for the binary item (item 8, from its LZSA1 block), and
+// tests_unroll_fallback() calls lzsa2_decompress_block() for item 1.
+#define TEST_UNROLL_ITEM 7
+#define TEST_UNROLL_FALLBACK_ITEM 0
+
+// Settings for compression tests: the full table with the full and small
+// windows, and a half-size table.
+static const struct {
+	uint8_t table_bits;
+	uint16_t window;
+} test_comp_settings[] = {
+	{ TEST_COMP_TABLE_BITS, LZSA1_COMP_WINDOW_MAX },
+	{ TEST_COMP_TABLE_BITS, TEST_COMP_WINDOW_SMALL },
+	{ TEST_COMP_TABLE_BITS - 1, LZSA1_COMP_WINDOW_MAX },
+};
+
+// Strings from the test string table, with their expected text. These are the
+// first and last of the table, either side of a block boundary, and strings
+// from the same block in turn.
+static const struct {
+	uint16_t id;
+	const char *text;
+} test_strings[] = {
+	{ TEST_STR_MENU_MAIN, "Main Menu" },
+	{ TEST_STR_LBL_BACKLIGHT, "Backlight Timeout" },
+	{ TEST_STR_LBL_LANGUAGE, "Language" },
+	{ TEST_STR_MSG_SAVED, "Settings saved.\n" },
+	{ TEST_STR_MSG_RESTORED, "Default settings restored.\n" },
+	{ TEST_STR_MSG_CONFIRM, "Are you sure? Press OK to confirm or Back to cancel.\n" },
+	{ TEST_STR_LOG_WAKE, "[power] waking from low power mode\n" },
+	{ TEST_STR_MENU_MAIN, "Main Menu" },
+};
+
+static size_t capture_len;
+
+static const char * const filter_names[] = { "NONE", "DELTA8", "DELTA16", "XOR", "LUT" };
+
+static volatile uint16_t cycles_ovf_count;
+static uint16_t cycles_overhead;
+static uint32_t benchmark_cycles[BENCHMARK_ITERATIONS_MAX];
 
 /******************************************************************************/
 
@@ -116,6 +378,129 @@ static void print_hex_data(const uint8_t *data, const size_t len) {
 	}
 }
 
+// Straightforward forward implementation of each filter, independent of the
+// decompressor's implementation, used to produce expected test output.
+static void filter_data(uint8_t *dst, const uint8_t *src, const size_t len, const lzsa_filter_t *filter) {
+	uint8_t prev = 0;
+	uint16_t word = 0;
+
+	for(size_t i = 0; i < len; i++) {
+		switch(filter->type) {
+			case LZSA_FILTER_DELTA8:
+				dst[i] = prev = prev + src[i];
+				break;
+			case LZSA_FILTER_DELTA16:
+				if(i & 1) {
+					word += (src[i - 1] | ((uint16_t)src[i] << 8));
+					dst[i - 1] = word & 0xFF;
+					dst[i] = word >> 8;
+				} else {
+					dst[i] = (word & 0xFF) + src[i]; // Odd trailing byte
+				}
+				break;
+			case LZSA_FILTER_XOR:
+				dst[i] = src[i] ^ filter->key;
+				break;
+			case LZSA_FILTER_LUT:
+				dst[i] = filter->lut[src[i]];
+				break;
+			default:
+				dst[i] = src[i];
+				break;
+		}
+	}
+}
+
+// Check that the plain data is laid out in rows of given width and stride in
+// the given buffer, and that the gaps between rows have been left untouched
+// (i.e. still contain the fill value). The end pointer must point to where the
+// next byte would be written.
+static bool check_strided(const uint8_t *buf, const size_t buf_len, const uint8_t *end, const uint8_t *plain, const size_t len, const uint8_t width, const uint16_t stride, const uint8_t fill) {
+	size_t pos = 0;
+
+	for(size_t i = 0; i < buf_len; i++) {
+		if((i % stride) < width && pos < len) {
+			if(buf[i] != plain[pos++]) return false;
+			if(pos == len && end != &buf[i + 1 + ((pos % width) == 0 ? stride - width : 0)]) return false;
+		} else {
+			if(buf[i] != fill) return false;
+		}
+	}
+
+	return true;
+}
+
+// Compressed size as a percentage of plain size (i.e. lower is better).
+static unsigned int ratio_percent(const size_t comp_len, const size_t plain_len) {
+	return (unsigned int)(((uint32_t)comp_len * 100) / plain_len);
+}
+
+void cycles_tim_ovf_isr(void) __interrupt(CYCLES_TIM_OVF_IRQ) {
+	CYCLES_TIM_SR1 &= ~(1 << CYCLES_TIM_SR1_UIF);
+	cycles_ovf_count++;
+}
+
+static void cycles_start(void) {
+	CYCLES_TIM_CNTRH = 0;
+	CYCLES_TIM_CNTRL = 0;
+	cycles_ovf_count = 0;
+	CYCLES_TIM_CR1 = (1 << CYCLES_TIM_CR1_CEN);
+}
+
+static uint32_t cycles_stop(void) {
+	uint16_t count;
+
+	CYCLES_TIM_CR1 = 0;
+
+	// Reading high byte of counter latches the low byte. Any overflow that
+	// happened just before stopping the counter will have been serviced by the
+	// time the overflow count is read.
+	count = (uint16_t)CYCLES_TIM_CNTRH << 8;
+	count |= CYCLES_TIM_CNTRL;
+
+	return (((uint32_t)cycles_ovf_count << 16) | count) - cycles_overhead;
+}
+
+static void cycles_init(void) {
+#ifdef CYCLES_TIM_PSCRH
+	CYCLES_TIM_PSCRH = 0;
+#endif
+	CYCLES_TIM_PSCR = 0; // Count at fMASTER
+	CYCLES_TIM_ARRH = 0xFF;
+	CYCLES_TIM_ARRL = 0xFF;
+	CYCLES_TIM_EGR = (1 << CYCLES_TIM_EGR_UG); // Load prescaler
+	CYCLES_TIM_SR1 = 0;
+	CYCLES_TIM_IER = (1 << CYCLES_TIM_IER_UIE);
+	enable_interrupts();
+
+	// Measure the cost of starting and stopping the count, which is then
+	// subtracted from every count.
+	cycles_overhead = 0;
+	cycles_start();
+	cycles_overhead = cycles_stop();
+}
+
+// Sort the cycle counts of a benchmark's iterations, then print the minimum,
+// median and maximum. When the number of bytes output by each iteration is
+// given, also print the median cycles per byte, to two decimal places.
+static void benchmark_report(const uint16_t count, const size_t out_len) {
+	uint32_t c, per_byte;
+	uint16_t i, j;
+
+	for(i = 1; i < count; i++) {
+		c = benchmark_cycles[i];
+		for(j = i; j > 0 && benchmark_cycles[j - 1] > c; j--) benchmark_cycles[j] = benchmark_cycles[j - 1];
+		benchmark_cycles[j] = c;
+	}
+
+	printf("cycles: min = %lu, median = %lu, max = %lu", benchmark_cycles[0], benchmark_cycles[count / 2], benchmark_cycles[count - 1]);
+	if(out_len > 0) {
+		per_byte = (benchmark_cycles[count / 2] * 100) / out_len;
+		printf(", per byte = %lu.%02lu", per_byte / 100, per_byte % 100);
+	}
+	putchar('\n');
+}
+
 static void test_lzsa1(test_result_t *result) {
 	ptrdiff_t out_len;
 	bool pass;
@@ -123,20 +508,29 @@ static void test_lzsa1(test_result_t *result) {
 	for(size_t i = 0; i < TESTS_COUNT; i++) {
 		printf("%s %02u:\n", test_str, i + 1);
 
-		memset(test_out, '\0', sizeof(test_out));
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
 		puts("lzsa1_decompress_block_ref()");
-		out_len = lzsa1_decompress_block_ref(test_out, tests[i].lzsa1.data) - test_out;
-		pass = (memcmp(test_out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
-		print_hex_data(test_out, out_len);
+		out_len = lzsa1_decompress_block_ref(buffers.test.out, tests[i].lzsa1.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
 		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
 		puts(pass ? pass_str : fail_str);
 		count_test_result(pass, result);
 
-		memset(test_out, '\0', sizeof(test_out));
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa1_decompress_block_fast()");
+		out_len = lzsa1_decompress_block_fast(buffers.test.out, tests[i].lzsa1.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
 		puts("lzsa1_decompress_block()");
-		out_len = lzsa1_decompress_block(test_out, tests[i].lzsa1.data) - test_out;
-		pass = (memcmp(test_out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
-		print_hex_data(test_out, out_len);
+		out_len = lzsa1_decompress_block(buffers.test.out, tests[i].lzsa1.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
 		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
 		puts(pass ? pass_str : fail_str);
 		count_test_result(pass, result);
@@ -150,40 +544,1145 @@ static void test_lzsa2(test_result_t *result) {
 	for(size_t i = 0; i < TESTS_COUNT; i++) {
 		printf("%s %02u:\n", test_str, i + 1);
 
-		memset(test_out, '\0', sizeof(test_out));
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
 		puts("lzsa2_decompress_block_ref()");
-		out_len = lzsa2_decompress_block_ref(test_out, tests[i].lzsa2.data) - test_out;
-		pass = (memcmp(test_out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
-		print_hex_data(test_out, out_len);
+		out_len = lzsa2_decompress_block_ref(buffers.test.out, tests[i].lzsa2.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
 		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
 		puts(pass ? pass_str : fail_str);
 		count_test_result(pass, result);
 
-		memset(test_out, '\0', sizeof(test_out));
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa2_decompress_block_fast()");
+		out_len = lzsa2_decompress_block_fast(buffers.test.out, tests[i].lzsa2.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
 		puts("lzsa2_decompress_block()");
-		out_len = lzsa2_decompress_block(test_out, tests[i].lzsa2.data) - test_out;
-		pass = (memcmp(test_out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
-		print_hex_data(test_out, out_len);
+		out_len = lzsa2_decompress_block(buffers.test.out, tests[i].lzsa2.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
 		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
 		puts(pass ? pass_str : fail_str);
 		count_test_result(pass, result);
 	}
 }
 
+static void test_lz4(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u:\n", test_str, i + 1);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lz4_decompress_block_ref()");
+		out_len = lz4_decompress_block_ref(buffers.test.out, tests[i].lz4.data, tests[i].lz4.length) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lz4_decompress_block()");
+		out_len = lz4_decompress_block(buffers.test.out, tests[i].lz4.data, tests[i].lz4.length) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+static void test_zx0(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u:\n", test_str, i + 1);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("zx0_decompress_block_ref()");
+		out_len = zx0_decompress_block_ref(buffers.test.out, tests[i].zx0.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("zx0_decompress_block()");
+		out_len = zx0_decompress_block(buffers.test.out, tests[i].zx0.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+static void test_native(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u:\n", test_str, i + 1);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa_native_decompress_block_ref()");
+		out_len = lzsa_native_decompress_block_ref(buffers.test.out, tests[i].native.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa_native_decompress_block()");
+		out_len = lzsa_native_decompress_block(buffers.test.out, tests[i].native.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+static void test_lzsa2_filter(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	// Arbitrary byte permutation for LUT tests.
+	for(size_t i = 0; i < sizeof(buffers.test.lut); i++) buffers.test.lut[i] = (uint8_t)(i * 167 + 13);
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		for(size_t f = 0; f < (sizeof(test_filters) / sizeof(test_filters[0])); f++) {
+			printf("%s %02u (%s):\n", test_str, i + 1, filter_names[test_filters[f].type]);
+
+			filter_data(buffers.test.expect, tests[i].plain.data, tests[i].plain.length, &test_filters[f]);
+
+			memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+			puts("lzsa2_decompress_block_filter_ref()");
+			out_len = lzsa2_decompress_block_filter_ref(buffers.test.out, tests[i].lzsa2.data, &test_filters[f]) - buffers.test.out;
+			pass = (memcmp(buffers.test.out, buffers.test.expect, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+			printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+
+			memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+			puts("lzsa2_decompress_block_filter()");
+			out_len = lzsa2_decompress_block_filter(buffers.test.out, tests[i].lzsa2.data, &test_filters[f]) - buffers.test.out;
+			pass = (memcmp(buffers.test.out, buffers.test.expect, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+			printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+		}
+	}
+}
+
+static void test_strided(test_result_t *result) {
+	const uint8_t fill = 0xAA;
+	uint8_t *end;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u (strided, width = %u, stride = %u):\n", test_str, i + 1, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE);
+
+		memset(buffers.test.out, fill, sizeof(buffers.test.out));
+		puts("lzsa1_decompress_block_strided_ref()");
+		end = lzsa1_decompress_block_strided_ref(buffers.test.out, tests[i].lzsa1.data, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE);
+		pass = check_strided(buffers.test.out, sizeof(buffers.test.out), end, tests[i].plain.data, tests[i].plain.length, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE, fill);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, fill, sizeof(buffers.test.out));
+		puts("lzsa1_decompress_block_strided()");
+		end = lzsa1_decompress_block_strided(buffers.test.out, tests[i].lzsa1.data, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE);
+		pass = check_strided(buffers.test.out, sizeof(buffers.test.out), end, tests[i].plain.data, tests[i].plain.length, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE, fill);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, fill, sizeof(buffers.test.out));
+		puts("lzsa2_decompress_block_strided_ref()");
+		end = lzsa2_decompress_block_strided_ref(buffers.test.out, tests[i].lzsa2.data, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE);
+		pass = check_strided(buffers.test.out, sizeof(buffers.test.out), end, tests[i].plain.data, tests[i].plain.length, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE, fill);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, fill, sizeof(buffers.test.out));
+		puts("lzsa2_decompress_block_strided()");
+		end = lzsa2_decompress_block_strided(buffers.test.out, tests[i].lzsa2.data, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE);
+		pass = check_strided(buffers.test.out, sizeof(buffers.test.out), end, tests[i].plain.data, tests[i].plain.length, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE, fill);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+// Check the result of a decompress-and-compare call against the expected offset
+// of the first difference (or the length of the data, if there is none).
+static bool check_compare(const uint16_t offset, const uint16_t expect) {
+	printf("expect = %u, offset = %u\n", expect, offset);
+	return (offset == expect);
+}
+
+// Compare each item's compressed data against its plain data, both as given (in
+// flash) and with one byte altered (in RAM), at a different position for each
+// item.
+static void test_compare_block(test_result_t *result) {
+	uint16_t pos;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		pos = (uint16_t)((i * 97) % tests[i].plain.length);
+		memcpy(buffers.test.out, tests[i].plain.data, tests[i].plain.length);
+		buffers.test.out[pos] ^= 0x5A;
+
+		printf("%s %02u (compare, mismatch at %u):\n", test_str, i + 1, pos);
+
+		puts("lzsa1_compare_block_ref()");
+		pass = check_compare(lzsa1_compare_block_ref(tests[i].plain.data, tests[i].lzsa1.data), tests[i].plain.length);
+		pass = check_compare(lzsa1_compare_block_ref(buffers.test.out, tests[i].lzsa1.data), pos) && pass;
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		puts("lzsa1_compare_block()");
+		pass = check_compare(lzsa1_compare_block(tests[i].plain.data, tests[i].lzsa1.data), tests[i].plain.length);
+		pass = check_compare(lzsa1_compare_block(buffers.test.out, tests[i].lzsa1.data), pos) && pass;
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		puts("lzsa2_compare_block_ref()");
+		pass = check_compare(lzsa2_compare_block_ref(tests[i].plain.data, tests[i].lzsa2.data), tests[i].plain.length);
+		pass = check_compare(lzsa2_compare_block_ref(buffers.test.out, tests[i].lzsa2.data), pos) && pass;
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		puts("lzsa2_compare_block()");
+		pass = check_compare(lzsa2_compare_block(tests[i].plain.data, tests[i].lzsa2.data), tests[i].plain.length);
+		pass = check_compare(lzsa2_compare_block(buffers.test.out, tests[i].lzsa2.data), pos) && pass;
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+static void setup_batch(const bool lzsa2) {
+	uint8_t *dst = buffers.test.out;
+
+	for(size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+		test_batch_entries[i].src = (lzsa2 ? tests[i].lzsa2.data : tests[i].lzsa1.data);
+		test_batch_entries[i].dst = dst;
+		dst += tests[i].plain.length;
+	}
+
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	memset(test_batch_ends, 0, sizeof(test_batch_ends));
+}
+
+static bool check_batch(const uint8_t *end, const bool check_ends) {
+	bool pass = true;
+
+	for(size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+		const uint8_t *dst = test_batch_entries[i].dst;
+		if(memcmp(dst, tests[i].plain.data, tests[i].plain.length) != 0) pass = false;
+		if(check_ends && test_batch_ends[i] != dst + tests[i].plain.length) pass = false;
+	}
+	printf("end = %p, expected = %p\n", end, (uint8_t *)test_batch_entries[TEST_BATCH_COUNT - 1].dst + tests[TEST_BATCH_COUNT - 1].plain.length);
+	if(end != (uint8_t *)test_batch_entries[TEST_BATCH_COUNT - 1].dst + tests[TEST_BATCH_COUNT - 1].plain.length) pass = false;
+
+	return pass;
+}
+
+// Only items short enough are tested with the short-block routines. When the
+// test program is built with LZSA_DEBUG defined, for use with libraries built
+// with LZSA_DEBUG set, the routines must reject the other items.
+static void test_small(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u (small):\n", test_str, i + 1);
+
+		if(tests[i].plain.length > LZSA_SMALL_PLAIN_MAX) {
+#ifdef LZSA_DEBUG
+			puts("lzsa1_decompress_small() (rejected)");
+			pass = (lzsa1_decompress_small(buffers.test.out, tests[i].lzsa1.data) == NULL);
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+
+			puts("lzsa2_decompress_small() (rejected)");
+			pass = (lzsa2_decompress_small(buffers.test.out, tests[i].lzsa2.data) == NULL);
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+#else
+			puts("Skipped, too long");
+#endif
+			continue;
+		}
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa1_decompress_small()");
+		out_len = lzsa1_decompress_small(buffers.test.out, tests[i].lzsa1.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa2_decompress_small()");
+		out_len = lzsa2_decompress_small(buffers.test.out, tests[i].lzsa2.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+static void test_batch(test_result_t *result) {
+	uint8_t *end;
+	bool pass;
+
+	printf("%s (batch, count = %u):\n", test_str, TEST_BATCH_COUNT);
+
+	setup_batch(false);
+	puts("lzsa1_decompress_batch_ref()");
+	end = lzsa1_decompress_batch_ref(test_batch_entries, TEST_BATCH_COUNT, test_batch_ends);
+	pass = check_batch(end, true);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	setup_batch(false);
+	puts("lzsa1_decompress_batch()");
+	end = lzsa1_decompress_batch(test_batch_entries, TEST_BATCH_COUNT, test_batch_ends);
+	pass = check_batch(end, true);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	setup_batch(false);
+	puts("lzsa1_decompress_batch() (no ends)");
+	end = lzsa1_decompress_batch(test_batch_entries, TEST_BATCH_COUNT, NULL);
+	pass = check_batch(end, false);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	setup_batch(true);
+	puts("lzsa2_decompress_batch_ref()");
+	end = lzsa2_decompress_batch_ref(test_batch_entries, TEST_BATCH_COUNT, test_batch_ends);
+	pass = check_batch(end, true);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	setup_batch(true);
+	puts("lzsa2_decompress_batch()");
+	end = lzsa2_decompress_batch(test_batch_entries, TEST_BATCH_COUNT, test_batch_ends);
+	pass = check_batch(end, true);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	setup_batch(true);
+	puts("lzsa2_decompress_batch() (no ends)");
+	end = lzsa2_decompress_batch(test_batch_entries, TEST_BATCH_COUNT, NULL);
+	pass = check_batch(end, false);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	printf("%s (batch, count = 0):\n", test_str);
+
+	puts("lzsa1_decompress_batch()");
+	pass = (lzsa1_decompress_batch(test_batch_entries, 0, test_batch_ends) == NULL);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa2_decompress_batch()");
+	pass = (lzsa2_decompress_batch(test_batch_entries, 0, test_batch_ends) == NULL);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+static bool check_cache_get(const uint8_t *data, const uint16_t len, const size_t item) {
+	return (data != NULL && len == tests[item].plain.length && memcmp(data, tests[item].plain.data, len) == 0);
+}
+
+static void test_cache_format(test_result_t *result, const uint8_t format) {
+	const uint8_t *data, *first = NULL;
+	uint16_t len;
+	bool pass;
+
+	lzsa_cache_init(&cache, test_cache_slots, TEST_CACHE_SLOTS, buffers.cache.arena, TEST_CACHE_SLOT_SIZE);
+	memset(buffers.cache.arena, '\0', sizeof(buffers.cache.arena));
+
+	for(size_t i = 0; i < sizeof(test_cache_seq); i++) {
+		const size_t item = test_cache_seq[i];
+		const void *src = (format == LZSA_CACHE_FORMAT_LZSA1 ? tests[item].lzsa1.data : tests[item].lzsa2.data);
+		printf("lzsa_cache_get() (LZSA%u, item %02u)\n", format, item + 1);
+		data = lzsa_cache_get(&cache, src, format, &len);
+		pass = check_cache_get(data, len, item);
+		// A hit on the first item must return the same data it was first
+		// decompressed to.
+		if(item == 0) {
+			if(first == NULL) first = data;
+			if(data != first) pass = false;
+		}
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+
+	puts("lzsa_cache_t counters");
+	printf("hits = %u, misses = %u, evictions = %u\n", cache.hits, cache.misses, cache.evictions);
+	pass = (cache.hits == TEST_CACHE_HITS && cache.misses == TEST_CACHE_MISSES && cache.evictions == TEST_CACHE_EVICTIONS);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	// After flushing, a previously cached item must be a miss, and filling an
+	// empty slot must not count as an eviction.
+	lzsa_cache_flush(&cache);
+	puts("lzsa_cache_flush()");
+	data = lzsa_cache_get(&cache, (format == LZSA_CACHE_FORMAT_LZSA1 ? tests[0].lzsa1.data : tests[0].lzsa2.data), format, NULL);
+	pass = check_cache_get(data, tests[0].plain.length, 0) && cache.misses == TEST_CACHE_MISSES + 1 && cache.evictions == TEST_CACHE_EVICTIONS;
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	// A NULL source must not match one of the remaining empty slots.
+	puts("lzsa_cache_get() (NULL)");
+	data = lzsa_cache_get(&cache, NULL, format, &len);
+	pass = (data == NULL && cache.hits == TEST_CACHE_HITS && cache.misses == TEST_CACHE_MISSES + 1);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+static void test_cache(test_result_t *result) {
+	printf("%s (cache, slots = %u, slot size = %u):\n", test_str, TEST_CACHE_SLOTS, TEST_CACHE_SLOT_SIZE);
+	test_cache_format(result, LZSA_CACHE_FORMAT_LZSA1);
+	test_cache_format(result, LZSA_CACHE_FORMAT_LZSA2);
+}
+
+static void test_archive(test_result_t *result) {
+	lzsa_archive_t archive;
+	lzsa_archive_far_t far_archive;
+	uint8_t *end;
+	uint16_t len;
+	bool pass;
+
+	printf("%s (archive):\n", test_str);
+
+	puts("lzsa_archive_open()");
+	pass = lzsa_archive_open(&archive, tests_archive) && archive.count == (sizeof(test_archive_entries) / sizeof(test_archive_entries[0]));
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	for(size_t i = 0; i < (sizeof(test_archive_entries) / sizeof(test_archive_entries[0])); i++) {
+		const size_t item = test_archive_entries[i].item;
+		printf("lzsa_archive_get() (id = %u)\n", test_archive_entries[i].id);
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		len = lzsa_archive_length(&archive, test_archive_entries[i].id);
+		end = lzsa_archive_get(&archive, test_archive_entries[i].id, buffers.test.out);
+		pass = (end != NULL && len == tests[item].plain.length && end == buffers.test.out + len && memcmp(buffers.test.out, tests[item].plain.data, len) == 0);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+
+	puts("lzsa_archive_get() (absent IDs)");
+	pass = true;
+	for(size_t i = 0; i < (sizeof(test_archive_absent_ids) / sizeof(test_archive_absent_ids[0])); i++) {
+		if(lzsa_archive_length(&archive, test_archive_absent_ids[i]) != 0) pass = false;
+		if(lzsa_archive_get(&archive, test_archive_absent_ids[i], buffers.test.out) != NULL) pass = false;
+	}
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa_archive_open() (bad header)");
+	pass = !lzsa_archive_open(&archive, tests[0].plain.data);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	// The test archive is in the 16-bit address space, but the far functions
+	// read it with far loads all the same.
+	puts("lzsa_archive_open_far()");
+	pass = lzsa_archive_open_far(&far_archive, (uintptr_t)tests_archive, buffers.test.expect, sizeof(buffers.test.expect)) && far_archive.count == archive.count;
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	for(size_t i = 0; i < (sizeof(test_archive_entries) / sizeof(test_archive_entries[0])); i++) {
+		const size_t item = test_archive_entries[i].item;
+		printf("lzsa_archive_get_far() (id = %u)\n", test_archive_entries[i].id);
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		len = lzsa_archive_length_far(&far_archive, test_archive_entries[i].id);
+		end = lzsa_archive_get_far(&far_archive, test_archive_entries[i].id, buffers.test.out);
+		pass = (end != NULL && len == tests[item].plain.length && end == buffers.test.out + len && memcmp(buffers.test.out, tests[item].plain.data, len) == 0);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+
+	puts("lzsa_archive_get_far() (absent IDs)");
+	pass = true;
+	for(size_t i = 0; i < (sizeof(test_archive_absent_ids) / sizeof(test_archive_absent_ids[0])); i++) {
+		if(lzsa_archive_length_far(&far_archive, test_archive_absent_ids[i]) != 0) pass = false;
+		if(lzsa_archive_get_far(&far_archive, test_archive_absent_ids[i], buffers.test.out) != NULL) pass = false;
+	}
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	// Entry 301 (test item 3 in LZSA2) has the smallest compressed data, so a
+	// buffer one byte too small for it is too small for every entry.
+	puts("lzsa_archive_get_far() (buffer too small)");
+	pass = lzsa_archive_open_far(&far_archive, (uintptr_t)tests_archive, buffers.test.expect, tests[3].lzsa2.length - 1);
+	for(size_t i = 0; i < (sizeof(test_archive_entries) / sizeof(test_archive_entries[0])); i++) {
+		if(lzsa_archive_get_far(&far_archive, test_archive_entries[i].id, buffers.test.out) != NULL) pass = false;
+	}
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa_archive_open_far() (bad header)");
+	pass = !lzsa_archive_open_far(&far_archive, (uintptr_t)tests[0].plain.data, buffers.test.expect, sizeof(buffers.test.expect));
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+static void test_overlay(test_result_t *result) {
+	lzsa_overlays_t overlays;
+	uint8_t *entry;
+	uint16_t loads;
+	bool pass;
+
+	printf("%s (overlay, region size = %u):\n", test_str, sizeof(buffers.test.out));
+
+	puts("lzsa_overlay_init()");
+	pass = lzsa_overlay_init(&overlays, tests_overlay, buffers.test.out, sizeof(buffers.test.out)) && overlays.count == TEST_OVERLAY_COUNT;
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	for(size_t i = 0; i < (sizeof(test_overlay_items) / sizeof(test_overlay_items[0])); i++) {
+		const size_t item = test_overlay_items[i].item;
+		printf("lzsa_overlay_load() (id = %u)\n", test_overlay_items[i].id);
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		loads = overlays.loads;
+		entry = lzsa_overlay_load(&overlays, test_overlay_items[i].id);
+		pass = (entry == buffers.test.out && overlays.resident == test_overlay_items[i].id && overlays.loads == loads + 1 && memcmp(buffers.test.out, tests[item].plain.data, tests[item].plain.length) == 0);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+
+	// Loading the resident overlay again must not decompress it, so a change
+	// made to the region must survive. After evicting, it must be decompressed.
+	puts("lzsa_overlay_load() (resident)");
+	buffers.test.out[0] ^= 0xFF;
+	loads = overlays.loads;
+	entry = lzsa_overlay_load(&overlays, test_overlay_items[2].id);
+	pass = (entry == buffers.test.out && overlays.loads == loads && buffers.test.out[0] == (tests[6].plain.data[0] ^ 0xFF));
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa_overlay_evict()");
+	lzsa_overlay_evict(&overlays);
+	entry = lzsa_overlay_load(&overlays, test_overlay_items[2].id);
+	pass = (entry == buffers.test.out && overlays.loads == loads + 1 && buffers.test.out[0] == tests[6].plain.data[0]);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa_overlay_load() (code)");
+	entry = lzsa_overlay_load(&overlays, TEST_OVERLAY_CODE);
+	pass = (entry != NULL && ((uint16_t (*)(void))entry)() == TEST_OVERLAY_CODE_RESULT);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa_overlay_load() (id = count)");
+	pass = (lzsa_overlay_load(&overlays, TEST_OVERLAY_COUNT) == NULL && overlays.resident == TEST_OVERLAY_CODE);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa_overlay_init() (region too small, bad header)");
+	pass = !lzsa_overlay_init(&overlays, tests_overlay, buffers.test.out, tests[6].plain.length - 1) && !lzsa_overlay_init(&overlays, tests[0].plain.data, buffers.test.out, sizeof(buffers.test.out));
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+// Build the new image for patch tests in the expected output buffer, from the
+// old image with the changes given above.
+static void make_patch_expect(void) {
+	const uint8_t *old = tests[10].plain.data;
+	uint8_t *p = buffers.test.expect;
+
+	memcpy(p, old, 700);
+	memcpy(p + 700, "PATCH!", 6);
+	memcpy(p + 706, old + 700, 200);
+	p[906] = 0x5A;
+	p[907] = 0xA5;
+	memcpy(p + 908, old + 902, 398);
+	memcpy(p + 1306, old + 1310, tests[10].plain.length - 1310);
+}
+
+// Apply a patch to the given old image, decompressing each block of the new
+// image straight to its place in the output buffer (standing in for a second
+// firmware slot). Returns the result of verifying the new image.
+static bool apply_patch(const uint8_t *data, const uint8_t *old, const size_t old_len) {
+	lzsa_patch_t patch;
+	uint32_t offset;
+
+	if(!lzsa_patch_init(&patch, data, (uintptr_t)old, old_len)) return false;
+
+	do {
+		offset = patch.done;
+	} while(lzsa_patch_next(&patch, buffers.test.out + offset) > 0 && patch.offset == offset);
+
+	return lzsa_patch_verify(&patch);
+}
+
+static void test_patch(test_result_t *result) {
+	const uint8_t *old_end = tests[10].plain.data + tests[10].plain.length;
+	const uint8_t *block;
+	lzsa_patch_t patch;
+	uint8_t *end;
+	bool pass;
+
+	make_patch_expect();
+
+	printf("%s (patch, %u-byte blocks):\n", test_str, TEST_PATCH_BLOCK_SIZE);
+
+	// The first block of each patch has the whole of the old image as its
+	// dictionary, so can be decompressed by itself.
+	puts("lzsa1_decompress_block_dict_ref()");
+	block = tests_patch_lzsa1 + LZSA_PATCH_HEADER_LEN + LZSA_PATCH_RECORD_LEN;
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	end = lzsa1_decompress_block_dict_ref(buffers.test.out, block, old_end);
+	pass = (end == buffers.test.out + TEST_PATCH_BLOCK_SIZE && memcmp(buffers.test.out, buffers.test.expect, TEST_PATCH_BLOCK_SIZE) == 0);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa1_decompress_block_dict()");
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	end = lzsa1_decompress_block_dict(buffers.test.out, block, (uintptr_t)old_end);
+	pass = (end == buffers.test.out + TEST_PATCH_BLOCK_SIZE && memcmp(buffers.test.out, buffers.test.expect, TEST_PATCH_BLOCK_SIZE) == 0);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa2_decompress_block_dict_ref()");
+	block = tests_patch_lzsa2 + LZSA_PATCH_HEADER_LEN + LZSA_PATCH_RECORD_LEN;
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	end = lzsa2_decompress_block_dict_ref(buffers.test.out, block, old_end);
+	pass = (end == buffers.test.out + TEST_PATCH_BLOCK_SIZE && memcmp(buffers.test.out, buffers.test.expect, TEST_PATCH_BLOCK_SIZE) == 0);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	puts("lzsa2_decompress_block_dict()");
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	end = lzsa2_decompress_block_dict(buffers.test.out, block, (uintptr_t)old_end);
+	pass = (end == buffers.test.out + TEST_PATCH_BLOCK_SIZE && memcmp(buffers.test.out, buffers.test.expect, TEST_PATCH_BLOCK_SIZE) == 0);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	for(size_t i = 0; i < (sizeof(test_patches) / sizeof(test_patches[0])); i++) {
+		printf("lzsa_patch_next() (LZSA%u)\n", i + 1);
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		pass = (apply_patch(test_patches[i], tests[10].plain.data, tests[10].plain.length) && memcmp(buffers.test.out, buffers.test.expect, TEST_PATCH_NEW_LEN) == 0);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+
+	puts("lzsa_patch_init() (wrong old length, bad header)");
+	pass = !lzsa_patch_init(&patch, tests_patch_lzsa1, (uintptr_t)tests[10].plain.data, tests[10].plain.length - 1) && !lzsa_patch_init(&patch, tests[0].plain.data, (uintptr_t)tests[10].plain.data, tests[10].plain.length);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	// Applying a patch to an old image other than the one it was made from must
+	// fail verification. Use a copy of the old image with one byte altered.
+	puts("lzsa_patch_verify() (altered old image)");
+	memcpy(buffers.test.expect, tests[10].plain.data, tests[10].plain.length);
+	buffers.test.expect[100] ^= 0xFF;
+	pass = !apply_patch(tests_patch_lzsa2, buffers.test.expect, tests[10].plain.length);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+static void test_unroll(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	printf("%s %02u:\n", test_str, TEST_UNROLL_ITEM + 1);
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	puts("tests_unroll()");
+	out_len = tests_unroll(buffers.test.out) - buffers.test.out;
+	pass = (memcmp(buffers.test.out, tests[TEST_UNROLL_ITEM].plain.data, tests[TEST_UNROLL_ITEM].plain.length) == 0 && out_len == tests[TEST_UNROLL_ITEM].plain.length);
+	print_hex_data(buffers.test.out, out_len);
+	printf("plain_len = %u, out_len = %td\n", tests[TEST_UNROLL_ITEM].plain.length, out_len);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+
+	printf("%s %02u:\n", test_str, TEST_UNROLL_FALLBACK_ITEM + 1);
+	memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+	puts("tests_unroll_fallback()");
+	out_len = tests_unroll_fallback(buffers.test.out) - buffers.test.out;
+	pass = (memcmp(buffers.test.out, tests[TEST_UNROLL_FALLBACK_ITEM].plain.data, tests[TEST_UNROLL_FALLBACK_ITEM].plain.length) == 0 && out_len == tests[TEST_UNROLL_FALLBACK_ITEM].plain.length);
+	print_hex_data(buffers.test.out, out_len);
+	printf("plain_len = %u, out_len = %td\n", tests[TEST_UNROLL_FALLBACK_ITEM].plain.length, out_len);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+// Compress each item with each of the test settings, checking the output is
+// within the bound and decompresses back to the original with both the
+// reference and assembly routines.
+static void test_compress(test_result_t *result) {
+	lzsa1_comp_t comp;
+	ptrdiff_t comp_len, out_len;
+	bool pass;
+
+	comp.table = buffers.comp.table;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		for(size_t j = 0; j < (sizeof(test_comp_settings) / sizeof(test_comp_settings[0])); j++) {
+			comp.table_bits = test_comp_settings[j].table_bits;
+			comp.window = test_comp_settings[j].window;
+			printf("%s %02u (compress, table_bits = %u, window = %u):\n", test_str, i + 1, comp.table_bits, comp.window);
+
+			puts("lzsa1_compress_block()");
+			comp_len = (uint8_t *)lzsa1_compress_block(buffers.comp.out, tests[i].plain.data, tests[i].plain.length, &comp) - buffers.comp.out;
+			pass = (comp_len > 0 && comp_len <= LZSA1_COMPRESS_BOUND(tests[i].plain.length));
+			printf("plain_len = %u, comp_len = %td (%u%%)\n", tests[i].plain.length, comp_len, ratio_percent(comp_len, tests[i].plain.length));
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+
+			memset(buffers.comp.check, '\0', sizeof(buffers.comp.check));
+			puts("lzsa1_decompress_block_ref()");
+			out_len = lzsa1_decompress_block_ref(buffers.comp.check, buffers.comp.out) - buffers.comp.check;
+			pass = (memcmp(buffers.comp.check, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+
+			memset(buffers.comp.check, '\0', sizeof(buffers.comp.check));
+			puts("lzsa1_decompress_block()");
+			out_len = lzsa1_decompress_block(buffers.comp.check, buffers.comp.out) - buffers.comp.check;
+			pass = (memcmp(buffers.comp.check, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+			puts(pass ? pass_str : fail_str);
+			count_test_result(pass, result);
+		}
+	}
+}
+
+// Output hooks for capturing printed strings into the test output buffer, or
+// discarding them.
+static int capture_putchar(int c) {
+	if(capture_len < sizeof(buffers.test.out)) buffers.test.out[capture_len++] = (uint8_t)c;
+	return c;
+}
+
+static int discard_putchar(int c) {
+	return c;
+}
+
+static void test_str_print(test_result_t *result) {
+	uart_putchar_func_t console_putchar;
+	bool pass, ok;
+
+	printf("%s (string table, count = %u):\n", test_str, TESTS_STRINGS_COUNT);
+
+	for(size_t i = 0; i < (sizeof(test_strings) / sizeof(test_strings[0])); i++) {
+		printf("lzsa_str_print() (id = %u)\n", test_strings[i].id);
+		capture_len = 0;
+		console_putchar = uart_set_putchar(capture_putchar);
+		ok = lzsa_str_print(&tests_strings, test_strings[i].id);
+		uart_set_putchar(console_putchar);
+		pass = (ok && capture_len == strlen(test_strings[i].text) && memcmp(buffers.test.out, test_strings[i].text, capture_len) == 0);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+
+	puts("lzsa_str_print() (id = count)");
+	capture_len = 0;
+	console_putchar = uart_set_putchar(capture_putchar);
+	ok = lzsa_str_print(&tests_strings, TESTS_STRINGS_COUNT);
+	uart_set_putchar(console_putchar);
+	pass = (!ok && capture_len == 0);
+	puts(pass ? pass_str : fail_str);
+	count_test_result(pass, result);
+}
+
+#ifdef LZSA_RAM
+
+static void test_ram(test_result_t *result) {
+	ptrdiff_t out_len;
+	bool pass;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u (RAM):\n", test_str, i + 1);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa1_decompress_block_ram()");
+		out_len = lzsa1_decompress_block_ram(buffers.test.out, tests[i].lzsa1.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+
+		memset(buffers.test.out, '\0', sizeof(buffers.test.out));
+		puts("lzsa2_decompress_block_ram()");
+		out_len = lzsa2_decompress_block_ram(buffers.test.out, tests[i].lzsa2.data) - buffers.test.out;
+		pass = (memcmp(buffers.test.out, tests[i].plain.data, tests[i].plain.length) == 0 && out_len == tests[i].plain.length);
+		print_hex_data(buffers.test.out, out_len);
+		printf("plain_len = %u, out_len = %td\n", tests[i].plain.length, out_len);
+		puts(pass ? pass_str : fail_str);
+		count_test_result(pass, result);
+	}
+}
+
+#endif
+
 static void benchmark_lzsa1(void) {
-	benchmark("lzsa1_decompress_block_ref", 100, lzsa1_decompress_block_ref(test_out, tests[10].lzsa1.data));
-	benchmark("lzsa1_decompress_block", 100, lzsa1_decompress_block(test_out, tests[10].lzsa1.data));
+	benchmark_bytes("lzsa1_decompress_block_ref", 100, lzsa1_decompress_block_ref(buffers.test.out, tests[10].lzsa1.data), tests[10].plain.length);
+	benchmark_bytes("lzsa1_decompress_block_fast", 100, lzsa1_decompress_block_fast(buffers.test.out, tests[10].lzsa1.data), tests[10].plain.length);
+	benchmark_bytes("lzsa1_decompress_block", 100, lzsa1_decompress_block(buffers.test.out, tests[10].lzsa1.data), tests[10].plain.length);
 }
 
 static void benchmark_lzsa2(void) {
-	benchmark("lzsa2_decompress_block_ref", 100, lzsa2_decompress_block_ref(test_out, tests[10].lzsa2.data));
-	benchmark("lzsa2_decompress_block", 100, lzsa2_decompress_block(test_out, tests[10].lzsa2.data));
+	benchmark_bytes("lzsa2_decompress_block_ref", 100, lzsa2_decompress_block_ref(buffers.test.out, tests[10].lzsa2.data), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block_fast", 100, lzsa2_decompress_block_fast(buffers.test.out, tests[10].lzsa2.data), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block", 100, lzsa2_decompress_block(buffers.test.out, tests[10].lzsa2.data), tests[10].plain.length);
+}
+
+#ifdef LZSA_RAM
+
+// Compare running each routine from flash and from RAM, on every item of the
+// test corpus in turn and then on the complex item alone.
+static void benchmark_ram(void) {
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u:\n", bench_str, i + 1);
+		benchmark_bytes("lzsa1_decompress_block", 10, lzsa1_decompress_block(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa1_decompress_block_ram", 10, lzsa1_decompress_block_ram(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block", 10, lzsa2_decompress_block(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block_ram", 10, lzsa2_decompress_block_ram(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+	}
+	benchmark_bytes("lzsa1_decompress_block", 100, lzsa1_decompress_block(buffers.test.out, tests[10].lzsa1.data), tests[10].plain.length);
+	benchmark_bytes("lzsa1_decompress_block_ram", 100, lzsa1_decompress_block_ram(buffers.test.out, tests[10].lzsa1.data), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block", 100, lzsa2_decompress_block(buffers.test.out, tests[10].lzsa2.data), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block_ram", 100, lzsa2_decompress_block_ram(buffers.test.out, tests[10].lzsa2.data), tests[10].plain.length);
+}
+
+#endif
+
+static void benchmark_zx0(void) {
+	benchmark_bytes("zx0_decompress_block_ref", 100, zx0_decompress_block_ref(buffers.test.out, tests[10].zx0.data), tests[10].plain.length);
+	benchmark_bytes("zx0_decompress_block", 100, zx0_decompress_block(buffers.test.out, tests[10].zx0.data), tests[10].plain.length);
+}
+
+static void benchmark_lz4(void) {
+	benchmark_bytes("lz4_decompress_block_ref", 100, lz4_decompress_block_ref(buffers.test.out, tests[10].lz4.data, tests[10].lz4.length), tests[10].plain.length);
+	benchmark_bytes("lz4_decompress_block", 100, lz4_decompress_block(buffers.test.out, tests[10].lz4.data, tests[10].lz4.length), tests[10].plain.length);
+}
+
+// Compare LZSA1, LZSA2, LZ4 and ZX0 on every item of the test corpus, giving both
+// the compression ratio and a decompression benchmark for each format, with
+// both the assembly routines and the C implementations.
+static void benchmark_compare(void) {
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u: plain = %u, lzsa1 = %u (%u%%), lzsa2 = %u (%u%%), lz4 = %u (%u%%), zx0 = %u (%u%%)\n",
+			bench_str, i + 1, tests[i].plain.length,
+			tests[i].lzsa1.length, ratio_percent(tests[i].lzsa1.length, tests[i].plain.length),
+			tests[i].lzsa2.length, ratio_percent(tests[i].lzsa2.length, tests[i].plain.length),
+			tests[i].lz4.length, ratio_percent(tests[i].lz4.length, tests[i].plain.length),
+			tests[i].zx0.length, ratio_percent(tests[i].zx0.length, tests[i].plain.length));
+		benchmark_bytes("lzsa1_decompress_block", 10, lzsa1_decompress_block(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block", 10, lzsa2_decompress_block(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+		benchmark_bytes("lz4_decompress_block", 10, lz4_decompress_block(buffers.test.out, tests[i].lz4.data, tests[i].lz4.length), tests[i].plain.length);
+		benchmark_bytes("zx0_decompress_block", 10, zx0_decompress_block(buffers.test.out, tests[i].zx0.data), tests[i].plain.length);
+		benchmark_bytes("lzsa1_decompress_block_ref", 10, lzsa1_decompress_block_ref(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa1_decompress_block_fast", 10, lzsa1_decompress_block_fast(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block_ref", 10, lzsa2_decompress_block_ref(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block_fast", 10, lzsa2_decompress_block_fast(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+		benchmark_bytes("lz4_decompress_block_ref", 10, lz4_decompress_block_ref(buffers.test.out, tests[i].lz4.data, tests[i].lz4.length), tests[i].plain.length);
+		benchmark_bytes("zx0_decompress_block_ref", 10, zx0_decompress_block_ref(buffers.test.out, tests[i].zx0.data), tests[i].plain.length);
+	}
+}
+
+// Compare the STM8-native format with the LZSA1 and LZSA2 blocks it was
+// transcoded from on every item of the test corpus, giving both the size and a
+// decompression benchmark for each.
+static void benchmark_native(void) {
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		printf("%s %02u: plain = %u, lzsa1 = %u (%u%%), lzsa2 = %u (%u%%), native = %u (%u%%)\n",
+			bench_str, i + 1, tests[i].plain.length,
+			tests[i].lzsa1.length, ratio_percent(tests[i].lzsa1.length, tests[i].plain.length),
+			tests[i].lzsa2.length, ratio_percent(tests[i].lzsa2.length, tests[i].plain.length),
+			tests[i].native.length, ratio_percent(tests[i].native.length, tests[i].plain.length));
+		benchmark_bytes("lzsa1_decompress_block", 10, lzsa1_decompress_block(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block", 10, lzsa2_decompress_block(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+		benchmark_bytes("lzsa_native_decompress_block", 10, lzsa_native_decompress_block(buffers.test.out, tests[i].native.data), tests[i].plain.length);
+	}
+}
+
+static void benchmark_strided(void) {
+	benchmark_bytes("lzsa1_decompress_block_strided", 100, lzsa1_decompress_block_strided(buffers.test.out, tests[10].lzsa1.data, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block_strided", 100, lzsa2_decompress_block_strided(buffers.test.out, tests[10].lzsa2.data, TEST_STRIDED_WIDTH, TEST_STRIDED_STRIDE), tests[10].plain.length);
+}
+
+// Verify the plain data of the complex item, in flash, against its compressed
+// data.
+static void benchmark_compare_block(void) {
+	benchmark_bytes("lzsa1_compare_block_ref", 100, lzsa1_compare_block_ref(tests[10].plain.data, tests[10].lzsa1.data), tests[10].plain.length);
+	benchmark_bytes("lzsa1_compare_block", 100, lzsa1_compare_block(tests[10].plain.data, tests[10].lzsa1.data), tests[10].plain.length);
+	benchmark_bytes("lzsa2_compare_block_ref", 100, lzsa2_compare_block_ref(tests[10].plain.data, tests[10].lzsa2.data), tests[10].plain.length);
+	benchmark_bytes("lzsa2_compare_block", 100, lzsa2_compare_block(tests[10].plain.data, tests[10].lzsa2.data), tests[10].plain.length);
+}
+
+// Compare the short-block routines with the general ones on every item short
+// enough for them.
+static void benchmark_small(void) {
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		if(tests[i].plain.length > LZSA_SMALL_PLAIN_MAX) continue;
+		printf("%s %02u:\n", bench_str, i + 1);
+		benchmark_bytes("lzsa1_decompress_block", 100, lzsa1_decompress_block(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa1_decompress_small", 100, lzsa1_decompress_small(buffers.test.out, tests[i].lzsa1.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_block", 100, lzsa2_decompress_block(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+		benchmark_bytes("lzsa2_decompress_small", 100, lzsa2_decompress_small(buffers.test.out, tests[i].lzsa2.data), tests[i].plain.length);
+	}
+}
+
+// Decompress the batch test table with a separate call per block, for
+// comparison against the batch functions.
+static void decompress_each(const bool lzsa2) {
+	for(size_t i = 0; i < TEST_BATCH_COUNT; i++) {
+		if(lzsa2) {
+			lzsa2_decompress_block(test_batch_entries[i].dst, test_batch_entries[i].src);
+		} else {
+			lzsa1_decompress_block(test_batch_entries[i].dst, test_batch_entries[i].src);
+		}
+	}
+}
+
+static void benchmark_batch(void) {
+	setup_batch(false);
+	benchmark("lzsa1_decompress_block (each of batch)", 100, decompress_each(false));
+	benchmark("lzsa1_decompress_batch", 100, lzsa1_decompress_batch(test_batch_entries, TEST_BATCH_COUNT, test_batch_ends));
+	setup_batch(true);
+	benchmark("lzsa2_decompress_block (each of batch)", 100, decompress_each(true));
+	benchmark("lzsa2_decompress_batch", 100, lzsa2_decompress_batch(test_batch_entries, TEST_BATCH_COUNT, test_batch_ends));
+}
+
+// Access the benchmark pattern of test items, either decompressing every item
+// each time it is accessed, or getting it through the cache.
+static void access_uncached(const uint8_t format) {
+	for(size_t i = 0; i < sizeof(bench_cache_seq); i++) {
+		const size_t item = bench_cache_seq[i];
+		if(format == LZSA_CACHE_FORMAT_LZSA1) {
+			lzsa1_decompress_block(buffers.cache.arena, tests[item].lzsa1.data);
+		} else {
+			lzsa2_decompress_block(buffers.cache.arena, tests[item].lzsa2.data);
+		}
+	}
+}
+
+static void access_cached(const uint8_t format) {
+	for(size_t i = 0; i < sizeof(bench_cache_seq); i++) {
+		const size_t item = bench_cache_seq[i];
+		lzsa_cache_get(&cache, (format == LZSA_CACHE_FORMAT_LZSA1 ? tests[item].lzsa1.data : tests[item].lzsa2.data), format, NULL);
+	}
+}
+
+static void benchmark_cache(void) {
+	benchmark("lzsa1_decompress_block (uncached access pattern)", 10, access_uncached(LZSA_CACHE_FORMAT_LZSA1));
+	lzsa_cache_init(&cache, test_cache_slots, TEST_CACHE_SLOTS, buffers.cache.arena, TEST_CACHE_SLOT_SIZE);
+	benchmark("lzsa_cache_get (LZSA1 access pattern)", 10, access_cached(LZSA_CACHE_FORMAT_LZSA1));
+	printf("hits = %u, misses = %u, evictions = %u\n", cache.hits, cache.misses, cache.evictions);
+	benchmark("lzsa2_decompress_block (uncached access pattern)", 10, access_uncached(LZSA_CACHE_FORMAT_LZSA2));
+	lzsa_cache_init(&cache, test_cache_slots, TEST_CACHE_SLOTS, buffers.cache.arena, TEST_CACHE_SLOT_SIZE);
+	benchmark("lzsa_cache_get (LZSA2 access pattern)", 10, access_cached(LZSA_CACHE_FORMAT_LZSA2));
+	printf("hits = %u, misses = %u, evictions = %u\n", cache.hits, cache.misses, cache.evictions);
+}
+
+static void benchmark_archive(void) {
+	lzsa_archive_t archive;
+	lzsa_archive_far_t far_archive;
+
+	lzsa_archive_open(&archive, tests_archive);
+	lzsa_archive_open_far(&far_archive, (uintptr_t)tests_archive, buffers.test.expect, sizeof(buffers.test.expect));
+	benchmark_bytes("lzsa1_decompress_block (archive entry data)", 100, lzsa1_decompress_block(buffers.test.out, tests[5].lzsa1.data), tests[5].plain.length);
+	benchmark_bytes("lzsa_archive_get", 100, lzsa_archive_get(&archive, 65535, buffers.test.out), tests[5].plain.length);
+	benchmark("lzsa_archive_length", 100, lzsa_archive_length(&archive, 65535));
+	benchmark_bytes("lzsa_archive_get_far", 100, lzsa_archive_get_far(&far_archive, 65535, buffers.test.out), tests[5].plain.length);
+	benchmark("lzsa_archive_length_far", 100, lzsa_archive_length_far(&far_archive, 65535));
+}
+
+// Load an overlay that is not resident, as when switching between overlays.
+static void load_evicted_overlay(lzsa_overlays_t *overlays, const uint8_t id) {
+	lzsa_overlay_evict(overlays);
+	lzsa_overlay_load(overlays, id);
+}
+
+static void benchmark_overlay(void) {
+	lzsa_overlays_t overlays;
+
+	lzsa_overlay_init(&overlays, tests_overlay, buffers.test.out, sizeof(buffers.test.out));
+	benchmark_bytes("lzsa_overlay_load (not resident, item 7)", 10, load_evicted_overlay(&overlays, test_overlay_items[2].id), tests[6].plain.length);
+	benchmark("lzsa_overlay_load (resident, item 7)", 100, lzsa_overlay_load(&overlays, test_overlay_items[2].id));
+}
+
+// Apply each test patch to the old image in flash, as when updating firmware.
+static void benchmark_patch(void) {
+	benchmark_bytes("lzsa_patch_next (LZSA1, whole image)", 10, apply_patch(tests_patch_lzsa1, tests[10].plain.data, tests[10].plain.length), TEST_PATCH_NEW_LEN);
+	benchmark_bytes("lzsa_patch_next (LZSA2, whole image)", 10, apply_patch(tests_patch_lzsa2, tests[10].plain.data, tests[10].plain.length), TEST_PATCH_NEW_LEN);
+}
+
+// Compare the straight-line routine generated by lzsa_unroll against the
+// general routine decompressing the same block.
+static void benchmark_unroll(void) {
+	benchmark_bytes("lzsa1_decompress_block", 10, lzsa1_decompress_block(buffers.test.out, tests[TEST_UNROLL_ITEM].lzsa1.data), tests[TEST_UNROLL_ITEM].plain.length);
+	benchmark_bytes("tests_unroll", 10, tests_unroll(buffers.test.out), tests[TEST_UNROLL_ITEM].plain.length);
+}
+
+// Compress every item of the test corpus with the full and small windows,
+// giving the compression ratio against the offline compressor's for each.
+static void benchmark_compress(void) {
+	lzsa1_comp_t comp = { buffers.comp.table, TEST_COMP_TABLE_BITS, LZSA1_COMP_WINDOW_MAX };
+	size_t comp_len;
+
+	for(size_t i = 0; i < TESTS_COUNT; i++) {
+		comp.window = LZSA1_COMP_WINDOW_MAX;
+		comp_len = (size_t)((uint8_t *)lzsa1_compress_block(buffers.comp.out, tests[i].plain.data, tests[i].plain.length, &comp) - buffers.comp.out);
+		printf("%s %02u: plain = %u, lzsa1 = %u (%u%%), compressed = %u (%u%%)\n",
+			bench_str, i + 1, tests[i].plain.length,
+			tests[i].lzsa1.length, ratio_percent(tests[i].lzsa1.length, tests[i].plain.length),
+			comp_len, ratio_percent(comp_len, tests[i].plain.length));
+		benchmark_bytes("lzsa1_compress_block", 10, lzsa1_compress_block(buffers.comp.out, tests[i].plain.data, tests[i].plain.length, &comp), tests[i].plain.length);
+		comp.window = TEST_COMP_WINDOW_SMALL;
+		benchmark_bytes("lzsa1_compress_block (small window)", 10, lzsa1_compress_block(buffers.comp.out, tests[i].plain.data, tests[i].plain.length, &comp), tests[i].plain.length);
+	}
+}
+
+// Print strings alternately from two different blocks (so every print needs a
+// block to be decompressed), or from the same block, discarding the output.
+static void print_str_pair(const uint16_t a, const uint16_t b) {
+	uart_putchar_func_t console_putchar = uart_set_putchar(discard_putchar);
+	lzsa_str_print(&tests_strings, a);
+	lzsa_str_print(&tests_strings, b);
+	uart_set_putchar(console_putchar);
+}
+
+static void benchmark_str_print(void) {
+	benchmark("lzsa_str_print (different blocks)", 100, print_str_pair(TEST_STR_MSG_CONFIRM, TEST_STR_ERR_CHECKSUM));
+	benchmark("lzsa_str_print (same block)", 100, print_str_pair(TEST_STR_MSG_CONFIRM, TEST_STR_MSG_SAVED));
+}
+
+static void benchmark_lzsa2_filter(void) {
+	benchmark_bytes("lzsa2_decompress_block_filter (DELTA8)", 100, lzsa2_decompress_block_filter(buffers.test.out, tests[10].lzsa2.data, &test_filters[0]), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block_filter (DELTA16)", 100, lzsa2_decompress_block_filter(buffers.test.out, tests[10].lzsa2.data, &test_filters[1]), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block_filter (XOR)", 100, lzsa2_decompress_block_filter(buffers.test.out, tests[10].lzsa2.data, &test_filters[2]), tests[10].plain.length);
+	benchmark_bytes("lzsa2_decompress_block_filter (LUT)", 100, lzsa2_decompress_block_filter(buffers.test.out, tests[10].lzsa2.data, &test_filters[3]), tests[10].plain.length);
+}
+
+static uint16_t corpus_read_word(void) {
+	uint16_t w = (uint8_t)ucsim_if_fin_getc();
+	w |= (uint16_t)(uint8_t)ucsim_if_fin_getc() << 8;
+	return w;
+}
+
+static void corpus_write_word(const uint16_t w) {
+	ucsim_if_fout_putc(w & 0xFF);
+	ucsim_if_fout_putc(w >> 8);
+}
+
+static corpus_status_t corpus_decompress(const uint8_t decoder, const uint16_t len, uint8_t **end) {
+	uint8_t *out = buffers.corpus.out;
+	const uint8_t *in = buffers.corpus.in;
+
+	switch(decoder) {
+		case CORPUS_DECODER_LZSA1: *end = lzsa1_decompress_block(out, in); break;
+		case CORPUS_DECODER_LZSA2: *end = lzsa2_decompress_block(out, in); break;
+		case CORPUS_DECODER_LZ4: *end = lz4_decompress_block(out, in, len); break;
+		case CORPUS_DECODER_ZX0: *end = zx0_decompress_block(out, in); break;
+		case CORPUS_DECODER_NATIVE: *end = lzsa_native_decompress_block(out, in); break;
+		case CORPUS_DECODER_LZSA1_REF: *end = lzsa1_decompress_block_ref(out, in); break;
+		case CORPUS_DECODER_LZSA2_REF: *end = lzsa2_decompress_block_ref(out, in); break;
+		case CORPUS_DECODER_LZ4_REF: *end = lz4_decompress_block_ref(out, in, len); break;
+		case CORPUS_DECODER_ZX0_REF: *end = zx0_decompress_block_ref(out, in); break;
+		case CORPUS_DECODER_NATIVE_REF: *end = lzsa_native_decompress_block_ref(out, in); break;
+		case CORPUS_DECODER_LZSA1_FAST: *end = lzsa1_decompress_block_fast(out, in); break;
+		case CORPUS_DECODER_LZSA2_FAST: *end = lzsa2_decompress_block_fast(out, in); break;
+#ifdef LZSA_RAM
+		case CORPUS_DECODER_LZSA1_RAM: *end = lzsa1_decompress_block_ram(out, in); break;
+		case CORPUS_DECODER_LZSA2_RAM: *end = lzsa2_decompress_block_ram(out, in); break;
+#endif
+		case CORPUS_DECODER_LZSA1_SMALL: *end = lzsa1_decompress_small(out, in); break;
+		case CORPUS_DECODER_LZSA2_SMALL: *end = lzsa2_decompress_small(out, in); break;
+		default: *end = out; return CORPUS_STATUS_BAD_DECODER;
+	}
+
+	if(*end < out || *end > out + CORPUS_OUT_MAX) {
+		*end = out;
+		return CORPUS_STATUS_OVERRUN;
+	}
+
+	return CORPUS_STATUS_OK;
+}
+
+// Decompress a stream of blocks read from the simulator's interface input
+// file, writing the output of each, along with the number of cycles taken, to
+// the interface output file. Each input record is the decoder to use (one of
+// corpus_decoder_t), then a 16-bit little-endian length, then that many bytes
+// of compressed data. Each output record is a status (one of corpus_status_t),
+// then the 16-bit length of the decompressed data, then the 32-bit cycle
+// count, then the decompressed data, all little-endian.
+static void corpus_run(void) {
+	corpus_status_t status;
+	uint8_t decoder, *end;
+	uint16_t len, count = 0;
+	uint32_t cycles;
+
+	cycles_init();
+
+	while(ucsim_if_fin_avail()) {
+		decoder = (uint8_t)ucsim_if_fin_getc();
+		len = corpus_read_word();
+		cycles = 0;
+
+		if(len <= CORPUS_IN_MAX) {
+			for(uint16_t i = 0; i < len; i++) buffers.corpus.in[i] = (uint8_t)ucsim_if_fin_getc();
+			cycles_start();
+			status = corpus_decompress(decoder, len, &end);
+			cycles = cycles_stop();
+		} else {
+			for(uint16_t i = 0; i < len; i++) ucsim_if_fin_getc();
+			status = CORPUS_STATUS_BAD_LENGTH;
+			end = buffers.corpus.out;
+		}
+
+		len = (uint16_t)(end - buffers.corpus.out);
+		ucsim_if_fout_putc(status);
+		corpus_write_word(len);
+		corpus_write_word(cycles & 0xFFFF);
+		corpus_write_word(cycles >> 16);
+		for(uint16_t i = 0; i < len; i++) ucsim_if_fout_putc(buffers.corpus.out[i]);
+
+		printf("CORPUS %03u: decoder = 0x%02X, status = %u, out_len = %u, cycles = %lu\n", count++, decoder, status, len, cycles);
+	}
+}
+
+// Set the master clock to run at F_CPU. At 16 MHz, this is the internal HSI
+// oscillator undivided. At 24 MHz, it is the HSE oscillator, which needs a
+// 24 MHz crystal (as fitted to the Nucleo-64 board) and the flash wait state to
+// have been enabled beforehand in option byte OPT7 (e.g. with stm8flash). If
+// the wait state is not enabled, halt rather than run out of specification.
+// Under μCsim, the clock speed is instead given on the command line.
+static void clock_init(void) {
+	CLK_CKDIVR = 0;
+
+#if F_CPU == 24000000UL
+	if(ucsim_if_detect()) return;
+	if(!(OPT7 & (1 << OPT7_WAITSTATE))) while(1);
+
+	CLK_SWCR |= (1 << CLK_SWCR_SWEN);
+	CLK_SWR = CLK_SOURCE_HSE;
+	while(CLK_CMSR != CLK_SOURCE_HSE);
+#endif
 }
 
 void main(void) {
 	test_result_t results = { 0, 0 };
 
-	CLK_CKDIVR = 0;
+	clock_init();
 	PC_DDR = (1 << PC_DDR_DDR5);
 	PC_CR1 = (1 << PC_CR1_C15);
 
@@ -195,16 +1694,69 @@ void main(void) {
 
 	puts(hrule_str);
 
+#ifdef LZSA_RAM
+	// Copy the decompression routines to RAM, so they may be run from there.
+	lzsa1_ram_init();
+	lzsa2_ram_init();
+#endif
+
+	// When run in μCsim with an interface input file containing data, run in
+	// corpus mode instead of running tests and benchmarks.
+	if(ucsim_if_detect() && ucsim_if_fin_avail()) {
+		corpus_run();
+		puts(hrule_str);
+		ucsim_if_stop();
+		while(1);
+	}
+
 	test_lzsa1(&results);
 	test_lzsa2(&results);
+	test_lz4(&results);
+	test_zx0(&results);
+	test_native(&results);
+	test_lzsa2_filter(&results);
+	test_strided(&results);
+	test_compare_block(&results);
+	test_small(&results);
+	test_batch(&results);
+	test_cache(&results);
+	test_archive(&results);
+	test_overlay(&results);
+	test_patch(&results);
+	test_unroll(&results);
+	test_compress(&results);
+	test_str_print(&results);
+#ifdef LZSA_RAM
+	test_ram(&results);
+#endif
 
 	printf("TOTAL RESULTS: passed = %u, failed = %u\n", results.pass_count, results.fail_count);
 
 	puts(hrule_str);
 
 	if(results.fail_count == 0) {
+		cycles_init();
 		benchmark_lzsa1();
 		benchmark_lzsa2();
+		benchmark_lz4();
+		benchmark_zx0();
+		benchmark_native();
+		benchmark_lzsa2_filter();
+		benchmark_strided();
+		benchmark_compare_block();
+		benchmark_small();
+		benchmark_batch();
+		benchmark_cache();
+		benchmark_archive();
+		benchmark_overlay();
+		benchmark_patch();
+		benchmark_unroll();
+		benchmark_compress();
+		benchmark_str_print();
+#ifdef LZSA_RAM
+		benchmark_ram();
+#endif
+		benchmark_compare();
 	} else {
 		puts("One or more tests failed, skipping benchmark");
 	}
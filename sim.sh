@@ -1,2 +1,9 @@
 #!/bin/sh
-~/sdcc/sdcc/sim/ucsim/stm8.src/sstm8 -t STM8S208 -X 16M -I if=rom[0x5800] -C 'sim_cmds.txt' 'bin/Test/test'
+# Set SIM to the path of lzsa_emu (see tools/lzsa_emu.c) to run the test program
+# under that instead of μCsim. It prints benchmark cycle counts the same way as
+# sim_cmds.txt has μCsim do, and exits at the end of the program.
+SIM=${SIM:-~/sdcc/sdcc/sim/ucsim/stm8.src/sstm8}
+case "$(basename "$SIM")" in
+	lzsa_emu*) "$SIM" -t STM8S208 -X 16M -I if=rom[0x5800] -b 0x500A 'bin/Test/test' ;;
+	*) "$SIM" -t STM8S208 -X 16M -I if=rom[0x5800] -C 'sim_cmds.txt' 'bin/Test/test' ;;
+esac
@@ -31,61 +31,98 @@
 // This included file is auto-generated from the contents of the 'tests' folder.
 // See make_tests.bat there.
 #include "tests/tests_data.c"
+#include "tests/tests_archive.c"
+#include "tests/tests_overlay.c"
+#include "tests/tests_patch_lzsa1.c"
+#include "tests/tests_patch_lzsa2.c"
 
 const test_case_t tests[TESTS_COUNT] = {
 	{
 		.plain = { .data = lzsa_test_01_plain, .length = sizeof(lzsa_test_01_plain) },
 		.lzsa1 = { .data = lzsa_test_01_lzsa1, .length = sizeof(lzsa_test_01_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_01_lzsa2, .length = sizeof(lzsa_test_01_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_01_lzsa2, .length = sizeof(lzsa_test_01_lzsa2) },
+		.lz4 = { .data = lzsa_test_01_lz4, .length = sizeof(lzsa_test_01_lz4) },
+		.zx0 = { .data = lzsa_test_01_zx0, .length = sizeof(lzsa_test_01_zx0) },
+		.native = { .data = lzsa_test_01_native, .length = sizeof(lzsa_test_01_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_02_plain, .length = sizeof(lzsa_test_02_plain) },
 		.lzsa1 = { .data = lzsa_test_02_lzsa1, .length = sizeof(lzsa_test_02_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_02_lzsa2, .length = sizeof(lzsa_test_02_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_02_lzsa2, .length = sizeof(lzsa_test_02_lzsa2) },
+		.lz4 = { .data = lzsa_test_02_lz4, .length = sizeof(lzsa_test_02_lz4) },
+		.zx0 = { .data = lzsa_test_02_zx0, .length = sizeof(lzsa_test_02_zx0) },
+		.native = { .data = lzsa_test_02_native, .length = sizeof(lzsa_test_02_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_03_plain, .length = sizeof(lzsa_test_03_plain) },
 		.lzsa1 = { .data = lzsa_test_03_lzsa1, .length = sizeof(lzsa_test_03_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_03_lzsa2, .length = sizeof(lzsa_test_03_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_03_lzsa2, .length = sizeof(lzsa_test_03_lzsa2) },
+		.lz4 = { .data = lzsa_test_03_lz4, .length = sizeof(lzsa_test_03_lz4) },
+		.zx0 = { .data = lzsa_test_03_zx0, .length = sizeof(lzsa_test_03_zx0) },
+		.native = { .data = lzsa_test_03_native, .length = sizeof(lzsa_test_03_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_04_plain, .length = sizeof(lzsa_test_04_plain) },
 		.lzsa1 = { .data = lzsa_test_04_lzsa1, .length = sizeof(lzsa_test_04_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_04_lzsa2, .length = sizeof(lzsa_test_04_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_04_lzsa2, .length = sizeof(lzsa_test_04_lzsa2) },
+		.lz4 = { .data = lzsa_test_04_lz4, .length = sizeof(lzsa_test_04_lz4) },
+		.zx0 = { .data = lzsa_test_04_zx0, .length = sizeof(lzsa_test_04_zx0) },
+		.native = { .data = lzsa_test_04_native, .length = sizeof(lzsa_test_04_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_05_plain, .length = sizeof(lzsa_test_05_plain) },
 		.lzsa1 = { .data = lzsa_test_05_lzsa1, .length = sizeof(lzsa_test_05_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_05_lzsa2, .length = sizeof(lzsa_test_05_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_05_lzsa2, .length = sizeof(lzsa_test_05_lzsa2) },
+		.lz4 = { .data = lzsa_test_05_lz4, .length = sizeof(lzsa_test_05_lz4) },
+		.zx0 = { .data = lzsa_test_05_zx0, .length = sizeof(lzsa_test_05_zx0) },
+		.native = { .data = lzsa_test_05_native, .length = sizeof(lzsa_test_05_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_06_plain, .length = sizeof(lzsa_test_06_plain) },
 		.lzsa1 = { .data = lzsa_test_06_lzsa1, .length = sizeof(lzsa_test_06_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_06_lzsa2, .length = sizeof(lzsa_test_06_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_06_lzsa2, .length = sizeof(lzsa_test_06_lzsa2) },
+		.lz4 = { .data = lzsa_test_06_lz4, .length = sizeof(lzsa_test_06_lz4) },
+		.zx0 = { .data = lzsa_test_06_zx0, .length = sizeof(lzsa_test_06_zx0) },
+		.native = { .data = lzsa_test_06_native, .length = sizeof(lzsa_test_06_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_07_plain, .length = sizeof(lzsa_test_07_plain) },
 		.lzsa1 = { .data = lzsa_test_07_lzsa1, .length = sizeof(lzsa_test_07_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_07_lzsa2, .length = sizeof(lzsa_test_07_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_07_lzsa2, .length = sizeof(lzsa_test_07_lzsa2) },
+		.lz4 = { .data = lzsa_test_07_lz4, .length = sizeof(lzsa_test_07_lz4) },
+		.zx0 = { .data = lzsa_test_07_zx0, .length = sizeof(lzsa_test_07_zx0) },
+		.native = { .data = lzsa_test_07_native, .length = sizeof(lzsa_test_07_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_08_plain, .length = sizeof(lzsa_test_08_plain) },
 		.lzsa1 = { .data = lzsa_test_08_lzsa1, .length = sizeof(lzsa_test_08_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_08_lzsa2, .length = sizeof(lzsa_test_08_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_08_lzsa2, .length = sizeof(lzsa_test_08_lzsa2) },
+		.lz4 = { .data = lzsa_test_08_lz4, .length = sizeof(lzsa_test_08_lz4) },
+		.zx0 = { .data = lzsa_test_08_zx0, .length = sizeof(lzsa_test_08_zx0) },
+		.native = { .data = lzsa_test_08_native, .length = sizeof(lzsa_test_08_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_09_plain, .length = sizeof(lzsa_test_09_plain) },
 		.lzsa1 = { .data = lzsa_test_09_lzsa1, .length = sizeof(lzsa_test_09_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_09_lzsa2, .length = sizeof(lzsa_test_09_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_09_lzsa2, .length = sizeof(lzsa_test_09_lzsa2) },
+		.lz4 = { .data = lzsa_test_09_lz4, .length = sizeof(lzsa_test_09_lz4) },
+		.zx0 = { .data = lzsa_test_09_zx0, .length = sizeof(lzsa_test_09_zx0) },
+		.native = { .data = lzsa_test_09_native, .length = sizeof(lzsa_test_09_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_10_plain, .length = sizeof(lzsa_test_10_plain) },
 		.lzsa1 = { .data = lzsa_test_10_lzsa1, .length = sizeof(lzsa_test_10_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_10_lzsa2, .length = sizeof(lzsa_test_10_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_10_lzsa2, .length = sizeof(lzsa_test_10_lzsa2) },
+		.lz4 = { .data = lzsa_test_10_lz4, .length = sizeof(lzsa_test_10_lz4) },
+		.zx0 = { .data = lzsa_test_10_zx0, .length = sizeof(lzsa_test_10_zx0) },
+		.native = { .data = lzsa_test_10_native, .length = sizeof(lzsa_test_10_native) }
 	},
 	{
 		.plain = { .data = lzsa_test_11_plain, .length = sizeof(lzsa_test_11_plain) },
 		.lzsa1 = { .data = lzsa_test_11_lzsa1, .length = sizeof(lzsa_test_11_lzsa1) },
-		.lzsa2 = { .data = lzsa_test_11_lzsa2, .length = sizeof(lzsa_test_11_lzsa2) }
+		.lzsa2 = { .data = lzsa_test_11_lzsa2, .length = sizeof(lzsa_test_11_lzsa2) },
+		.lz4 = { .data = lzsa_test_11_lz4, .length = sizeof(lzsa_test_11_lz4) },
+		.zx0 = { .data = lzsa_test_11_zx0, .length = sizeof(lzsa_test_11_zx0) },
+		.native = { .data = lzsa_test_11_native, .length = sizeof(lzsa_test_11_native) }
 	},
 };
@@ -29,6 +29,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "lzsa.h"
 
 #define TESTS_COUNT 11
 #define TESTS_DATA_PLAIN_MAX_LEN 1700
@@ -47,8 +48,28 @@ typedef struct {
 		size_t length;
 		uint8_t *data;
 	} lzsa2;
+	struct {
+		size_t length;
+		uint8_t *data;
+	} lz4;
+	struct {
+		size_t length;
+		uint8_t *data;
+	} zx0;
+	struct {
+		size_t length;
+		uint8_t *data;
+	} native;
 } test_case_t;
 
 extern const test_case_t tests[TESTS_COUNT];
+extern const uint8_t tests_archive[];
+extern const uint8_t tests_overlay[];
+extern const uint8_t tests_patch_lzsa1[];
+extern const uint8_t tests_patch_lzsa2[];
+
+// Routines generated by the lzsa_unroll host tool (see make_tests.bat).
+extern void * tests_unroll(void *dst) __stack_args;
+extern void * tests_unroll_fallback(void *dst) __stack_args;
 
 #endif // TESTS_H_
@@ -13,12 +13,68 @@ for %%F in (%INPUT%) do (
 	..\tools\lzsa.exe -v -stats -f1 -r "%%F" "%%~nF.lzsa1"
 	..\tools\lzsa.exe -v -stats -f2 -r "%%F" "%%~nF.lzsa2"
 	
+	rem Compress input file to a raw LZ4 block for comparison. The LZ4 tool has no
+	rem raw block output, so use the legacy frame format (which, for inputs under
+	rem 8 MB, is a single block) and strip its 8-byte header.
+	..\tools\lz4.exe -l -12 -f "%%F" "%%~nF.lz4l"
+	..\tools\xxd.exe -p -s 8 "%%~nF.lz4l" | ..\tools\xxd.exe -r -p > "%%~nF.lz4"
+	del "%%~nF.lz4l"
+	
+	rem Compress input file to ZX0 format (which is always raw, with no header).
+	rem This is done with the lzsa_zx0 host tool, not the reference zx0 tool, whose
+	rem output differs (though is equally valid).
+	..\tools\lzsa_zx0.exe "%%F" "%%~nF.zx0"
+	
+	rem Transcode the LZSA1 block to the STM8-native format.
+	..\tools\lzsa_native.exe -f 1 "%%~nF.lzsa1" "%%~nF.native"
+	
 	rem Format input and compressed data files as C-style hex arrays and append to output.
 	..\tools\xxd.exe -i "%%F" >> "%OUTPUT_TMP%"
 	..\tools\xxd.exe -i "%%~nF.lzsa1" >> "%OUTPUT_TMP%"
 	..\tools\xxd.exe -i "%%~nF.lzsa2" >> "%OUTPUT_TMP%"
+	..\tools\xxd.exe -i "%%~nF.lz4" >> "%OUTPUT_TMP%"
+	..\tools\xxd.exe -i "%%~nF.zx0" >> "%OUTPUT_TMP%"
+	..\tools\xxd.exe -i "%%~nF.native" >> "%OUTPUT_TMP%"
 )
 
 rem Munge temp output file with AWK script into final output. Delete temp file.
 ..\tools\gawk-3.1.6-1-bin\bin\gawk.exe -f modify_tests.awk "%OUTPUT_TMP%" > "%OUTPUT%"
 del "%OUTPUT_TMP%"
+
+rem Pack some of the compressed data files into an archive, with IDs in no
+rem particular order and including the minimum and maximum.
+..\tools\lzsa_archive.exe -c tests_archive -o tests_archive.c 300:lzsa1:lzsa_test_03.lzsa1 7:lzsa1:lzsa_test_01.lzsa1 42:lzsa2:lzsa_test_02.lzsa2 301:lzsa2:lzsa_test_04.lzsa2 4096:lzsa2:lzsa_test_05.lzsa2 65535:lzsa1:lzsa_test_06.lzsa1 0:lzsa2:lzsa_test_07.lzsa2
+
+rem Build the test string table. This goes in the parent folder, alongside
+rem lzsa_str.h, which it includes.
+..\tools\lzsa_strings.exe -n tests_strings -p TEST_STR_ -o ..\tests_strings.c -H ..\tests_strings.h lzsa_test_strings.txt
+
+rem Build the test overlay store. The first overlay is position-independent
+rem code that returns 0x1234 (LDW X,#0x1234; RETF - for the large model only);
+rem the others are plain test data.
+..\tools\lzsa_overlay.exe -c tests_overlay -o tests_overlay.c lzsa_test_overlay.bin lzsa_test_01.plain lzsa_test_04.plain lzsa_test_07.plain
+
+rem Build the test delta patches, from item 11 as the old image to an edited
+rem copy of it as the new image (see test_patch() in main.c), in both formats and
+rem with small blocks so there is more than one.
+..\tools\lzsa_patch.exe -f 1 -b 512 -c tests_patch_lzsa1 -o tests_patch_lzsa1.c lzsa_test_11.plain lzsa_test_patch.bin
+..\tools\lzsa_patch.exe -f 2 -b 512 -c tests_patch_lzsa2 -o tests_patch_lzsa2.c lzsa_test_11.plain lzsa_test_patch.bin
+
+rem Generate straight-line decompression routines for the test program: one for
+rem the binary item (item 8), and one for item 1 with a size limit of zero, so
+rem that it falls back to calling the general routine.
+..\tools\lzsa_unroll.exe -f 1 -n tests_unroll -o tests_unroll.s lzsa_test_08.lzsa1
+..\tools\lzsa_unroll.exe -f 2 -s 0 -n tests_unroll_fallback -o tests_unroll_fallback.s lzsa_test_01.lzsa2
+
+rem Compress the data-class benchmark corpus (not compiled into the test program,
+rem but used in corpus mode) in both LZSA formats, LZ4 and ZX0 (as above), and
+rem transcode it to the STM8-native format.
+for %%F in (corpus\*.plain) do (
+	..\tools\lzsa.exe -v -stats -f1 -r "%%F" "corpus\%%~nF.lzsa1"
+	..\tools\lzsa.exe -v -stats -f2 -r "%%F" "corpus\%%~nF.lzsa2"
+	..\tools\lz4.exe -l -12 -f "%%F" "corpus\%%~nF.lz4l"
+	..\tools\xxd.exe -p -s 8 "corpus\%%~nF.lz4l" | ..\tools\xxd.exe -r -p > "corpus\%%~nF.lz4"
+	del "corpus\%%~nF.lz4l"
+	..\tools\lzsa_zx0.exe "%%F" "corpus\%%~nF.zx0"
+	..\tools\lzsa_native.exe -f 1 "corpus\%%~nF.lzsa1" "corpus\%%~nF.native"
+)
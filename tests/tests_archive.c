@@ -0,0 +1,145 @@
+// Generated by lzsa_archive. Do not edit.
+
+#include <stdint.h>
+
+// Entries (ID, format, compressed length, decompressed length):
+//     0 LZSA2   566   560 lzsa_test_07.lzsa2
+//     7 LZSA1    43    51 lzsa_test_01.lzsa1
+//    42 LZSA2   202   229 lzsa_test_02.lzsa2
+//   300 LZSA1   162   185 lzsa_test_03.lzsa1
+//   301 LZSA2    13   240 lzsa_test_04.lzsa2
+//  4096 LZSA2   196   192 lzsa_test_05.lzsa2
+// 65535 LZSA1   311   304 lzsa_test_06.lzsa1
+const uint8_t tests_archive[1571] = {
+	0x4c, 0x5a, 0x41, 0x52, 0x01, 0x00, 0x00, 0x07, 0x00, 0x00, 0x02, 0x00,
+	0x00, 0x4e, 0x02, 0x36, 0x02, 0x30, 0x00, 0x07, 0x01, 0x00, 0x02, 0x84,
+	0x00, 0x2b, 0x00, 0x33, 0x00, 0x2a, 0x02, 0x00, 0x02, 0xaf, 0x00, 0xca,
+	0x00, 0xe5, 0x01, 0x2c, 0x01, 0x00, 0x03, 0x79, 0x00, 0xa2, 0x00, 0xb9,
+	0x01, 0x2d, 0x02, 0x00, 0x04, 0x1b, 0x00, 0x0d, 0x00, 0xf0, 0x10, 0x00,
+	0x02, 0x00, 0x04, 0x28, 0x00, 0xc4, 0x00, 0xc0, 0xff, 0xff, 0x01, 0x00,
+	0x04, 0xec, 0x01, 0x37, 0x01, 0x30, 0xff, 0xff, 0xef, 0x30, 0x02, 0x31,
+	0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67, 0x64, 0x56, 0x6e,
+	0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47, 0x76, 0x39, 0x36, 0x6e,
+	0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f, 0x56, 0x74, 0x42, 0x67,
+	0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43, 0x6b, 0x78, 0x72, 0x55,
+	0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43, 0x4d, 0x42, 0x39, 0x74,
+	0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71, 0x53, 0x41, 0x68, 0x49,
+	0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73, 0x7a, 0x34, 0x62, 0x57,
+	0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75, 0x53, 0x32, 0x6e, 0x56,
+	0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54, 0x7a, 0x58, 0x32, 0x5a,
+	0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61, 0x55, 0x4d, 0x75, 0x50,
+	0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75, 0x66, 0x56, 0x71, 0x74,
+	0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38, 0x65, 0x69, 0x69, 0x6b,
+	0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f, 0x6f, 0x7a, 0x65, 0x64,
+	0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67, 0x65, 0x42, 0x4a, 0x78,
+	0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b, 0x79, 0x65, 0x52, 0x34,
+	0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36, 0x66, 0x6e, 0x6a, 0x68,
+	0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45, 0x4b, 0x76, 0x36, 0x51,
+	0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68, 0x49, 0x41, 0x6f, 0x39,
+	0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57, 0x62, 0x78, 0x56, 0x6b,
+	0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32, 0x4f, 0x36, 0x77, 0x56,
+	0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c, 0x52, 0x41, 0x6e, 0x4e,
+	0x4d, 0x54, 0x51, 0x63, 0x62, 0x53, 0x36, 0x34, 0x34, 0x54, 0x76, 0x49,
+	0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64, 0x33, 0x52, 0x59, 0x58, 0x4f,
+	0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47, 0x70, 0x34, 0x4d, 0x72, 0x6f,
+	0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a, 0x51, 0x57, 0x54, 0x31, 0x4f,
+	0x43, 0x61, 0x65, 0x4a, 0x43, 0x69, 0x65, 0x45, 0x6a, 0x53, 0x78, 0x49,
+	0x6f, 0x4e, 0x4d, 0x6c, 0x70, 0x51, 0x72, 0x54, 0x4e, 0x6d, 0x48, 0x7a,
+	0x49, 0x44, 0x70, 0x6a, 0x45, 0x73, 0x49, 0x73, 0x48, 0x6b, 0x66, 0x36,
+	0x65, 0x6e, 0x35, 0x4d, 0x48, 0x6d, 0x65, 0x72, 0x59, 0x79, 0x6c, 0x42,
+	0x52, 0x41, 0x76, 0x71, 0x45, 0x48, 0x52, 0x71, 0x4c, 0x66, 0x41, 0x46,
+	0x56, 0x67, 0x6c, 0x41, 0x6e, 0x33, 0x4e, 0x47, 0x6f, 0x68, 0x35, 0x38,
+	0x68, 0x31, 0x61, 0x30, 0x5a, 0x64, 0x73, 0x4d, 0x6d, 0x65, 0x58, 0x64,
+	0x68, 0x6c, 0x6d, 0x74, 0x46, 0x32, 0x4d, 0x44, 0x47, 0x45, 0x41, 0x45,
+	0x70, 0x74, 0x56, 0x42, 0x67, 0x6d, 0x6b, 0x75, 0x6e, 0x62, 0x61, 0x36,
+	0x36, 0x5a, 0x32, 0x39, 0x49, 0x55, 0x55, 0x50, 0x69, 0x62, 0x72, 0x33,
+	0x36, 0x51, 0x30, 0x49, 0x61, 0x36, 0x39, 0x37, 0x5a, 0x69, 0x44, 0x37,
+	0x63, 0x7a, 0x47, 0x61, 0x37, 0x41, 0x73, 0x77, 0x55, 0x42, 0x42, 0x64,
+	0x50, 0x76, 0x44, 0x39, 0x31, 0x78, 0x47, 0x32, 0x6b, 0x56, 0x75, 0x57,
+	0x58, 0x75, 0x31, 0x59, 0x6d, 0x67, 0x61, 0x46, 0x78, 0x4d, 0x42, 0x35,
+	0x6a, 0x37, 0x78, 0x4c, 0x39, 0x51, 0x5a, 0x4d, 0x73, 0x59, 0x4c, 0x42,
+	0x54, 0x44, 0x48, 0x52, 0x67, 0x38, 0x77, 0x76, 0x78, 0x45, 0x70, 0x48,
+	0x6e, 0x5a, 0x43, 0x74, 0x4e, 0x56, 0x43, 0x41, 0x74, 0x45, 0x6e, 0x47,
+	0x4a, 0x46, 0x6d, 0x32, 0x30, 0x56, 0x45, 0x31, 0x30, 0x73, 0x6b, 0x6b,
+	0x43, 0x36, 0x46, 0x37, 0x70, 0x69, 0x46, 0x43, 0x6c, 0x53, 0x31, 0x55,
+	0x77, 0x36, 0x73, 0x4a, 0x50, 0x76, 0x6a, 0x52, 0x72, 0x78, 0x69, 0x63,
+	0x68, 0x56, 0x5a, 0x7a, 0x68, 0x33, 0x6b, 0x55, 0x53, 0x54, 0x4c, 0x45,
+	0x33, 0x44, 0x32, 0x33, 0x45, 0x71, 0x54, 0xe8, 0x73, 0x01, 0x48, 0x65,
+	0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x68, 0xf9, 0x53, 0x69, 0x73, 0x20, 0x74,
+	0x68, 0xfb, 0x76, 0x07, 0x6e, 0x67, 0x20, 0x6f, 0x6e, 0x3f, 0x20, 0x42,
+	0x6c, 0x61, 0x68, 0x2c, 0x20, 0x62, 0xfa, 0x3f, 0x2e, 0x2e, 0x2e, 0x00,
+	0xee, 0x00, 0x00, 0x18, 0xfc, 0x14, 0x46, 0x6f, 0x72, 0x20, 0x6d, 0x65,
+	0x20, 0x69, 0x74, 0x20, 0x77, 0x61, 0x73, 0x20, 0x61, 0x63, 0x74, 0x75,
+	0x61, 0x6c, 0x6c, 0x79, 0x20, 0x61, 0x20, 0x72, 0x65, 0x6c, 0x69, 0x65,
+	0x66, 0x20, 0x74, 0x6f, 0x20, 0x73, 0x65, 0x65, 0x50, 0x68, 0x61, 0xde,
+	0x30, 0x6e, 0x6f, 0xed, 0x1a, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68,
+	0x69, 0x6e, 0x67, 0x20, 0x69, 0x73, 0x20, 0x62, 0x65, 0xb6, 0x29, 0x6f,
+	0x59, 0x81, 0x2d, 0x65, 0x78, 0x70, 0x6c, 0x61, 0x69, 0x6e, 0x65, 0x64,
+	0x2c, 0xc3, 0x18, 0x73, 0x69, 0x63, 0x6b, 0xa5, 0x48, 0x73, 0xdf, 0xf8,
+	0x6d, 0x61, 0x6e, 0x79, 0x20, 0x6d, 0x6f, 0x64, 0x09, 0x6e, 0xc6, 0x30,
+	0x76, 0x69, 0x20, 0x2b, 0x38, 0x75, 0x66, 0x66, 0x65, 0x72, 0x20, 0x66,
+	0x72, 0x6f, 0x6d, 0x2e, 0x20, 0x57, 0x68, 0x3b, 0x4a, 0x65, 0xb6, 0x08,
+	0x74, 0x00, 0x6a, 0x10, 0x75, 0x6e, 0x48, 0x66, 0x7b, 0x30, 0x66, 0x74,
+	0x07, 0x02, 0x44, 0xce, 0x38, 0x76, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x64,
+	0x6f, 0x6e, 0x27, 0x74, 0x40, 0x64, 0x08, 0x6b, 0x08, 0x28, 0x62, 0x49,
+	0x74, 0x4f, 0x18, 0x28, 0x2c, 0x20, 0x6c, 0x6f, 0x6f, 0x43, 0x74, 0x59,
+	0x2f, 0x73, 0x20, 0x75, 0x70, 0x2c, 0x93, 0x48, 0x79, 0x6f, 0x42, 0x5e,
+	0x49, 0x6e, 0x42, 0x53, 0x61, 0x64, 0xac, 0x49, 0x62, 0xdc, 0xef, 0x3f,
+	0xe8, 0x71, 0x3e, 0x54, 0x68, 0x65, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61,
+	0x6c, 0x20, 0x64, 0x72, 0x69, 0x76, 0x65, 0x20, 0x63, 0x61, 0x70, 0x61,
+	0x62, 0x69, 0x6c, 0x69, 0x74, 0x69, 0x65, 0x73, 0x20, 0x6f, 0x66, 0x20,
+	0x49, 0x53, 0x41, 0x20, 0x6d, 0x6f, 0x74, 0x68, 0x65, 0x72, 0x62, 0x6f,
+	0x61, 0x72, 0x64, 0x73, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x76, 0x61, 0x72,
+	0x79, 0x20, 0x67, 0x72, 0x65, 0x61, 0x74, 0x6c, 0x79, 0x2e, 0x0d, 0x0a,
+	0xbb, 0x70, 0x0c, 0x49, 0x45, 0x45, 0x45, 0x20, 0x50, 0x39, 0x39, 0x36,
+	0x20, 0x73, 0x70, 0x65, 0x63, 0x73, 0x20, 0x31, 0x2e, 0x30, 0xc1, 0x50,
+	0x66, 0x65, 0x72, 0x73, 0x20, 0xc3, 0x70, 0x13, 0x73, 0x65, 0x20, 0x67,
+	0x75, 0x69, 0x64, 0x65, 0x6c, 0x69, 0x6e, 0x65, 0x73, 0x3a, 0x0d, 0x0a,
+	0x20, 0x20, 0x20, 0x2b, 0x31, 0x32, 0x56, 0x20, 0x61, 0x74, 0xd7, 0x22,
+	0x35, 0x41, 0xef, 0x14, 0x2d, 0xef, 0x33, 0x30, 0x2e, 0x33, 0xef, 0x32,
+	0x20, 0x2b, 0x35, 0xef, 0x15, 0x34, 0xde, 0x34, 0x20, 0x2d, 0x35, 0xde,
+	0x2f, 0x32, 0x41, 0x00, 0xee, 0x00, 0x00, 0x0f, 0x41, 0xff, 0x57, 0xef,
+	0x42, 0xf6, 0x57, 0xef, 0x43, 0xe7, 0xf0, 0xe8, 0xff, 0xff, 0xae, 0x4a,
+	0x35, 0x72, 0x38, 0x4b, 0x41, 0x44, 0x42, 0x31, 0x53, 0x5a, 0x49, 0x79,
+	0x35, 0x70, 0x4e, 0x44, 0x69, 0x53, 0x52, 0x6a, 0x4a, 0x4c, 0x43, 0x6d,
+	0x58, 0x44, 0x35, 0x6e, 0x4a, 0x47, 0x35, 0x5a, 0x65, 0x62, 0x76, 0x70,
+	0x58, 0x51, 0x70, 0x37, 0x67, 0x63, 0x72, 0x6a, 0x6d, 0x69, 0x31, 0x48,
+	0x6b, 0x49, 0x4e, 0x30, 0x55, 0x34, 0x73, 0x37, 0x78, 0x41, 0x55, 0x59,
+	0x66, 0x30, 0x34, 0x6a, 0x66, 0x63, 0x66, 0x58, 0x6a, 0x61, 0x68, 0x32,
+	0x52, 0x6e, 0x37, 0x4d, 0x5a, 0x48, 0x42, 0x45, 0x69, 0x39, 0x68, 0x4c,
+	0x57, 0x61, 0x43, 0x56, 0x71, 0x79, 0x44, 0x34, 0x59, 0x4d, 0x43, 0x4c,
+	0x33, 0x56, 0x42, 0x6e, 0x71, 0x68, 0x4c, 0x64, 0x53, 0x42, 0x49, 0x32,
+	0x76, 0x74, 0x6f, 0x45, 0x56, 0x33, 0x55, 0x39, 0x6a, 0x58, 0x71, 0x52,
+	0x65, 0x4f, 0x65, 0x75, 0x4d, 0x4a, 0x33, 0x30, 0x61, 0x70, 0x51, 0x41,
+	0x61, 0x6f, 0x46, 0x36, 0x4a, 0x4e, 0x30, 0x51, 0x6d, 0x62, 0x39, 0x32,
+	0x4d, 0x50, 0x4b, 0x4a, 0x6b, 0x69, 0x75, 0x62, 0x46, 0x65, 0x4e, 0x58,
+	0x66, 0x70, 0x64, 0x6e, 0x34, 0x78, 0x63, 0x71, 0x6a, 0x72, 0x38, 0x72,
+	0x30, 0x30, 0x49, 0x79, 0x34, 0x56, 0x36, 0x65, 0x45, 0x64, 0x4d, 0x47,
+	0x4b, 0x4e, 0x4f, 0x56, 0x42, 0x4d, 0x4d, 0x70, 0x63, 0x6f, 0x64, 0xe8,
+	0x7f, 0xfa, 0x30, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69,
+	0x67, 0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47,
+	0x76, 0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f,
+	0x56, 0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43,
+	0x6b, 0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43,
+	0x4d, 0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71,
+	0x53, 0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73,
+	0x7a, 0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75,
+	0x53, 0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54,
+	0x7a, 0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61,
+	0x55, 0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75,
+	0x66, 0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38,
+	0x65, 0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f,
+	0x6f, 0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67,
+	0x65, 0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b,
+	0x79, 0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36,
+	0x66, 0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45,
+	0x4b, 0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68,
+	0x49, 0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57,
+	0x62, 0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32,
+	0x4f, 0x36, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c,
+	0x52, 0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0x63, 0x62, 0x53, 0x36, 0x34,
+	0x34, 0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64, 0x33,
+	0x52, 0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47, 0x70,
+	0x34, 0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a, 0x51,
+	0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65, 0x00, 0xee, 0x00, 0x00
+};
@@ -24,6 +24,27 @@ static const uint8_t lzsa_test_01_lzsa2[] = {
   0xe7, 0xe8
 };
 // static const size_t lzsa_test_01_lzsa2_len = 38;
+static const uint8_t lzsa_test_01_lz4[] = {
+  0x82, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x68, 0x07, 0x00, 0x52,
+  0x69, 0x73, 0x20, 0x74, 0x68, 0x05, 0x00, 0xe3, 0x6e, 0x67, 0x20, 0x6f,
+  0x6e, 0x3f, 0x20, 0x42, 0x6c, 0x61, 0x68, 0x2c, 0x20, 0x62, 0x06, 0x00,
+  0x50, 0x61, 0x68, 0x2e, 0x2e, 0x2e
+};
+// static const size_t lzsa_test_01_lz4_len = 42;
+static const uint8_t lzsa_test_01_zx0[] = {
+  0x68, 0x48, 0x65, 0x6c, 0x39, 0x6f, 0x2c, 0x20, 0x68, 0xf2, 0x87, 0x69,
+  0x73, 0x20, 0x74, 0x68, 0x98, 0xf6, 0x5e, 0x6e, 0x67, 0x20, 0x6f, 0x6e,
+  0x3f, 0x20, 0x42, 0x6c, 0x61, 0x68, 0xd1, 0xe0, 0x62, 0xf4, 0xbd, 0x2e,
+  0xff, 0x55, 0x56
+};
+// static const size_t lzsa_test_01_zx0_len = 39;
+static const uint8_t lzsa_test_01_native[] = {
+  0x85, 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x2c, 0x20, 0x68, 0xf9, 0x55, 0x69,
+  0x73, 0x20, 0x74, 0x68, 0xfb, 0xe7, 0x6e, 0x67, 0x20, 0x6f, 0x6e, 0x3f,
+  0x20, 0x42, 0x6c, 0x61, 0x68, 0x2c, 0x20, 0x62, 0x09, 0xfa, 0x30, 0x2e,
+  0x2e, 0x2e, 0x00
+};
+// static const size_t lzsa_test_01_native_len = 39;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_02_plain[] = {
   0x46, 0x6f, 0x72, 0x20, 0x6d, 0x65, 0x20, 0x69, 0x74, 0x20, 0x77, 0x61,
@@ -89,6 +110,68 @@ static const uint8_t lzsa_test_02_lzsa2[] = {
   0x53, 0x61, 0x64, 0xac, 0x49, 0x62, 0xdc, 0xef, 0x3f, 0xe8
 };
 // static const size_t lzsa_test_02_lzsa2_len = 202;
+static const uint8_t lzsa_test_02_lz4[] = {
+  0xf0, 0x31, 0x46, 0x6f, 0x72, 0x20, 0x6d, 0x65, 0x20, 0x69, 0x74, 0x20,
+  0x77, 0x61, 0x73, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c, 0x6c, 0x79,
+  0x20, 0x61, 0x20, 0x72, 0x65, 0x6c, 0x69, 0x65, 0x66, 0x20, 0x74, 0x6f,
+  0x20, 0x73, 0x65, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x6e, 0x6f,
+  0x74, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68, 0x69, 0x6e, 0x67,
+  0x20, 0x69, 0x73, 0x20, 0x62, 0x65, 0x09, 0x00, 0xf0, 0x31, 0x6f, 0x76,
+  0x65, 0x72, 0x2d, 0x65, 0x78, 0x70, 0x6c, 0x61, 0x69, 0x6e, 0x65, 0x64,
+  0x2c, 0x20, 0x61, 0x20, 0x73, 0x69, 0x63, 0x6b, 0x6e, 0x65, 0x73, 0x73,
+  0x20, 0x6d, 0x61, 0x6e, 0x79, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x72, 0x6e,
+  0x20, 0x6d, 0x6f, 0x76, 0x69, 0x65, 0x73, 0x20, 0x73, 0x75, 0x66, 0x66,
+  0x65, 0x72, 0x20, 0x66, 0x72, 0x6f, 0x6d, 0x2e, 0x20, 0x57, 0x68, 0x65,
+  0x72, 0x65, 0x4a, 0x00, 0xf1, 0x01, 0x74, 0x68, 0x65, 0x20, 0x66, 0x75,
+  0x6e, 0x20, 0x69, 0x66, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0x11, 0x00,
+  0x01, 0x32, 0x00, 0xf1, 0x10, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f,
+  0x6e, 0x27, 0x74, 0x20, 0x74, 0x61, 0x6c, 0x6b, 0x20, 0x61, 0x62, 0x6f,
+  0x75, 0x74, 0x20, 0x69, 0x74, 0x2c, 0x20, 0x6c, 0x6f, 0x6f, 0x6b, 0x20,
+  0x8c, 0x00, 0xb0, 0x73, 0x20, 0x75, 0x70, 0x2c, 0x20, 0x6d, 0x61, 0x79,
+  0x62, 0x65, 0xa2, 0x00, 0xf0, 0x01, 0x6e, 0x20, 0x72, 0x65, 0x61, 0x64,
+  0x20, 0x74, 0x68, 0x65, 0x20, 0x62, 0x6f, 0x6f, 0x6b, 0x3f
+};
+// static const size_t lzsa_test_02_lz4_len = 226;
+static const uint8_t lzsa_test_02_zx0[] = {
+  0x10, 0xae, 0x46, 0x6f, 0x72, 0x20, 0x6d, 0x65, 0x20, 0x69, 0x74, 0x20,
+  0x77, 0x61, 0x73, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c, 0x79, 0xef,
+  0x5a, 0x20, 0x72, 0x65, 0x6c, 0x69, 0x65, 0x66, 0x1e, 0x74, 0x6f, 0x20,
+  0x73, 0x65, 0xc1, 0x79, 0x74, 0x68, 0x61, 0xbd, 0xa1, 0x6e, 0x6f, 0x74,
+  0xe7, 0x65, 0x76, 0x65, 0x72, 0x79, 0xe5, 0x69, 0x6e, 0x67, 0xe3, 0x99,
+  0xa1, 0x62, 0x65, 0xee, 0xee, 0x6f, 0xd8, 0x93, 0x2d, 0x65, 0x78, 0x70,
+  0x6c, 0x61, 0x9f, 0xe5, 0x65, 0x64, 0x2c, 0x87, 0x9e, 0x9b, 0x69, 0x63,
+  0x6b, 0xeb, 0xe4, 0x73, 0xbf, 0xa8, 0x6d, 0x61, 0x6e, 0x79, 0x20, 0x6d,
+  0x64, 0xbf, 0x6e, 0xf3, 0xb1, 0xa8, 0x5d, 0x73, 0x2e, 0x73, 0x75, 0x66,
+  0x66, 0x17, 0x1a, 0x66, 0x72, 0x6f, 0x6d, 0x2e, 0x7f, 0x57, 0x68, 0x65,
+  0x2f, 0x6c, 0xf6, 0x3f, 0xf7, 0x48, 0x66, 0x75, 0x6e, 0x20, 0x69, 0x66,
+  0xaf, 0x66, 0xd7, 0xf9, 0xde, 0x9c, 0x9a, 0x20, 0x79, 0x6f, 0x4f, 0x20,
+  0x64, 0x6f, 0x6e, 0x27, 0x74, 0xd9, 0x6e, 0xc9, 0x6b, 0xc3, 0xfd, 0x62,
+  0xe1, 0xeb, 0xe7, 0x9f, 0x31, 0x6c, 0x6f, 0x6f, 0xd8, 0xe3, 0xe8, 0xe7,
+  0x2f, 0x75, 0x70, 0x2c, 0xad, 0x26, 0x79, 0xdf, 0xdf, 0xbc, 0xe3, 0x73,
+  0x57, 0x61, 0x64, 0x8f, 0x7a, 0xa7, 0xb5, 0xb9, 0x3f, 0x55, 0x58
+};
+// static const size_t lzsa_test_02_zx0_len = 191;
+static const uint8_t lzsa_test_02_native[] = {
+  0xf3, 0x40, 0x46, 0x6f, 0x72, 0x20, 0x6d, 0x65, 0x20, 0x69, 0x74, 0x20,
+  0x77, 0x61, 0x73, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c, 0x6c, 0x79,
+  0x20, 0x61, 0x20, 0x72, 0x65, 0x6c, 0x69, 0x65, 0x66, 0x20, 0x74, 0x6f,
+  0x20, 0x73, 0x65, 0x65, 0x20, 0x74, 0x68, 0x61, 0x74, 0x20, 0x6e, 0x6f,
+  0x74, 0x20, 0x65, 0x76, 0x65, 0x72, 0x79, 0x74, 0x68, 0x69, 0x6e, 0x67,
+  0x20, 0x69, 0x73, 0x20, 0x62, 0x65, 0xf7, 0x12, 0x6f, 0xec, 0xf3, 0x3c,
+  0x2d, 0x65, 0x78, 0x70, 0x6c, 0x61, 0x69, 0x6e, 0x65, 0x64, 0x2c, 0x20,
+  0x61, 0x20, 0x73, 0x69, 0x63, 0x6b, 0x6e, 0x65, 0x73, 0x73, 0x20, 0x6d,
+  0x61, 0x6e, 0x79, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x72, 0x6e, 0x20, 0x6d,
+  0x6f, 0x76, 0x69, 0x65, 0x73, 0x20, 0x73, 0x75, 0x66, 0x66, 0x65, 0x72,
+  0x20, 0x66, 0x72, 0x6f, 0x6d, 0x2e, 0x20, 0x57, 0x68, 0x65, 0x72, 0x65,
+  0xb6, 0xf3, 0x10, 0x74, 0x68, 0x65, 0x20, 0x66, 0x75, 0x6e, 0x20, 0x69,
+  0x66, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72, 0xef, 0x05, 0xce, 0xf4, 0x1f,
+  0x20, 0x79, 0x6f, 0x75, 0x20, 0x64, 0x6f, 0x6e, 0x27, 0x74, 0x20, 0x74,
+  0x61, 0x6c, 0x6b, 0x20, 0x61, 0x62, 0x6f, 0x75, 0x74, 0x20, 0x69, 0x74,
+  0x2c, 0x20, 0x6c, 0x6f, 0x6f, 0x6b, 0x20, 0x74, 0x52, 0x73, 0x20, 0x75,
+  0x70, 0x2c, 0x93, 0x33, 0x79, 0x62, 0x65, 0x5e, 0x12, 0x6e, 0x42, 0x24,
+  0x61, 0x64, 0xbd, 0x12, 0x62, 0xdc, 0x10, 0x3f, 0x00
+};
+// static const size_t lzsa_test_02_native_len = 213;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_03_plain[] = {
   0x54, 0x68, 0x65, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c, 0x20, 0x64,
@@ -142,6 +225,57 @@ static const uint8_t lzsa_test_03_lzsa2[] = {
   0x34, 0xfd, 0x20, 0x2d, 0x35, 0xf7, 0x32, 0x41, 0xf0, 0xe8
 };
 // static const size_t lzsa_test_03_lzsa2_len = 154;
+static const uint8_t lzsa_test_03_lz4[] = {
+  0xf0, 0x36, 0x54, 0x68, 0x65, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c,
+  0x20, 0x64, 0x72, 0x69, 0x76, 0x65, 0x20, 0x63, 0x61, 0x70, 0x61, 0x62,
+  0x69, 0x6c, 0x69, 0x74, 0x69, 0x65, 0x73, 0x20, 0x6f, 0x66, 0x20, 0x49,
+  0x53, 0x41, 0x20, 0x6d, 0x6f, 0x74, 0x68, 0x65, 0x72, 0x62, 0x6f, 0x61,
+  0x72, 0x64, 0x73, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x76, 0x61, 0x72, 0x79,
+  0x20, 0x67, 0x72, 0x65, 0x61, 0x74, 0x6c, 0x79, 0x2e, 0x0d, 0x0a, 0x45,
+  0x00, 0xf1, 0x2e, 0x49, 0x45, 0x45, 0x45, 0x20, 0x50, 0x39, 0x39, 0x36,
+  0x20, 0x73, 0x70, 0x65, 0x63, 0x73, 0x20, 0x31, 0x2e, 0x30, 0x20, 0x6f,
+  0x66, 0x66, 0x65, 0x72, 0x73, 0x20, 0x74, 0x68, 0x65, 0x73, 0x65, 0x20,
+  0x67, 0x75, 0x69, 0x64, 0x65, 0x6c, 0x69, 0x6e, 0x65, 0x73, 0x3a, 0x0d,
+  0x0a, 0x20, 0x20, 0x20, 0x2b, 0x31, 0x32, 0x56, 0x20, 0x61, 0x74, 0x20,
+  0x31, 0x2e, 0x35, 0x41, 0x11, 0x00, 0x13, 0x2d, 0x11, 0x00, 0x32, 0x30,
+  0x2e, 0x33, 0x11, 0x00, 0x31, 0x20, 0x2b, 0x35, 0x11, 0x00, 0x14, 0x34,
+  0x22, 0x00, 0xc0, 0x20, 0x2d, 0x35, 0x56, 0x20, 0x61, 0x74, 0x20, 0x30,
+  0x2e, 0x32, 0x41
+};
+// static const size_t lzsa_test_03_lz4_len = 171;
+static const uint8_t lzsa_test_03_zx0[] = {
+  0x57, 0x54, 0x68, 0x65, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c, 0x20,
+  0x64, 0x72, 0x69, 0x76, 0x81, 0xe7, 0xa2, 0x63, 0x61, 0x70, 0x61, 0x62,
+  0x69, 0x6c, 0x69, 0x74, 0x65, 0x73, 0x84, 0xe5, 0x6f, 0x66, 0x20, 0x49,
+  0x53, 0x41, 0x20, 0x6d, 0x6f, 0x74, 0xb3, 0xe9, 0x72, 0x62, 0x6f, 0x61,
+  0x72, 0x64, 0x73, 0xbe, 0xe4, 0x6e, 0x20, 0x76, 0xed, 0x3e, 0x79, 0x20,
+  0x67, 0x72, 0x65, 0x61, 0x74, 0x6c, 0x79, 0x2e, 0x0d, 0x0a, 0x76, 0x39,
+  0x49, 0x45, 0xff, 0xa4, 0x20, 0x50, 0x39, 0xe7, 0x36, 0x20, 0x73, 0x70,
+  0x65, 0x63, 0xb3, 0x31, 0x2e, 0x30, 0xaf, 0x82, 0x66, 0x93, 0xfe, 0xeb,
+  0x87, 0x6b, 0xbf, 0x1e, 0x67, 0x75, 0x69, 0x64, 0x65, 0x51, 0xee, 0x6e,
+  0x53, 0x3a, 0x9d, 0xe1, 0x20, 0xff, 0xfa, 0x2b, 0x31, 0x32, 0x56, 0x20,
+  0x7f, 0xae, 0x38, 0x35, 0x41, 0xde, 0xa5, 0x2d, 0xaa, 0x30, 0x33, 0x4e,
+  0xbb, 0xe2, 0x35, 0xbc, 0x80, 0x34, 0x99, 0x20, 0x2d, 0x35, 0x6b, 0x32,
+  0x55, 0x55, 0x80
+};
+// static const size_t lzsa_test_03_zx0_len = 147;
+static const uint8_t lzsa_test_03_native[] = {
+  0xf3, 0x45, 0x54, 0x68, 0x65, 0x20, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c,
+  0x20, 0x64, 0x72, 0x69, 0x76, 0x65, 0x20, 0x63, 0x61, 0x70, 0x61, 0x62,
+  0x69, 0x6c, 0x69, 0x74, 0x69, 0x65, 0x73, 0x20, 0x6f, 0x66, 0x20, 0x49,
+  0x53, 0x41, 0x20, 0x6d, 0x6f, 0x74, 0x68, 0x65, 0x72, 0x62, 0x6f, 0x61,
+  0x72, 0x64, 0x73, 0x20, 0x63, 0x61, 0x6e, 0x20, 0x76, 0x61, 0x72, 0x79,
+  0x20, 0x67, 0x72, 0x65, 0x61, 0x74, 0x6c, 0x79, 0x2e, 0x0d, 0x0a, 0xbb,
+  0xf2, 0x13, 0x49, 0x45, 0x45, 0x45, 0x20, 0x50, 0x39, 0x39, 0x36, 0x20,
+  0x73, 0x70, 0x65, 0x63, 0x73, 0x20, 0x31, 0x2e, 0x30, 0xc1, 0x52, 0x66,
+  0x65, 0x72, 0x73, 0x20, 0xc3, 0xf2, 0x1a, 0x73, 0x65, 0x20, 0x67, 0x75,
+  0x69, 0x64, 0x65, 0x6c, 0x69, 0x6e, 0x65, 0x73, 0x3a, 0x0d, 0x0a, 0x20,
+  0x20, 0x20, 0x2b, 0x31, 0x32, 0x56, 0x20, 0x61, 0x74, 0xd7, 0x24, 0x35,
+  0x41, 0xef, 0x18, 0x2d, 0x07, 0x38, 0x30, 0x2e, 0x33, 0x06, 0x38, 0x20,
+  0x2b, 0x35, 0x05, 0x17, 0x34, 0x08, 0xde, 0x38, 0x20, 0x2d, 0x35, 0x07,
+  0x20, 0x32, 0x41, 0x00
+};
+// static const size_t lzsa_test_03_native_len = 160;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_04_plain[] = {
   0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
@@ -176,6 +310,19 @@ static const uint8_t lzsa_test_04_lzsa2[] = {
   0xe8
 };
 // static const size_t lzsa_test_04_lzsa2_len = 13;
+static const uint8_t lzsa_test_04_lz4[] = {
+  0x1f, 0x41, 0x01, 0x00, 0x5c, 0x1f, 0x42, 0x01, 0x00, 0x5c, 0x16, 0x43,
+  0x01, 0x00, 0x50, 0x43, 0x43, 0x43, 0x43, 0x43
+};
+// static const size_t lzsa_test_04_lz4_len = 20;
+static const uint8_t lzsa_test_04_zx0[] = {
+  0x91, 0x41, 0x56, 0x91, 0x42, 0x56, 0x95, 0x43, 0xd5, 0x55, 0x60
+};
+// static const size_t lzsa_test_04_zx0_len = 11;
+static const uint8_t lzsa_test_04_native[] = {
+  0x17, 0x41, 0x6f, 0xff, 0x18, 0x42, 0x6f, 0x18, 0x43, 0x0f, 0x00
+};
+// static const size_t lzsa_test_04_native_len = 11;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_05_plain[] = {
   0x4a, 0x35, 0x72, 0x38, 0x4b, 0x41, 0x44, 0x42, 0x31, 0x53, 0x5a, 0x49,
@@ -236,6 +383,66 @@ static const uint8_t lzsa_test_05_lzsa2[] = {
   0x63, 0x6f, 0x64, 0xe8
 };
 // static const size_t lzsa_test_05_lzsa2_len = 196;
+static const uint8_t lzsa_test_05_lz4[] = {
+  0xf0, 0xb1, 0x4a, 0x35, 0x72, 0x38, 0x4b, 0x41, 0x44, 0x42, 0x31, 0x53,
+  0x5a, 0x49, 0x79, 0x35, 0x70, 0x4e, 0x44, 0x69, 0x53, 0x52, 0x6a, 0x4a,
+  0x4c, 0x43, 0x6d, 0x58, 0x44, 0x35, 0x6e, 0x4a, 0x47, 0x35, 0x5a, 0x65,
+  0x62, 0x76, 0x70, 0x58, 0x51, 0x70, 0x37, 0x67, 0x63, 0x72, 0x6a, 0x6d,
+  0x69, 0x31, 0x48, 0x6b, 0x49, 0x4e, 0x30, 0x55, 0x34, 0x73, 0x37, 0x78,
+  0x41, 0x55, 0x59, 0x66, 0x30, 0x34, 0x6a, 0x66, 0x63, 0x66, 0x58, 0x6a,
+  0x61, 0x68, 0x32, 0x52, 0x6e, 0x37, 0x4d, 0x5a, 0x48, 0x42, 0x45, 0x69,
+  0x39, 0x68, 0x4c, 0x57, 0x61, 0x43, 0x56, 0x71, 0x79, 0x44, 0x34, 0x59,
+  0x4d, 0x43, 0x4c, 0x33, 0x56, 0x42, 0x6e, 0x71, 0x68, 0x4c, 0x64, 0x53,
+  0x42, 0x49, 0x32, 0x76, 0x74, 0x6f, 0x45, 0x56, 0x33, 0x55, 0x39, 0x6a,
+  0x58, 0x71, 0x52, 0x65, 0x4f, 0x65, 0x75, 0x4d, 0x4a, 0x33, 0x30, 0x61,
+  0x70, 0x51, 0x41, 0x61, 0x6f, 0x46, 0x36, 0x4a, 0x4e, 0x30, 0x51, 0x6d,
+  0x62, 0x39, 0x32, 0x4d, 0x50, 0x4b, 0x4a, 0x6b, 0x69, 0x75, 0x62, 0x46,
+  0x65, 0x4e, 0x58, 0x66, 0x70, 0x64, 0x6e, 0x34, 0x78, 0x63, 0x71, 0x6a,
+  0x72, 0x38, 0x72, 0x30, 0x30, 0x49, 0x79, 0x34, 0x56, 0x36, 0x65, 0x45,
+  0x64, 0x4d, 0x47, 0x4b, 0x4e, 0x4f, 0x56, 0x42, 0x4d, 0x4d, 0x70, 0x63,
+  0x6f, 0x64
+};
+// static const size_t lzsa_test_05_lz4_len = 194;
+static const uint8_t lzsa_test_05_zx0[] = {
+  0x11, 0x12, 0x4a, 0x35, 0x72, 0x38, 0x4b, 0x41, 0x44, 0x42, 0x31, 0x53,
+  0x5a, 0x49, 0x79, 0x35, 0x70, 0x4e, 0x44, 0x69, 0x53, 0x52, 0x6a, 0x4a,
+  0x4c, 0x43, 0x6d, 0x58, 0x44, 0x35, 0x6e, 0x4a, 0x47, 0x35, 0x5a, 0x65,
+  0x62, 0x76, 0x70, 0x58, 0x51, 0x70, 0x37, 0x67, 0x63, 0x72, 0x6a, 0x6d,
+  0x69, 0x31, 0x48, 0x6b, 0x49, 0x4e, 0x30, 0x55, 0x34, 0x73, 0x37, 0x78,
+  0x41, 0x55, 0x59, 0x66, 0x30, 0x34, 0x6a, 0x66, 0x63, 0x66, 0x58, 0x6a,
+  0x61, 0x68, 0x32, 0x52, 0x6e, 0x37, 0x4d, 0x5a, 0x48, 0x42, 0x45, 0x69,
+  0x39, 0x68, 0x4c, 0x57, 0x61, 0x43, 0x56, 0x71, 0x79, 0x44, 0x34, 0x59,
+  0x4d, 0x43, 0x4c, 0x33, 0x56, 0x42, 0x6e, 0x71, 0x68, 0x4c, 0x64, 0x53,
+  0x42, 0x49, 0x32, 0x76, 0x74, 0x6f, 0x45, 0x56, 0x33, 0x55, 0x39, 0x6a,
+  0x58, 0x71, 0x52, 0x65, 0x4f, 0x65, 0x75, 0x4d, 0x4a, 0x33, 0x30, 0x61,
+  0x70, 0x51, 0x41, 0x61, 0x6f, 0x46, 0x36, 0x4a, 0x4e, 0x30, 0x51, 0x6d,
+  0x62, 0x39, 0x32, 0x4d, 0x50, 0x4b, 0x4a, 0x6b, 0x69, 0x75, 0x62, 0x46,
+  0x65, 0x4e, 0x58, 0x66, 0x70, 0x64, 0x6e, 0x34, 0x78, 0x63, 0x71, 0x6a,
+  0x72, 0x38, 0x72, 0x30, 0xd8, 0xc1, 0x5e, 0x34, 0x56, 0x36, 0x65, 0x45,
+  0x64, 0x4d, 0x47, 0x4b, 0x4e, 0x4f, 0x55, 0x4d, 0x4d, 0x4d, 0x70, 0x63,
+  0x6f, 0x64, 0x55, 0x56
+};
+// static const size_t lzsa_test_05_zx0_len = 196;
+static const uint8_t lzsa_test_05_native[] = {
+  0xf0, 0xc0, 0x4a, 0x35, 0x72, 0x38, 0x4b, 0x41, 0x44, 0x42, 0x31, 0x53,
+  0x5a, 0x49, 0x79, 0x35, 0x70, 0x4e, 0x44, 0x69, 0x53, 0x52, 0x6a, 0x4a,
+  0x4c, 0x43, 0x6d, 0x58, 0x44, 0x35, 0x6e, 0x4a, 0x47, 0x35, 0x5a, 0x65,
+  0x62, 0x76, 0x70, 0x58, 0x51, 0x70, 0x37, 0x67, 0x63, 0x72, 0x6a, 0x6d,
+  0x69, 0x31, 0x48, 0x6b, 0x49, 0x4e, 0x30, 0x55, 0x34, 0x73, 0x37, 0x78,
+  0x41, 0x55, 0x59, 0x66, 0x30, 0x34, 0x6a, 0x66, 0x63, 0x66, 0x58, 0x6a,
+  0x61, 0x68, 0x32, 0x52, 0x6e, 0x37, 0x4d, 0x5a, 0x48, 0x42, 0x45, 0x69,
+  0x39, 0x68, 0x4c, 0x57, 0x61, 0x43, 0x56, 0x71, 0x79, 0x44, 0x34, 0x59,
+  0x4d, 0x43, 0x4c, 0x33, 0x56, 0x42, 0x6e, 0x71, 0x68, 0x4c, 0x64, 0x53,
+  0x42, 0x49, 0x32, 0x76, 0x74, 0x6f, 0x45, 0x56, 0x33, 0x55, 0x39, 0x6a,
+  0x58, 0x71, 0x52, 0x65, 0x4f, 0x65, 0x75, 0x4d, 0x4a, 0x33, 0x30, 0x61,
+  0x70, 0x51, 0x41, 0x61, 0x6f, 0x46, 0x36, 0x4a, 0x4e, 0x30, 0x51, 0x6d,
+  0x62, 0x39, 0x32, 0x4d, 0x50, 0x4b, 0x4a, 0x6b, 0x69, 0x75, 0x62, 0x46,
+  0x65, 0x4e, 0x58, 0x66, 0x70, 0x64, 0x6e, 0x34, 0x78, 0x63, 0x71, 0x6a,
+  0x72, 0x38, 0x72, 0x30, 0x30, 0x49, 0x79, 0x34, 0x56, 0x36, 0x65, 0x45,
+  0x64, 0x4d, 0x47, 0x4b, 0x4e, 0x4f, 0x56, 0x42, 0x4d, 0x4d, 0x70, 0x63,
+  0x6f, 0x64, 0x00
+};
+// static const size_t lzsa_test_05_native_len = 195;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_06_plain[] = {
   0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67, 0x64, 0x56,
@@ -324,6 +531,93 @@ static const uint8_t lzsa_test_06_lzsa2[] = {
   0x51, 0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65, 0xe8
 };
 // static const size_t lzsa_test_06_lzsa2_len = 309;
+static const uint8_t lzsa_test_06_lz4[] = {
+  0xf0, 0xff, 0x22, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69,
+  0x67, 0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47,
+  0x76, 0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f,
+  0x56, 0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43,
+  0x6b, 0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43,
+  0x4d, 0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71,
+  0x53, 0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73,
+  0x7a, 0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75,
+  0x53, 0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54,
+  0x7a, 0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61,
+  0x55, 0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75,
+  0x66, 0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38,
+  0x65, 0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f,
+  0x6f, 0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67,
+  0x65, 0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b,
+  0x79, 0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36,
+  0x66, 0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45,
+  0x4b, 0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68,
+  0x49, 0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57,
+  0x62, 0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32,
+  0x4f, 0x36, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c,
+  0x52, 0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0x63, 0x62, 0x53, 0x36, 0x34,
+  0x34, 0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64, 0x33,
+  0x52, 0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47, 0x70,
+  0x34, 0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a, 0x51,
+  0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65
+};
+// static const size_t lzsa_test_06_lz4_len = 307;
+static const uint8_t lzsa_test_06_zx0[] = {
+  0x51, 0x17, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67,
+  0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47, 0x76,
+  0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f, 0x56,
+  0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43, 0x6b,
+  0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43, 0x4d,
+  0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71, 0x53,
+  0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73, 0x7a,
+  0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75, 0x53,
+  0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54, 0x7a,
+  0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61, 0x55,
+  0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75, 0x66,
+  0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38, 0x65,
+  0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f, 0x6f,
+  0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67, 0x65,
+  0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b, 0x79,
+  0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36, 0x66,
+  0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45, 0x4b,
+  0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68, 0x49,
+  0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57, 0x62,
+  0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0xe5, 0x7d, 0xc7,
+  0x12, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c, 0x52,
+  0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0x63, 0x62, 0x53, 0x36, 0x34, 0x34,
+  0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64, 0x33, 0x52,
+  0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47, 0x70, 0x34,
+  0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a, 0x51, 0xa8,
+  0x54, 0x35, 0x4f, 0x43, 0x61, 0x65, 0x55, 0x58
+};
+// static const size_t lzsa_test_06_zx0_len = 308;
+static const uint8_t lzsa_test_06_native[] = {
+  0xf0, 0x00, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67,
+  0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47, 0x76,
+  0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f, 0x56,
+  0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43, 0x6b,
+  0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43, 0x4d,
+  0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71, 0x53,
+  0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73, 0x7a,
+  0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75, 0x53,
+  0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54, 0x7a,
+  0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61, 0x55,
+  0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75, 0x66,
+  0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38, 0x65,
+  0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f, 0x6f,
+  0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67, 0x65,
+  0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b, 0x79,
+  0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36, 0x66,
+  0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45, 0x4b,
+  0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68, 0x49,
+  0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57, 0x62,
+  0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32, 0x4f,
+  0x36, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c, 0x52,
+  0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0xf0, 0x30, 0x63, 0x62, 0x53, 0x36,
+  0x34, 0x34, 0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64,
+  0x33, 0x52, 0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47,
+  0x70, 0x34, 0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a,
+  0x51, 0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65, 0x00
+};
+// static const size_t lzsa_test_06_native_len = 309;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_07_plain[] = {
   0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67, 0x64, 0x56,
@@ -477,6 +771,157 @@ static const uint8_t lzsa_test_07_lzsa2[] = {
   0x54, 0xe8
 };
 // static const size_t lzsa_test_07_lzsa2_len = 566;
+static const uint8_t lzsa_test_07_lz4[] = {
+  0xf0, 0xff, 0xff, 0x23, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32,
+  0x69, 0x67, 0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b,
+  0x47, 0x76, 0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e,
+  0x4f, 0x56, 0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e,
+  0x43, 0x6b, 0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74,
+  0x43, 0x4d, 0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c,
+  0x71, 0x53, 0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53,
+  0x73, 0x7a, 0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c,
+  0x75, 0x53, 0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e,
+  0x54, 0x7a, 0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a,
+  0x61, 0x55, 0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39,
+  0x75, 0x66, 0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49,
+  0x38, 0x65, 0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a,
+  0x4f, 0x6f, 0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33,
+  0x67, 0x65, 0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65,
+  0x4b, 0x79, 0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69,
+  0x36, 0x66, 0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d,
+  0x45, 0x4b, 0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75,
+  0x68, 0x49, 0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43,
+  0x57, 0x62, 0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e,
+  0x32, 0x4f, 0x36, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38,
+  0x6c, 0x52, 0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0x63, 0x62, 0x53, 0x36,
+  0x34, 0x34, 0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64,
+  0x33, 0x52, 0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47,
+  0x70, 0x34, 0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a,
+  0x51, 0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65, 0x4a, 0x43, 0x69, 0x65,
+  0x45, 0x6a, 0x53, 0x78, 0x49, 0x6f, 0x4e, 0x4d, 0x6c, 0x70, 0x51, 0x72,
+  0x54, 0x4e, 0x6d, 0x48, 0x7a, 0x49, 0x44, 0x70, 0x6a, 0x45, 0x73, 0x49,
+  0x73, 0x48, 0x6b, 0x66, 0x36, 0x65, 0x6e, 0x35, 0x4d, 0x48, 0x6d, 0x65,
+  0x72, 0x59, 0x79, 0x6c, 0x42, 0x52, 0x41, 0x76, 0x71, 0x45, 0x48, 0x52,
+  0x71, 0x4c, 0x66, 0x41, 0x46, 0x56, 0x67, 0x6c, 0x41, 0x6e, 0x33, 0x4e,
+  0x47, 0x6f, 0x68, 0x35, 0x38, 0x68, 0x31, 0x61, 0x30, 0x5a, 0x64, 0x73,
+  0x4d, 0x6d, 0x65, 0x58, 0x64, 0x68, 0x6c, 0x6d, 0x74, 0x46, 0x32, 0x4d,
+  0x44, 0x47, 0x45, 0x41, 0x45, 0x70, 0x74, 0x56, 0x42, 0x67, 0x6d, 0x6b,
+  0x75, 0x6e, 0x62, 0x61, 0x36, 0x36, 0x5a, 0x32, 0x39, 0x49, 0x55, 0x55,
+  0x50, 0x69, 0x62, 0x72, 0x33, 0x36, 0x51, 0x30, 0x49, 0x61, 0x36, 0x39,
+  0x37, 0x5a, 0x69, 0x44, 0x37, 0x63, 0x7a, 0x47, 0x61, 0x37, 0x41, 0x73,
+  0x77, 0x55, 0x42, 0x42, 0x64, 0x50, 0x76, 0x44, 0x39, 0x31, 0x78, 0x47,
+  0x32, 0x6b, 0x56, 0x75, 0x57, 0x58, 0x75, 0x31, 0x59, 0x6d, 0x67, 0x61,
+  0x46, 0x78, 0x4d, 0x42, 0x35, 0x6a, 0x37, 0x78, 0x4c, 0x39, 0x51, 0x5a,
+  0x4d, 0x73, 0x59, 0x4c, 0x42, 0x54, 0x44, 0x48, 0x52, 0x67, 0x38, 0x77,
+  0x76, 0x78, 0x45, 0x70, 0x48, 0x6e, 0x5a, 0x43, 0x74, 0x4e, 0x56, 0x43,
+  0x41, 0x74, 0x45, 0x6e, 0x47, 0x4a, 0x46, 0x6d, 0x32, 0x30, 0x56, 0x45,
+  0x31, 0x30, 0x73, 0x6b, 0x6b, 0x43, 0x36, 0x46, 0x37, 0x70, 0x69, 0x46,
+  0x43, 0x6c, 0x53, 0x31, 0x55, 0x77, 0x36, 0x73, 0x4a, 0x50, 0x76, 0x6a,
+  0x52, 0x72, 0x78, 0x69, 0x63, 0x68, 0x56, 0x5a, 0x7a, 0x68, 0x33, 0x6b,
+  0x55, 0x53, 0x54, 0x4c, 0x45, 0x33, 0x44, 0x32, 0x33, 0x45, 0x71, 0x54
+};
+// static const size_t lzsa_test_07_lz4_len = 564;
+static const uint8_t lzsa_test_07_zx0[] = {
+  0x14, 0x44, 0xf9, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69,
+  0x67, 0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47,
+  0x76, 0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f,
+  0x56, 0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43,
+  0x6b, 0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43,
+  0x4d, 0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71,
+  0x53, 0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73,
+  0x7a, 0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75,
+  0x53, 0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54,
+  0x7a, 0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61,
+  0x55, 0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75,
+  0x66, 0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38,
+  0x65, 0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f,
+  0x6f, 0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67,
+  0x65, 0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b,
+  0x79, 0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36,
+  0x66, 0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45,
+  0x4b, 0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68,
+  0x49, 0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57,
+  0x62, 0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32,
+  0x4f, 0x36, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c,
+  0x52, 0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0x63, 0x62, 0x53, 0x36, 0x34,
+  0x34, 0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64, 0x33,
+  0x52, 0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47, 0x70,
+  0x34, 0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a, 0x51,
+  0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65, 0x4a, 0x43, 0x69, 0x65, 0x45,
+  0x6a, 0x53, 0x78, 0x49, 0x6f, 0x4e, 0x4d, 0x6c, 0x70, 0x51, 0x72, 0x54,
+  0x4e, 0x6d, 0x48, 0x7a, 0x49, 0x44, 0x70, 0x6a, 0x45, 0x73, 0x49, 0x73,
+  0x48, 0x6b, 0x66, 0x36, 0x65, 0x6e, 0x35, 0x4d, 0x48, 0x6d, 0x65, 0x72,
+  0x59, 0x79, 0x6c, 0x42, 0x52, 0x41, 0x76, 0x71, 0x45, 0x48, 0x52, 0x71,
+  0x4c, 0x66, 0x41, 0x46, 0x56, 0x59, 0x1d, 0x50, 0x2b, 0x33, 0x4e, 0x47,
+  0x6f, 0x68, 0x35, 0x38, 0x68, 0x31, 0x61, 0x30, 0x5a, 0x64, 0x73, 0x4d,
+  0x6d, 0x65, 0x58, 0x64, 0x68, 0x6c, 0x6d, 0x74, 0x46, 0x32, 0x4d, 0x44,
+  0x47, 0x45, 0x41, 0x45, 0x70, 0x74, 0x56, 0x42, 0x67, 0x6d, 0x6b, 0x75,
+  0x6e, 0x62, 0x61, 0x36, 0x36, 0x5a, 0x32, 0x39, 0x49, 0x55, 0x55, 0x50,
+  0x69, 0x62, 0x72, 0x33, 0x36, 0x51, 0x30, 0x49, 0x61, 0x36, 0x39, 0x37,
+  0x5a, 0x69, 0x44, 0x37, 0x63, 0x7a, 0x47, 0x61, 0x37, 0x41, 0x73, 0x77,
+  0x55, 0x42, 0x42, 0x64, 0x50, 0x76, 0x44, 0x39, 0x31, 0x78, 0x47, 0x32,
+  0x6b, 0x56, 0x75, 0x57, 0x58, 0x75, 0x31, 0x59, 0x6d, 0x67, 0x61, 0x46,
+  0x78, 0x4d, 0x42, 0x35, 0x6a, 0x37, 0x78, 0x4c, 0x39, 0x51, 0x5a, 0x4d,
+  0x73, 0x59, 0x4c, 0x42, 0x54, 0x44, 0x48, 0x52, 0x67, 0x77, 0x5e, 0xc3,
+  0x45, 0xd8, 0x48, 0x73, 0x10, 0xae, 0x43, 0x74, 0x4e, 0x56, 0x43, 0x41,
+  0x74, 0x45, 0x6e, 0x47, 0x4a, 0x46, 0x6d, 0x32, 0x30, 0x56, 0x45, 0x31,
+  0x30, 0x73, 0x6b, 0x6b, 0x43, 0x36, 0x46, 0x37, 0x70, 0x69, 0x46, 0x43,
+  0x6c, 0x53, 0x31, 0x55, 0x77, 0x36, 0x4a, 0x51, 0x69, 0x6a, 0x52, 0x72,
+  0xa0, 0x69, 0x63, 0x68, 0x1d, 0x5a, 0x7a, 0x68, 0x33, 0x6b, 0x55, 0x53,
+  0x54, 0x4c, 0x45, 0x33, 0x44, 0x32, 0x33, 0x45, 0x71, 0x54, 0x55, 0x56
+};
+// static const size_t lzsa_test_07_zx0_len = 564;
+static const uint8_t lzsa_test_07_native[] = {
+  0xf0, 0x00, 0x31, 0x69, 0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67,
+  0x64, 0x56, 0x6e, 0x67, 0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47, 0x76,
+  0x39, 0x36, 0x6e, 0x55, 0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f, 0x56,
+  0x74, 0x42, 0x67, 0x7a, 0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43, 0x6b,
+  0x78, 0x72, 0x55, 0x75, 0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43, 0x4d,
+  0x42, 0x39, 0x74, 0x43, 0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71, 0x53,
+  0x41, 0x68, 0x49, 0x76, 0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73, 0x7a,
+  0x34, 0x62, 0x57, 0x36, 0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75, 0x53,
+  0x32, 0x6e, 0x56, 0x4c, 0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54, 0x7a,
+  0x58, 0x32, 0x5a, 0x59, 0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61, 0x55,
+  0x4d, 0x75, 0x50, 0x4c, 0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75, 0x66,
+  0x56, 0x71, 0x74, 0x43, 0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38, 0x65,
+  0x69, 0x69, 0x6b, 0x65, 0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f, 0x6f,
+  0x7a, 0x65, 0x64, 0x50, 0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67, 0x65,
+  0x42, 0x4a, 0x78, 0x4e, 0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b, 0x79,
+  0x65, 0x52, 0x34, 0x78, 0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36, 0x66,
+  0x6e, 0x6a, 0x68, 0x4e, 0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45, 0x4b,
+  0x76, 0x36, 0x51, 0x54, 0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68, 0x49,
+  0x41, 0x6f, 0x39, 0x7a, 0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57, 0x62,
+  0x78, 0x56, 0x6b, 0x52, 0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32, 0x4f,
+  0x36, 0x77, 0x56, 0x73, 0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c, 0x52,
+  0x41, 0x6e, 0x4e, 0x4d, 0x54, 0x51, 0xf0, 0x00, 0x63, 0x62, 0x53, 0x36,
+  0x34, 0x34, 0x54, 0x76, 0x49, 0x41, 0x30, 0x42, 0x57, 0x45, 0x31, 0x64,
+  0x33, 0x52, 0x59, 0x58, 0x4f, 0x50, 0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47,
+  0x70, 0x34, 0x4d, 0x72, 0x6f, 0x4d, 0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a,
+  0x51, 0x57, 0x54, 0x31, 0x4f, 0x43, 0x61, 0x65, 0x4a, 0x43, 0x69, 0x65,
+  0x45, 0x6a, 0x53, 0x78, 0x49, 0x6f, 0x4e, 0x4d, 0x6c, 0x70, 0x51, 0x72,
+  0x54, 0x4e, 0x6d, 0x48, 0x7a, 0x49, 0x44, 0x70, 0x6a, 0x45, 0x73, 0x49,
+  0x73, 0x48, 0x6b, 0x66, 0x36, 0x65, 0x6e, 0x35, 0x4d, 0x48, 0x6d, 0x65,
+  0x72, 0x59, 0x79, 0x6c, 0x42, 0x52, 0x41, 0x76, 0x71, 0x45, 0x48, 0x52,
+  0x71, 0x4c, 0x66, 0x41, 0x46, 0x56, 0x67, 0x6c, 0x41, 0x6e, 0x33, 0x4e,
+  0x47, 0x6f, 0x68, 0x35, 0x38, 0x68, 0x31, 0x61, 0x30, 0x5a, 0x64, 0x73,
+  0x4d, 0x6d, 0x65, 0x58, 0x64, 0x68, 0x6c, 0x6d, 0x74, 0x46, 0x32, 0x4d,
+  0x44, 0x47, 0x45, 0x41, 0x45, 0x70, 0x74, 0x56, 0x42, 0x67, 0x6d, 0x6b,
+  0x75, 0x6e, 0x62, 0x61, 0x36, 0x36, 0x5a, 0x32, 0x39, 0x49, 0x55, 0x55,
+  0x50, 0x69, 0x62, 0x72, 0x33, 0x36, 0x51, 0x30, 0x49, 0x61, 0x36, 0x39,
+  0x37, 0x5a, 0x69, 0x44, 0x37, 0x63, 0x7a, 0x47, 0x61, 0x37, 0x41, 0x73,
+  0x77, 0x55, 0x42, 0x42, 0x64, 0x50, 0x76, 0x44, 0x39, 0x31, 0x78, 0x47,
+  0x32, 0x6b, 0x56, 0x75, 0x57, 0x58, 0x75, 0x31, 0x59, 0x6d, 0x67, 0x61,
+  0x46, 0x78, 0x4d, 0x42, 0x35, 0x6a, 0x37, 0x78, 0x4c, 0x39, 0x51, 0x5a,
+  0x4d, 0x73, 0x59, 0x4c, 0x42, 0x54, 0x44, 0x48, 0x52, 0x67, 0x38, 0x77,
+  0x76, 0x78, 0x45, 0x70, 0x48, 0x6e, 0x5a, 0x43, 0x74, 0x4e, 0x56, 0x43,
+  0x41, 0x74, 0x45, 0x6e, 0x47, 0x4a, 0x46, 0x6d, 0x32, 0x30, 0x56, 0x45,
+  0xf0, 0x30, 0x31, 0x30, 0x73, 0x6b, 0x6b, 0x43, 0x36, 0x46, 0x37, 0x70,
+  0x69, 0x46, 0x43, 0x6c, 0x53, 0x31, 0x55, 0x77, 0x36, 0x73, 0x4a, 0x50,
+  0x76, 0x6a, 0x52, 0x72, 0x78, 0x69, 0x63, 0x68, 0x56, 0x5a, 0x7a, 0x68,
+  0x33, 0x6b, 0x55, 0x53, 0x54, 0x4c, 0x45, 0x33, 0x44, 0x32, 0x33, 0x45,
+  0x71, 0x54, 0x00
+};
+// static const size_t lzsa_test_07_native_len = 567;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_08_plain[] = {
   0x04, 0x97, 0x89, 0x8d, 0x00, 0xa6, 0xc9, 0x5b, 0x02, 0x87, 0x1e, 0x06,
@@ -554,6 +999,79 @@ static const uint8_t lzsa_test_08_lzsa2[] = {
   0x1e, 0x0f, 0x1f, 0x0f, 0x20, 0x5f, 0x1f, 0xf0, 0xe8
 };
 // static const size_t lzsa_test_08_lzsa2_len = 249;
+static const uint8_t lzsa_test_08_lz4[] = {
+  0xff, 0x13, 0x04, 0x97, 0x89, 0x8d, 0x00, 0xa6, 0xc9, 0x5b, 0x02, 0x87,
+  0x1e, 0x06, 0x89, 0x1e, 0x06, 0x89, 0x5f, 0x89, 0x4b, 0x1e, 0x4b, 0xa9,
+  0x4b, 0x00, 0x8d, 0x00, 0xaa, 0x04, 0x5b, 0x09, 0x87, 0x96, 0x1c, 0x00,
+  0x17, 0x00, 0x01, 0xf0, 0x07, 0x7b, 0x04, 0xab, 0x30, 0xa1, 0x39, 0x23,
+  0x08, 0xab, 0x07, 0x0d, 0x05, 0x27, 0x02, 0xab, 0x20, 0x1e, 0x09, 0x89,
+  0x88, 0x4b, 0x77, 0x21, 0x00, 0xf0, 0x0c, 0x1e, 0x0d, 0x89, 0x7b, 0x0e,
+  0x88, 0x87, 0x5b, 0x03, 0x87, 0x88, 0x7b, 0x05, 0x4e, 0xa4, 0x0f, 0x6b,
+  0x01, 0x1e, 0x0a, 0x89, 0x1e, 0x0a, 0x89, 0x7b, 0x0b, 0x88, 0x03, 0x00,
+  0xaf, 0x07, 0x88, 0x8d, 0x00, 0xa9, 0x56, 0x5b, 0x07, 0x7b, 0x05, 0x1b,
+  0x00, 0x05, 0xf0, 0x67, 0x08, 0x87, 0x52, 0x0b, 0x16, 0x0f, 0x17, 0x01,
+  0x93, 0x90, 0xee, 0x02, 0xfe, 0x1f, 0x07, 0x1e, 0x01, 0x1c, 0x00, 0x04,
+  0xa6, 0x20, 0x6b, 0x0b, 0xf6, 0x48, 0x6b, 0x06, 0x7b, 0x07, 0x48, 0x4f,
+  0x49, 0x1a, 0x06, 0xf7, 0x90, 0x58, 0x09, 0x08, 0x09, 0x07, 0x11, 0x11,
+  0x25, 0x15, 0xf6, 0x10, 0x11, 0xf7, 0x90, 0x54, 0x99, 0x90, 0x59, 0x7b,
+  0x07, 0x6b, 0x03, 0x7b, 0x08, 0x6b, 0x08, 0x7b, 0x03, 0x6b, 0x07, 0x0a,
+  0x0b, 0x0d, 0x0b, 0x26, 0xcf, 0x1e, 0x01, 0xef, 0x02, 0x16, 0x07, 0xff,
+  0x5b, 0x0b, 0x87, 0x52, 0x29, 0x5f, 0x1f, 0x10, 0x96, 0x1c, 0x00, 0x09,
+  0x1f, 0x12, 0x1f, 0x14, 0x16, 0x12, 0x17, 0x16, 0x1e, 0x32, 0xf6, 0x5c,
+  0x1f, 0x32, 0x97, 0x4d, 0x26, 0x04, 0xac, 0x00, 0xb0, 0xb4, 0x9f, 0xa1,
+  0x25, 0x27, 0x09, 0x00, 0xf0, 0x06, 0x96, 0x0f, 0x18, 0x0f, 0x19, 0x0f,
+  0x1a, 0x0f, 0x1b, 0x0f, 0x1c, 0x0f, 0x1d, 0x0f, 0x1e, 0x0f, 0x1f, 0x0f,
+  0x20, 0x5f, 0x1f
+};
+// static const size_t lzsa_test_08_lz4_len = 255;
+static const uint8_t lzsa_test_08_zx0[] = {
+  0x47, 0x04, 0x97, 0x89, 0x8d, 0x00, 0xa6, 0xc9, 0x5b, 0x02, 0x87, 0x1e,
+  0x06, 0x89, 0xa0, 0xfa, 0x38, 0x5f, 0x89, 0x4b, 0x1e, 0x4b, 0xa9, 0x4b,
+  0x00, 0xd7, 0xaa, 0xaa, 0x04, 0x09, 0x78, 0x96, 0x1c, 0x00, 0xd2, 0x58,
+  0x53, 0x7b, 0x04, 0xab, 0x30, 0xa1, 0x39, 0x23, 0x08, 0xab, 0x07, 0x0d,
+  0x05, 0x27, 0x02, 0xab, 0x20, 0x1e, 0x09, 0x89, 0x88, 0x4b, 0x77, 0xe4,
+  0x90, 0xa1, 0x1e, 0x0d, 0x89, 0x7b, 0x0e, 0x88, 0x6b, 0x5b, 0x03, 0x87,
+  0x88, 0x7b, 0x05, 0x4e, 0xa4, 0x0f, 0x6b, 0x01, 0x0a, 0xe6, 0x7f, 0xfb,
+  0x7b, 0x0b, 0x88, 0x0a, 0x07, 0xe2, 0x7d, 0xa9, 0x56, 0xbe, 0x07, 0xc9,
+  0xca, 0x56, 0x45, 0x62, 0x08, 0x87, 0x52, 0x0b, 0x16, 0x0f, 0x17, 0x01,
+  0x93, 0x90, 0xee, 0x02, 0xfe, 0x1f, 0x07, 0x1e, 0x01, 0x1c, 0x00, 0x04,
+  0xa6, 0x20, 0x6b, 0x0b, 0xf6, 0x48, 0x6b, 0x06, 0x7b, 0x07, 0x48, 0x4f,
+  0x49, 0x1a, 0x06, 0xf7, 0x90, 0x58, 0x09, 0x08, 0x09, 0x07, 0x11, 0x11,
+  0x25, 0x15, 0xf6, 0x10, 0x11, 0xf7, 0x90, 0x54, 0x99, 0x90, 0x59, 0x00,
+  0xe4, 0x6b, 0x03, 0x7b, 0x08, 0x6b, 0x08, 0x7b, 0x03, 0x6b, 0x07, 0x0a,
+  0x0b, 0x0d, 0x0b, 0x26, 0xcf, 0x8d, 0xb8, 0xef, 0x02, 0x16, 0x07, 0xff,
+  0x5b, 0x5f, 0x36, 0x29, 0x5f, 0x1f, 0x10, 0x6c, 0x90, 0x28, 0x09, 0x1f,
+  0x12, 0x1f, 0x14, 0x16, 0x12, 0x17, 0x16, 0x1e, 0x32, 0xf6, 0x5c, 0x1f,
+  0x32, 0x97, 0x4d, 0x26, 0x04, 0xac, 0x00, 0xb0, 0xb4, 0x9f, 0xf8, 0x25,
+  0x27, 0xee, 0x17, 0x96, 0x0f, 0x18, 0x0f, 0x19, 0x0f, 0x1a, 0x0f, 0x1b,
+  0x0f, 0x1c, 0x0f, 0x1d, 0x0f, 0x1e, 0x0f, 0x1f, 0x0f, 0x20, 0xd5, 0x91,
+  0x55, 0x60
+};
+// static const size_t lzsa_test_08_zx0_len = 242;
+static const uint8_t lzsa_test_08_native[] = {
+  0xf7, 0x22, 0x04, 0x97, 0x89, 0x8d, 0x00, 0xa6, 0xc9, 0x5b, 0x02, 0x87,
+  0x1e, 0x06, 0x89, 0x1e, 0x06, 0x89, 0x5f, 0x89, 0x4b, 0x1e, 0x4b, 0xa9,
+  0x4b, 0x00, 0x8d, 0x00, 0xaa, 0x04, 0x5b, 0x09, 0x87, 0x96, 0x1c, 0x00,
+  0x14, 0xe9, 0xf3, 0x16, 0x7b, 0x04, 0xab, 0x30, 0xa1, 0x39, 0x23, 0x08,
+  0xab, 0x07, 0x0d, 0x05, 0x27, 0x02, 0xab, 0x20, 0x1e, 0x09, 0x89, 0x88,
+  0x4b, 0x77, 0xdf, 0xf2, 0x15, 0x1e, 0x0d, 0x89, 0x7b, 0x0e, 0x88, 0x87,
+  0x5b, 0x03, 0x87, 0x88, 0x7b, 0x05, 0x4e, 0xa4, 0x0f, 0x6b, 0x01, 0x1e,
+  0x0a, 0x89, 0xfd, 0x38, 0x7b, 0x0b, 0x88, 0x04, 0xa7, 0x07, 0x88, 0x8d,
+  0x00, 0xa9, 0x56, 0x5b, 0x07, 0x7b, 0x05, 0x18, 0xe5, 0xf3, 0x76, 0x08,
+  0x87, 0x52, 0x0b, 0x16, 0x0f, 0x17, 0x01, 0x93, 0x90, 0xee, 0x02, 0xfe,
+  0x1f, 0x07, 0x1e, 0x01, 0x1c, 0x00, 0x04, 0xa6, 0x20, 0x6b, 0x0b, 0xf6,
+  0x48, 0x6b, 0x06, 0x7b, 0x07, 0x48, 0x4f, 0x49, 0x1a, 0x06, 0xf7, 0x90,
+  0x58, 0x09, 0x08, 0x09, 0x07, 0x11, 0x11, 0x25, 0x15, 0xf6, 0x10, 0x11,
+  0xf7, 0x90, 0x54, 0x99, 0x90, 0x59, 0x7b, 0x07, 0x6b, 0x03, 0x7b, 0x08,
+  0x6b, 0x08, 0x7b, 0x03, 0x6b, 0x07, 0x0a, 0x0b, 0x0d, 0x0b, 0x26, 0xcf,
+  0x1e, 0x01, 0xef, 0x02, 0x16, 0x07, 0xff, 0x5b, 0x0b, 0x87, 0x52, 0x29,
+  0x5f, 0x1f, 0x10, 0x96, 0x1c, 0x00, 0x09, 0x1f, 0x12, 0x1f, 0x14, 0x16,
+  0x12, 0x17, 0x16, 0x1e, 0x32, 0xf6, 0x5c, 0x1f, 0x32, 0x97, 0x4d, 0x26,
+  0x04, 0xac, 0x00, 0xb0, 0xb4, 0x9f, 0xa1, 0x25, 0x27, 0xf7, 0xf0, 0x15,
+  0x96, 0x0f, 0x18, 0x0f, 0x19, 0x0f, 0x1a, 0x0f, 0x1b, 0x0f, 0x1c, 0x0f,
+  0x1d, 0x0f, 0x1e, 0x0f, 0x1f, 0x0f, 0x20, 0x5f, 0x1f, 0x00
+};
+// static const size_t lzsa_test_08_native_len = 250;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_09_plain[] = {
   0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
@@ -590,6 +1108,18 @@ static const uint8_t lzsa_test_09_lzsa2[] = {
   0x0f, 0x41, 0xff, 0xe9, 0x1f, 0x01, 0xe7, 0xf0, 0xe8
 };
 // static const size_t lzsa_test_09_lzsa2_len = 9;
+static const uint8_t lzsa_test_09_lz4[] = {
+  0x1f, 0x41, 0x01, 0x00, 0xff, 0x08, 0x50, 0x41, 0x41, 0x41, 0x41, 0x41
+};
+// static const size_t lzsa_test_09_lz4_len = 12;
+static const uint8_t lzsa_test_09_zx0[] = {
+  0x80, 0x41, 0x55, 0x75, 0x55, 0x58
+};
+// static const size_t lzsa_test_09_zx0_len = 6;
+static const uint8_t lzsa_test_09_native[] = {
+  0x17, 0x41, 0x00, 0xff, 0x08, 0x1f, 0x00
+};
+// static const size_t lzsa_test_09_native_len = 7;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_10_plain[] = {
   0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41, 0x41,
@@ -649,6 +1179,19 @@ static const uint8_t lzsa_test_10_lzsa2[] = {
   0x0f, 0x41, 0xff, 0xe9, 0x2f, 0x02, 0xe7, 0xf0, 0xe8
 };
 // static const size_t lzsa_test_10_lzsa2_len = 9;
+static const uint8_t lzsa_test_10_lz4[] = {
+  0x1f, 0x41, 0x01, 0x00, 0xff, 0xff, 0x19, 0x50, 0x41, 0x41, 0x41, 0x41,
+  0x41
+};
+// static const size_t lzsa_test_10_lz4_len = 13;
+static const uint8_t lzsa_test_10_zx0[] = {
+  0x80, 0x41, 0x45, 0x5d, 0x55, 0x56
+};
+// static const size_t lzsa_test_10_zx0_len = 6;
+static const uint8_t lzsa_test_10_native[] = {
+  0x17, 0x41, 0x00, 0xff, 0x08, 0x00, 0x08, 0x2f, 0x00
+};
+// static const size_t lzsa_test_10_native_len = 9;
 /******************************************************************************/ 
 static const uint8_t lzsa_test_11_plain[] = {
   0x41, 0x6c, 0x69, 0x63, 0x65, 0x20, 0x77, 0x61, 0x73, 0x20, 0x62, 0x65,
@@ -984,3 +1527,295 @@ static const uint8_t lzsa_test_11_lzsa2[] = {
   0x8b, 0xa2, 0xfe, 0x56, 0xb3, 0x65, 0x70, 0xc6, 0xef, 0x2e, 0xf0, 0xe8
 };
 // static const size_t lzsa_test_11_lzsa2_len = 1044;
+static const uint8_t lzsa_test_11_lz4[] = {
+  0xf0, 0x1e, 0x41, 0x6c, 0x69, 0x63, 0x65, 0x20, 0x77, 0x61, 0x73, 0x20,
+  0x62, 0x65, 0x67, 0x69, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x20, 0x74, 0x6f,
+  0x20, 0x67, 0x65, 0x74, 0x20, 0x76, 0x65, 0x72, 0x79, 0x20, 0x74, 0x69,
+  0x72, 0x65, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x73, 0x69, 0x74, 0x74, 0x1d,
+  0x00, 0xf1, 0x0f, 0x62, 0x79, 0x20, 0x68, 0x65, 0x72, 0x20, 0x73, 0x69,
+  0x73, 0x74, 0x65, 0x72, 0x20, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x0d,
+  0x0a, 0x62, 0x61, 0x6e, 0x6b, 0x2c, 0x20, 0x61, 0x6e, 0x2b, 0x00, 0x30,
+  0x68, 0x61, 0x76, 0x2a, 0x00, 0x43, 0x6e, 0x6f, 0x74, 0x68, 0x4f, 0x00,
+  0xe0, 0x64, 0x6f, 0x3a, 0x20, 0x6f, 0x6e, 0x63, 0x65, 0x20, 0x6f, 0x72,
+  0x20, 0x74, 0x77, 0x72, 0x00, 0xf8, 0x0e, 0x73, 0x68, 0x65, 0x20, 0x68,
+  0x61, 0x64, 0x20, 0x70, 0x65, 0x65, 0x70, 0x65, 0x64, 0x20, 0x69, 0x6e,
+  0x74, 0x6f, 0x0d, 0x0a, 0x74, 0x68, 0x65, 0x20, 0x62, 0x6f, 0x6f, 0x6b,
+  0x62, 0x00, 0x00, 0x9b, 0x00, 0xf1, 0x00, 0x72, 0x65, 0x61, 0x64, 0x69,
+  0x6e, 0x67, 0x2c, 0x20, 0x62, 0x75, 0x74, 0x20, 0x69, 0x74, 0x39, 0x00,
+  0xf0, 0x17, 0x6e, 0x6f, 0x20, 0x70, 0x69, 0x63, 0x74, 0x75, 0x72, 0x65,
+  0x73, 0x20, 0x6f, 0x72, 0x0d, 0x0a, 0x63, 0x6f, 0x6e, 0x76, 0x65, 0x72,
+  0x73, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0x20, 0x69, 0x6e, 0x20, 0x69,
+  0x74, 0x2c, 0x20, 0x93, 0x92, 0x00, 0x80, 0x77, 0x68, 0x61, 0x74, 0x20,
+  0x69, 0x73, 0x20, 0x5e, 0x00, 0x30, 0x75, 0x73, 0x65, 0xa2, 0x00, 0x11,
+  0x61, 0x67, 0x00, 0xb1, 0x2c, 0x94, 0x20, 0x74, 0x68, 0x6f, 0x75, 0x67,
+  0x68, 0x74, 0x20, 0x07, 0x01, 0x50, 0x0d, 0x0a, 0x93, 0x77, 0x69, 0x12,
+  0x00, 0x18, 0x74, 0x5b, 0x00, 0x19, 0x20, 0x5a, 0x00, 0x80, 0x3f, 0x94,
+  0x0d, 0x0a, 0x0d, 0x0a, 0x53, 0x6f, 0xc1, 0x00, 0x00, 0x9c, 0x00, 0x00,
+  0x1e, 0x00, 0x50, 0x73, 0x69, 0x64, 0x65, 0x72, 0xea, 0x00, 0x21, 0x69,
+  0x6e, 0xba, 0x00, 0xf1, 0x05, 0x6f, 0x77, 0x6e, 0x20, 0x6d, 0x69, 0x6e,
+  0x64, 0x20, 0x28, 0x61, 0x73, 0x20, 0x77, 0x65, 0x6c, 0x6c, 0x20, 0x61,
+  0x73, 0x30, 0x00, 0xa2, 0x63, 0x6f, 0x75, 0x6c, 0x64, 0x2c, 0x20, 0x66,
+  0x6f, 0x72, 0x36, 0x01, 0xc1, 0x68, 0x6f, 0x74, 0x20, 0x64, 0x61, 0x79,
+  0x20, 0x6d, 0x61, 0x64, 0x65, 0x3a, 0x00, 0x42, 0x66, 0x65, 0x65, 0x6c,
+  0x78, 0x01, 0x61, 0x73, 0x6c, 0x65, 0x65, 0x70, 0x79, 0x52, 0x01, 0xd0,
+  0x73, 0x74, 0x75, 0x70, 0x69, 0x64, 0x29, 0x2c, 0x20, 0x77, 0x68, 0x65,
+  0x74, 0x26, 0x00, 0x00, 0xc9, 0x00, 0x70, 0x70, 0x6c, 0x65, 0x61, 0x73,
+  0x75, 0x72, 0xce, 0x00, 0x50, 0x0d, 0x0a, 0x6d, 0x61, 0x6b, 0x7f, 0x00,
+  0xf0, 0x00, 0x61, 0x20, 0x64, 0x61, 0x69, 0x73, 0x79, 0x2d, 0x63, 0x68,
+  0x61, 0x69, 0x6e, 0x20, 0x77, 0x6d, 0x00, 0x91, 0x20, 0x62, 0x65, 0x20,
+  0x77, 0x6f, 0x72, 0x74, 0x68, 0x35, 0x00, 0x61, 0x74, 0x72, 0x6f, 0x75,
+  0x62, 0x6c, 0x02, 0x01, 0x22, 0x67, 0x65, 0xcf, 0x01, 0x20, 0x75, 0x70,
+  0x64, 0x00, 0x51, 0x0d, 0x0a, 0x70, 0x69, 0x63, 0x44, 0x00, 0x00, 0x27,
+  0x00, 0x00, 0x46, 0x00, 0x31, 0x69, 0x65, 0x73, 0x71, 0x00, 0xf0, 0x0b,
+  0x6e, 0x20, 0x73, 0x75, 0x64, 0x64, 0x65, 0x6e, 0x6c, 0x79, 0x20, 0x61,
+  0x20, 0x57, 0x68, 0x69, 0x74, 0x65, 0x20, 0x52, 0x61, 0x62, 0x62, 0x69,
+  0x74, 0x20, 0x2b, 0x01, 0xf3, 0x06, 0x20, 0x70, 0x69, 0x6e, 0x6b, 0x20,
+  0x65, 0x79, 0x65, 0x73, 0x20, 0x72, 0x61, 0x6e, 0x0d, 0x0a, 0x63, 0x6c,
+  0x6f, 0x73, 0x65, 0x23, 0x02, 0x10, 0x2e, 0x29, 0x01, 0x42, 0x54, 0x68,
+  0x65, 0x72, 0x28, 0x01, 0x04, 0x0e, 0x02, 0x40, 0x73, 0x6f, 0x20, 0x5f,
+  0xe2, 0x00, 0x90, 0x5f, 0x20, 0x72, 0x65, 0x6d, 0x61, 0x72, 0x6b, 0x61,
+  0x91, 0x00, 0x10, 0x69, 0x47, 0x02, 0xc2, 0x61, 0x74, 0x3b, 0x20, 0x6e,
+  0x6f, 0x72, 0x20, 0x64, 0x69, 0x64, 0x20, 0x97, 0x02, 0x20, 0x74, 0x68,
+  0x5f, 0x00, 0x46, 0x69, 0x74, 0x0d, 0x0a, 0x36, 0x00, 0x80, 0x6d, 0x75,
+  0x63, 0x68, 0x20, 0x6f, 0x75, 0x74, 0xc5, 0x00, 0x11, 0x74, 0x84, 0x01,
+  0x10, 0x79, 0x62, 0x02, 0x32, 0x68, 0x65, 0x61, 0x19, 0x01, 0x03, 0x9e,
+  0x00, 0x12, 0x73, 0x17, 0x00, 0xf2, 0x07, 0x69, 0x74, 0x73, 0x65, 0x6c,
+  0x66, 0x2c, 0x20, 0x93, 0x4f, 0x68, 0x0d, 0x0a, 0x64, 0x65, 0x61, 0x72,
+  0x21, 0x20, 0x4f, 0x68, 0x20, 0x09, 0x00, 0x70, 0x49, 0x20, 0x73, 0x68,
+  0x61, 0x6c, 0x6c, 0x23, 0x01, 0x82, 0x6c, 0x61, 0x74, 0x65, 0x21, 0x94,
+  0x20, 0x28, 0xf1, 0x00, 0x24, 0x68, 0x65, 0x18, 0x02, 0x00, 0x6d, 0x02,
+  0xf0, 0x03, 0x6f, 0x76, 0x65, 0x72, 0x20, 0x61, 0x66, 0x74, 0x65, 0x72,
+  0x77, 0x61, 0x72, 0x64, 0x73, 0x2c, 0x0d, 0x0a, 0x15, 0x00, 0x40, 0x63,
+  0x63, 0x75, 0x72, 0x1a, 0x03, 0x01, 0x7b, 0x00, 0x11, 0x72, 0xbe, 0x00,
+  0x01, 0x39, 0x00, 0x02, 0x37, 0x00, 0x20, 0x74, 0x6f, 0x05, 0x03, 0x00,
+  0x7b, 0x01, 0x30, 0x6e, 0x64, 0x65, 0x27, 0x00, 0x20, 0x61, 0x74, 0xcd,
+  0x00, 0x12, 0x73, 0xc2, 0x02, 0x22, 0x61, 0x74, 0xff, 0x01, 0x40, 0x74,
+  0x69, 0x6d, 0x65, 0x62, 0x00, 0x00, 0x85, 0x00, 0x90, 0x73, 0x65, 0x65,
+  0x6d, 0x65, 0x64, 0x20, 0x71, 0x75, 0x62, 0x01, 0x91, 0x6e, 0x61, 0x74,
+  0x75, 0x72, 0x61, 0x6c, 0x29, 0x3b, 0x2f, 0x00, 0x01, 0x95, 0x00, 0x07,
+  0xdb, 0x00, 0xb0, 0x61, 0x63, 0x74, 0x75, 0x61, 0x6c, 0x6c, 0x79, 0x20,
+  0x5f, 0x74, 0x2c, 0x03, 0x65, 0x61, 0x0d, 0x0a, 0x77, 0x61, 0x74, 0x15,
+  0x01, 0x00, 0xf3, 0x00, 0xf2, 0x03, 0x20, 0x77, 0x61, 0x69, 0x73, 0x74,
+  0x63, 0x6f, 0x61, 0x74, 0x2d, 0x70, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x5f,
+  0x9c, 0x03, 0x42, 0x6c, 0x6f, 0x6f, 0x6b, 0x8d, 0x00, 0x22, 0x69, 0x74,
+  0x12, 0x00, 0x10, 0x74, 0x5c, 0x00, 0xc3, 0x68, 0x75, 0x72, 0x72, 0x69,
+  0x65, 0x64, 0x0d, 0x0a, 0x6f, 0x6e, 0x2c, 0x7a, 0x01, 0x55, 0x73, 0x74,
+  0x61, 0x72, 0x74, 0xdf, 0x00, 0x00, 0x98, 0x02, 0x11, 0x74, 0xb8, 0x02,
+  0x00, 0xaf, 0x00, 0x50, 0x66, 0x6c, 0x61, 0x73, 0x68, 0x47, 0x00, 0x51,
+  0x63, 0x72, 0x6f, 0x73, 0x73, 0x20, 0x00, 0x01, 0xee, 0x02, 0x04, 0x04,
+  0x01, 0x21, 0x0d, 0x0a, 0xa0, 0x03, 0x10, 0x65, 0x38, 0x01, 0x60, 0x62,
+  0x65, 0x66, 0x6f, 0x72, 0x65, 0xde, 0x00, 0x57, 0x6e, 0x20, 0x61, 0x20,
+  0x72, 0x3a, 0x02, 0x21, 0x65, 0x69, 0xcc, 0x02, 0x1d, 0x61, 0xac, 0x00,
+  0x10, 0x2c, 0x74, 0x03, 0x04, 0xd5, 0x00, 0x00, 0x81, 0x00, 0x46, 0x74,
+  0x61, 0x6b, 0x65, 0xdd, 0x00, 0x02, 0xb8, 0x00, 0x31, 0x62, 0x75, 0x72,
+  0xab, 0x04, 0x01, 0x4b, 0x00, 0xa0, 0x63, 0x75, 0x72, 0x69, 0x6f, 0x73,
+  0x69, 0x74, 0x79, 0x2c, 0x83, 0x01, 0x00, 0x8a, 0x02, 0x04, 0x9c, 0x00,
+  0x01, 0x67, 0x01, 0x52, 0x66, 0x69, 0x65, 0x6c, 0x64, 0xc2, 0x01, 0x04,
+  0x40, 0x00, 0x00, 0xcb, 0x00, 0x81, 0x74, 0x75, 0x6e, 0x61, 0x74, 0x65,
+  0x6c, 0x79, 0x9e, 0x02, 0x41, 0x6a, 0x75, 0x73, 0x74, 0x86, 0x02, 0x00,
+  0x93, 0x01, 0x20, 0x74, 0x6f, 0xb1, 0x00, 0x00, 0xeb, 0x00, 0x80, 0x70,
+  0x6f, 0x70, 0x20, 0x64, 0x6f, 0x77, 0x6e, 0x90, 0x00, 0x53, 0x6c, 0x61,
+  0x72, 0x67, 0x65, 0xc3, 0x00, 0x93, 0x2d, 0x68, 0x6f, 0x6c, 0x65, 0x20,
+  0x75, 0x6e, 0x64, 0x8e, 0x03, 0x51, 0x68, 0x65, 0x64, 0x67, 0x65, 0xf1,
+  0x02, 0x40, 0x49, 0x6e, 0x20, 0x61, 0xeb, 0x02, 0x00, 0x15, 0x01, 0x52,
+  0x6f, 0x6d, 0x65, 0x6e, 0x74, 0x40, 0x00, 0x33, 0x77, 0x65, 0x6e, 0x65,
+  0x04, 0x07, 0x89, 0x00, 0x02, 0x23, 0x01, 0x01, 0x18, 0x05, 0x08, 0x46,
+  0x04, 0x51, 0x68, 0x6f, 0x77, 0x0d, 0x0a, 0x12, 0x03, 0x01, 0xbc, 0x03,
+  0x25, 0x6c, 0x64, 0x6c, 0x04, 0x03, 0x99, 0x05, 0x10, 0x6f, 0x44, 0x02,
+  0x44, 0x67, 0x61, 0x69, 0x6e, 0x63, 0x03, 0x09, 0x96, 0x00, 0x01, 0x6b,
+  0x00, 0x80, 0x73, 0x74, 0x72, 0x61, 0x69, 0x67, 0x68, 0x74, 0xa1, 0x05,
+  0xd1, 0x6c, 0x69, 0x6b, 0x65, 0x20, 0x61, 0x20, 0x74, 0x75, 0x6e, 0x6e,
+  0x65, 0x6c, 0xc5, 0x01, 0x31, 0x73, 0x6f, 0x6d, 0x39, 0x03, 0x06, 0x04,
+  0x02, 0x50, 0x0d, 0x0a, 0x64, 0x69, 0x70, 0x89, 0x05, 0x05, 0xee, 0x03,
+  0x00, 0xb7, 0x00, 0x10, 0x2c, 0xae, 0x03, 0x05, 0x12, 0x00, 0x01, 0xe0,
+  0x01, 0x02, 0xc4, 0x00, 0x02, 0x81, 0x05, 0x34, 0x74, 0x20, 0x61, 0xe5,
+  0x00, 0x22, 0x74, 0x6f, 0xad, 0x03, 0x60, 0x0d, 0x0a, 0x61, 0x62, 0x6f,
+  0x75, 0x80, 0x00, 0x31, 0x6f, 0x70, 0x70, 0xcd, 0x00, 0x20, 0x65, 0x72,
+  0x82, 0x03, 0x04, 0x09, 0x02, 0x00, 0xca, 0x00, 0x55, 0x66, 0x6f, 0x75,
+  0x6e, 0x64, 0x19, 0x00, 0x40, 0x66, 0x61, 0x6c, 0x6c, 0x29, 0x00, 0x02,
+  0x67, 0x01, 0x01, 0xfd, 0x04, 0x00, 0xaa, 0x03, 0x80, 0x65, 0x70, 0x20,
+  0x77, 0x65, 0x6c, 0x6c, 0x2e
+};
+// static const size_t lzsa_test_11_lz4_len = 1277;
+static const uint8_t lzsa_test_11_zx0[] = {
+  0x56, 0x41, 0x6c, 0x69, 0x63, 0x65, 0x20, 0x77, 0x61, 0x73, 0x20, 0x62,
+  0x65, 0x67, 0x69, 0x6e, 0xe4, 0xfb, 0x78, 0x67, 0x20, 0x74, 0x6f, 0x20,
+  0x67, 0x65, 0x74, 0x20, 0x76, 0x65, 0x72, 0x79, 0xe9, 0x5b, 0x69, 0x72,
+  0x65, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x73, 0x69, 0x74, 0xee, 0xc6, 0x62,
+  0xd9, 0xfa, 0x68, 0xcf, 0xe2, 0xbe, 0x73, 0xc1, 0xcf, 0xf8, 0x6e, 0xbd,
+  0xe3, 0x0f, 0x0d, 0x0a, 0x62, 0x61, 0x6e, 0x6b, 0x2c, 0x20, 0xf7, 0xf8,
+  0xaa, 0xc1, 0xfa, 0x61, 0x76, 0x72, 0x6e, 0xfc, 0xcb, 0x62, 0x9e, 0x64,
+  0x6f, 0x3a, 0xaa, 0xfa, 0x2f, 0xa1, 0x72, 0x2f, 0x77, 0x1c, 0xbe, 0x73,
+  0x95, 0xb0, 0xe7, 0x4d, 0x70, 0x65, 0x65, 0xff, 0xfb, 0x3f, 0x4d, 0xb5,
+  0xee, 0x75, 0x6a, 0x41, 0x79, 0x6f, 0x6f, 0x6b, 0x3c, 0x77, 0xca, 0xdf,
+  0xfb, 0xad, 0xb9, 0x6c, 0x3f, 0xb7, 0x62, 0x75, 0x74, 0xf1, 0xfb, 0x8e,
+  0x44, 0xe3, 0x89, 0x6f, 0x74, 0x75, 0xfe, 0xc9, 0xc1, 0x55, 0x89, 0xf6,
+  0x63, 0x41, 0x9e, 0x88, 0x73, 0x61, 0xff, 0xef, 0x9d, 0x61, 0xbb, 0xb0,
+  0xa1, 0x93, 0x7b, 0xdc, 0x77, 0xef, 0xa3, 0x94, 0xd9, 0xe7, 0x44, 0x75,
+  0x73, 0x65, 0x7b, 0xbc, 0x61, 0x88, 0x32, 0xe8, 0x2c, 0x94, 0xd8, 0x3c,
+  0x6f, 0x75, 0x67, 0x68, 0xc3, 0x8e, 0xf2, 0x77, 0xdf, 0x93, 0xc9, 0xdc,
+  0xb9, 0x74, 0x4a, 0x6f, 0x20, 0x4c, 0x08, 0xfa, 0x3f, 0x94, 0xb5, 0x27,
+  0x53, 0xdf, 0x7e, 0x3f, 0x92, 0xc4, 0xcb, 0xcb, 0x64, 0xdf, 0xc1, 0x2c,
+  0xcf, 0x15, 0xc8, 0xbb, 0x99, 0x77, 0x05, 0x6d, 0xef, 0xe9, 0x0d, 0x28,
+  0xc1, 0x9b, 0x05, 0x65, 0x6c, 0x6c, 0xff, 0xf1, 0xa0, 0xa9, 0x9a, 0x27,
+  0x6c, 0x64, 0x2c, 0xf2, 0x66, 0x57, 0x94, 0x7d, 0x2b, 0xab, 0x69, 0x64,
+  0x79, 0xbf, 0xa7, 0x61, 0x7f, 0x8c, 0xef, 0xcd, 0x65, 0xa5, 0x26, 0x10,
+  0x32, 0x73, 0x6c, 0xce, 0xf3, 0xf3, 0x5c, 0xc8, 0xf3, 0xee, 0x75, 0x70,
+  0x3d, 0x29, 0x91, 0xfb, 0x77, 0xbb, 0x92, 0x8d, 0x88, 0xfd, 0xbf, 0xc1,
+  0x57, 0xdf, 0xbd, 0x64, 0xef, 0x71, 0x81, 0x6b, 0x02, 0xbb, 0x61, 0x66,
+  0x67, 0x31, 0x79, 0x2d, 0x63, 0x7f, 0x1f, 0xe3, 0xa5, 0xf7, 0x26, 0x31,
+  0x6f, 0xb4, 0x23, 0xfd, 0x93, 0x96, 0xa2, 0x25, 0x72, 0xf5, 0x62, 0x8f,
+  0xe2, 0x62, 0x67, 0x65, 0x4f, 0x4b, 0xfd, 0x38, 0x7b, 0xbf, 0x1e, 0x78,
+  0xf8, 0xb2, 0x74, 0xb7, 0x69, 0x09, 0x8f, 0x1e, 0x71, 0xb6, 0x35, 0x64,
+  0x43, 0x7a, 0x6e, 0x6c, 0x79, 0x42, 0x2b, 0x57, 0x68, 0x74, 0xa8, 0xc3,
+  0x52, 0xb7, 0x62, 0x62, 0x8f, 0x3d, 0xaa, 0xea, 0xf3, 0x99, 0x6b, 0x2d,
+  0x65, 0x79, 0x6f, 0xb8, 0x73, 0x5a, 0xf6, 0x6d, 0x6c, 0x6f, 0x73, 0x32,
+  0xba, 0xce, 0x2e, 0xae, 0xec, 0x54, 0xee, 0x9d, 0xb0, 0x36, 0xe4, 0x8b,
+  0x73, 0x5f, 0x7b, 0x3c, 0x5f, 0x5b, 0x54, 0x67, 0x11, 0x72, 0x6b, 0x61,
+  0x7f, 0xde, 0xcf, 0xb2, 0x0e, 0x3f, 0xeb, 0x3b, 0xb4, 0x72, 0xdd, 0x03,
+  0x27, 0x67, 0xe0, 0xbf, 0xd8, 0x42, 0xf8, 0x31, 0x71, 0x94, 0x67, 0x6d,
+  0x75, 0x63, 0xd7, 0x13, 0xba, 0xde, 0x77, 0xc0, 0xff, 0x48, 0x25, 0x4e,
+  0x3d, 0x1e, 0xff, 0x69, 0xe0, 0x76, 0xc4, 0xe7, 0x73, 0xd2, 0xb2, 0x89,
+  0x73, 0x5d, 0xd2, 0x66, 0xee, 0x8e, 0x4f, 0x68, 0x77, 0xe9, 0x64, 0xb8,
+  0xf9, 0x21, 0x20, 0x4f, 0x83, 0xee, 0xbf, 0x49, 0xb7, 0x19, 0x5c, 0xc7,
+  0xee, 0xba, 0x6c, 0x09, 0x75, 0x65, 0x21, 0x94, 0xd9, 0xa1, 0x1e, 0xf4,
+  0xf7, 0xdf, 0xd0, 0x81, 0xbb, 0x30, 0x10, 0x6c, 0x09, 0x66, 0x6b, 0xe8,
+  0x77, 0xb3, 0x95, 0x64, 0xd5, 0xf8, 0x71, 0xd6, 0xcc, 0x63, 0x63, 0x07,
+  0x2e, 0xcc, 0x0a, 0x7f, 0x0c, 0xe3, 0x7d, 0x8e, 0x9f, 0x92, 0xd5, 0x0f,
+  0xf6, 0x3b, 0x0a, 0x6e, 0xff, 0x29, 0xb2, 0xc5, 0x7f, 0x66, 0x87, 0x1f,
+  0x7c, 0xb5, 0xe6, 0x9c, 0x02, 0x2b, 0x49, 0x6d, 0xf7, 0x3c, 0xf6, 0xdc,
+  0xb3, 0xe8, 0xe5, 0xb0, 0xce, 0x71, 0x75, 0x3c, 0xb4, 0x6e, 0xb8, 0x06,
+  0xd5, 0xe3, 0x29, 0x3b, 0xa2, 0x7d, 0xd6, 0x96, 0x4a, 0xc6, 0x61, 0xca,
+  0xed, 0x9a, 0xbc, 0x13, 0x5f, 0x33, 0x7e, 0x77, 0xe3, 0x6f, 0xf2, 0x77,
+  0xa1, 0xd6, 0x0d, 0xf2, 0x1a, 0xd6, 0xfb, 0x29, 0xdb, 0x6f, 0x8d, 0x2f,
+  0x2d, 0x70, 0xb5, 0xad, 0x6b, 0xb5, 0x2b, 0x5f, 0x66, 0xc8, 0xed, 0x6c,
+  0xa0, 0x9f, 0xe6, 0xb7, 0x8f, 0xdc, 0x52, 0xc6, 0x98, 0xdb, 0x6a, 0x5d,
+  0x21, 0x2d, 0xf6, 0xb3, 0xa5, 0x2c, 0x0c, 0x3c, 0x85, 0xb7, 0xab, 0x74,
+  0x42, 0x71, 0xfc, 0xd0, 0x79, 0x67, 0x90, 0xf3, 0x8f, 0xf3, 0xa5, 0x7e,
+  0x2d, 0x72, 0xd2, 0x63, 0x63, 0xff, 0x73, 0x29, 0xc0, 0x1f, 0x24, 0x20,
+  0xf8, 0xf5, 0x71, 0x62, 0xc0, 0xcf, 0x65, 0x90, 0x3b, 0x49, 0x96, 0xbb,
+  0x62, 0x81, 0x6e, 0xad, 0xa1, 0x20, 0x24, 0x8c, 0xbb, 0x65, 0xf6, 0x3d,
+  0x4e, 0xd3, 0xa8, 0xfd, 0x30, 0x9d, 0x83, 0x56, 0x7d, 0xfe, 0xf7, 0xeb,
+  0xd5, 0x46, 0x77, 0x90, 0x72, 0x73, 0xd1, 0x72, 0xf9, 0xaa, 0x6a, 0xd6,
+  0xea, 0xb7, 0x69, 0xed, 0x8f, 0x61, 0x79, 0x2c, 0x02, 0xc7, 0xec, 0xdc,
+  0xc8, 0xc9, 0x32, 0xac, 0x66, 0x2d, 0x57, 0x64, 0x67, 0x7c, 0xdd, 0x80,
+  0xf3, 0x6a, 0x77, 0x2e, 0x32, 0xcd, 0xc6, 0x79, 0xc4, 0x23, 0x6a, 0x75,
+  0x71, 0xf9, 0xf5, 0xf4, 0xfb, 0xda, 0x18, 0x7d, 0x9e, 0xf7, 0x2a, 0xdd,
+  0x0b, 0xc3, 0x64, 0x56, 0x62, 0xce, 0x36, 0xca, 0x6c, 0xdd, 0x67, 0xdc,
+  0x7a, 0xb4, 0x2d, 0xc6, 0xc3, 0x94, 0xed, 0x7f, 0x64, 0x5c, 0xe4, 0xcb,
+  0xe2, 0xc6, 0xc9, 0x1e, 0x2e, 0x49, 0xa8, 0xc7, 0x2a, 0xce, 0xd6, 0xeb,
+  0x6f, 0x69, 0x6e, 0x9b, 0x80, 0x77, 0xb2, 0xec, 0x4a, 0x76, 0xee, 0x1c,
+  0xcd, 0xba, 0x0f, 0xd0, 0x53, 0x74, 0x0e, 0x49, 0xf0, 0x77, 0x71, 0x8d,
+  0xdc, 0x58, 0x88, 0xdd, 0x89, 0x4d, 0x28, 0xc5, 0xcc, 0xce, 0xfb, 0xe8,
+  0x75, 0x67, 0x56, 0x38, 0xc3, 0x3a, 0x37, 0xd4, 0x0e, 0x2a, 0x77, 0x65,
+  0xb1, 0xdb, 0x69, 0xb1, 0xec, 0x7e, 0xbe, 0x15, 0x9f, 0x6b, 0x87, 0x7b,
+  0x21, 0x1f, 0x6c, 0x7f, 0x0c, 0xc5, 0x70, 0xcd, 0x8d, 0x8e, 0x21, 0xf8,
+  0xf0, 0x73, 0xb1, 0x15, 0x70, 0x7d, 0xee, 0x5d, 0x24, 0xd8, 0x92, 0xfe,
+  0xc1, 0xad, 0xdc, 0x0d, 0x7d, 0x40, 0xcc, 0x78, 0x5c, 0xfe, 0xdb, 0xf4,
+  0x77, 0x36, 0x75, 0xcd, 0x67, 0xa6, 0xdd, 0x71, 0xed, 0xfb, 0xc3, 0x00,
+  0x6f, 0xdf, 0x63, 0x66, 0x2d, 0xee, 0x5f, 0xfc, 0x4d, 0xee, 0xdf, 0x6c,
+  0xcb, 0xef, 0x8e, 0xdf, 0xce, 0xe5, 0x1b, 0x6a, 0xb3, 0xae, 0x32, 0x34,
+  0x63, 0x06, 0x6d, 0xe6, 0x1b, 0x06, 0x42, 0x8c, 0x2d, 0x2e, 0x55, 0x56
+};
+// static const size_t lzsa_test_11_zx0_len = 936;
+static const uint8_t lzsa_test_11_native[] = {
+  0xf3, 0x2d, 0x41, 0x6c, 0x69, 0x63, 0x65, 0x20, 0x77, 0x61, 0x73, 0x20,
+  0x62, 0x65, 0x67, 0x69, 0x6e, 0x6e, 0x69, 0x6e, 0x67, 0x20, 0x74, 0x6f,
+  0x20, 0x67, 0x65, 0x74, 0x20, 0x76, 0x65, 0x72, 0x79, 0x20, 0x74, 0x69,
+  0x72, 0x65, 0x64, 0x20, 0x6f, 0x66, 0x20, 0x73, 0x69, 0x74, 0x74, 0xe3,
+  0x62, 0x62, 0x79, 0x20, 0x68, 0x65, 0x72, 0xf1, 0x22, 0x73, 0x74, 0xf9,
+  0xf4, 0x10, 0x6f, 0x6e, 0x20, 0x74, 0x68, 0x65, 0x0d, 0x0a, 0x62, 0x61,
+  0x6e, 0x6b, 0x2c, 0x20, 0x61, 0x6e, 0xd5, 0x33, 0x68, 0x61, 0x76, 0xd6,
+  0x46, 0x6e, 0x6f, 0x74, 0x68, 0xb1, 0x32, 0x64, 0x6f, 0x3a, 0xd5, 0x02,
+  0x97, 0x53, 0x6f, 0x72, 0x20, 0x74, 0x77, 0x8e, 0x32, 0x73, 0x68, 0x65,
+  0xd8, 0x62, 0x64, 0x20, 0x70, 0x65, 0x65, 0x70, 0x9f, 0x62, 0x69, 0x6e,
+  0x74, 0x6f, 0x0d, 0x0a, 0xb5, 0x57, 0x20, 0x62, 0x6f, 0x6f, 0x6b, 0x0b,
+  0x9e, 0x04, 0x65, 0x42, 0x72, 0x65, 0x61, 0x64, 0xb6, 0x84, 0x2c, 0x20,
+  0x62, 0x75, 0x74, 0x20, 0x69, 0x74, 0xc7, 0xb2, 0x6e, 0x6f, 0x20, 0x70,
+  0x69, 0x63, 0x74, 0x75, 0x72, 0x65, 0x73, 0xaa, 0x52, 0x0d, 0x0a, 0x63,
+  0x6f, 0x6e, 0x4f, 0x72, 0x73, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x73, 0xb0,
+  0x02, 0xd8, 0x33, 0x2c, 0x20, 0x93, 0x6e, 0x32, 0x77, 0x68, 0x61, 0xca,
+  0x23, 0x73, 0x20, 0xa2, 0x33, 0x75, 0x73, 0x65, 0x5e, 0x14, 0x61, 0x99,
+  0x22, 0x2c, 0x94, 0xec, 0x6c, 0x6f, 0x75, 0x67, 0x68, 0x74, 0x20, 0xfe,
+  0xf9, 0x53, 0x0d, 0x0a, 0x93, 0x77, 0x69, 0xee, 0x17, 0x74, 0x0c, 0xa5,
+  0x17, 0x20, 0x0d, 0xa6, 0x83, 0x3f, 0x94, 0x0d, 0x0a, 0x0d, 0x0a, 0x53,
+  0x6f, 0x3f, 0x04, 0x64, 0x12, 0x63, 0xeb, 0x43, 0x69, 0x64, 0x65, 0x72,
+  0x16, 0x24, 0x69, 0x6e, 0x46, 0x62, 0x6f, 0x77, 0x6e, 0x20, 0x6d, 0x69,
+  0x86, 0x12, 0x28, 0xe0, 0x52, 0x77, 0x65, 0x6c, 0x6c, 0x20, 0xf8, 0x02,
+  0xd0, 0x02, 0xd4, 0x62, 0x75, 0x6c, 0x64, 0x2c, 0x20, 0x66, 0xab, 0x0c,
+  0xfe, 0xca, 0xc4, 0x68, 0x6f, 0x74, 0x20, 0x64, 0x61, 0x79, 0x20, 0x6d,
+  0x61, 0x64, 0x65, 0xc6, 0x4d, 0x66, 0x65, 0x65, 0x6c, 0xfe, 0x88, 0x6c,
+  0x73, 0x6c, 0x65, 0x65, 0x70, 0x79, 0xfe, 0xae, 0x82, 0x73, 0x74, 0x75,
+  0x70, 0x69, 0x64, 0x29, 0x2c, 0x37, 0x22, 0x65, 0x74, 0xda, 0x04, 0x37,
+  0x52, 0x70, 0x6c, 0x65, 0x61, 0x73, 0x5e, 0x02, 0x32, 0x53, 0x0d, 0x0a,
+  0x6d, 0x61, 0x6b, 0x81, 0x12, 0x61, 0xb3, 0x72, 0x69, 0x73, 0x79, 0x2d,
+  0x63, 0x68, 0x61, 0x76, 0x13, 0x77, 0x93, 0x32, 0x20, 0x62, 0x65, 0xf7,
+  0x34, 0x72, 0x74, 0x68, 0xcb, 0x6c, 0x74, 0x72, 0x6f, 0x75, 0x62, 0x6c,
+  0xfe, 0xfe, 0x2d, 0x67, 0x65, 0xfe, 0x31, 0x23, 0x75, 0x70, 0x9c, 0x22,
+  0x0d, 0x0a, 0x0f, 0x03, 0xbc, 0x03, 0xd9, 0x04, 0xba, 0x34, 0x69, 0x65,
+  0x73, 0x8f, 0xfb, 0x1a, 0x6e, 0x20, 0x73, 0x75, 0x64, 0x64, 0x65, 0x6e,
+  0x6c, 0x79, 0x20, 0x61, 0x20, 0x57, 0x68, 0x69, 0x74, 0x65, 0x20, 0x52,
+  0x61, 0x62, 0x62, 0x69, 0x74, 0x20, 0xfe, 0xd5, 0x0a, 0xfe, 0xd8, 0x6a,
+  0x6e, 0x6b, 0x20, 0x65, 0x79, 0x65, 0xfe, 0x5c, 0x2a, 0x61, 0x6e, 0xfe,
+  0x7b, 0x4e, 0x6c, 0x6f, 0x73, 0x65, 0xfd, 0xdd, 0x1b, 0x2e, 0xfe, 0xd7,
+  0x12, 0x54, 0xf7, 0x0c, 0xfe, 0xd8, 0x0f, 0x09, 0xfd, 0xf2, 0x43, 0x73,
+  0x6f, 0x20, 0x5f, 0x1e, 0x1a, 0x5f, 0xfe, 0x2a, 0x53, 0x6d, 0x61, 0x72,
+  0x6b, 0x61, 0x6f, 0x1b, 0x69, 0xfd, 0xb9, 0x32, 0x61, 0x74, 0x3b, 0xda,
+  0x5d, 0x72, 0x20, 0x64, 0x69, 0x64, 0xfe, 0x70, 0x02, 0xec, 0x03, 0xa1,
+  0x47, 0x69, 0x74, 0x0d, 0x0a, 0x0a, 0xca, 0x5b, 0x6d, 0x75, 0x63, 0x68,
+  0x20, 0xfe, 0x5d, 0x24, 0x6f, 0x66, 0x53, 0x3b, 0x77, 0x61, 0x79, 0xfd,
+  0x9e, 0x3b, 0x68, 0x65, 0x61, 0xfe, 0xe7, 0x07, 0x09, 0x62, 0x15, 0x73,
+  0xe9, 0x6a, 0x69, 0x74, 0x73, 0x65, 0x6c, 0x66, 0xfd, 0xf7, 0x52, 0x4f,
+  0x68, 0x0d, 0x0a, 0x64, 0xdc, 0x55, 0x21, 0x20, 0x4f, 0x68, 0x20, 0xf7,
+  0x1a, 0x49, 0xfe, 0x6c, 0x3b, 0x61, 0x6c, 0x6c, 0xfe, 0xdd, 0x85, 0x6c,
+  0x61, 0x74, 0x65, 0x21, 0x94, 0x20, 0x28, 0x0f, 0x2f, 0x68, 0x65, 0x09,
+  0xfd, 0xe8, 0x12, 0x69, 0x98, 0x02, 0x88, 0xe3, 0x20, 0x61, 0x66, 0x74,
+  0x65, 0x72, 0x77, 0x61, 0x72, 0x64, 0x73, 0x2c, 0x0d, 0x0a, 0xeb, 0x4a,
+  0x63, 0x63, 0x75, 0x72, 0xfc, 0xe6, 0x05, 0x85, 0x14, 0x72, 0x42, 0x04,
+  0xc7, 0x04, 0xc9, 0x04, 0xea, 0x2b, 0x61, 0x76, 0xfe, 0x85, 0x33, 0x6e,
+  0x64, 0x65, 0xd9, 0x23, 0x61, 0x74, 0x33, 0x1d, 0x73, 0xfd, 0x3e, 0x2d,
+  0x61, 0x74, 0xfe, 0x01, 0x43, 0x74, 0x69, 0x6d, 0x65, 0x9e, 0x03, 0x7b,
+  0x42, 0x73, 0x65, 0x65, 0x6d, 0xd8, 0x2b, 0x71, 0x75, 0xfe, 0x9e, 0x2a,
+  0x6e, 0x61, 0xfd, 0x83, 0x44, 0x61, 0x6c, 0x29, 0x3b, 0xd1, 0x03, 0x6b,
+  0x07, 0x0c, 0x25, 0x42, 0x61, 0x63, 0x74, 0x75, 0xcd, 0x4b, 0x79, 0x20,
+  0x5f, 0x74, 0xfc, 0xd4, 0x6f, 0x61, 0x0d, 0x0a, 0x77, 0x61, 0x74, 0x09,
+  0xfe, 0xeb, 0x03, 0x0d, 0xfd, 0x12, 0x20, 0x77, 0x61, 0x69, 0x73, 0x74,
+  0x63, 0x6f, 0x61, 0x74, 0x2d, 0x70, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x5f,
+  0xfc, 0x64, 0x12, 0x6c, 0xd0, 0x05, 0x73, 0x25, 0x69, 0x74, 0xee, 0x13,
+  0x74, 0xa4, 0x12, 0x68, 0x35, 0x2a, 0x69, 0x65, 0xfd, 0xfb, 0x3e, 0x6f,
+  0x6e, 0x2c, 0xfe, 0x86, 0x57, 0x73, 0x74, 0x61, 0x72, 0x74, 0x0a, 0x21,
+  0x4c, 0x66, 0x65, 0x65, 0x74, 0xfd, 0x48, 0x03, 0x51, 0x53, 0x66, 0x6c,
+  0x61, 0x73, 0x68, 0xb9, 0x53, 0x63, 0x72, 0x6f, 0x73, 0x73, 0xe0, 0x0c,
+  0xfd, 0x12, 0x0f, 0x09, 0xfe, 0xfc, 0x2c, 0x0d, 0x0a, 0xfc, 0x60, 0x1b,
+  0x65, 0xfe, 0xc8, 0x22, 0x62, 0x65, 0xcb, 0x13, 0x65, 0x22, 0x5f, 0x6e,
+  0x20, 0x61, 0x20, 0x72, 0x0b, 0xfd, 0xc6, 0x2c, 0x65, 0x69, 0xfd, 0x34,
+  0x17, 0x61, 0x11, 0x54, 0x47, 0x2c, 0x20, 0x6f, 0x72, 0x09, 0x2b, 0x03,
+  0x7f, 0x46, 0x74, 0x61, 0x6b, 0x65, 0x23, 0x07, 0x09, 0x48, 0x3b, 0x62,
+  0x75, 0x72, 0xfb, 0x55, 0x05, 0xb5, 0x5a, 0x63, 0x75, 0x72, 0x69, 0x6f,
+  0xfb, 0x60, 0x23, 0x79, 0x2c, 0x81, 0x0b, 0xfd, 0x76, 0x06, 0x64, 0x0d,
+  0xfe, 0x99, 0x5d, 0x66, 0x69, 0x65, 0x6c, 0x64, 0xfe, 0x3e, 0x07, 0x08,
+  0xc0, 0x03, 0x35, 0x3a, 0x74, 0x75, 0x6e, 0xfe, 0x0a, 0x2c, 0x6c, 0x79,
+  0xfd, 0x62, 0x4b, 0x6a, 0x75, 0x73, 0x74, 0xfd, 0x7a, 0x0c, 0xfe, 0x6d,
+  0x23, 0x74, 0x6f, 0x4f, 0x03, 0x15, 0x5a, 0x70, 0x6f, 0x70, 0x20, 0x64,
+  0xfc, 0x31, 0x03, 0x70, 0x56, 0x6c, 0x61, 0x72, 0x67, 0x65, 0x3d, 0x4a,
+  0x2d, 0x68, 0x6f, 0x6c, 0xfb, 0xb3, 0x2e, 0x6e, 0x64, 0xfc, 0x72, 0x5c,
+  0x68, 0x65, 0x64, 0x67, 0x65, 0xfd, 0x0f, 0x22, 0x49, 0x6e, 0xa0, 0x14,
+  0x6f, 0x25, 0x65, 0x6d, 0x6f, 0x6d, 0x65, 0x6e, 0x74, 0xc0, 0x3e, 0x77,
+  0x65, 0x6e, 0xfb, 0x9b, 0x07, 0x0a, 0x77, 0x0d, 0xfe, 0xdd, 0x0c, 0xfa,
+  0xe8, 0x0f, 0x0d, 0xfb, 0xba, 0x5c, 0x68, 0x6f, 0x77, 0x0d, 0x0a, 0xfc,
+  0xee, 0x0c, 0xfc, 0x44, 0x2f, 0x6c, 0x64, 0x08, 0xfb, 0x94, 0x0f, 0x08,
+  0xfa, 0x67, 0x1b, 0x6f, 0xfd, 0xbc, 0x4e, 0x67, 0x61, 0x69, 0x6e, 0xfc,
+  0x9d, 0x07, 0x0d, 0x6a, 0x05, 0x95, 0x5b, 0x73, 0x74, 0x72, 0x61, 0x69,
+  0xfd, 0x76, 0x62, 0x6f, 0x6e, 0x20, 0x6c, 0x69, 0x6b, 0x8a, 0x12, 0x20,
+  0x10, 0x3c, 0x6e, 0x65, 0x6c, 0xfe, 0x3b, 0x3c, 0x73, 0x6f, 0x6d, 0xfc,
+  0xc7, 0x0f, 0x0a, 0xfd, 0xfc, 0x5a, 0x0d, 0x0a, 0x64, 0x69, 0x70, 0xfa,
+  0x77, 0x0f, 0x09, 0xfc, 0x12, 0x04, 0x49, 0x12, 0x2c, 0xd6, 0x07, 0x0a,
+  0xee, 0x36, 0x74, 0x68, 0x61, 0x3c, 0x0e, 0xfa, 0x7f, 0x02, 0x7a, 0x07,
+  0x08, 0x1b, 0x2d, 0x74, 0x6f, 0xfc, 0x53, 0x63, 0x0d, 0x0a, 0x61, 0x62,
+  0x6f, 0x75, 0x80, 0x34, 0x6f, 0x70, 0x70, 0x33, 0x2b, 0x65, 0x72, 0xfc,
+  0x7e, 0x0f, 0x09, 0xfd, 0xf7, 0x22, 0x68, 0x65, 0x7e, 0x37, 0x75, 0x6e,
+  0x64, 0x09, 0xe7, 0x42, 0x66, 0x61, 0x6c, 0x6c, 0xd7, 0x0e, 0xfe, 0x99,
+  0x0c, 0xfb, 0x03, 0x0b, 0xfc, 0x56, 0x2c, 0x65, 0x70, 0xfa, 0xc6, 0x10,
+  0x2e, 0x00
+};
+// static const size_t lzsa_test_11_native_len = 1166;
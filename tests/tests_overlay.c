@@ -0,0 +1,67 @@
+// Generated by lzsa_overlay. Do not edit.
+
+#include <stdint.h>
+
+// Overlays (ID, decompressed length, compressed length, entry offset):
+//   0     4     9     0 lzsa_test_overlay.bin
+//   1    51    43     0 lzsa_test_01.plain
+//   2   240    16     0 lzsa_test_04.plain
+//   3   560   568     0 lzsa_test_07.plain
+const uint8_t tests_overlay[670] = {
+	0x4c, 0x5a, 0x4f, 0x56, 0x01, 0x04, 0x00, 0x00, 0x02, 0x30, 0x00, 0x22,
+	0x00, 0x04, 0x00, 0x00, 0x00, 0x2b, 0x00, 0x33, 0x00, 0x00, 0x00, 0x56,
+	0x00, 0xf0, 0x00, 0x00, 0x00, 0x66, 0x02, 0x30, 0x00, 0x00, 0x4f, 0xae,
+	0x12, 0x34, 0x87, 0xff, 0xee, 0x00, 0x00, 0x73, 0x01, 0x48, 0x65, 0x6c,
+	0x6c, 0x6f, 0x2c, 0x20, 0x68, 0xf9, 0x53, 0x69, 0x73, 0x20, 0x74, 0x68,
+	0xfb, 0x76, 0x07, 0x6e, 0x67, 0x20, 0x6f, 0x6e, 0x3f, 0x20, 0x42, 0x6c,
+	0x61, 0x68, 0x2c, 0x20, 0x62, 0xfa, 0x3f, 0x2e, 0x2e, 0x2e, 0xff, 0xee,
+	0x00, 0x00, 0x1f, 0x41, 0xff, 0x5d, 0x1f, 0x42, 0xff, 0x5d, 0x1c, 0x43,
+	0xff, 0x0f, 0xff, 0xee, 0x00, 0x00, 0x7f, 0xf9, 0x30, 0x02, 0x31, 0x69,
+	0x6a, 0x5a, 0x55, 0x63, 0x36, 0x32, 0x69, 0x67, 0x64, 0x56, 0x6e, 0x67,
+	0x6f, 0x75, 0x64, 0x37, 0x64, 0x4b, 0x47, 0x76, 0x39, 0x36, 0x6e, 0x55,
+	0x37, 0x34, 0x35, 0x37, 0x62, 0x4e, 0x4f, 0x56, 0x74, 0x42, 0x67, 0x7a,
+	0x4a, 0x62, 0x70, 0x65, 0x6c, 0x4e, 0x43, 0x6b, 0x78, 0x72, 0x55, 0x75,
+	0x36, 0x6f, 0x58, 0x61, 0x42, 0x74, 0x43, 0x4d, 0x42, 0x39, 0x74, 0x43,
+	0x43, 0x67, 0x36, 0x4e, 0x78, 0x4c, 0x71, 0x53, 0x41, 0x68, 0x49, 0x76,
+	0x78, 0x69, 0x58, 0x68, 0x45, 0x53, 0x73, 0x7a, 0x34, 0x62, 0x57, 0x36,
+	0x6e, 0x79, 0x4a, 0x53, 0x43, 0x6c, 0x75, 0x53, 0x32, 0x6e, 0x56, 0x4c,
+	0x72, 0x31, 0x34, 0x6b, 0x4c, 0x4e, 0x54, 0x7a, 0x58, 0x32, 0x5a, 0x59,
+	0x69, 0x6c, 0x59, 0x46, 0x61, 0x4a, 0x61, 0x55, 0x4d, 0x75, 0x50, 0x4c,
+	0x45, 0x78, 0x77, 0x43, 0x6d, 0x39, 0x75, 0x66, 0x56, 0x71, 0x74, 0x43,
+	0x67, 0x51, 0x46, 0x55, 0x37, 0x49, 0x38, 0x65, 0x69, 0x69, 0x6b, 0x65,
+	0x34, 0x52, 0x38, 0x46, 0x57, 0x4a, 0x4f, 0x6f, 0x7a, 0x65, 0x64, 0x50,
+	0x75, 0x33, 0x59, 0x54, 0x6f, 0x33, 0x67, 0x65, 0x42, 0x4a, 0x78, 0x4e,
+	0x32, 0x47, 0x47, 0x5a, 0x6b, 0x65, 0x4b, 0x79, 0x65, 0x52, 0x34, 0x78,
+	0x6a, 0x68, 0x72, 0x77, 0x36, 0x69, 0x36, 0x66, 0x6e, 0x6a, 0x68, 0x4e,
+	0x34, 0x76, 0x64, 0x45, 0x69, 0x6d, 0x45, 0x4b, 0x76, 0x36, 0x51, 0x54,
+	0x78, 0x79, 0x4f, 0x36, 0x6f, 0x75, 0x68, 0x49, 0x41, 0x6f, 0x39, 0x7a,
+	0x41, 0x31, 0x7a, 0x70, 0x49, 0x43, 0x57, 0x62, 0x78, 0x56, 0x6b, 0x52,
+	0x4d, 0x58, 0x35, 0x50, 0x32, 0x4e, 0x32, 0x4f, 0x36, 0x77, 0x56, 0x73,
+	0x39, 0x6f, 0x71, 0x47, 0x4d, 0x38, 0x6c, 0x52, 0x41, 0x6e, 0x4e, 0x4d,
+	0x54, 0x51, 0x63, 0x62, 0x53, 0x36, 0x34, 0x34, 0x54, 0x76, 0x49, 0x41,
+	0x30, 0x42, 0x57, 0x45, 0x31, 0x64, 0x33, 0x52, 0x59, 0x58, 0x4f, 0x50,
+	0x67, 0x6c, 0x52, 0x66, 0x4d, 0x47, 0x70, 0x34, 0x4d, 0x72, 0x6f, 0x4d,
+	0x44, 0x65, 0x33, 0x37, 0x6e, 0x5a, 0x51, 0x57, 0x54, 0x31, 0x4f, 0x43,
+	0x61, 0x65, 0x4a, 0x43, 0x69, 0x65, 0x45, 0x6a, 0x53, 0x78, 0x49, 0x6f,
+	0x4e, 0x4d, 0x6c, 0x70, 0x51, 0x72, 0x54, 0x4e, 0x6d, 0x48, 0x7a, 0x49,
+	0x44, 0x70, 0x6a, 0x45, 0x73, 0x49, 0x73, 0x48, 0x6b, 0x66, 0x36, 0x65,
+	0x6e, 0x35, 0x4d, 0x48, 0x6d, 0x65, 0x72, 0x59, 0x79, 0x6c, 0x42, 0x52,
+	0x41, 0x76, 0x71, 0x45, 0x48, 0x52, 0x71, 0x4c, 0x66, 0x41, 0x46, 0x56,
+	0x67, 0x6c, 0x41, 0x6e, 0x33, 0x4e, 0x47, 0x6f, 0x68, 0x35, 0x38, 0x68,
+	0x31, 0x61, 0x30, 0x5a, 0x64, 0x73, 0x4d, 0x6d, 0x65, 0x58, 0x64, 0x68,
+	0x6c, 0x6d, 0x74, 0x46, 0x32, 0x4d, 0x44, 0x47, 0x45, 0x41, 0x45, 0x70,
+	0x74, 0x56, 0x42, 0x67, 0x6d, 0x6b, 0x75, 0x6e, 0x62, 0x61, 0x36, 0x36,
+	0x5a, 0x32, 0x39, 0x49, 0x55, 0x55, 0x50, 0x69, 0x62, 0x72, 0x33, 0x36,
+	0x51, 0x30, 0x49, 0x61, 0x36, 0x39, 0x37, 0x5a, 0x69, 0x44, 0x37, 0x63,
+	0x7a, 0x47, 0x61, 0x37, 0x41, 0x73, 0x77, 0x55, 0x42, 0x42, 0x64, 0x50,
+	0x76, 0x44, 0x39, 0x31, 0x78, 0x47, 0x32, 0x6b, 0x56, 0x75, 0x57, 0x58,
+	0x75, 0x31, 0x59, 0x6d, 0x67, 0x61, 0x46, 0x78, 0x4d, 0x42, 0x35, 0x6a,
+	0x37, 0x78, 0x4c, 0x39, 0x51, 0x5a, 0x4d, 0x73, 0x59, 0x4c, 0x42, 0x54,
+	0x44, 0x48, 0x52, 0x67, 0x38, 0x77, 0x76, 0x78, 0x45, 0x70, 0x48, 0x6e,
+	0x5a, 0x43, 0x74, 0x4e, 0x56, 0x43, 0x41, 0x74, 0x45, 0x6e, 0x47, 0x4a,
+	0x46, 0x6d, 0x32, 0x30, 0x56, 0x45, 0x31, 0x30, 0x73, 0x6b, 0x6b, 0x43,
+	0x36, 0x46, 0x37, 0x70, 0x69, 0x46, 0x43, 0x6c, 0x53, 0x31, 0x55, 0x77,
+	0x36, 0x73, 0x4a, 0x50, 0x76, 0x6a, 0x52, 0x72, 0x78, 0x69, 0x63, 0x68,
+	0x56, 0x5a, 0x7a, 0x68, 0x33, 0x6b, 0x55, 0x53, 0x54, 0x4c, 0x45, 0x33,
+	0x44, 0x32, 0x33, 0x45, 0x71, 0x54, 0xff, 0xee, 0x00, 0x00
+};
@@ -0,0 +1,16 @@
+// Generated by lzsa_patch. Do not edit.
+
+#include <stdint.h>
+
+// Patch from 1696-byte to 1692-byte image.
+const uint8_t tests_patch_lzsa1[100] = {
+	0x4c, 0x5a, 0x50, 0x54, 0x01, 0x01, 0x02, 0x00, 0x00, 0x00, 0x06, 0xa0,
+	0x00, 0x00, 0x06, 0x9c, 0x67, 0x04, 0x00, 0x00, 0x06, 0xa0, 0x00, 0x0b,
+	0x8f, 0x60, 0xf9, 0xee, 0x00, 0x02, 0x0f, 0x00, 0xee, 0x00, 0x00, 0x00,
+	0x00, 0x06, 0xa0, 0x00, 0x19, 0x8f, 0x60, 0xfb, 0xaa, 0xef, 0x50, 0x41,
+	0x54, 0x43, 0x48, 0x21, 0x5a, 0xfb, 0xb6, 0xaf, 0x5a, 0xa5, 0x5a, 0xfb,
+	0x62, 0x0f, 0x00, 0xee, 0x00, 0x00, 0x00, 0x00, 0x06, 0xa0, 0x00, 0x0e,
+	0x8f, 0x5a, 0xfd, 0xef, 0x1a, 0x8f, 0x64, 0xfd, 0xd4, 0x0f, 0x00, 0xee,
+	0x00, 0x00, 0x00, 0x00, 0x06, 0xa0, 0x00, 0x08, 0x0f, 0x64, 0x8a, 0x0f,
+	0x00, 0xee, 0x00, 0x00
+};
@@ -0,0 +1,15 @@
+// Generated by lzsa_patch. Do not edit.
+
+#include <stdint.h>
+
+// Patch from 1696-byte to 1692-byte image.
+const uint8_t tests_patch_lzsa2[92] = {
+	0x4c, 0x5a, 0x50, 0x54, 0x01, 0x02, 0x02, 0x00, 0x00, 0x00, 0x06, 0xa0,
+	0x00, 0x00, 0x06, 0x9c, 0x67, 0x04, 0x00, 0x00, 0x06, 0xa0, 0x00, 0x09,
+	0x87, 0xdf, 0x60, 0xe9, 0x00, 0x02, 0xe7, 0xf0, 0xe8, 0x00, 0x00, 0x06,
+	0xa0, 0x00, 0x16, 0x87, 0xef, 0x60, 0xa4, 0x9f, 0x3e, 0x50, 0x41, 0x54,
+	0x43, 0x48, 0x21, 0x5a, 0xff, 0xb0, 0xf7, 0x5a, 0xa5, 0x5c, 0xe7, 0xf0,
+	0xe8, 0x00, 0x00, 0x06, 0xa0, 0x00, 0x0d, 0x87, 0xff, 0x5a, 0xe9, 0x1a,
+	0x01, 0x87, 0xff, 0x64, 0xce, 0xe7, 0xf0, 0xe8, 0x00, 0x00, 0x06, 0xa0,
+	0x00, 0x06, 0x47, 0x64, 0xff, 0x84, 0xe7, 0xe8
+};
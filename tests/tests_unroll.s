@@ -0,0 +1,301 @@
+; ------------------------------------------------------------------------------
+; Generated by lzsa_unroll from lzsa_test_08.lzsa1. Do not edit.
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * tests_unroll(void *dst)
+; Arguments:
+;     dst = pointer to destination buffer of at least 288 bytes
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; Writes the decompressed data of the LZSA1 block with straight-line code. X
+; holds the destination pointer throughout, except while a long match is
+; copied.
+
+.module tests_unroll
+.globl _tests_unroll
+
+.area CODE
+
+_tests_unroll:
+	ldw x, (ARGS_SP_OFFSET+0, sp)
+
+	; 0x0000-0x0021
+	ldw y, #0x0497
+	ldw (x), y
+	ldw y, #0x898D
+	ldw (0x0002, x), y
+	ldw y, #0x00A6
+	ldw (0x0004, x), y
+	ldw y, #0xC95B
+	ldw (0x0006, x), y
+	ldw y, #0x0287
+	ldw (0x0008, x), y
+	ldw y, #0x1E06
+	ldw (0x000A, x), y
+	ldw y, #0x891E
+	ldw (0x000C, x), y
+	ldw y, #0x0689
+	ldw (0x000E, x), y
+	ldw y, #0x5F89
+	ldw (0x0010, x), y
+	ldw y, #0x4B1E
+	ldw (0x0012, x), y
+	ldw y, #0x4BA9
+	ldw (0x0014, x), y
+	ldw y, #0x4B00
+	ldw (0x0016, x), y
+	ldw y, #0x8D00
+	ldw (0x0018, x), y
+	ldw y, #0xAA04
+	ldw (0x001A, x), y
+	ldw y, #0x5B09
+	ldw (0x001C, x), y
+	ldw y, #0x8796
+	ldw (0x001E, x), y
+	ldw y, #0x1C00
+	ldw (0x0020, x), y
+
+	; 0x0022-0x0035, match of 20 at -23
+	addw x, #0x000B
+	ldw y, #0x0014
+0$:
+	ld a, (x)
+	ld (0x0017, x), a
+	incw x
+	decw y
+	jrne 0$
+	subw x, #0x001F
+
+	; 0x0036-0x0078
+	ldw y, #0x7B04
+	ldw (0x0036, x), y
+	ldw y, #0xAB30
+	ldw (0x0038, x), y
+	ldw y, #0xA139
+	ldw (0x003A, x), y
+	ldw y, #0x2308
+	ldw (0x003C, x), y
+	ldw y, #0xAB07
+	ldw (0x003E, x), y
+	ldw y, #0x0D05
+	ldw (0x0040, x), y
+	ldw y, #0x2702
+	ldw (0x0042, x), y
+	ldw y, #0xAB20
+	ldw (0x0044, x), y
+	ldw y, #0x1E09
+	ldw (0x0046, x), y
+	ldw y, #0x8988
+	ldw (0x0048, x), y
+	ldw y, #0x4B77
+	ldw (0x004A, x), y
+	ldw y, #0x4BA9
+	ldw (0x004C, x), y
+	ldw y, #0x4B00
+	ldw (0x004E, x), y
+	ldw y, #0x1E0D
+	ldw (0x0050, x), y
+	ldw y, #0x897B
+	ldw (0x0052, x), y
+	ldw y, #0x0E88
+	ldw (0x0054, x), y
+	ld (0x0056, x), a
+	ldw y, #0x5B03
+	ldw (0x0057, x), y
+	ld (0x0059, x), a
+	ldw y, #0x887B
+	ldw (0x005A, x), y
+	ldw y, #0x054E
+	ldw (0x005C, x), y
+	ldw y, #0xA40F
+	ldw (0x005E, x), y
+	ldw y, #0x6B01
+	ldw (0x0060, x), y
+	ldw y, #0x1E0A
+	ldw (0x0062, x), y
+	ldw y, #0x891E
+	ldw (0x0064, x), y
+	ldw y, #0x0A89
+	ldw (0x0066, x), y
+	ldw y, #0x7B0B
+	ldw (0x0068, x), y
+	ldw y, #0x887B
+	ldw (0x006A, x), y
+	ldw y, #0x0B88
+	ldw (0x006C, x), y
+	ldw y, #0x7B07
+	ldw (0x006E, x), y
+	ldw y, #0x888D
+	ldw (0x0070, x), y
+	ldw y, #0x00A9
+	ldw (0x0072, x), y
+	ldw y, #0x565B
+	ldw (0x0074, x), y
+	ldw y, #0x077B
+	ldw (0x0076, x), y
+	ld a, #0x05
+	ld (0x0078, x), a
+
+	; 0x0079-0x0090, match of 24 at -27
+	addw x, #0x005E
+	ldw y, #0x0018
+1$:
+	ld a, (x)
+	ld (0x001B, x), a
+	incw x
+	decw y
+	jrne 1$
+	subw x, #0x0076
+
+	; 0x0091-0x011F
+	ldw y, #0x0887
+	ldw (0x0091, x), y
+	ldw y, #0x520B
+	ldw (0x0093, x), y
+	ldw y, #0x160F
+	ldw (0x0095, x), y
+	ldw y, #0x1701
+	ldw (0x0097, x), y
+	ldw y, #0x9390
+	ldw (0x0099, x), y
+	ldw y, #0xEE02
+	ldw (0x009B, x), y
+	ldw y, #0xFE1F
+	ldw (0x009D, x), y
+	ldw y, #0x071E
+	ldw (0x009F, x), y
+	ldw y, #0x011C
+	ldw (0x00A1, x), y
+	ldw y, #0x0004
+	ldw (0x00A3, x), y
+	ldw y, #0xA620
+	ldw (0x00A5, x), y
+	ldw y, #0x6B0B
+	ldw (0x00A7, x), y
+	ldw y, #0xF648
+	ldw (0x00A9, x), y
+	ldw y, #0x6B06
+	ldw (0x00AB, x), y
+	ldw y, #0x7B07
+	ldw (0x00AD, x), y
+	ldw y, #0x484F
+	ldw (0x00AF, x), y
+	ldw y, #0x491A
+	ldw (0x00B1, x), y
+	ldw y, #0x06F7
+	ldw (0x00B3, x), y
+	ldw y, #0x9058
+	ldw (0x00B5, x), y
+	ldw y, #0x0908
+	ldw (0x00B7, x), y
+	ldw y, #0x0907
+	ldw (0x00B9, x), y
+	ld a, #0x11
+	ld (0x00BB, x), a
+	ld (0x00BC, x), a
+	ldw y, #0x2515
+	ldw (0x00BD, x), y
+	ldw y, #0xF610
+	ldw (0x00BF, x), y
+	ld (0x00C1, x), a
+	ldw y, #0xF790
+	ldw (0x00C2, x), y
+	ldw y, #0x5499
+	ldw (0x00C4, x), y
+	ldw y, #0x9059
+	ldw (0x00C6, x), y
+	ldw y, #0x7B07
+	ldw (0x00C8, x), y
+	ldw y, #0x6B03
+	ldw (0x00CA, x), y
+	ldw y, #0x7B08
+	ldw (0x00CC, x), y
+	ldw y, #0x6B08
+	ldw (0x00CE, x), y
+	ldw y, #0x7B03
+	ldw (0x00D0, x), y
+	ldw y, #0x6B07
+	ldw (0x00D2, x), y
+	ldw y, #0x0A0B
+	ldw (0x00D4, x), y
+	ldw y, #0x0D0B
+	ldw (0x00D6, x), y
+	ldw y, #0x26CF
+	ldw (0x00D8, x), y
+	ldw y, #0x1E01
+	ldw (0x00DA, x), y
+	ldw y, #0xEF02
+	ldw (0x00DC, x), y
+	ldw y, #0x1607
+	ldw (0x00DE, x), y
+	ldw y, #0xFF5B
+	ldw (0x00E0, x), y
+	ldw y, #0x0B87
+	ldw (0x00E2, x), y
+	ldw y, #0x5229
+	ldw (0x00E4, x), y
+	ldw y, #0x5F1F
+	ldw (0x00E6, x), y
+	ldw y, #0x1096
+	ldw (0x00E8, x), y
+	ldw y, #0x1C00
+	ldw (0x00EA, x), y
+	ldw y, #0x091F
+	ldw (0x00EC, x), y
+	ldw y, #0x121F
+	ldw (0x00EE, x), y
+	ldw y, #0x1416
+	ldw (0x00F0, x), y
+	ldw y, #0x1217
+	ldw (0x00F2, x), y
+	ldw y, #0x161E
+	ldw (0x00F4, x), y
+	ldw y, #0x32F6
+	ldw (0x00F6, x), y
+	ldw y, #0x5C1F
+	ldw (0x00F8, x), y
+	ldw y, #0x3297
+	ldw (0x00FA, x), y
+	ldw y, #0x4D26
+	ldw (0x00FC, x), y
+	ldw y, #0x04AC
+	ldw (0x00FE, x), y
+	ldw y, #0x00B0
+	ldw (0x0100, x), y
+	ldw y, #0xB49F
+	ldw (0x0102, x), y
+	ldw y, #0xA125
+	ldw (0x0104, x), y
+	ldw y, #0x2704
+	ldw (0x0106, x), y
+	ldw y, #0xAC00
+	ldw (0x0108, x), y
+	ldw y, #0xB096
+	ldw (0x010A, x), y
+	ldw y, #0x0F18
+	ldw (0x010C, x), y
+	ldw y, #0x0F19
+	ldw (0x010E, x), y
+	ldw y, #0x0F1A
+	ldw (0x0110, x), y
+	ldw y, #0x0F1B
+	ldw (0x0112, x), y
+	ldw y, #0x0F1C
+	ldw (0x0114, x), y
+	ldw y, #0x0F1D
+	ldw (0x0116, x), y
+	ldw y, #0x0F1E
+	ldw (0x0118, x), y
+	ldw y, #0x0F1F
+	ldw (0x011A, x), y
+	ldw y, #0x0F20
+	ldw (0x011C, x), y
+	ldw y, #0x5F1F
+	ldw (0x011E, x), y
+
+	; Return pointer to end of output.
+	addw x, #0x0120
+	return
@@ -0,0 +1,40 @@
+; ------------------------------------------------------------------------------
+; Generated by lzsa_unroll from lzsa_test_01.lzsa2. Do not edit.
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * tests_unroll_fallback(void *dst)
+; Arguments:
+;     dst = pointer to destination buffer of at least 51 bytes
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; Decompresses the LZSA2 block with lzsa2_decompress_block, as straight-line
+; code for it would have been over the size limit.
+
+.module tests_unroll_fallback
+.globl _tests_unroll_fallback
+.globl _lzsa2_decompress_block
+
+.area CODE
+
+_tests_unroll_fallback:
+	ldw x, #_tests_unroll_fallback_block
+	pushw x
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	pushw x
+	call_abs _lzsa2_decompress_block
+	addw sp, #4
+	return
+
+; The block is given to the general routine by a 16-bit pointer, so must be
+; placed in the first 64 KB, along with other constant data.
+
+.area CONST
+
+_tests_unroll_fallback_block:
+	.db 0x1C, 0x5C, 0x48, 0x65, 0x6C, 0x6C, 0x6F, 0x2C, 0x20, 0x68, 0x1C, 0x2D
+	.db 0x69, 0x73, 0x20, 0x74, 0x68, 0x18, 0x80, 0x6E, 0x67, 0x20, 0x6F, 0x6E
+	.db 0x3F, 0x20, 0x42, 0x6C, 0x61, 0x68, 0x2F, 0x62, 0xD0, 0x08, 0x2E, 0xFF
+	.db 0xE7, 0xE8
@@ -0,0 +1,157 @@
+// Generated by lzsa_strings. Do not edit.
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lzsa_str.h"
+#include "tests_strings.h"
+
+#if LZSA_STR_WINDOW_LEN < 374
+#error "LZSA_STR_WINDOW_LEN must be at least 374 for this string table"
+#endif
+
+static const uint8_t tests_strings_dict[127] = {
+	0x65, 0x64, 0x2e, 0x0a, 0x5b, 0x62, 0x6f, 0x6f, 0x74, 0x5d, 0x20, 0x72,
+	0x65, 0x73, 0x65, 0x74, 0x20, 0x63, 0x61, 0x75, 0x73, 0x69, 0x6e, 0x67,
+	0x20, 0x70, 0x6f, 0x77, 0x65, 0x72, 0x5d, 0x20, 0x69, 0x6e, 0x69, 0x74,
+	0x69, 0x61, 0x6c, 0x69, 0x73, 0x65, 0x6e, 0x73, 0x6f, 0x72, 0x69, 0x72,
+	0x6d, 0x77, 0x61, 0x72, 0x65, 0x20, 0x75, 0x70, 0x64, 0x61, 0x74, 0x65,
+	0x66, 0x61, 0x75, 0x6c, 0x74, 0x20, 0x74, 0x6f, 0x20, 0x6e, 0x65, 0x74,
+	0x77, 0x6f, 0x72, 0x6b, 0x2e, 0x45, 0x72, 0x72, 0x6f, 0x72, 0x3a, 0x20,
+	0x63, 0x6f, 0x75, 0x6c, 0x64, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x77, 0x72,
+	0x69, 0x74, 0x65, 0x20, 0x73, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67, 0x73,
+	0x20, 0x74, 0x65, 0x6d, 0x70, 0x65, 0x72, 0x61, 0x74, 0x75, 0x72, 0x65,
+	0x20, 0x61, 0x6c, 0x61, 0x72, 0x6d, 0x20
+};
+
+static const uint8_t tests_strings_data[] = {
+	// Block 0 (strings 0-14)
+	0x10, 0x4d, 0x61, 0x3d, 0x00, 0x40, 0xa4, 0x55, 0x75, 0x53, 0xdc, 0x48,
+	0x44, 0x96, 0x28, 0x70, 0x38, 0x36, 0x79, 0x20, 0x4c, 0x4e, 0xa5, 0x27,
+	0x80, 0x4b, 0x53, 0x78, 0x07, 0x80, 0x4b, 0x41, 0xba, 0x26, 0x90, 0x59,
+	0x54, 0x69, 0x6d, 0xa7, 0x48, 0x6e, 0x84, 0x49, 0x44, 0x62, 0x47, 0xdc,
+	0x14, 0x40, 0x21, 0x48, 0x75, 0x75, 0x50, 0x54, 0x68, 0xa6, 0x20, 0x5c,
+	0xc1, 0x65, 0x76, 0x69, 0x63, 0x65, 0x3c, 0x20, 0x42, 0x61, 0x63, 0x6b,
+	0x45, 0x78, 0x69, 0x74, 0x85, 0x57, 0x61, 0x76, 0xd3, 0x68, 0x52, 0xfb,
+	0x51, 0x74, 0x6f, 0x61, 0x4d, 0x44, 0x22, 0x26, 0x4c, 0x48, 0x42, 0x36,
+	0x5a, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x43, 0x6f, 0x6e, 0x74,
+	0x72, 0x61, 0x73, 0x74, 0xbc, 0x0a, 0x6c, 0x5f, 0x4a, 0x20, 0x89, 0x41,
+	0x9d, 0xe7, 0xe8,
+	// Block 1 (strings 15-25)
+	0x30, 0x4c, 0x61, 0x42, 0x3f, 0x75, 0x61, 0x67, 0x65, 0x54, 0x32, 0x49,
+	0x55, 0x8d, 0x38, 0x87, 0x73, 0x43, 0x65, 0x6c, 0x73, 0x69, 0x75, 0x73,
+	0x46, 0x61, 0x68, 0xf8, 0x07, 0x6e, 0x68, 0x65, 0x08, 0x52, 0x00, 0x02,
+	0xf0, 0x69, 0x76, 0x38, 0x48, 0x75, 0x6d, 0x69, 0x64, 0x8a, 0x59, 0x79,
+	0x42, 0x61, 0x72, 0x6f, 0x6d, 0x65, 0x74, 0x72, 0x69, 0x63, 0x20, 0x50,
+	0x45, 0x48, 0x73, 0xc5, 0x47, 0xba, 0x32, 0x5f, 0x48, 0x69, 0x67, 0x68,
+	0x20, 0xaa, 0x35, 0x4a, 0x41, 0x90, 0x48, 0x4c, 0x2b, 0x07, 0x9d, 0x03,
+	0x1c, 0x59, 0x20, 0x45, 0x6e, 0x61, 0x62, 0x6c, 0x65, 0x64, 0x48, 0x44,
+	0x10, 0x23, 0x9f, 0xe7, 0xe8,
+	// Block 2 (strings 26-39)
+	0x30, 0x53, 0x61, 0x71, 0x4a, 0x6c, 0x91, 0x10, 0x49, 0x6e, 0x10, 0x72,
+	0x76, 0x55, 0x38, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x73, 0x6d, 0x67,
+	0x08, 0x75, 0x50, 0x73, 0x68, 0xb6, 0x59, 0xd1, 0x72, 0x73, 0x55, 0x73,
+	0x65, 0x20, 0x44, 0x48, 0x43, 0x50, 0x49, 0x50, 0x20, 0x41, 0x64, 0x64,
+	0x5a, 0x59, 0x73, 0x53, 0x75, 0x62, 0x8d, 0x5d, 0x39, 0x20, 0x4d, 0x61,
+	0x73, 0x6b, 0x44, 0x7a, 0x49, 0x47, 0x70, 0x40, 0x65, 0x54, 0x79, 0x4e,
+	0x76, 0x1e, 0x20, 0x4e, 0x61, 0x6d, 0x65, 0x20, 0x28, 0x53, 0x53, 0x49,
+	0x44, 0x29, 0x6b, 0x48, 0x50, 0xd2, 0x09, 0x73, 0x56, 0x64, 0x53, 0x72,
+	0x5a, 0x02, 0x73, 0x61, 0x76, 0x02, 0x46, 0xbe, 0x46, 0x5a, 0x62, 0xf8,
+	0x40, 0x2c, 0x0a, 0x72, 0x49, 0x41, 0x58, 0x48, 0x79, 0x7d, 0x00, 0x23,
+	0x41, 0x4f, 0x48, 0x3f, 0xbf, 0x01, 0x20, 0x15, 0x52, 0x4f, 0x4b, 0x0e,
+	0x41, 0x5b, 0x69, 0x66, 0xf3, 0x1b, 0x20, 0x6f, 0x72, 0x20, 0x42, 0x61,
+	0x63, 0x6b, 0x65, 0x18, 0x61, 0x6e, 0x63, 0x65, 0x6c, 0x2e, 0x0a, 0x57,
+	0xd1, 0x20, 0x40, 0x82, 0x4d, 0x21, 0xd0, 0x20, 0x52, 0x5d, 0x79, 0x20,
+	0x6b, 0x65, 0x79, 0xcb, 0x41, 0x9e, 0x50, 0x75, 0x65, 0xdc, 0xe7, 0xf0,
+	0xe8,
+	// Block 3 (strings 40-48)
+	0x49, 0x43, 0xa5, 0x29, 0x62, 0x74, 0x42, 0x8e, 0x44, 0x9d, 0x18, 0x73,
+	0x2c, 0x20, 0x70, 0x6c, 0x65, 0x61, 0x9f, 0x40, 0xc3, 0xe8, 0x61, 0x08,
+	0x2e, 0x4f, 0x0a, 0xdc, 0x01, 0x51, 0x6f, 0x6e, 0xa5, 0x29, 0x6d, 0x31,
+	0x74, 0x65, 0x59, 0x20, 0x40, 0x89, 0x4a, 0x63, 0xc7, 0x47, 0x7e, 0x33,
+	0x0f, 0x2e, 0x04, 0x37, 0x65, 0x64, 0x33, 0x50, 0x0a, 0x44, 0x3e, 0x0f,
+	0x63, 0x02, 0x48, 0x66, 0x59, 0x0f, 0x6d, 0x11, 0x48, 0x57, 0x77, 0x49,
+	0x6e, 0xb9, 0x40, 0x48, 0x48, 0x62, 0x9c, 0x20, 0x18, 0x8b, 0x72, 0x79,
+	0x20, 0x6c, 0x65, 0x76, 0x65, 0x6c, 0x20, 0x69, 0x73, 0x10, 0x6f, 0x77,
+	0x05, 0x2c, 0x42, 0x22, 0x85, 0x50, 0x63, 0x68, 0xd5, 0xe9, 0x67, 0x07,
+	0x42, 0x48, 0x66, 0x13, 0x14, 0x6c, 0x79, 0x62, 0xb3, 0x6f, 0x46, 0xdc,
+	0x4f, 0x41, 0x18, 0x48, 0x76, 0x39, 0x40, 0x15, 0x51, 0x62, 0x6c, 0x4d,
+	0xe7, 0xe8,
+	// Block 4 (strings 49-55)
+	0x4a, 0x55, 0xb7, 0x42, 0x91, 0x4d, 0x66, 0xa5, 0x5a, 0x12, 0x2c, 0x20,
+	0x64, 0x6f, 0xc5, 0x44, 0x80, 0x18, 0x20, 0x6f, 0x66, 0x66, 0x2e, 0xf4,
+	0x57, 0x0a, 0x46, 0x87, 0x41, 0x4c, 0x50, 0x20, 0x52, 0x53, 0x08, 0x74,
+	0x70, 0x42, 0xc5, 0x22, 0x45, 0x87, 0x44, 0x5b, 0x42, 0xc1, 0x42, 0x33,
+	0x40, 0xbe, 0x31, 0x6e, 0x64, 0x01, 0x27, 0x63, 0x21, 0x0a, 0x61, 0x48,
+	0x40, 0xa5, 0x51, 0x75, 0x74, 0xa1, 0x00, 0x28, 0x61, 0xa7, 0x48, 0x65,
+	0xdc, 0x47, 0x45, 0x21, 0xb4, 0x48, 0x6e, 0x29, 0x4f, 0x63, 0x21, 0x46,
+	0xdb, 0x4b, 0x6f, 0x3b, 0x48, 0x69, 0xdf, 0x00, 0x11, 0x50, 0x69, 0x6d,
+	0x73, 0x42, 0xb6, 0x47, 0xbf, 0x18, 0xb8, 0x68, 0x65, 0x63, 0x6b, 0x73,
+	0x75, 0x6d, 0x20, 0x6d, 0x69, 0x73, 0x6d, 0x61, 0x74, 0x61, 0xbe, 0x41,
+	0x8d, 0x59, 0x1f, 0x63, 0x65, 0x69, 0x76, 0xd6, 0x41, 0x43, 0x48, 0x61,
+	0xd5, 0xe7, 0xe8,
+	// Block 5 (strings 56-61)
+	0x47, 0xce, 0xd0, 0x42, 0xac, 0x28, 0x66, 0xf8, 0x38, 0x73, 0x68, 0x20,
+	0x6d, 0x65, 0x6d, 0x48, 0x79, 0x5d, 0x47, 0xd8, 0x41, 0xb9, 0x57, 0x73,
+	0x65, 0xdb, 0xee, 0x47, 0x81, 0x42, 0xaa, 0x5e, 0x32, 0x45, 0x45, 0x50,
+	0x52, 0x4f, 0x4d, 0xd5, 0x41, 0x22, 0x49, 0x76, 0x24, 0x49, 0x64, 0xcd,
+	0x59, 0x6e, 0x66, 0x69, 0x67, 0x75, 0x65, 0x28, 0x69, 0xb0, 0x74, 0x2c,
+	0x20, 0xfe, 0x4c, 0x64, 0x1f, 0x4f, 0x73, 0xd2, 0x4f, 0x66, 0x01, 0x50,
+	0x08, 0x20, 0x71, 0x69, 0x6c, 0xc0, 0x06, 0x0e, 0x40, 0x89, 0x28, 0x74,
+	0x4f, 0x66, 0x72, 0x0f, 0xe7, 0xe8,
+	// Block 6 (strings 62-68)
+	0x45, 0x85, 0x39, 0x02, 0x73, 0x79, 0x73, 0x00, 0xc6, 0x28, 0x74, 0x20,
+	0xc9, 0x4f, 0x64, 0x6f, 0x54, 0x65, 0x3a, 0x70, 0x3c, 0x05, 0x2d, 0x6f,
+	0x6e, 0x47, 0xdd, 0xc5, 0xff, 0x77, 0x61, 0x74, 0x63, 0x68, 0x64, 0x6f,
+	0x67, 0xf4, 0x03, 0x40, 0x3c, 0x52, 0x66, 0x74, 0x3e, 0x46, 0xdd, 0x43,
+	0x29, 0x47, 0x19, 0x0f, 0x64, 0x5a, 0x08, 0x61, 0xc0, 0x41, 0x87, 0x40,
+	0x11, 0x17, 0x69, 0x6c, 0x18, 0x42, 0xa7, 0x72, 0x61, 0x64, 0xd6, 0x24,
+	0x50, 0x20, 0x76, 0xd6, 0x48, 0x75, 0xab, 0xef, 0x0a, 0xf0, 0xe8,
+	// Block 7 (strings 69-75)
+	0x4d, 0x5b, 0xc5, 0x47, 0x97, 0x35, 0x37, 0x64, 0x0a, 0x18, 0x20, 0x51,
+	0x6e, 0x6b, 0x92, 0x27, 0x77, 0x48, 0x64, 0x63, 0x2f, 0x6e, 0x62, 0x08,
+	0x72, 0xb5, 0x51, 0x72, 0x79, 0x9e, 0x41, 0x86, 0x08, 0x6e, 0x48, 0x63,
+	0xb8, 0x29, 0x6f, 0x12, 0x43, 0x9f, 0x20, 0x5f, 0x1a, 0x68, 0x69, 0x67,
+	0x68, 0x87, 0x30, 0x74, 0x72, 0x46, 0x08, 0x67, 0x41, 0x93, 0x46, 0xd7,
+	0x48, 0x6c, 0xac, 0x47, 0xd8, 0xfa, 0x0c, 0x47, 0xdc, 0x5a, 0x1f, 0x63,
+	0x6c, 0x65, 0x61, 0xde, 0xe7, 0xe8,
+	// Block 8 (strings 76-80)
+	0x2e, 0x5b, 0x29, 0x18, 0x5d, 0x20, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x64,
+	0x20, 0x66, 0x72, 0x6f, 0x44, 0x3f, 0x45, 0x45, 0x50, 0x52, 0x4f, 0x4d,
+	0x0a, 0x12, 0x19, 0x01, 0x73, 0x61, 0x76, 0x17, 0x74, 0x6f, 0x2a, 0x44,
+	0x50, 0x4d, 0x64, 0x71, 0x48, 0x76, 0xa7, 0x48, 0x75, 0x37, 0x20, 0x0c,
+	0x45, 0x40, 0x40, 0x49, 0x08, 0x74, 0x22, 0x08, 0x28, 0x6c, 0x44, 0x2c,
+	0x3f, 0x20, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x01, 0x40, 0x31, 0x29, 0x6b,
+	0x43, 0x8a, 0x47, 0xdd, 0x7f, 0xe7, 0xe8
+};
+
+static const uint16_t tests_strings_block_offsets[9] = {
+	0, 123, 224, 405, 539, 674, 764, 847,
+	925
+};
+
+static const uint16_t tests_strings_block_first[9] = {
+	0, 15, 26, 40, 49, 56, 62, 69,
+	76
+};
+
+static const uint8_t tests_strings_ends[81] = {
+	9, 17, 33, 49, 64, 78, 100, 117, 123, 132, 145, 169,
+	179, 187, 204, 8, 25, 32, 42, 59, 78, 89, 111, 132,
+	145, 159, 17, 24, 31, 36, 44, 54, 65, 80, 99, 115,
+	131, 158, 211, 247, 36, 58, 83, 105, 132, 163, 184, 210,
+	237, 39, 71, 101, 137, 174, 202, 245, 40, 77, 120, 166,
+	197, 219, 22, 57, 92, 127, 148, 179, 210, 22, 40, 60,
+	90, 131, 171, 205, 30, 57, 89, 121, 156
+};
+
+const lzsa_str_table_t tests_strings = {
+	.format = 2,
+	.dict = tests_strings_dict,
+	.dict_len = 127,
+	.data = tests_strings_data,
+	.block_offsets = tests_strings_block_offsets,
+	.block_first = tests_strings_block_first,
+	.block_count = 9,
+	.ends = tests_strings_ends,
+	.count = 81,
+};
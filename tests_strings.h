@@ -0,0 +1,94 @@
+// Generated by lzsa_strings. Do not edit.
+
+#ifndef TESTS_STRINGS_H_
+#define TESTS_STRINGS_H_
+
+#include "lzsa_str.h"
+
+#define TEST_STR_MENU_MAIN 0
+#define TEST_STR_MENU_SETTINGS 1
+#define TEST_STR_MENU_DISPLAY 2
+#define TEST_STR_MENU_NETWORK 3
+#define TEST_STR_MENU_SENSORS 4
+#define TEST_STR_MENU_ALARMS 5
+#define TEST_STR_MENU_TIME 6
+#define TEST_STR_MENU_ABOUT 7
+#define TEST_STR_MENU_BACK 8
+#define TEST_STR_MENU_EXIT 9
+#define TEST_STR_MENU_SAVE 10
+#define TEST_STR_MENU_RESTORE 11
+#define TEST_STR_LBL_BRIGHTNESS 12
+#define TEST_STR_LBL_CONTRAST 13
+#define TEST_STR_LBL_BACKLIGHT 14
+#define TEST_STR_LBL_LANGUAGE 15
+#define TEST_STR_LBL_UNITS 16
+#define TEST_STR_LBL_CELSIUS 17
+#define TEST_STR_LBL_FAHRENHEIT 18
+#define TEST_STR_LBL_HUMIDITY 19
+#define TEST_STR_LBL_PRESSURE 20
+#define TEST_STR_LBL_TEMPERATURE 21
+#define TEST_STR_LBL_HIGH_ALARM 22
+#define TEST_STR_LBL_LOW_ALARM 23
+#define TEST_STR_LBL_ALARM_ON 24
+#define TEST_STR_LBL_ALARM_OFF 25
+#define TEST_STR_LBL_INTERVAL 26
+#define TEST_STR_LBL_SECONDS 27
+#define TEST_STR_LBL_MINUTES 28
+#define TEST_STR_LBL_HOURS 29
+#define TEST_STR_LBL_DHCP 30
+#define TEST_STR_LBL_IP_ADDR 31
+#define TEST_STR_LBL_NETMASK 32
+#define TEST_STR_LBL_GATEWAY 33
+#define TEST_STR_LBL_SSID 34
+#define TEST_STR_LBL_PASSWORD 35
+#define TEST_STR_MSG_SAVED 36
+#define TEST_STR_MSG_RESTORED 37
+#define TEST_STR_MSG_CONFIRM 38
+#define TEST_STR_MSG_WELCOME 39
+#define TEST_STR_MSG_CALIBRATING 40
+#define TEST_STR_MSG_CALIBRATED 41
+#define TEST_STR_MSG_CONNECTING 42
+#define TEST_STR_MSG_CONNECTED 43
+#define TEST_STR_MSG_DISCONNECTED 44
+#define TEST_STR_MSG_LOW_BATTERY 45
+#define TEST_STR_MSG_CHARGING 46
+#define TEST_STR_MSG_CHARGED 47
+#define TEST_STR_MSG_UPDATE 48
+#define TEST_STR_MSG_UPDATING 49
+#define TEST_STR_MSG_UPDATED 50
+#define TEST_STR_ERR_SENSOR 51
+#define TEST_STR_ERR_SENSOR_RANGE 52
+#define TEST_STR_ERR_NETWORK 53
+#define TEST_STR_ERR_TIMEOUT 54
+#define TEST_STR_ERR_CHECKSUM 55
+#define TEST_STR_ERR_FLASH_WRITE 56
+#define TEST_STR_ERR_FLASH_ERASE 57
+#define TEST_STR_ERR_EEPROM 58
+#define TEST_STR_ERR_CONFIG 59
+#define TEST_STR_ERR_UPDATE 60
+#define TEST_STR_ERR_MEMORY 61
+#define TEST_STR_LOG_BOOT 62
+#define TEST_STR_LOG_RESET_POR 63
+#define TEST_STR_LOG_RESET_WDG 64
+#define TEST_STR_LOG_RESET_SW 65
+#define TEST_STR_LOG_SENSOR_INIT 66
+#define TEST_STR_LOG_SENSOR_FAIL 67
+#define TEST_STR_LOG_SENSOR_READ 68
+#define TEST_STR_LOG_NET_INIT 69
+#define TEST_STR_LOG_NET_UP 70
+#define TEST_STR_LOG_NET_DOWN 71
+#define TEST_STR_LOG_NET_RETRY 72
+#define TEST_STR_LOG_ALARM_HIGH 73
+#define TEST_STR_LOG_ALARM_LOW 74
+#define TEST_STR_LOG_ALARM_CLEAR 75
+#define TEST_STR_LOG_SETTINGS_LOAD 76
+#define TEST_STR_LOG_SETTINGS_SAVE 77
+#define TEST_STR_LOG_SETTINGS_DEF 78
+#define TEST_STR_LOG_IDLE 79
+#define TEST_STR_LOG_WAKE 80
+
+#define TESTS_STRINGS_COUNT 81
+
+extern const lzsa_str_table_t tests_strings;
+
+#endif // TESTS_STRINGS_H_
@@ -0,0 +1,250 @@
+#!/bin/sh
+# ------------------------------------------------------------------------------
+#
+# bench_matrix.sh - Benchmark matrix across memory models, SDCC optimisation
+#                   options, STM8 device types and clock speeds
+#
+# Copyright (c) 2022 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# ------------------------------------------------------------------------------
+
+# Builds the test program for every combination of memory model and C
+# optimisation option, then runs it in corpus mode under μCsim on every test
+# corpus item with every decoder, for each device type and clock speed. Prints
+# a single Markdown table of code size, cycles per byte and throughput.
+#
+# With DATA set to "classes", the corpus is instead the data-class corpus in
+# tests/corpus, and the table has a row for each class of data with each
+# decoder, which also gives the compression ratio.
+#
+# The configurations tested may be changed by setting the following variables
+# in the environment (lists are space-separated):
+#
+#   MODELS   Memory models (default "medium large"), optionally with a "_ram"
+#            suffix (e.g. "large_ram") for the library built to run from RAM,
+#            which adds the RAM-resident decoders to the benchmark
+#   OPTS     C optimisation options, "default" meaning none (default
+#            "default --opt-code-speed --opt-code-size")
+#   DEVICES  μCsim device types (default "STM8S208")
+#   CLOCKS   Clock speeds (default "16M")
+#   DATA     Corpus to decompress, "tests" for the test corpus items or
+#            "classes" for the data-class corpus (default "tests")
+#   SDCC, SDAS, SSTM8, CC
+#            Paths to tools (defaults "sdcc", "sdasstm8", "sstm8", "cc")
+#
+# Any device must have enough flash and RAM for the test program (see README).
+
+set -e
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$SCRIPT_DIR/../.." && pwd)
+BUILD="$SCRIPT_DIR/build"
+
+MODELS=${MODELS:-"medium large"}
+OPTS=${OPTS:-"default --opt-code-speed --opt-code-size"}
+DEVICES=${DEVICES:-"STM8S208"}
+CLOCKS=${CLOCKS:-"16M"}
+DATA=${DATA:-tests}
+SDCC=${SDCC:-sdcc}
+SDAS=${SDAS:-sdasstm8}
+SSTM8=${SSTM8:-sstm8}
+CC=${CC:-cc}
+
+C_SRCS="main.c tests.c lzsa_ref.c lzsa_fast.c lzsa_cache.c lzsa_archive.c lzsa_str.c lzsa_overlay.c lzsa_patch.c lzsa_comp.c tests_strings.c uart.c ucsim.c"
+
+# Decoders to benchmark, and the test data file extension each decodes. Those
+# run from RAM are only available with the "_ram" memory models.
+DECODERS="lzsa1:lzsa1 lzsa2:lzsa2 lz4:lz4 zx0:zx0 lzsa1_ref:lzsa1 lzsa2_ref:lzsa2 lz4_ref:lz4 zx0_ref:zx0 lzsa1_fast:lzsa1 lzsa2_fast:lzsa2 lzsa_native:native lzsa_native_ref:native"
+RAM_DECODERS="$DECODERS lzsa1_ram:lzsa1 lzsa2_ram:lzsa2"
+
+# Print the size of every function defined in the code area of the given
+# object files, as "name size" lines. Functions in an object are assumed to be
+# laid out in order of their symbol definitions, so any static (non-global)
+# functions are counted as part of the preceding global one.
+code_sizes() {
+	awk '
+		function flush() {
+			n = 0
+			for(s in off) offs[n++] = off[s] " " s
+			for(i = 0; i < n; i++) for(j = i + 1; j < n; j++) {
+				split(offs[i], a, " "); split(offs[j], b, " ")
+				if(a[1] + 0 > b[1] + 0) { t = offs[i]; offs[i] = offs[j]; offs[j] = t }
+			}
+			for(i = 0; i < n; i++) {
+				split(offs[i], a, " ")
+				if(i + 1 < n) { split(offs[i + 1], b, " "); end = b[1] } else { end = size }
+				print a[2], end - a[1]
+			}
+			delete off
+		}
+		function hex(h,    i, v) {
+			v = 0; h = toupper(h)
+			for(i = 1; i <= length(h); i++) v = v * 16 + index("0123456789ABCDEF", substr(h, i, 1)) - 1
+			return v
+		}
+		FNR == 1 { flush(); in_code = 0 }
+		$1 == "A" { flush(); in_code = ($2 == "CODE"); size = hex($4) }
+		$1 == "S" && in_code && $3 ~ /^Def/ { off[$2] = hex(substr($3, 4)) }
+		END { flush() }
+	' "$@"
+}
+
+mkdir -p "$BUILD"
+
+# Build host tool for preparing corpus input and reading results.
+$CC -std=c99 -O2 -o "$BUILD/lzsa_corpus" "$ROOT/tools/lzsa_corpus.c"
+
+case "$DATA" in
+	tests) PLAINS="$ROOT/tests/lzsa_test_*.plain" ;;
+	classes) PLAINS="$ROOT/tests/corpus/*.plain" ;;
+	*) echo "Unknown DATA '$DATA'" >&2; exit 1 ;;
+esac
+
+# Assemble corpus of every corpus item for every one of the given decoders that
+# it has a compressed file for, with the given name. Keep a list of the decoder,
+# data class and compressed size for each block, in order. The class of a
+# data-class corpus item is the part of its name before the first underscore.
+pack_corpus() {
+	CORPUS_ARGS=""
+	: > "$BUILD/$1.list"
+	for t in $PLAINS; do
+		class=$(basename "$t")
+		class=${class%%_*}
+		for d in $2; do
+			name=${d%%:*}
+			ext=${d#*:}
+			[ -f "${t%.plain}.$ext" ] || continue
+			CORPUS_ARGS="$CORPUS_ARGS $name:${t%.plain}.$ext"
+			echo "$name $class $(wc -c < "${t%.plain}.$ext")" >> "$BUILD/$1.list"
+		done
+	done
+	"$BUILD/lzsa_corpus" pack "$BUILD/$1.in" $CORPUS_ARGS
+}
+
+pack_corpus corpus "$DECODERS"
+pack_corpus corpus-ram "$RAM_DECODERS"
+
+if [ "$DATA" = "classes" ]; then
+	echo "| Model     | C Option         | Device   | Clock | Class    | Function                        | Code Size | Ratio  | Cycles/Byte | KB/s   |"
+	echo "| --------- | ---------------- | -------- | ----: | -------- | ------------------------------- | --------: | -----: | ----------: | -----: |"
+else
+	echo "| Model     | C Option         | Device   | Clock | Function                        | Code Size | Cycles/Byte | KB/s   |"
+	echo "| --------- | ---------------- | -------- | ----: | ------------------------------- | --------: | ----------: | -----: |"
+fi
+
+for model in $MODELS; do
+	case "$model" in
+		large*) MODEL_OPT="--model-large" ;;
+		*) MODEL_OPT="" ;;
+	esac
+	case "$model" in
+		*_ram) RAM_OPT="-DLZSA_RAM"; CORPUS="corpus-ram"; MODEL_DECODERS="$RAM_DECODERS" ;;
+		*) RAM_OPT=""; CORPUS="corpus"; MODEL_DECODERS="$DECODERS" ;;
+	esac
+
+	# Assemble library routines, and the test program's generated routines, for
+	# this memory model.
+	LIB_DIR="$BUILD/lib-$model"
+	mkdir -p "$LIB_DIR"
+	for s in "$ROOT"/*.s "$ROOT"/tests/*.s; do
+		case "$(basename "$s")" in
+			lzsa_medium*.s|lzsa_large*.s|lzsa_batch.s) continue ;;
+		esac
+		$SDAS -ff -w -l -p -o "$LIB_DIR/$(basename "${s%.s}").rel" "$ROOT/lzsa_$model.s" "$s"
+	done
+
+	for opt in $OPTS; do
+		if [ "$opt" = "default" ]; then
+			C_OPT=""
+		else
+			C_OPT="$opt"
+		fi
+
+		# Compile test program with this optimisation option and link it with
+		# the library.
+		OBJ_DIR="$BUILD/$model$opt"
+		mkdir -p "$OBJ_DIR"
+		for c in $C_SRCS; do
+			$SDCC -mstm8 --std-c99 $MODEL_OPT $C_OPT $RAM_OPT -DF_CPU=16000000UL -I"$ROOT" -c -o "$OBJ_DIR/${c%.c}.rel" "$ROOT/$c"
+		done
+		$SDCC -mstm8 --std-c99 $MODEL_OPT --out-fmt-ihx -o "$OBJ_DIR/test.ihx" "$OBJ_DIR"/*.rel "$LIB_DIR"/*.rel
+
+		code_sizes "$OBJ_DIR"/*.rel "$LIB_DIR"/*.rel > "$OBJ_DIR/sizes.txt"
+
+		for device in $DEVICES; do
+			for clock in $CLOCKS; do
+				RESULT="$OBJ_DIR/corpus-$device-$clock.out"
+				rm -f "$RESULT"
+				$SSTM8 -t "$device" -X "$clock" -I "if=rom[0x5800],in=$BUILD/$CORPUS.in,out=$RESULT" -G "$OBJ_DIR/test.ihx" > /dev/null
+
+				# Sum cycles and bytes for each decoder (and class, for the
+				# data-class corpus) over all blocks, then output a table row
+				# for each.
+				"$BUILD/lzsa_corpus" report "$RESULT" | paste -d ' ' "$BUILD/$CORPUS.list" - | awk \
+					-v model="$model" -v opt="$opt" -v device="$device" -v clock="$clock" -v sizes="$OBJ_DIR/sizes.txt" -v decoders="$MODEL_DECODERS" -v classes="$([ "$DATA" = "classes" ] && echo 1 || echo 0)" '
+					BEGIN {
+						while((getline line < sizes) > 0) { split(line, a, " "); size[a[1]] = a[2] }
+						hz = clock + 0
+						if(clock ~ /[kK]$/) hz *= 1000
+						if(clock ~ /[mM]$/) hz *= 1000000
+					}
+					{
+						class = classes ? $2 : "-"
+						if(!(class in class_seen)) { class_seen[class] = 1; class_list[++class_count] = class }
+						key = $1 SUBSEP class
+						seen[key] = 1
+						if($5 != 0) failed[key] = 1
+						cycles[key] += $7
+						bytes[key] += $6
+						comp[key] += $3
+					}
+					END {
+						# Classes are listed in order of first appearance, which
+						# is alphabetical, as the corpus files are packed so.
+						n = split(decoders, d, " ")
+						for(c = 1; c <= class_count; c++) for(i = 1; i <= n; i++) {
+							name = d[i]; sub(/:.*/, "", name)
+							key = name SUBSEP class_list[c]
+							if(!(key in seen)) continue
+							fn = name
+							if(fn ~ /_ref$/) { sub(/_ref$/, "", fn); fn = "_" fn "_decompress_block_ref" }
+							else if(fn ~ /_fast$/) { sub(/_fast$/, "", fn); fn = "_" fn "_decompress_block_fast" }
+							else if(fn ~ /_ram$/) { sub(/_ram$/, "", fn); fn = "_" fn "_decompress_block_ram" }
+							else fn = "_" fn "_decompress_block"
+							# Code run from RAM is a copy of the flash routine.
+							if(!(fn in size)) { sz = fn; sub(/_ram$/, "", sz); size[fn] = size[sz] }
+							row = sprintf("| %-9s | %-16s | %-8s | %5s | ", model, opt, device, clock)
+							if(classes) row = row sprintf("%-8s | ", class_list[c])
+							row = row sprintf("%-31s | %9s | ", substr(fn, 2), size[fn])
+							if(failed[key] || bytes[key] == 0 || cycles[key] == 0) {
+								if(classes) row = row sprintf("%6s | ", "-")
+								printf "%s%11s | %6s |\n", row, "FAIL", "-"
+							} else {
+								cpb = cycles[key] / bytes[key]
+								if(classes) row = row sprintf("%5.1f%% | ", 100 * comp[key] / bytes[key])
+								printf "%s%11.2f | %6.1f |\n", row, cpb, hz / cpb / 1024
+							}
+						}
+					}'
+			done
+		done
+	done
+done
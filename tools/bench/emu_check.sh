@@ -0,0 +1,116 @@
+#!/bin/sh
+# ------------------------------------------------------------------------------
+#
+# emu_check.sh - Cross-check lzsa_emu against μCsim on the test corpus
+#
+# Copyright (c) 2022 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# ------------------------------------------------------------------------------
+
+# Runs an already built test program in corpus mode under both μCsim and the
+# lzsa_emu emulator, on every test corpus item with every decoder, and compares
+# the results: the decompressed output and the cycle count of every block.
+# Prints a line for each block that differs, the total cycles of each decoder
+# under both simulators (with how many more μCsim counts, as lzsa_emu does not
+# model instruction fetch stalls), and the time each simulator took. Exits with
+# a failure status if any block differs. For example:
+#
+#   tools/bench/emu_check.sh bin/Test/test
+#
+# The test program defaults to bin/Test/test. The following variables may be
+# set in the environment:
+#
+#   DECODERS  Decoders to run, as "name:extension" pairs (default all of those
+#             benchmarked by bench_matrix.sh that run from flash)
+#   DEVICE    μCsim device type (default "STM8S208")
+#   SSTM8, CC Paths to tools (defaults "sstm8", "cc")
+
+set -e
+
+SCRIPT_DIR=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(cd "$SCRIPT_DIR/../.." && pwd)
+BUILD="$SCRIPT_DIR/build"
+
+PROGRAM=${1:-"$ROOT/bin/Test/test"}
+DECODERS=${DECODERS:-"lzsa1:lzsa1 lzsa2:lzsa2 lz4:lz4 zx0:zx0 lzsa1_ref:lzsa1 lzsa2_ref:lzsa2 lz4_ref:lz4 zx0_ref:zx0 lzsa1_fast:lzsa1 lzsa2_fast:lzsa2 lzsa_native:native lzsa_native_ref:native"}
+DEVICE=${DEVICE:-STM8S208}
+SSTM8=${SSTM8:-sstm8}
+CC=${CC:-cc}
+
+mkdir -p "$BUILD"
+
+$CC -std=c99 -O2 -o "$BUILD/lzsa_corpus" "$ROOT/tools/lzsa_corpus.c"
+$CC -std=c99 -O2 -o "$BUILD/lzsa_emu" "$ROOT/tools/lzsa_emu.c"
+
+# Pack every test corpus item for every decoder it has a compressed file for,
+# keeping a list of the decoder and file of each block, in order.
+CORPUS_ARGS=""
+: > "$BUILD/check.list"
+for t in "$ROOT"/tests/lzsa_test_*.plain; do
+	for d in $DECODERS; do
+		name=${d%%:*}
+		ext=${d#*:}
+		[ -f "${t%.plain}.$ext" ] || continue
+		CORPUS_ARGS="$CORPUS_ARGS $name:${t%.plain}.$ext"
+		echo "$name $(basename "${t%.plain}.$ext")" >> "$BUILD/check.list"
+	done
+done
+"$BUILD/lzsa_corpus" pack "$BUILD/check.in" $CORPUS_ARGS
+
+# Run the program under each simulator, timing it in milliseconds.
+run() {
+	rm -f "$BUILD/check-$1.out"
+	start=$(date +%s%N)
+	$2 -t "$DEVICE" -X 16M -I "if=rom[0x5800],in=$BUILD/check.in,out=$BUILD/check-$1.out" -G "$PROGRAM" > /dev/null
+	end=$(date +%s%N)
+	echo "$1: $(( (end - start) / 1000000 )) ms"
+	"$BUILD/lzsa_corpus" report "$BUILD/check-$1.out" > "$BUILD/check-$1.txt"
+}
+
+run ucsim "$SSTM8"
+run emu "$BUILD/lzsa_emu"
+
+# Compare status, length and cycles of each block; then, if they all agree, the
+# whole output including the decompressed data.
+paste -d ' ' "$BUILD/check.list" "$BUILD/check-ucsim.txt" "$BUILD/check-emu.txt" | awk '
+	{
+		if($4 != $8 || $5 != $9 || $6 != $10) {
+			printf "%s %s: μCsim status %s, %s bytes, %s cycles; lzsa_emu status %s, %s bytes, %s cycles\n", $1, $2, $4, $5, $6, $8, $9, $10
+			bad++
+		}
+		if(!($1 in ucsim)) order[n++] = $1
+		ucsim[$1] += $6
+		emu[$1] += $10
+	}
+	END {
+		for(i = 0; i < n; i++) {
+			d = order[i]
+			printf "%s: μCsim %d cycles, lzsa_emu %d cycles", d, ucsim[d], emu[d]
+			if(emu[d] > 0) printf " (μCsim %+.1f%%)", (ucsim[d] - emu[d]) * 100 / emu[d]
+			printf "\n"
+		}
+		printf "%d blocks, %d differ\n", NR, bad
+		exit(bad > 0)
+	}'
+if ! cmp -s "$BUILD/check-ucsim.out" "$BUILD/check-emu.out"; then
+	echo "Decompressed output differs"
+	exit 1
+fi
@@ -0,0 +1,135 @@
+/*******************************************************************************
+ *
+ * fuzz_fw.c - Firmware side of differential fuzzing harness
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Runs under the μCsim simulator, driven by the lzsa_fuzz host tool. Reads
+// compressed blocks from the simulator's interface input file, decompresses
+// each with the library's assembly routines, and writes the results to the
+// interface output file. Stops the simulator when input is exhausted.
+//
+// Input record:  <format:1> <length:2 LE> <compressed data:length>
+// Output record: <status:1> <length:2 LE> <decompressed data:length>
+//
+// Where format is 1 for LZSA1 or 2 for LZSA2, and status is one of the
+// fuzz_status_t values.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ucsim.h"
+#include "lzsa.h"
+
+#define CLK_CKDIVR (*(volatile uint8_t *)(0x50C6))
+
+// Buffer sizes must agree with those in lzsa_fuzz.c. Total, plus stack, must
+// fit in the 6 KB of RAM of the STM8S208.
+#define FUZZ_IN_MAX 1024
+#define FUZZ_OUT_MAX 4096
+
+// Number of bytes past the end of decompressed output that are checked for
+// having been left untouched, and the value they are filled with beforehand.
+#define FUZZ_GUARD_LEN 16
+#define FUZZ_GUARD_BYTE 0xA5
+
+typedef enum {
+	FUZZ_STATUS_OK = 0,
+	FUZZ_STATUS_BAD_FORMAT = 1,
+	FUZZ_STATUS_BAD_LENGTH = 2,
+	FUZZ_STATUS_OVERRUN = 3,
+} fuzz_status_t;
+
+/******************************************************************************/
+
+static uint8_t fuzz_in[FUZZ_IN_MAX];
+static uint8_t fuzz_out[FUZZ_OUT_MAX + FUZZ_GUARD_LEN];
+
+/******************************************************************************/
+
+static uint16_t read_word(void) {
+	uint16_t w = (uint8_t)ucsim_if_fin_getc();
+	w |= (uint16_t)(uint8_t)ucsim_if_fin_getc() << 8;
+	return w;
+}
+
+static void write_word(const uint16_t w) {
+	ucsim_if_fout_putc(w & 0xFF);
+	ucsim_if_fout_putc(w >> 8);
+}
+
+static fuzz_status_t decompress(const uint8_t format, uint8_t **end) {
+	memset(fuzz_out, FUZZ_GUARD_BYTE, sizeof(fuzz_out));
+
+	switch(format) {
+		case 1: *end = lzsa1_decompress_block(fuzz_out, fuzz_in); break;
+		case 2: *end = lzsa2_decompress_block(fuzz_out, fuzz_in); break;
+		default: *end = fuzz_out; return FUZZ_STATUS_BAD_FORMAT;
+	}
+
+	// Output must not extend past the buffer, nor may anything have been
+	// written in the guard area following the end of the output.
+	if(*end < fuzz_out || *end > fuzz_out + FUZZ_OUT_MAX) {
+		*end = fuzz_out;
+		return FUZZ_STATUS_OVERRUN;
+	}
+	for(uint8_t *p = *end; p < *end + FUZZ_GUARD_LEN; p++) {
+		if(*p != FUZZ_GUARD_BYTE) return FUZZ_STATUS_OVERRUN;
+	}
+
+	return FUZZ_STATUS_OK;
+}
+
+void main(void) {
+	fuzz_status_t status;
+	uint8_t format, *end;
+	uint16_t len;
+
+	CLK_CKDIVR = 0;
+
+	if(!ucsim_if_detect()) while(1);
+
+	while(ucsim_if_fin_avail()) {
+		format = (uint8_t)ucsim_if_fin_getc();
+		len = read_word();
+
+		if(len <= FUZZ_IN_MAX) {
+			for(uint16_t i = 0; i < len; i++) fuzz_in[i] = (uint8_t)ucsim_if_fin_getc();
+			status = decompress(format, &end);
+		} else {
+			for(uint16_t i = 0; i < len; i++) ucsim_if_fin_getc();
+			status = FUZZ_STATUS_BAD_LENGTH;
+			end = fuzz_out;
+		}
+
+		len = (uint16_t)(end - fuzz_out);
+		ucsim_if_fout_putc(status);
+		write_word(len);
+		for(uint16_t i = 0; i < len; i++) ucsim_if_fout_putc(fuzz_out[i]);
+	}
+
+	ucsim_if_stop();
+
+	while(1);
+}
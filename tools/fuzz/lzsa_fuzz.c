@@ -0,0 +1,797 @@
+/*******************************************************************************
+ *
+ * lzsa_fuzz.c - Parallel differential fuzzing of LZSA decompression
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Generates random and adversarial LZSA1/LZSA2 raw blocks, decompresses them
+// with the library's assembly routines running under μCsim (several simulator
+// instances in parallel), and compares the results against the reference C
+// implementation (lzsa_ref.c) compiled natively. Failing blocks are minimised
+// and written out. See the Makefile in this folder for building, and the
+// 'Fuzzing' section of README.md for usage.
+//
+// Blocks are generated as a list of sequences (literal run plus match), which
+// are then encoded with a randomly chosen valid encoding for every field, so
+// that every extended-length form, offset mode and the repeat offset are
+// exercised, including non-canonical encodings (e.g. a short length given in
+// 16-bit form) that a compressor would never produce but which are valid.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "lzsa_ref.h"
+
+// Buffer sizes must agree with those in fuzz_fw.c.
+#define FUZZ_IN_MAX 1024
+#define FUZZ_OUT_MAX 4096
+
+#define MAX_SEQS 64
+#define MAX_JOBS 64
+#define SIM_TIMEOUT_MS 60000
+#define SIM_POLL_MS 5
+
+typedef enum {
+	FUZZ_STATUS_OK = 0,
+	FUZZ_STATUS_BAD_FORMAT = 1,
+	FUZZ_STATUS_BAD_LENGTH = 2,
+	FUZZ_STATUS_OVERRUN = 3,
+	FUZZ_STATUS_NO_OUTPUT = 0xFF, // Simulator crashed, hung or stopped early
+} fuzz_status_t;
+
+// A sequence is a run of literals followed by a match. The last sequence of a
+// block has a match length of zero, meaning end-of-data (EOD). A match offset
+// of zero means re-use the previous offset (LZSA2 only). The form values
+// select which of the valid encodings to use for each field; they are reduced
+// modulo the number of valid encodings when encoding.
+typedef struct {
+	uint16_t lit_len;
+	uint16_t match_off;
+	uint16_t match_len;
+	uint8_t lit_form;
+	uint8_t off_form;
+	uint8_t len_form;
+} seq_t;
+
+typedef struct {
+	uint8_t format;
+	uint8_t seq_count;
+	seq_t seqs[MAX_SEQS];
+	uint8_t lits[FUZZ_OUT_MAX];  // Literal byte pool, consumed in order
+	uint8_t comp[FUZZ_IN_MAX];   // Encoded block
+	uint16_t comp_len;
+	uint8_t plain[FUZZ_OUT_MAX]; // Expected output (from generator)
+	uint16_t plain_len;
+} block_t;
+
+typedef struct {
+	uint8_t status;
+	uint16_t len;
+	uint8_t data[FUZZ_OUT_MAX];
+} result_t;
+
+typedef struct {
+	size_t first;
+	size_t count;
+	pid_t pid;
+	struct timespec start;
+	char in_path[64];
+	char out_path[64];
+} job_t;
+
+/******************************************************************************/
+
+static const char *sim_path = "sstm8";
+static const char *fw_path = "fuzz_fw.ihx";
+static const char *fail_dir = ".";
+static const char *tmp_dir = "/tmp";
+static unsigned long rng_state;
+
+static block_t *blocks;
+static size_t block_count = 1000;
+static size_t batch_size = 50;
+static unsigned int job_count = 4;
+static unsigned int formats = 0x3;
+static bool verbose = false;
+
+/******************************************************************************/
+
+static uint32_t rng_next(void) {
+	// xorshift64*
+	rng_state ^= rng_state >> 12;
+	rng_state ^= rng_state << 25;
+	rng_state ^= rng_state >> 27;
+	return (uint32_t)((rng_state * 2685821657736338717ULL) >> 32);
+}
+
+static uint32_t rng_range(const uint32_t lo, const uint32_t hi) {
+	return lo + (rng_next() % (hi - lo + 1));
+}
+
+// Pick a length, biased towards values either side of the boundaries between
+// the different length encodings of both formats.
+static uint16_t rng_length(const uint16_t min, const uint16_t max) {
+	static const uint16_t edges[] = { 0, 1, 2, 3, 6, 7, 8, 9, 10, 17, 18, 19, 23, 24, 25, 254, 255, 256, 257, 511, 512, 513 };
+	uint16_t len;
+
+	if(min > max) return min;
+
+	switch(rng_range(0, 3)) {
+		case 0:
+			len = edges[rng_range(0, (sizeof(edges) / sizeof(edges[0])) - 1)];
+			break;
+		case 1:
+			len = (uint16_t)rng_range(0, 20);
+			break;
+		case 2:
+			len = (uint16_t)rng_range(0, 300);
+			break;
+		default:
+			len = (uint16_t)rng_range(0, 600);
+			break;
+	}
+
+	if(len < min) len = min;
+	if(len > max) len = max;
+
+	return len;
+}
+
+// Pick a match offset, biased towards the boundaries between offset modes.
+static uint16_t rng_offset(const uint16_t pos) {
+	static const uint16_t edges[] = { 1, 2, 31, 32, 33, 255, 256, 257, 511, 512, 513, 514, 8703, 8704, 8705 };
+	uint16_t off;
+
+	switch(rng_range(0, 2)) {
+		case 0:
+			off = edges[rng_range(0, (sizeof(edges) / sizeof(edges[0])) - 1)];
+			break;
+		case 1:
+			off = (uint16_t)rng_range(1, 40);
+			break;
+		default:
+			off = (uint16_t)rng_range(1, pos);
+			break;
+	}
+
+	return (off > pos ? pos : off);
+}
+
+/******************************************************************************/
+
+// Output helpers for encoding. Return false when the compressed block would
+// exceed the maximum length.
+#define emit(b, v) do { if((b)->comp_len >= FUZZ_IN_MAX) return false; (b)->comp[(b)->comp_len++] = (uint8_t)(v); } while(0)
+
+typedef struct {
+	block_t *b;
+	int16_t nibble_pos; // Index of byte holding pending low nibble, or -1
+} lzsa2_writer_t;
+
+static bool lzsa2_emit_nibble(lzsa2_writer_t *w, const uint8_t n) {
+	if(w->nibble_pos >= 0) {
+		w->b->comp[w->nibble_pos] |= (n & 0x0F);
+		w->nibble_pos = -1;
+	} else {
+		emit(w->b, (n & 0x0F) << 4);
+		w->nibble_pos = (int16_t)(w->b->comp_len - 1);
+	}
+	return true;
+}
+
+static bool encode_lzsa1(block_t *b) {
+	uint16_t lit_pos = 0;
+
+	b->comp_len = 0;
+
+	for(uint8_t i = 0; i < b->seq_count; i++) {
+		const seq_t *s = &b->seqs[i];
+		const bool eod = (s->match_len == 0);
+		const uint16_t neg_off = (uint16_t)-s->match_off;
+		uint8_t forms, token = 0;
+
+		// Literal length forms: 0 = in token (0-6), 1 = byte (7-255),
+		// 2 = 250 + byte (256-511), 3 = 249 + word (any).
+		uint8_t lit_forms[4], lf = 0;
+		if(s->lit_len < 7) lit_forms[lf++] = 0;
+		if(s->lit_len >= 7 && s->lit_len <= 255) lit_forms[lf++] = 1;
+		if(s->lit_len >= 256 && s->lit_len <= 511) lit_forms[lf++] = 2;
+		lit_forms[lf++] = 3;
+		const uint8_t lit_form = lit_forms[s->lit_form % lf];
+
+		// Offset forms: 0 = single byte (offset 1-256), 1 = two bytes.
+		forms = (neg_off >= 0xFF00 ? 2 : 1);
+		const uint8_t off_form = (forms == 2 ? s->off_form % 2 : 1);
+
+		// Match length forms: 0 = in token (3-17), 1 = byte (18-255),
+		// 2 = 239 + byte (256-511), 3 = 238 + word (any, or zero for EOD).
+		uint8_t len_forms[4], mf = 0;
+		if(!eod && s->match_len < 18) len_forms[mf++] = 0;
+		if(!eod && s->match_len >= 18 && s->match_len <= 255) len_forms[mf++] = 1;
+		if(!eod && s->match_len >= 256 && s->match_len <= 511) len_forms[mf++] = 2;
+		len_forms[mf++] = 3;
+		const uint8_t len_form = len_forms[s->len_form % mf];
+
+		token |= (off_form ? 0x80 : 0x00);
+		token |= (lit_form == 0 ? s->lit_len : 7) << 4;
+		token |= (len_form == 0 ? s->match_len - 3 : 15);
+		emit(b, token);
+
+		switch(lit_form) {
+			case 1: emit(b, s->lit_len - 7); break;
+			case 2: emit(b, 250); emit(b, s->lit_len - 256); break;
+			case 3: emit(b, 249); emit(b, s->lit_len & 0xFF); emit(b, s->lit_len >> 8); break;
+		}
+
+		for(uint16_t j = 0; j < s->lit_len; j++) emit(b, b->lits[lit_pos++]);
+
+		emit(b, neg_off & 0xFF);
+		if(off_form) emit(b, neg_off >> 8);
+
+		switch(len_form) {
+			case 1: emit(b, s->match_len - 18); break;
+			case 2: emit(b, 239); emit(b, s->match_len - 256); break;
+			case 3: emit(b, 238); emit(b, s->match_len & 0xFF); emit(b, s->match_len >> 8); break;
+		}
+	}
+
+	return true;
+}
+
+static bool encode_lzsa2(block_t *b) {
+	lzsa2_writer_t w = { .b = b, .nibble_pos = -1 };
+	uint16_t prev_off = 0, lit_pos = 0;
+
+	b->comp_len = 0;
+
+	for(uint8_t i = 0; i < b->seq_count; i++) {
+		const seq_t *s = &b->seqs[i];
+		const bool eod = (s->match_len == 0);
+		const bool rep = (s->match_off == 0 || (s->match_off == prev_off && s->off_form % 3 == 0));
+		const uint16_t off = (s->match_off == 0 ? prev_off : s->match_off);
+		const uint16_t neg_off = (uint16_t)-off;
+		uint8_t token = 0;
+
+		// Literal length forms: 0 = in token (0-2), 1 = nibble (3-17),
+		// 2 = byte (18-255), 3 = 239 + word (any).
+		uint8_t lit_forms[4], lf = 0;
+		if(s->lit_len < 3) lit_forms[lf++] = 0;
+		if(s->lit_len >= 3 && s->lit_len <= 17) lit_forms[lf++] = 1;
+		if(s->lit_len >= 18 && s->lit_len <= 255) lit_forms[lf++] = 2;
+		lit_forms[lf++] = 3;
+		const uint8_t lit_form = lit_forms[s->lit_form % lf];
+
+		// Offset modes: 0 = 5-bit (1-32), 1 = 9-bit (1-512), 2 = 13-bit
+		// (513-8704), 3 = 16-bit (any), 4 = repeat.
+		uint8_t off_modes[4], om = 0, off_mode;
+		if(rep) {
+			off_mode = 4;
+		} else {
+			if(off <= 32) off_modes[om++] = 0;
+			if(off <= 512) off_modes[om++] = 1;
+			if(off >= 513 && off <= 8704) off_modes[om++] = 2;
+			off_modes[om++] = 3;
+			off_mode = off_modes[s->off_form % om];
+		}
+
+		// Match length forms: 0 = in token (2-8), 1 = nibble (9-23),
+		// 2 = byte (24-255), 3 = 233 + word (any), 4 = EOD.
+		uint8_t len_forms[4], mf = 0, len_form;
+		if(eod) {
+			len_form = 4;
+		} else {
+			if(s->match_len < 9) len_forms[mf++] = 0;
+			if(s->match_len >= 9 && s->match_len <= 23) len_forms[mf++] = 1;
+			if(s->match_len >= 24 && s->match_len <= 255) len_forms[mf++] = 2;
+			len_forms[mf++] = 3;
+			len_form = len_forms[s->len_form % mf];
+		}
+
+		token |= (lit_form == 0 ? s->lit_len : 3) << 3;
+		token |= (len_form == 0 ? s->match_len - 2 : 7);
+		switch(off_mode) {
+			case 0: token |= 0x00 | ((neg_off & 0x01) ? 0x00 : 0x20); break;
+			case 1: token |= 0x40 | ((neg_off & 0x100) ? 0x00 : 0x20); break;
+			case 2: token |= 0x80 | (((uint16_t)(neg_off + 512) & 0x100) ? 0x00 : 0x20); break;
+			case 3: token |= 0xC0; break;
+			case 4: token |= 0xE0; break;
+		}
+		emit(b, token);
+
+		switch(lit_form) {
+			case 1:
+				if(!lzsa2_emit_nibble(&w, s->lit_len - 3)) return false;
+				break;
+			case 2:
+				if(!lzsa2_emit_nibble(&w, 15)) return false;
+				emit(b, s->lit_len - 18);
+				break;
+			case 3:
+				if(!lzsa2_emit_nibble(&w, 15)) return false;
+				emit(b, 239);
+				emit(b, s->lit_len & 0xFF);
+				emit(b, s->lit_len >> 8);
+				break;
+		}
+
+		for(uint16_t j = 0; j < s->lit_len; j++) emit(b, b->lits[lit_pos++]);
+
+		switch(off_mode) {
+			case 0:
+				if(!lzsa2_emit_nibble(&w, (neg_off >> 1) & 0x0F)) return false;
+				break;
+			case 1:
+				emit(b, neg_off & 0xFF);
+				break;
+			case 2:
+				if(!lzsa2_emit_nibble(&w, ((uint16_t)(neg_off + 512) >> 9) & 0x0F)) return false;
+				emit(b, (neg_off + 512) & 0xFF);
+				break;
+			case 3:
+				emit(b, neg_off >> 8);
+				emit(b, neg_off & 0xFF);
+				break;
+		}
+		prev_off = off;
+
+		switch(len_form) {
+			case 1:
+				if(!lzsa2_emit_nibble(&w, s->match_len - 9)) return false;
+				break;
+			case 2:
+				if(!lzsa2_emit_nibble(&w, 15)) return false;
+				emit(b, s->match_len - 24);
+				break;
+			case 3:
+				if(!lzsa2_emit_nibble(&w, 15)) return false;
+				emit(b, 233);
+				emit(b, s->match_len & 0xFF);
+				emit(b, s->match_len >> 8);
+				break;
+			case 4:
+				if(!lzsa2_emit_nibble(&w, 15)) return false;
+				emit(b, 232);
+				break;
+		}
+	}
+
+	return true;
+}
+
+// Make a block's sequences consistent after generation or modification:
+// matches may not reach back before the start of output, repeat offsets need
+// a previous offset, and total output must fit the buffer. Then encode the
+// block and produce the expected output. Returns false if the block can not be
+// made valid (e.g. it encodes too large).
+static bool finalise_block(block_t *b) {
+	uint16_t pos = 0, prev_off = 0;
+
+	for(uint8_t i = 0; i < b->seq_count; i++) {
+		seq_t *s = &b->seqs[i];
+		const bool eod = (i == b->seq_count - 1);
+
+		if(eod) s->match_len = 0;
+		if(!eod && s->match_len < (b->format == 1 ? 3 : 2)) s->match_len = (b->format == 1 ? 3 : 2);
+		if(pos + s->lit_len > FUZZ_OUT_MAX) s->lit_len = FUZZ_OUT_MAX - pos;
+		pos += s->lit_len;
+		if(pos == 0 && !eod) {
+			// A match needs something to refer to.
+			s->lit_len = 1;
+			pos = 1;
+		}
+		if(s->match_off == 0 && (b->format == 1 || prev_off == 0)) s->match_off = 1;
+		if(s->match_off > pos && pos > 0) s->match_off = pos;
+		if(pos + s->match_len > FUZZ_OUT_MAX) s->match_len = FUZZ_OUT_MAX - pos;
+		if(!eod && s->match_len < (b->format == 1 ? 3 : 2)) return false;
+		pos += s->match_len;
+		if(s->match_off != 0) prev_off = s->match_off;
+	}
+
+	if(!(b->format == 1 ? encode_lzsa1(b) : encode_lzsa2(b))) return false;
+
+	// Build the expected output directly from the sequences, independently of
+	// the reference decompressor.
+	uint16_t lit_pos = 0;
+	pos = prev_off = 0;
+	for(uint8_t i = 0; i < b->seq_count; i++) {
+		const seq_t *s = &b->seqs[i];
+		memcpy(&b->plain[pos], &b->lits[lit_pos], s->lit_len);
+		pos += s->lit_len;
+		lit_pos += s->lit_len;
+		if(s->match_off != 0) prev_off = s->match_off;
+		for(uint16_t j = 0; j < s->match_len; j++, pos++) b->plain[pos] = b->plain[pos - prev_off];
+	}
+	b->plain_len = pos;
+
+	return true;
+}
+
+static void generate_block(block_t *b, const uint8_t format) {
+	do {
+		uint16_t pos = 0;
+
+		b->format = format;
+		b->seq_count = (uint8_t)rng_range(1, rng_range(0, 3) ? 8 : MAX_SEQS);
+
+		// Literal pool is either random bytes or from a small alphabet.
+		const uint32_t alphabet = (rng_range(0, 1) ? 256 : rng_range(1, 4));
+		for(size_t i = 0; i < sizeof(b->lits); i++) b->lits[i] = (uint8_t)rng_range(0, alphabet - 1);
+
+		for(uint8_t i = 0; i < b->seq_count; i++) {
+			seq_t *s = &b->seqs[i];
+			s->lit_len = rng_length(0, FUZZ_IN_MAX / 4);
+			pos += s->lit_len;
+			s->match_off = (format == 2 && rng_range(0, 4) == 0 ? 0 : rng_offset(pos ? pos : 1));
+			s->match_len = rng_length(0, FUZZ_OUT_MAX);
+			s->lit_form = (uint8_t)rng_next();
+			s->off_form = (uint8_t)rng_next();
+			s->len_form = (uint8_t)rng_next();
+			pos += s->match_len;
+		}
+	} while(!finalise_block(b));
+}
+
+/******************************************************************************/
+
+static bool write_batch(const char *path, const size_t first, const size_t count) {
+	FILE *f = fopen(path, "wb");
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+	for(size_t i = first; i < first + count; i++) {
+		const block_t *b = &blocks[i];
+		fputc(b->format, f);
+		fputc(b->comp_len & 0xFF, f);
+		fputc(b->comp_len >> 8, f);
+		fwrite(b->comp, 1, b->comp_len, f);
+	}
+	fclose(f);
+	return true;
+}
+
+// Read results for a batch. Any blocks with no (or truncated) result are
+// marked as such. Returns number of complete results read.
+static size_t read_results(const char *path, result_t *results, const size_t count) {
+	FILE *f = fopen(path, "rb");
+	size_t n = 0;
+
+	for(size_t i = 0; i < count; i++) results[i].status = FUZZ_STATUS_NO_OUTPUT;
+	if(f == NULL) return 0;
+
+	while(n < count) {
+		int s = fgetc(f), lo = fgetc(f), hi = fgetc(f);
+		if(s == EOF || lo == EOF || hi == EOF) break;
+		results[n].len = (uint16_t)(lo | (hi << 8));
+		if(results[n].len > FUZZ_OUT_MAX || fread(results[n].data, 1, results[n].len, f) != results[n].len) break;
+		results[n].status = (uint8_t)s;
+		n++;
+	}
+	fclose(f);
+
+	return n;
+}
+
+static bool start_sim(job_t *job) {
+	char if_opt[200];
+
+	snprintf(if_opt, sizeof(if_opt), "if=rom[0x5800],in=%s,out=%s", job->in_path, job->out_path);
+	remove(job->out_path);
+	clock_gettime(CLOCK_MONOTONIC, &job->start);
+
+	job->pid = fork();
+	if(job->pid < 0) {
+		perror("fork");
+		return false;
+	}
+	if(job->pid == 0) {
+		// Child: silence simulator console output and run until the firmware
+		// stops the simulation.
+		if(freopen("/dev/null", "r", stdin) == NULL || freopen("/dev/null", "w", stdout) == NULL) _exit(127);
+		execlp(sim_path, sim_path, "-t", "STM8S208", "-X", "16M", "-G", "-I", if_opt, fw_path, (char *)NULL);
+		_exit(127);
+	}
+
+	return true;
+}
+
+static long elapsed_ms(const struct timespec *start) {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000 + (now.tv_nsec - start->tv_nsec) / 1000000;
+}
+
+// Wait for a job to finish, killing it if it exceeds the timeout. Returns true
+// if it finished, false if still running (only when not blocking).
+static bool poll_sim(job_t *job, const bool block) {
+	const struct timespec delay = { 0, SIM_POLL_MS * 1000000L };
+	int wstatus;
+
+	while(1) {
+		pid_t r = waitpid(job->pid, &wstatus, WNOHANG);
+		if(r == job->pid || (r < 0 && errno != EINTR)) return true;
+		if(elapsed_ms(&job->start) > SIM_TIMEOUT_MS) {
+			kill(job->pid, SIGKILL);
+			waitpid(job->pid, &wstatus, 0);
+			return true;
+		}
+		if(!block) return false;
+		nanosleep(&delay, NULL);
+	}
+}
+
+/******************************************************************************/
+
+// Check a simulator result against the expected output of a block, also
+// checking that the natively-compiled reference implementation agrees.
+static const char * check_result(const block_t *b, const result_t *r) {
+	static uint8_t ref_out[FUZZ_OUT_MAX + 1024];
+	size_t ref_len;
+
+	ref_len = (uint8_t *)(b->format == 1 ? lzsa1_decompress_block_ref(ref_out, b->comp) : lzsa2_decompress_block_ref(ref_out, b->comp)) - ref_out;
+	if(ref_len != b->plain_len || memcmp(ref_out, b->plain, ref_len) != 0) return "reference disagrees with generator";
+
+	switch(r->status) {
+		case FUZZ_STATUS_OK: break;
+		case FUZZ_STATUS_OVERRUN: return "output overran";
+		case FUZZ_STATUS_NO_OUTPUT: return "no output (crash or timeout)";
+		default: return "firmware error";
+	}
+	if(r->len != ref_len) return "output length differs";
+	if(memcmp(r->data, ref_out, ref_len) != 0) return "output data differs";
+
+	return NULL;
+}
+
+// Run a single block through the simulator and check it. Used for
+// minimisation.
+static const char * run_single(block_t *b, job_t *job) {
+	static result_t r;
+	block_t *saved = blocks;
+
+	blocks = b;
+	write_batch(job->in_path, 0, 1);
+	blocks = saved;
+	if(!start_sim(job)) return NULL;
+	poll_sim(job, true);
+	read_results(job->out_path, &r, 1);
+
+	return check_result(b, &r);
+}
+
+// Reduce a failing block to something smaller that still fails, by repeatedly
+// trying to remove sequences, shorten lengths and canonicalise encodings.
+static void minimise_block(block_t *b, job_t *job) {
+	static block_t trial;
+	bool progress = true;
+
+	while(progress) {
+		progress = false;
+
+		for(int i = 0; i < b->seq_count; i++) {
+			for(int step = 0; step < 6; step++) {
+				trial = *b;
+				seq_t *s = &trial.seqs[i];
+				switch(step) {
+					case 0:
+						if(trial.seq_count < 2) continue;
+						memmove(s, s + 1, (trial.seq_count - i - 1) * sizeof(seq_t));
+						trial.seq_count--;
+						break;
+					case 1:
+						if(s->lit_len == 0) continue;
+						s->lit_len /= 2;
+						break;
+					case 2:
+						if(s->match_len <= 3) continue;
+						s->match_len /= 2;
+						break;
+					case 3:
+						if(s->lit_form == 0) continue;
+						s->lit_form = 0;
+						break;
+					case 4:
+						if(s->off_form == 0) continue;
+						s->off_form = 0;
+						break;
+					case 5:
+						if(s->len_form == 0) continue;
+						s->len_form = 0;
+						break;
+				}
+				if(!finalise_block(&trial)) continue;
+				if(trial.comp_len > b->comp_len || (trial.comp_len == b->comp_len && memcmp(&trial.seqs, &b->seqs, sizeof(b->seqs)) == 0)) continue;
+				if(run_single(&trial, job) != NULL) {
+					*b = trial;
+					progress = true;
+					break;
+				}
+			}
+		}
+	}
+}
+
+static void save_failure(const block_t *b, const size_t index, const char *reason) {
+	char path[300];
+	FILE *f;
+
+	snprintf(path, sizeof(path), "%s/fail_%06zu.lzsa%u", fail_dir, index, b->format);
+	if((f = fopen(path, "wb")) != NULL) {
+		fwrite(b->comp, 1, b->comp_len, f);
+		fclose(f);
+	}
+	snprintf(path, sizeof(path), "%s/fail_%06zu.plain", fail_dir, index);
+	if((f = fopen(path, "wb")) != NULL) {
+		fwrite(b->plain, 1, b->plain_len, f);
+		fclose(f);
+	}
+	printf("FAIL: block %zu (LZSA%u): %s; minimised to %u bytes, saved as %s/fail_%06zu.*\n", index, b->format, reason, b->comp_len, fail_dir, index);
+}
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options]\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -n <count>    number of blocks to generate (default %zu)\n", block_count);
+	fprintf(stderr, "  -j <jobs>     number of parallel simulator instances (default %u)\n", job_count);
+	fprintf(stderr, "  -b <size>     blocks per simulator run (default %zu)\n", batch_size);
+	fprintf(stderr, "  -f <1|2|12>   format(s) to test (default 12)\n");
+	fprintf(stderr, "  -s <seed>     random seed (default from time)\n");
+	fprintf(stderr, "  -S <path>     path to sstm8 simulator (default %s)\n", sim_path);
+	fprintf(stderr, "  -F <path>     path to fuzz firmware (default %s)\n", fw_path);
+	fprintf(stderr, "  -o <dir>      directory for minimised failing blocks (default %s)\n", fail_dir);
+	fprintf(stderr, "  -t <dir>      directory for temporary files (default %s)\n", tmp_dir);
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+int main(int argc, char *argv[]) {
+	static job_t jobs[MAX_JOBS];
+	static result_t results[1000];
+	unsigned long seed = (unsigned long)time(NULL);
+	struct timespec start;
+	size_t next = 0, done = 0, fail_count = 0, sim_runs = 0;
+	long gen_ms, run_ms;
+	int opt;
+
+	while((opt = getopt(argc, argv, "n:j:b:f:s:S:F:o:t:vh")) != -1) {
+		switch(opt) {
+			case 'n': block_count = strtoul(optarg, NULL, 0); break;
+			case 'j': job_count = (unsigned int)strtoul(optarg, NULL, 0); break;
+			case 'b': batch_size = strtoul(optarg, NULL, 0); break;
+			case 'f':
+				formats = 0;
+				if(strchr(optarg, '1')) formats |= 0x1;
+				if(strchr(optarg, '2')) formats |= 0x2;
+				break;
+			case 's': seed = strtoul(optarg, NULL, 0); break;
+			case 'S': sim_path = optarg; break;
+			case 'F': fw_path = optarg; break;
+			case 'o': fail_dir = optarg; break;
+			case 't': tmp_dir = optarg; break;
+			case 'v': verbose = true; break;
+			default: usage(argv[0]); return EXIT_FAILURE;
+		}
+	}
+	if(block_count == 0 || formats == 0 || job_count < 1 || job_count > MAX_JOBS || batch_size < 1 || batch_size > sizeof(results) / sizeof(results[0])) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	printf("Seed: %lu\n", seed);
+	rng_state = (seed ? seed : 1) * 0x9E3779B97F4A7C15ULL;
+
+	// Generate all blocks up-front, alternating formats when both are chosen.
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if((blocks = malloc(block_count * sizeof(block_t))) == NULL) {
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+	for(size_t i = 0; i < block_count; i++) {
+		generate_block(&blocks[i], (formats == 0x3 ? (i & 1) + 1 : (formats == 0x1 ? 1 : 2)));
+	}
+	gen_ms = elapsed_ms(&start);
+	printf("Generated %zu blocks in %ld ms\n", block_count, gen_ms);
+
+	for(unsigned int j = 0; j < job_count; j++) {
+		snprintf(jobs[j].in_path, sizeof(jobs[j].in_path), "%s/lzsa_fuzz_%d_%u.in", tmp_dir, (int)getpid(), j);
+		snprintf(jobs[j].out_path, sizeof(jobs[j].out_path), "%s/lzsa_fuzz_%d_%u.out", tmp_dir, (int)getpid(), j);
+		jobs[j].pid = 0;
+	}
+
+	// Keep all job slots busy with batches until every block is done. When a
+	// batch is cut short (simulator crashed or hung), the block it stopped at
+	// is counted as failing and the rest are put back to be run again.
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while(done < block_count) {
+		for(unsigned int j = 0; j < job_count; j++) {
+			job_t *job = &jobs[j];
+
+			if(job->pid == 0 && next < block_count) {
+				job->first = next;
+				job->count = (block_count - next < batch_size ? block_count - next : batch_size);
+				next += job->count;
+				if(!write_batch(job->in_path, job->first, job->count) || !start_sim(job)) return EXIT_FAILURE;
+				sim_runs++;
+			}
+
+			if(job->pid != 0 && poll_sim(job, false)) {
+				size_t n = read_results(job->out_path, results, job->count);
+				size_t checked = (n < job->count ? n + 1 : n);
+
+				for(size_t i = 0; i < checked; i++) {
+					const char *reason = check_result(&blocks[job->first + i], &results[i]);
+					if(reason != NULL) {
+						fail_count++;
+						if(verbose) printf("Block %zu failed (%s), minimising...\n", job->first + i, reason);
+						minimise_block(&blocks[job->first + i], job);
+						save_failure(&blocks[job->first + i], job->first + i, reason);
+					}
+				}
+				done += checked;
+
+				// Re-queue any remainder of a short batch by running it next.
+				if(checked < job->count) {
+					job->first += checked;
+					job->count -= checked;
+					if(!write_batch(job->in_path, job->first, job->count) || !start_sim(job)) return EXIT_FAILURE;
+					sim_runs++;
+				} else {
+					job->pid = 0;
+				}
+
+				if(verbose) printf("%zu/%zu blocks done\n", done, block_count);
+			}
+		}
+
+		if(done < block_count) {
+			const struct timespec delay = { 0, SIM_POLL_MS * 1000000L };
+			nanosleep(&delay, NULL);
+		}
+	}
+	run_ms = elapsed_ms(&start);
+
+	for(unsigned int j = 0; j < job_count; j++) {
+		remove(jobs[j].in_path);
+		remove(jobs[j].out_path);
+	}
+
+	printf("Ran %zu blocks in %zu simulator runs over %u jobs in %ld ms (%.1f blocks/sec)\n",
+		block_count, sim_runs, job_count, run_ms, (run_ms > 0 ? (block_count * 1000.0) / run_ms : 0.0));
+	printf("RESULTS: passed = %zu, failed = %zu\n", block_count - fail_count, fail_count);
+
+	free(blocks);
+
+	return (fail_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,275 @@
+/*******************************************************************************
+ *
+ * lzsa_archive.c - Host tool to pack compressed blocks into an archive
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Packs raw LZSA1 and LZSA2 blocks (as produced by the LZSA tool with the -r
+// option) into an archive for use with lzsa_archive_open() and
+// lzsa_archive_get(). Each block is given on the command line as its ID (0 to
+// 65535), format and file, e.g.:
+//
+//   lzsa -f2 -r logo.bin logo.lzsa2
+//   lzsa -f1 -r font.bin font.lzsa1
+//   lzsa_archive -o res.bin 10:lzsa2:logo.lzsa2 3:lzsa1:font.lzsa1
+//
+// Entries may be given in any order; the directory is sorted by ID. Every
+// block is checked by decompressing it with the reference C implementation,
+// which also gives the decompressed length stored in the directory.
+//
+// With the -c option, a C source file defining a const array of the given
+// name is written instead of a binary file.
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_archive lzsa_archive.c ../lzsa_ref.c
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "lzsa_ref.h"
+#include "lzsa_archive.h"
+
+#define ENTRIES_MAX 4096
+#define ARCHIVE_MAX_LEN 65535
+#define PLAIN_MAX_LEN 65535
+
+typedef struct {
+	unsigned long id;
+	uint8_t format;
+	const char *path;
+	uint8_t *data;
+	size_t comp_len;
+	size_t plain_len;
+	size_t offset;
+} entry_t;
+
+/******************************************************************************/
+
+static entry_t entries[ENTRIES_MAX];
+static size_t entry_count = 0;
+
+// Decompressing a corrupt or wrongly-formatted block could run past the end of
+// a buffer of only the maximum length, so leave a generous margin.
+static uint8_t plain_buf[PLAIN_MAX_LEN * 4];
+
+static uint8_t archive[ARCHIVE_MAX_LEN];
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] -o <output_file> <id>:<format>:<file>...\n", name);
+	fprintf(stderr, "Formats: lzsa1, lzsa2\n");
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -c <name>     write C source defining array of given name\n");
+}
+
+static uint8_t * read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if(f == NULL) return NULL;
+	if(fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(size > 0 ? (size_t)size : 1);
+		if(data != NULL && fread(data, 1, (size_t)size, f) == (size_t)size) {
+			*len = (size_t)size;
+		} else {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+
+	return data;
+}
+
+static bool parse_entry(const char *arg, entry_t *e) {
+	char *end;
+	const char *fmt;
+
+	e->id = strtoul(arg, &end, 0);
+	if(end == arg || *end != ':' || e->id > 0xFFFF) return false;
+	fmt = end + 1;
+	if(strncmp(fmt, "lzsa1:", 6) == 0) {
+		e->format = LZSA_ARCHIVE_FORMAT_LZSA1;
+	} else if(strncmp(fmt, "lzsa2:", 6) == 0) {
+		e->format = LZSA_ARCHIVE_FORMAT_LZSA2;
+	} else {
+		return false;
+	}
+	e->path = fmt + 6;
+
+	return (*e->path != '\0');
+}
+
+static int compare_entries(const void *a, const void *b) {
+	const entry_t *ea = (const entry_t *)a, *eb = (const entry_t *)b;
+	return (ea->id > eb->id) - (ea->id < eb->id);
+}
+
+static void put16(uint8_t *p, const size_t v) {
+	p[0] = (uint8_t)(v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static bool write_binary(const char *path, const size_t len) {
+	FILE *f = fopen(path, "wb");
+	bool ok;
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+	ok = (fwrite(archive, 1, len, f) == len);
+	if(fclose(f) != 0) ok = false;
+	if(!ok) perror(path);
+
+	return ok;
+}
+
+static bool write_source(const char *path, const char *name, const size_t len) {
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	fprintf(f, "// Generated by lzsa_archive. Do not edit.\n\n");
+	fprintf(f, "#include <stdint.h>\n\n");
+	fprintf(f, "// Entries (ID, format, compressed length, decompressed length):\n");
+	for(size_t i = 0; i < entry_count; i++) {
+		fprintf(f, "// %5lu LZSA%u %5zu %5zu %s\n", entries[i].id, entries[i].format, entries[i].comp_len, entries[i].plain_len, entries[i].path);
+	}
+	fprintf(f, "const uint8_t %s[%zu] = {", name, len);
+	for(size_t i = 0; i < len; i++) {
+		fprintf(f, "%s0x%02x%s", (i % 12 == 0 ? "\n\t" : ""), archive[i], (i < len - 1 ? (i % 12 == 11 ? "," : ", ") : ""));
+	}
+	fprintf(f, "\n};\n");
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	const char *out_path = NULL, *array_name = NULL;
+	size_t len, total_plain = 0, max_comp = 0;
+	int i;
+
+	for(i = 1; i < argc && argv[i][0] == '-'; i++) {
+		if(strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+			out_path = argv[++i];
+		} else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+			array_name = argv[++i];
+		} else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if(out_path == NULL || i >= argc) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	if(argc - i > ENTRIES_MAX) {
+		fprintf(stderr, "Error: too many entries (max. %u)\n", ENTRIES_MAX);
+		return EXIT_FAILURE;
+	}
+
+	for(; i < argc; i++) {
+		entry_t *e = &entries[entry_count++];
+		uint8_t *end;
+
+		if(!parse_entry(argv[i], e)) {
+			fprintf(stderr, "Error: invalid entry '%s'\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+		if((e->data = read_file(e->path, &e->comp_len)) == NULL || e->comp_len == 0) {
+			fprintf(stderr, "Error: could not read '%s'\n", e->path);
+			return EXIT_FAILURE;
+		}
+		if(e->format == LZSA_ARCHIVE_FORMAT_LZSA1) {
+			end = lzsa1_decompress_block_ref(plain_buf, e->data);
+		} else {
+			end = lzsa2_decompress_block_ref(plain_buf, e->data);
+		}
+		e->plain_len = (size_t)(end - plain_buf);
+		if(e->plain_len > PLAIN_MAX_LEN) {
+			fprintf(stderr, "Error: '%s' decompresses to more than %u bytes (wrong format?)\n", e->path, PLAIN_MAX_LEN);
+			return EXIT_FAILURE;
+		}
+		total_plain += e->plain_len;
+		if(e->comp_len > max_comp) max_comp = e->comp_len;
+	}
+
+	qsort(entries, entry_count, sizeof(entry_t), compare_entries);
+
+	// Lay out header, then directory, then data in directory order.
+	len = LZSA_ARCHIVE_HEADER_LEN + (entry_count * LZSA_ARCHIVE_ENTRY_LEN);
+	for(size_t j = 0; j < entry_count; j++) {
+		if(j > 0 && entries[j].id == entries[j - 1].id) {
+			fprintf(stderr, "Error: duplicate ID %lu ('%s' and '%s')\n", entries[j].id, entries[j - 1].path, entries[j].path);
+			return EXIT_FAILURE;
+		}
+		entries[j].offset = len;
+		len += entries[j].comp_len;
+		if(len > ARCHIVE_MAX_LEN) {
+			fprintf(stderr, "Error: archive too large (max. %u bytes)\n", ARCHIVE_MAX_LEN);
+			return EXIT_FAILURE;
+		}
+	}
+
+	memcpy(archive, LZSA_ARCHIVE_MAGIC, 4);
+	archive[4] = LZSA_ARCHIVE_VERSION;
+	archive[5] = 0;
+	put16(archive + 6, entry_count);
+	for(size_t j = 0; j < entry_count; j++) {
+		uint8_t *d = archive + LZSA_ARCHIVE_HEADER_LEN + (j * LZSA_ARCHIVE_ENTRY_LEN);
+		put16(d, entries[j].id);
+		d[2] = entries[j].format;
+		d[3] = 0;
+		put16(d + 4, entries[j].offset);
+		put16(d + 6, entries[j].comp_len);
+		put16(d + 8, entries[j].plain_len);
+		memcpy(archive + entries[j].offset, entries[j].data, entries[j].comp_len);
+	}
+
+	if(array_name != NULL) {
+		if(!write_source(out_path, array_name, len)) return EXIT_FAILURE;
+	} else {
+		if(!write_binary(out_path, len)) return EXIT_FAILURE;
+	}
+
+	printf("%zu entries, %zu bytes decompressed, %zu bytes archive (%zu bytes directory)\n",
+		entry_count, total_plain, len, LZSA_ARCHIVE_HEADER_LEN + (entry_count * LZSA_ARCHIVE_ENTRY_LEN));
+	printf("largest entry %zu bytes compressed (buffer size needed for far archive)\n", max_comp);
+
+	return EXIT_SUCCESS;
+}
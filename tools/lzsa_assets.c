@@ -0,0 +1,595 @@
+/*******************************************************************************
+ *
+ * lzsa_assets.c - Asset compiler for LZSA-compressed firmware data
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Compresses a set of asset files listed in a manifest, choosing LZSA1 or
+// LZSA2 for each, and generates a C source file containing the compressed
+// data as arrays along with an lzsa_asset_t metadata struct for each, plus a
+// header file declaring them. For example:
+//
+//   lzsa_assets -j 8 -o assets.c -H assets.h assets.txt
+//
+// Each line of the manifest gives an asset's name (which must be a valid C
+// identifier), the path of its file, and optionally the format to use and
+// the maximum number of cycles its decompression may take. Blank lines and
+// lines starting with '#' are ignored. For example:
+//
+//   # name   file              format  max cycles
+//   logo     img/logo.bin      auto    50000
+//   font     img/font.bin      lzsa2
+//   strings  text/strings.bin
+//
+// Format may be 'lzsa1', 'lzsa2' or 'auto' (the default). When automatic, the
+// input is compressed in both formats and LZSA2 is chosen only when it is
+// sufficiently smaller than LZSA1 (see the -s option) and its predicted
+// decompression time is within the maximum. Otherwise LZSA1 is chosen, being
+// faster to decompress. Predictions are optimistic (see lzsa_cycles.c), so the
+// maximum should allow for the true time being about a fifth longer.
+//
+// Compression is done by running the LZSA command-line tool, several at once
+// in parallel. Compressed output is kept in a cache folder, named by a hash of
+// the input data, so unchanged assets are not compressed again. The
+// compressed data is checked by decompressing it with the reference C
+// implementation.
+//
+// Assets short enough to be decompressed with lzsa1_decompress_small() or
+// lzsa2_decompress_small() (which are faster) are flagged as 'small' in the
+// report.
+//
+// Build with any hosted C99 compiler on a POSIX system, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_assets lzsa_assets.c lzsa_cycles.c ../lzsa_ref.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include "lzsa_ref.h"
+#include "lzsa_cycles.h"
+
+#define ASSETS_MAX 1024
+#define ASSET_PLAIN_MAX 65535
+
+// Must agree with LZSA_SMALL_PLAIN_MAX in lzsa.h.
+#define SMALL_PLAIN_MAX 255
+#define JOBS_MAX 64
+#define LINE_MAX_LEN 1024
+
+typedef enum {
+	FORMAT_AUTO = 0,
+	FORMAT_LZSA1 = 1,
+	FORMAT_LZSA2 = 2,
+} format_t;
+
+typedef struct {
+	uint8_t *data;
+	size_t len;
+	uint32_t cycles;
+	char path[300]; // Cache file
+} compressed_t;
+
+typedef struct {
+	char name[64];
+	char path[LINE_MAX_LEN];
+	format_t format;
+	uint32_t max_cycles;
+	unsigned int line;
+	uint8_t *plain;
+	size_t plain_len;
+	uint64_t hash;
+	compressed_t comp[2]; // LZSA1, LZSA2
+	format_t chosen;
+} asset_t;
+
+typedef struct {
+	asset_t *asset;
+	uint8_t format;
+	pid_t pid;
+	char tmp_path[320];
+} job_t;
+
+/******************************************************************************/
+
+static const char *lzsa_path = "lzsa";
+static const char *lzsa_opts = ""; // Extra compressor option, e.g. "-m4"
+static const char *cache_dir = ".lzsa_cache";
+static unsigned int job_count = 4;
+static unsigned int min_saving = 5;
+static bool verbose = false;
+
+static asset_t assets[ASSETS_MAX];
+static size_t asset_count = 0;
+
+/******************************************************************************/
+
+// CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+static uint16_t crc16(const uint8_t *data, size_t len) {
+	uint16_t crc = 0xFFFF;
+
+	while(len--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for(uint8_t i = 0; i < 8; i++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+// 64-bit FNV-1a hash, used to name cache files.
+static uint64_t fnv1a(uint64_t hash, const uint8_t *data, size_t len) {
+	while(len--) {
+		hash ^= *data++;
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+static uint8_t * read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if(f == NULL) return NULL;
+	if(fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(size > 0 ? (size_t)size : 1);
+		if(data != NULL && fread(data, 1, (size_t)size, f) == (size_t)size) {
+			*len = (size_t)size;
+		} else {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+
+	return data;
+}
+
+static bool file_exists(const char *path) {
+	struct stat st;
+	return (stat(path, &st) == 0 && S_ISREG(st.st_mode));
+}
+
+/******************************************************************************/
+
+static bool is_identifier(const char *s) {
+	if(!isalpha((unsigned char)*s) && *s != '_') return false;
+	while(*++s) {
+		if(!isalnum((unsigned char)*s) && *s != '_') return false;
+	}
+	return true;
+}
+
+static bool read_manifest(const char *path) {
+	char line[LINE_MAX_LEN], *tok, *save;
+	unsigned int line_num = 0;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		asset_t *a = &assets[asset_count];
+
+		line_num++;
+		if((tok = strtok_r(line, " \t\r\n", &save)) == NULL || *tok == '#') continue;
+
+		if(asset_count >= ASSETS_MAX) {
+			fprintf(stderr, "%s:%u: Error: too many assets (maximum is %u)\n", path, line_num, ASSETS_MAX);
+			fclose(f);
+			return false;
+		}
+		if(!is_identifier(tok) || strlen(tok) >= sizeof(a->name)) {
+			fprintf(stderr, "%s:%u: Error: asset name '%s' is not a valid identifier\n", path, line_num, tok);
+			fclose(f);
+			return false;
+		}
+		for(size_t i = 0; i < asset_count; i++) {
+			if(strcmp(assets[i].name, tok) == 0) {
+				fprintf(stderr, "%s:%u: Error: duplicate asset name '%s'\n", path, line_num, tok);
+				fclose(f);
+				return false;
+			}
+		}
+		strcpy(a->name, tok);
+
+		if((tok = strtok_r(NULL, " \t\r\n", &save)) == NULL) {
+			fprintf(stderr, "%s:%u: Error: missing file for asset '%s'\n", path, line_num, a->name);
+			fclose(f);
+			return false;
+		}
+		strcpy(a->path, tok);
+
+		a->format = FORMAT_AUTO;
+		if((tok = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+			if(strcmp(tok, "lzsa1") == 0) {
+				a->format = FORMAT_LZSA1;
+			} else if(strcmp(tok, "lzsa2") == 0) {
+				a->format = FORMAT_LZSA2;
+			} else if(strcmp(tok, "auto") != 0) {
+				fprintf(stderr, "%s:%u: Error: unknown format '%s'\n", path, line_num, tok);
+				fclose(f);
+				return false;
+			}
+		}
+
+		a->max_cycles = 0;
+		if((tok = strtok_r(NULL, " \t\r\n", &save)) != NULL) {
+			char *end;
+			a->max_cycles = (uint32_t)strtoul(tok, &end, 0);
+			if(*end != '\0' || a->max_cycles == 0) {
+				fprintf(stderr, "%s:%u: Error: invalid maximum cycles '%s'\n", path, line_num, tok);
+				fclose(f);
+				return false;
+			}
+		}
+
+		a->line = line_num;
+		asset_count++;
+	}
+
+	fclose(f);
+
+	return true;
+}
+
+/******************************************************************************/
+
+static bool start_job(job_t *job) {
+	static unsigned int tmp_seq = 0;
+	char format_opt[8];
+
+	snprintf(job->tmp_path, sizeof(job->tmp_path), "%s.%d.%u.tmp", job->asset->comp[job->format - 1].path, (int)getpid(), tmp_seq++);
+	snprintf(format_opt, sizeof(format_opt), "-f%u", job->format);
+
+	if(verbose) printf("Compressing %s as LZSA%u\n", job->asset->path, job->format);
+
+	job->pid = fork();
+	if(job->pid < 0) {
+		perror("fork");
+		return false;
+	}
+	if(job->pid == 0) {
+		if(freopen("/dev/null", "w", stdout) == NULL) _exit(127);
+		if(*lzsa_opts != '\0') {
+			execlp(lzsa_path, lzsa_path, format_opt, "-r", lzsa_opts, job->asset->path, job->tmp_path, (char *)NULL);
+		} else {
+			execlp(lzsa_path, lzsa_path, format_opt, "-r", job->asset->path, job->tmp_path, (char *)NULL);
+		}
+		_exit(127);
+	}
+
+	return true;
+}
+
+static bool finish_job(job_t *job, const int wstatus) {
+	const char *cache_path = job->asset->comp[job->format - 1].path;
+
+	if(!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+		fprintf(stderr, "Error: compressing %s as LZSA%u failed (is '%s' the LZSA tool?)\n", job->asset->path, job->format, lzsa_path);
+		remove(job->tmp_path);
+		return false;
+	}
+	if(rename(job->tmp_path, cache_path) != 0) {
+		perror(cache_path);
+		remove(job->tmp_path);
+		return false;
+	}
+
+	return true;
+}
+
+// Compress every asset (in each format it may use) that does not already have
+// compressed data in the cache, running several compressor processes at once.
+static bool compress_assets(unsigned int *run_count, unsigned int *cached_count) {
+	static job_t pending[ASSETS_MAX * 2];
+	job_t *running[JOBS_MAX] = { NULL };
+	size_t pending_count = 0, next = 0, active = 0;
+	bool ok = true;
+
+	for(size_t i = 0; i < asset_count; i++) {
+		for(uint8_t f = FORMAT_LZSA1; f <= FORMAT_LZSA2; f++) {
+			if(assets[i].format != FORMAT_AUTO && assets[i].format != f) continue;
+			if(file_exists(assets[i].comp[f - 1].path)) {
+				(*cached_count)++;
+				continue;
+			}
+			pending[pending_count].asset = &assets[i];
+			pending[pending_count].format = f;
+			pending_count++;
+		}
+	}
+	*run_count = (unsigned int)pending_count;
+
+	while(next < pending_count || active > 0) {
+		int wstatus;
+		pid_t pid;
+
+		while(ok && next < pending_count && active < job_count) {
+			for(unsigned int j = 0; j < job_count; j++) {
+				if(running[j] == NULL) {
+					if(!start_job(&pending[next])) {
+						ok = false;
+						break;
+					}
+					running[j] = &pending[next++];
+					active++;
+					break;
+				}
+			}
+		}
+		if(active == 0) break;
+
+		pid = wait(&wstatus);
+		if(pid < 0) {
+			if(errno == EINTR) continue;
+			perror("wait");
+			return false;
+		}
+		for(unsigned int j = 0; j < job_count; j++) {
+			if(running[j] != NULL && running[j]->pid == pid) {
+				if(!finish_job(running[j], wstatus)) ok = false;
+				running[j] = NULL;
+				active--;
+				break;
+			}
+		}
+	}
+
+	return ok;
+}
+
+// Load compressed data for an asset from the cache, check it decompresses to
+// the original data, and predict how long it takes to decompress.
+static bool load_compressed(asset_t *a, const uint8_t format) {
+	static uint8_t out[ASSET_PLAIN_MAX + 1024];
+	compressed_t *c = &a->comp[format - 1];
+	size_t out_len;
+
+	if((c->data = read_file(c->path, &c->len)) == NULL || c->len == 0) {
+		fprintf(stderr, "Error: could not read compressed data for '%s' from %s\n", a->name, c->path);
+		return false;
+	}
+
+	out_len = (uint8_t *)(format == FORMAT_LZSA1 ? lzsa1_decompress_block_ref(out, c->data) : lzsa2_decompress_block_ref(out, c->data)) - out;
+	if(out_len != a->plain_len || memcmp(out, a->plain, out_len) != 0) {
+		fprintf(stderr, "Error: LZSA%u data for '%s' (%s) does not decompress correctly\n", format, a->name, c->path);
+		return false;
+	}
+
+	c->cycles = (format == FORMAT_LZSA1 ? predict_lzsa1_cycles(c->data) : predict_lzsa2_cycles(c->data));
+
+	return true;
+}
+
+static format_t choose_format(const asset_t *a) {
+	const compressed_t *c1 = &a->comp[0], *c2 = &a->comp[1];
+	bool fits1, fits2;
+
+	if(a->format != FORMAT_AUTO) return a->format;
+
+	fits1 = (a->max_cycles == 0 || c1->cycles <= a->max_cycles);
+	fits2 = (a->max_cycles == 0 || c2->cycles <= a->max_cycles);
+
+	// LZSA2 is only worth its slower decompression when it saves enough space.
+	if(fits2 && (!fits1 || c2->len * 100 <= c1->len * (100 - min_saving))) return FORMAT_LZSA2;
+
+	return FORMAT_LZSA1;
+}
+
+/******************************************************************************/
+
+static void make_guard(char *guard, const size_t size, const char *path) {
+	const char *base = strrchr(path, '/');
+	size_t i;
+
+	base = (base != NULL ? base + 1 : path);
+	for(i = 0; base[i] != '\0' && i < size - 2; i++) {
+		guard[i] = (isalnum((unsigned char)base[i]) ? (char)toupper((unsigned char)base[i]) : '_');
+	}
+	guard[i++] = '_';
+	guard[i] = '\0';
+}
+
+static bool write_header(const char *path) {
+	char guard[256];
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	make_guard(guard, sizeof(guard), path);
+
+	fprintf(f, "// Generated by lzsa_assets. Do not edit.\n\n");
+	fprintf(f, "#ifndef %s\n#define %s\n\n", guard, guard);
+	fprintf(f, "#include \"lzsa.h\"\n\n");
+	fprintf(f, "#define ASSETS_COUNT %zu\n\n", asset_count);
+	for(size_t i = 0; i < asset_count; i++) {
+		fprintf(f, "extern const lzsa_asset_t asset_%s;\n", assets[i].name);
+	}
+	fprintf(f, "\nextern const lzsa_asset_t * const assets[ASSETS_COUNT];\n");
+	fprintf(f, "\n#endif // %s\n", guard);
+
+	fclose(f);
+
+	return true;
+}
+
+static bool write_source(const char *path, const char *header_path) {
+	const char *header_base = strrchr(header_path, '/');
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	fprintf(f, "// Generated by lzsa_assets. Do not edit.\n\n");
+	fprintf(f, "#include <stddef.h>\n#include <stdint.h>\n#include \"%s\"\n", (header_base != NULL ? header_base + 1 : header_path));
+
+	for(size_t i = 0; i < asset_count; i++) {
+		const asset_t *a = &assets[i];
+		const compressed_t *c = &a->comp[a->chosen - 1];
+
+		fprintf(f, "\n/******************************************************************************/\n\n");
+		fprintf(f, "// %s\n", a->path);
+		fprintf(f, "static const uint8_t asset_%s_data[%zu] = {", a->name, c->len);
+		for(size_t j = 0; j < c->len; j++) {
+			fprintf(f, "%s0x%02x%s", (j % 12 == 0 ? "\n\t" : ""), c->data[j], (j < c->len - 1 ? (j % 12 == 11 ? "," : ", ") : ""));
+		}
+		fprintf(f, "\n};\n\n");
+		fprintf(f, "const lzsa_asset_t asset_%s = {\n", a->name);
+		fprintf(f, "\t.data = asset_%s_data,\n", a->name);
+		fprintf(f, "\t.comp_len = %zu,\n", c->len);
+		fprintf(f, "\t.plain_len = %zu,\n", a->plain_len);
+		fprintf(f, "\t.format = %u,\n", a->chosen);
+		fprintf(f, "\t.checksum = 0x%04X,\n", crc16(a->plain, a->plain_len));
+		fprintf(f, "\t.cycles = %luUL,\n", (unsigned long)c->cycles);
+		fprintf(f, "};\n");
+	}
+
+	fprintf(f, "\n/******************************************************************************/\n\n");
+	fprintf(f, "const lzsa_asset_t * const assets[ASSETS_COUNT] = {\n");
+	for(size_t i = 0; i < asset_count; i++) {
+		fprintf(f, "\t&asset_%s,\n", assets[i].name);
+	}
+	fprintf(f, "};\n");
+
+	fclose(f);
+
+	return true;
+}
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] -o <output.c> -H <output.h> <manifest>\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -j <jobs>     number of compressions to run in parallel (default %u)\n", job_count);
+	fprintf(stderr, "  -c <dir>      cache folder (default %s)\n", cache_dir);
+	fprintf(stderr, "  -l <path>     path to LZSA tool (default %s)\n", lzsa_path);
+	fprintf(stderr, "  -m <option>   extra option to pass to LZSA tool (e.g. -m4)\n");
+	fprintf(stderr, "  -s <percent>  minimum saving of LZSA2 over LZSA1 to choose it (default %u)\n", min_saving);
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+int main(int argc, char *argv[]) {
+	const char *out_path = NULL, *header_path = NULL;
+	unsigned int run_count = 0, cached_count = 0;
+	size_t total_plain = 0, total_comp = 0, small_count = 0;
+	int opt;
+
+	while((opt = getopt(argc, argv, "o:H:j:c:l:m:s:vh")) != -1) {
+		switch(opt) {
+			case 'o': out_path = optarg; break;
+			case 'H': header_path = optarg; break;
+			case 'j': job_count = (unsigned int)strtoul(optarg, NULL, 0); break;
+			case 'c': cache_dir = optarg; break;
+			case 'l': lzsa_path = optarg; break;
+			case 'm': lzsa_opts = optarg; break;
+			case 's': min_saving = (unsigned int)strtoul(optarg, NULL, 0); break;
+			case 'v': verbose = true; break;
+			default: usage(argv[0]); return EXIT_FAILURE;
+		}
+	}
+	if(optind != argc - 1 || out_path == NULL || header_path == NULL || job_count < 1 || job_count > JOBS_MAX || min_saving > 99) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if(!read_manifest(argv[optind])) return EXIT_FAILURE;
+	if(mkdir(cache_dir, 0777) != 0 && errno != EEXIST) {
+		perror(cache_dir);
+		return EXIT_FAILURE;
+	}
+
+	// Load every asset and work out the cache file names for its compressed
+	// data. The hash covers the compressor options too, so that changing them
+	// causes re-compression.
+	for(size_t i = 0; i < asset_count; i++) {
+		asset_t *a = &assets[i];
+
+		if((a->plain = read_file(a->path, &a->plain_len)) == NULL) {
+			fprintf(stderr, "%s:%u: Error: could not read '%s'\n", argv[optind], a->line, a->path);
+			return EXIT_FAILURE;
+		}
+		if(a->plain_len == 0 || a->plain_len > ASSET_PLAIN_MAX) {
+			fprintf(stderr, "%s:%u: Error: '%s' must be 1 to %u bytes long\n", argv[optind], a->line, a->path, ASSET_PLAIN_MAX);
+			return EXIT_FAILURE;
+		}
+
+		a->hash = fnv1a(0xCBF29CE484222325ULL, a->plain, a->plain_len);
+		a->hash = fnv1a(a->hash, (const uint8_t *)lzsa_opts, strlen(lzsa_opts) + 1);
+		for(uint8_t f = FORMAT_LZSA1; f <= FORMAT_LZSA2; f++) {
+			snprintf(a->comp[f - 1].path, sizeof(a->comp[f - 1].path), "%s/%016llx.lzsa%u", cache_dir, (unsigned long long)a->hash, f);
+		}
+	}
+
+	if(!compress_assets(&run_count, &cached_count)) return EXIT_FAILURE;
+
+	for(size_t i = 0; i < asset_count; i++) {
+		asset_t *a = &assets[i];
+
+		for(uint8_t f = FORMAT_LZSA1; f <= FORMAT_LZSA2; f++) {
+			if((a->format == FORMAT_AUTO || a->format == f) && !load_compressed(a, f)) return EXIT_FAILURE;
+		}
+
+		a->chosen = choose_format(a);
+		total_plain += a->plain_len;
+		total_comp += a->comp[a->chosen - 1].len;
+
+		printf("%-24s %6zu -> %6zu bytes (%3zu%%), LZSA%u, %8lu cycles", a->name, a->plain_len,
+			a->comp[a->chosen - 1].len, (a->comp[a->chosen - 1].len * 100) / a->plain_len, a->chosen,
+			(unsigned long)a->comp[a->chosen - 1].cycles);
+		if(a->plain_len <= SMALL_PLAIN_MAX) {
+			printf(", small");
+			small_count++;
+		}
+		if(a->max_cycles != 0 && a->comp[a->chosen - 1].cycles > a->max_cycles) {
+			printf(" (WARNING: exceeds maximum of %lu)", (unsigned long)a->max_cycles);
+		}
+		printf("\n");
+	}
+
+	if(!write_header(header_path) || !write_source(out_path, header_path)) return EXIT_FAILURE;
+
+	printf("%zu assets (%zu small), %zu -> %zu bytes, %u compressed, %u cached\n", asset_count, small_count, total_plain, total_comp, run_count, cached_count);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,259 @@
+/*******************************************************************************
+ *
+ * lzsa_corpus.c - Host tool for test program corpus mode
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Packs compressed files into an input stream for the test program's corpus
+// mode, and checks the resulting output stream against the original plain
+// files, reporting the cycles taken to decompress each. For example:
+//
+//   lzsa_corpus pack corpus.in lzsa2:logo.lzsa2 lz4:logo.lz4 lzsa2_ref:font.lzsa2
+//   sstm8 -t STM8S208 -X 16M -I if=rom[0x5800],in=corpus.in,out=corpus.out -G bin/Test/test
+//   lzsa_corpus check corpus.out logo.bin logo.bin font.bin
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -o lzsa_corpus lzsa_corpus.c
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// Must agree with CORPUS_IN_MAX and CORPUS_OUT_MAX in main.c.
+#define CORPUS_IN_MAX 1536
+#define CORPUS_OUT_MAX 3584
+
+typedef struct {
+	const char *name;
+	uint8_t id;
+} decoder_t;
+
+// Must agree with corpus_decoder_t in main.c.
+static const decoder_t decoders[] = {
+	{ "lzsa1", 0x01 },
+	{ "lzsa2", 0x02 },
+	{ "lz4", 0x03 },
+	{ "zx0", 0x04 },
+	{ "lzsa_native", 0x05 },
+	{ "lzsa1_ref", 0x11 },
+	{ "lzsa2_ref", 0x12 },
+	{ "lz4_ref", 0x13 },
+	{ "zx0_ref", 0x14 },
+	{ "lzsa_native_ref", 0x15 },
+	{ "lzsa1_fast", 0x21 },
+	{ "lzsa2_fast", 0x22 },
+	{ "lzsa1_ram", 0x31 },
+	{ "lzsa2_ram", 0x32 },
+	{ "lzsa1_small", 0x41 },
+	{ "lzsa2_small", 0x42 },
+};
+
+#define DECODERS_COUNT (sizeof(decoders) / sizeof(decoders[0]))
+
+// Must agree with corpus_status_t in main.c.
+static const char * const status_names[] = { "OK", "BAD_DECODER", "BAD_LENGTH", "OVERRUN" };
+
+/******************************************************************************/
+
+static const decoder_t * find_decoder(const char *name, const size_t name_len) {
+	for(size_t i = 0; i < DECODERS_COUNT; i++) {
+		if(strlen(decoders[i].name) == name_len && strncmp(decoders[i].name, name, name_len) == 0) return &decoders[i];
+	}
+	return NULL;
+}
+
+static uint8_t * read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if(f == NULL) {
+		perror(path);
+		return NULL;
+	}
+	if(fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(size > 0 ? (size_t)size : 1);
+		if(data != NULL && fread(data, 1, (size_t)size, f) == (size_t)size) {
+			*len = (size_t)size;
+		} else {
+			fprintf(stderr, "%s: read error\n", path);
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+
+	return data;
+}
+
+static bool read_word(FILE *f, uint16_t *w) {
+	int lo = fgetc(f), hi = fgetc(f);
+	if(lo == EOF || hi == EOF) return false;
+	*w = (uint16_t)(lo | (hi << 8));
+	return true;
+}
+
+/******************************************************************************/
+
+static int pack(const char *out_path, char **items, const int count) {
+	FILE *out = fopen(out_path, "wb");
+
+	if(out == NULL) {
+		perror(out_path);
+		return EXIT_FAILURE;
+	}
+
+	for(int i = 0; i < count; i++) {
+		const char *sep = strchr(items[i], ':');
+		const decoder_t *decoder;
+		uint8_t *data;
+		size_t len;
+
+		if(sep == NULL || (decoder = find_decoder(items[i], (size_t)(sep - items[i]))) == NULL) {
+			fprintf(stderr, "Error: '%s' is not of form <decoder>:<file> with a known decoder\n", items[i]);
+			fclose(out);
+			return EXIT_FAILURE;
+		}
+		if((data = read_file(sep + 1, &len)) == NULL) {
+			fclose(out);
+			return EXIT_FAILURE;
+		}
+		if(len > CORPUS_IN_MAX) {
+			fprintf(stderr, "Error: %s is too large (%zu bytes, maximum is %u)\n", sep + 1, len, CORPUS_IN_MAX);
+			free(data);
+			fclose(out);
+			return EXIT_FAILURE;
+		}
+
+		fputc(decoder->id, out);
+		fputc(len & 0xFF, out);
+		fputc(len >> 8, out);
+		fwrite(data, 1, len, out);
+		free(data);
+	}
+
+	fclose(out);
+
+	return EXIT_SUCCESS;
+}
+
+static int check(const char *in_path, char **plains, const int count) {
+	static uint8_t out[CORPUS_OUT_MAX];
+	FILE *in = fopen(in_path, "rb");
+	unsigned int pass_count = 0, fail_count = 0;
+
+	if(in == NULL) {
+		perror(in_path);
+		return EXIT_FAILURE;
+	}
+
+	for(int i = 0; i < count; i++) {
+		uint16_t len, cycles_lo, cycles_hi;
+		uint8_t *plain;
+		size_t plain_len;
+		uint32_t cycles;
+		int status;
+		bool pass;
+
+		if((status = fgetc(in)) == EOF || !read_word(in, &len) || !read_word(in, &cycles_lo) || !read_word(in, &cycles_hi) || len > CORPUS_OUT_MAX || fread(out, 1, len, in) != len) {
+			printf("%03d: %s: missing or truncated result\n", i, plains[i]);
+			fail_count += (unsigned int)(count - i);
+			break;
+		}
+		if((plain = read_file(plains[i], &plain_len)) == NULL) {
+			fclose(in);
+			return EXIT_FAILURE;
+		}
+
+		cycles = ((uint32_t)cycles_hi << 16) | cycles_lo;
+		pass = (status == 0 && plain_len == len && memcmp(plain, out, len) == 0);
+		printf("%03d: %s: status = %s, plain_len = %zu, out_len = %u, cycles = %lu (%.1f/byte), %s\n",
+			i, plains[i], (status < (int)(sizeof(status_names) / sizeof(status_names[0])) ? status_names[status] : "?"),
+			plain_len, len, (unsigned long)cycles, (len ? (double)cycles / len : 0.0), (pass ? "PASS" : "FAIL"));
+		if(pass) {
+			pass_count++;
+		} else {
+			fail_count++;
+		}
+		free(plain);
+	}
+
+	fclose(in);
+
+	printf("RESULTS: passed = %u, failed = %u\n", pass_count, fail_count);
+
+	return (fail_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+// Print the result of each block as a line of space-separated values (index,
+// status, decompressed length and cycles), for processing by scripts.
+static int report(const char *in_path) {
+	FILE *in = fopen(in_path, "rb");
+	uint16_t len, cycles_lo, cycles_hi;
+	int status;
+
+	if(in == NULL) {
+		perror(in_path);
+		return EXIT_FAILURE;
+	}
+
+	for(unsigned int i = 0; (status = fgetc(in)) != EOF; i++) {
+		if(!read_word(in, &len) || !read_word(in, &cycles_lo) || !read_word(in, &cycles_hi) || fseek(in, len, SEEK_CUR) != 0) {
+			fprintf(stderr, "%s: truncated result\n", in_path);
+			fclose(in);
+			return EXIT_FAILURE;
+		}
+		printf("%u %d %u %lu\n", i, status, len, ((unsigned long)cycles_hi << 16) | cycles_lo);
+	}
+
+	fclose(in);
+
+	return EXIT_SUCCESS;
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage:\n");
+	fprintf(stderr, "  %s pack <out file> <decoder>:<compressed file> [...]\n", name);
+	fprintf(stderr, "  %s check <results file> <plain file> [...]\n", name);
+	fprintf(stderr, "  %s report <results file>\n", name);
+	fprintf(stderr, "Decoders:");
+	for(size_t i = 0; i < DECODERS_COUNT; i++) fprintf(stderr, " %s", decoders[i].name);
+	fprintf(stderr, "\n");
+}
+
+int main(int argc, char *argv[]) {
+	if(argc >= 4 && strcmp(argv[1], "pack") == 0) {
+		return pack(argv[2], &argv[3], argc - 3);
+	} else if(argc >= 4 && strcmp(argv[1], "check") == 0) {
+		return check(argv[2], &argv[3], argc - 3);
+	} else if(argc == 3 && strcmp(argv[1], "report") == 0) {
+		return report(argv[2]);
+	}
+
+	usage(argv[0]);
+	return EXIT_FAILURE;
+}
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ *
+ * lzsa_cycles.h - Header for cycle count model of the LZSA assembly decompression
+ *                 routines
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef LZSA_CYCLES_H_
+#define LZSA_CYCLES_H_
+
+#include <stdint.h>
+
+// Predict the number of cycles the assembly routine takes to decompress the
+// given (valid) compressed block. The predictions are optimistic (about a fifth
+// too low), see lzsa_cycles.c.
+extern uint32_t predict_lzsa1_cycles(const uint8_t *src);
+extern uint32_t predict_lzsa2_cycles(const uint8_t *src);
+extern uint32_t predict_lzsa_native_cycles(const uint8_t *src);
+
+#endif // LZSA_CYCLES_H_
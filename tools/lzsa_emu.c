@@ -0,0 +1,1746 @@
+/*******************************************************************************
+ *
+ * lzsa_emu.c - Host tool to emulate an STM8 program, for fast testing and
+ *              cycle counting without μCsim
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Emulates the STM8 CPU core, running a linked program from its Intel HEX file
+// many times faster than μCsim, and counting cycles per the STM8 programming
+// manual (PM0044). It has two modes.
+//
+// Without -e, it stands in for μCsim's sstm8, taking the same command-line
+// options as are used by the fuzzing harness, the benchmark matrix script and
+// the test program's corpus mode, e.g.:
+//
+//   lzsa_emu -t STM8S208 -X 16M -I if=rom[0x5800],in=corpus.in,out=corpus.out -G bin/Test/test
+//   lzsa_fuzz -S ../lzsa_emu -n 100000 -j 8
+//   SSTM8=tools/lzsa_emu tools/bench/bench_matrix.sh
+//
+// The program is run from the reset vector. μCsim's simulator interface is
+// emulated at the address given (with console output going to stdout), as is
+// timer TIM2 and its update interrupt, which the test program uses to count
+// cycles. Writes to UART1 also go to stdout, and its status register always
+// reads as ready. Other peripheral registers read back as last written. The
+// emulation stops when the program stops it through the simulator interface,
+// or enters an endless loop (a jump to itself, or a WFI with no interrupt to
+// wake it), or executes HALT, BREAK or an illegal opcode.
+//
+// With -e, it instead calls a single function of the program (e.g. one of the
+// decompression routines) on an input file, and writes the output buffer to a
+// file, reporting the cycles taken by the call, e.g.:
+//
+//   lzsa_emu -m test.map -e lzsa1_decompress_block test.ihx item.lzsa1 item.bin
+//
+// The function is given the destination and source pointers on the stack (and
+// also, with -n, the length of the input, as lz4_decompress_block() takes, and
+// with -a, a far address as a 32-bit value, as lzsa1_decompress_block_dict()
+// takes for its dictionary), in the manner of SDCC's __stack_args calling
+// convention. Further files may be loaded into memory first with -L (e.g. the
+// dictionary, or the data for lzsa1_compare_block() to compare against). The
+// output is taken to end at the pointer returned in X. If the map file defines
+// main, the program's startup code is run first, so that its global variables
+// are initialised. The peripherals are not emulated in this mode. Only linked
+// programs can be run, so an assembled decoder must first be linked (with sdld
+// or SDCC) on its own or into a program.
+//
+// The cycle counts of instructions that take a variable number of cycles in
+// hardware, depending on the pipeline (e.g. those after a jump, or DIV), are
+// those given by the programming manual, and no flash wait states are added.
+// Stalls while the instruction fetch catches up (e.g. after a jump, or for long
+// instructions) are not modelled, so the counts are lower bounds: on the README
+// benchmark, μCsim counts 20-21% more cycles than this does, and hardware takes
+// slightly more again. The tools/bench/emu_check.sh script cross-checks results
+// against μCsim, reporting the gap for each decoder.
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -o lzsa_emu lzsa_emu.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define IMAGE_SIZE 0x1000000UL // 24-bit address space of STM8
+#define LINE_MAX_LEN 1024
+
+#define RESET_VECTOR 0x8000
+#define TRAP_VECTOR 0x8004
+#define IRQ_VECTOR(n) (0x8008 + (n) * 4)
+
+#define CALL_RETURN_ADDR 0x000000 // Fake return address marking end of a call
+#define CALL_CYCLE_LIMIT 100000000ULL
+#define CALL_SRC_END 0x8000 // Input is placed up to the start of flash
+#define CALL_DST_DEFAULT 0x1800 // Output is placed after the end of RAM
+#define CALL_LOADS_MAX 8
+
+#define CC_V 0x80
+#define CC_I1 0x20
+#define CC_H 0x10
+#define CC_I0 0x08
+#define CC_N 0x04
+#define CC_Z 0x02
+#define CC_C 0x01
+#define CC_RESET (CC_I1 | CC_I0)
+
+// Peripheral registers emulated in firmware mode (as used by the test program).
+#define UART1_SR 0x5230
+#define UART1_SR_READY 0xC0 // TXE and TC set
+#define UART1_DR 0x5231
+#define TIM2_CR1 0x5300
+#define TIM2_CR1_CEN 0x01
+#define TIM2_IER 0x5303
+#define TIM2_IER_UIE 0x01
+#define TIM2_SR1 0x5304
+#define TIM2_SR1_UIF 0x01
+#define TIM2_EGR 0x5306
+#define TIM2_EGR_UG 0x01
+#define TIM2_CNTRH 0x530C
+#define TIM2_CNTRL 0x530D
+#define TIM2_PSCR 0x530E
+#define TIM2_ARRH 0x530F
+#define TIM2_ARRL 0x5310
+#define TIM2_OVF_IRQ 13
+
+// μCsim simulator interface commands (see ucsim.h).
+#define SIMIF_CMD_DETECT '_'
+#define SIMIF_CMD_IFVER 'v'
+#define SIMIF_CMD_STOP 's'
+#define SIMIF_CMD_PRINT 'p'
+#define SIMIF_CMD_FIN_CHECK 'f'
+#define SIMIF_CMD_READ 'r'
+#define SIMIF_CMD_WRITE 'w'
+#define SIMIF_DETECT_RESP '!'
+#define SIMIF_VERSION 1
+
+typedef enum {
+	STOP_NONE = 0,
+	STOP_SIMIF,
+	STOP_RETURN,
+	STOP_LOOP,
+	STOP_HALT,
+	STOP_BREAK,
+	STOP_ILLEGAL,
+	STOP_LIMIT,
+} stop_t;
+
+typedef struct {
+	const char *name;
+	uint16_t sp_reset; // End of RAM
+} device_t;
+
+/******************************************************************************/
+
+static const device_t devices[] = {
+	{ "STM8S208", 0x17FF }, { "STM8S207", 0x17FF }, { "STM8AF52", 0x17FF },
+	{ "STM8S007", 0x17FF }, { "STM8S105", 0x07FF }, { "STM8S005", 0x07FF },
+	{ "STM8AF62", 0x07FF }, { "STM8S103", 0x03FF }, { "STM8S003", 0x03FF },
+	{ "STM8S903", 0x03FF },
+};
+
+static const char * const stop_reasons[] = {
+	[STOP_NONE] = "still running",
+	[STOP_SIMIF] = "stopped by program",
+	[STOP_RETURN] = "function returned",
+	[STOP_LOOP] = "endless loop",
+	[STOP_HALT] = "halted",
+	[STOP_BREAK] = "BREAK instruction",
+	[STOP_ILLEGAL] = "illegal opcode",
+	[STOP_LIMIT] = "cycle limit reached",
+};
+
+static uint8_t *mem;
+static bool verbose = false;
+
+static struct {
+	uint32_t pc;
+	uint16_t x, y, sp;
+	uint8_t a, cc;
+} cpu;
+
+static unsigned long long cycles;
+static unsigned long long cycle_limit = 0;
+static stop_t stop = STOP_NONE;
+static uint32_t insn_pc; // Address of the instruction being executed
+static bool waiting = false; // In WFI
+
+// Peripheral emulation, only enabled in firmware mode.
+static bool io_enabled = false;
+static long watch_addr = -1;
+static unsigned long long watch_cycles;
+
+// Files to load into memory before a call.
+static struct {
+	uint32_t addr;
+	const char *path;
+} call_loads[CALL_LOADS_MAX];
+static size_t call_loads_count = 0;
+
+static struct {
+	long addr;
+	uint8_t cmd;
+	uint8_t resp;
+	FILE *fin;
+	FILE *fout;
+	int fin_next; // Look-ahead byte, so that the end of input can be checked
+} simif = { -1, 0, 0, NULL, NULL, EOF };
+
+static struct {
+	uint8_t cr1, ier, sr1, pscr, cntrl_latch;
+	bool latched;
+	uint16_t cnt, arr;
+	uint8_t psc; // Prescaler in effect, loaded from PSCR on update
+	uint32_t psc_cnt;
+} tim2 = { .arr = 0xFFFF };
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] <program.ihx>\n", name);
+	fprintf(stderr, "       %s [options] -e <function> <program.ihx> <input_file> [output_file]\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -t <device>   device type, for the end of RAM (default STM8S208)\n");
+	fprintf(stderr, "  -X <freq>     clock frequency (accepted for μCsim compatibility; ignored)\n");
+	fprintf(stderr, "  -I <options>  simulator interface, as 'if=rom[addr],in=file,out=file'\n");
+	fprintf(stderr, "  -G            go (accepted for μCsim compatibility; always the case)\n");
+	fprintf(stderr, "  -b <addr>     print cycles since previous write to address, on each write\n");
+	fprintf(stderr, "  -l <cycles>   stop after this many cycles (default none, or %llu with -e)\n", CALL_CYCLE_LIMIT);
+	fprintf(stderr, "  -e <func>     call function (address, or symbol with -m) on input file\n");
+	fprintf(stderr, "  -m <file>     sdld map file of program, for symbols\n");
+	fprintf(stderr, "  -f            function is far (called with CALLF, large memory model)\n");
+	fprintf(stderr, "  -n            also pass input length to function\n");
+	fprintf(stderr, "  -a <addr>     also pass far address (32-bit) to function, after input (and length)\n");
+	fprintf(stderr, "  -L <addr>:<file>  load file into memory at address before call (up to %d)\n", CALL_LOADS_MAX);
+	fprintf(stderr, "  -d <addr>     address of output buffer (default 0x%04X)\n", CALL_DST_DEFAULT);
+	fprintf(stderr, "  -s <addr>     address of input buffer (default end at 0x%04X)\n", CALL_SRC_END);
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+static bool parse_addr(const char *s, uint32_t *addr) {
+	char *end;
+	const unsigned long v = strtoul(s, &end, 0);
+	if(*s == '\0' || *end != '\0' || v >= IMAGE_SIZE) return false;
+	*addr = (uint32_t)v;
+	return true;
+}
+
+static bool parse_load_opt(char *s) {
+	char *sep = strchr(s, ':');
+	if(sep == NULL || sep[1] == '\0' || call_loads_count >= CALL_LOADS_MAX) return false;
+	*sep = '\0';
+	if(!parse_addr(s, &call_loads[call_loads_count].addr)) return false;
+	call_loads[call_loads_count++].path = sep + 1;
+	return true;
+}
+
+/******************************************************************************/
+
+static int hex_byte(const char *s) {
+	int v = 0;
+	for(int i = 0; i < 2; i++) {
+		const char c = s[i];
+		v <<= 4;
+		if(c >= '0' && c <= '9') v |= c - '0';
+		else if(c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+		else if(c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+		else return -1;
+	}
+	return v;
+}
+
+// Read an Intel HEX file into memory. Data (00), end of file (01) and extended
+// segment/linear address (02/04) records are understood; start address records
+// (03/05) are ignored, as the STM8 starts from its reset vector.
+static bool read_hex(const char *path) {
+	char line[LINE_MAX_LEN];
+	uint8_t rec[256 + 5];
+	uint32_t base = 0;
+	unsigned int line_num = 0;
+	bool ok = false;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		size_t len, rec_len;
+		uint8_t sum = 0;
+		uint16_t offset;
+
+		line_num++;
+		len = strcspn(line, "\r\n");
+		if(len == 0) continue;
+		if(line[0] != ':' || len < 11 || (len - 1) % 2 != 0) goto bad_record;
+		rec_len = (len - 1) / 2;
+		for(size_t i = 0; i < rec_len; i++) {
+			const int v = hex_byte(&line[1 + i * 2]);
+			if(v < 0) goto bad_record;
+			rec[i] = (uint8_t)v;
+			sum += rec[i];
+		}
+		if(sum != 0 || rec_len != (size_t)rec[0] + 5) goto bad_record;
+
+		offset = (uint16_t)((rec[1] << 8) | rec[2]);
+		switch(rec[3]) {
+			case 0x00:
+				for(size_t i = 0; i < rec[0]; i++) {
+					mem[(base + offset + i) % IMAGE_SIZE] = rec[4 + i];
+				}
+				break;
+			case 0x01:
+				ok = true;
+				goto done;
+			case 0x02:
+				if(rec[0] != 2) goto bad_record;
+				base = (uint32_t)((rec[4] << 8) | rec[5]) << 4;
+				break;
+			case 0x04:
+				if(rec[0] != 2) goto bad_record;
+				base = (uint32_t)((rec[4] << 8) | rec[5]) << 16;
+				break;
+			case 0x03:
+			case 0x05:
+				break;
+			default:
+				goto bad_record;
+		}
+	}
+
+	fprintf(stderr, "%s: Error: missing end of file record\n", path);
+	goto done;
+
+bad_record:
+	fprintf(stderr, "%s:%u: Error: invalid record\n", path, line_num);
+
+done:
+	fclose(f);
+
+	return ok;
+}
+
+// Like μCsim, allow the program to be given without its file extension.
+static bool load_program(const char *path) {
+	static const char * const exts[] = { ".ihx", ".hex" };
+	char alt[LINE_MAX_LEN];
+
+	if(access(path, R_OK) != 0) {
+		for(size_t i = 0; i < sizeof(exts) / sizeof(exts[0]); i++) {
+			snprintf(alt, sizeof(alt), "%s%s", path, exts[i]);
+			if(access(alt, R_OK) == 0) return read_hex(alt);
+		}
+	}
+
+	return read_hex(path);
+}
+
+// Find the value of a global symbol in the symbol listing of an sdld map file,
+// where each line looks like:
+//
+//   00008080  _lzsa1_decompress_block            lzsa1
+//
+// The symbol may be given with or without the leading underscore that SDCC
+// adds to C names.
+static bool find_symbol(const char *path, const char *symbol, uint32_t *value) {
+	char line[LINE_MAX_LEN], val[16], name[128];
+	bool found = false;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(!found && fgets(line, sizeof(line), f) != NULL) {
+		if(sscanf(line, "%15s %127s", val, name) != 2) continue;
+		if(strspn(val, "0123456789ABCDEFabcdef") != strlen(val)) continue;
+		if(strcmp(name, symbol) == 0 || (name[0] == '_' && strcmp(name + 1, symbol) == 0)) {
+			*value = (uint32_t)strtoul(val, NULL, 16);
+			found = true;
+		}
+	}
+
+	fclose(f);
+
+	return found;
+}
+
+/******************************************************************************/
+
+// Simulator interface: each command is written to the interface register, and
+// then a response is read from it or an argument written to it.
+static uint8_t simif_read(void) {
+	uint8_t v = simif.resp;
+
+	switch(simif.cmd) {
+		case SIMIF_CMD_FIN_CHECK:
+			v = (simif.fin_next != EOF);
+			break;
+		case SIMIF_CMD_READ:
+			v = (simif.fin_next != EOF ? (uint8_t)simif.fin_next : 0);
+			if(simif.fin_next != EOF) simif.fin_next = fgetc(simif.fin);
+			simif.cmd = 0;
+			break;
+	}
+
+	return v;
+}
+
+static void simif_write(const uint8_t v) {
+	switch(simif.cmd) {
+		case SIMIF_CMD_PRINT:
+			putchar(v);
+			simif.cmd = 0;
+			return;
+		case SIMIF_CMD_WRITE:
+			if(simif.fout != NULL) fputc(v, simif.fout);
+			simif.cmd = 0;
+			return;
+	}
+
+	simif.cmd = v;
+	simif.resp = 0;
+	switch(v) {
+		case SIMIF_CMD_DETECT: simif.resp = SIMIF_DETECT_RESP; break;
+		case SIMIF_CMD_IFVER: simif.resp = SIMIF_VERSION; break;
+		case SIMIF_CMD_STOP: stop = STOP_SIMIF; break;
+	}
+}
+
+// TIM2 counts up to ARR at the CPU clock divided by the prescaler, setting the
+// update flag each time it wraps to zero.
+static void tim2_tick(const unsigned int n) {
+	if(!(tim2.cr1 & TIM2_CR1_CEN)) return;
+	tim2.psc_cnt += n;
+	while(tim2.psc_cnt >> tim2.psc) {
+		tim2.psc_cnt -= 1UL << tim2.psc;
+		if(tim2.cnt == tim2.arr) {
+			tim2.cnt = 0;
+			tim2.psc = tim2.pscr & 0x0F;
+			tim2.sr1 |= TIM2_SR1_UIF;
+		} else {
+			tim2.cnt++;
+		}
+	}
+}
+
+static bool tim2_irq(void) {
+	return (tim2.sr1 & TIM2_SR1_UIF) && (tim2.ier & TIM2_IER_UIE);
+}
+
+static uint8_t io_read(const uint32_t addr) {
+	if(addr == (uint32_t)simif.addr) return simif_read();
+
+	switch(addr) {
+		case UART1_SR: return UART1_SR_READY;
+		case TIM2_CR1: return tim2.cr1;
+		case TIM2_IER: return tim2.ier;
+		case TIM2_SR1: return tim2.sr1;
+		case TIM2_PSCR: return tim2.pscr;
+		case TIM2_ARRH: return tim2.arr >> 8;
+		case TIM2_ARRL: return tim2.arr & 0xFF;
+		case TIM2_CNTRH:
+			// Reading the MSB latches the LSB until it is read.
+			tim2.cntrl_latch = tim2.cnt & 0xFF;
+			tim2.latched = true;
+			return tim2.cnt >> 8;
+		case TIM2_CNTRL:
+			if(tim2.latched) {
+				tim2.latched = false;
+				return tim2.cntrl_latch;
+			}
+			return tim2.cnt & 0xFF;
+	}
+
+	return mem[addr];
+}
+
+static void io_write(const uint32_t addr, const uint8_t v) {
+	if(addr == (uint32_t)simif.addr) {
+		simif_write(v);
+		return;
+	}
+
+	switch(addr) {
+		case UART1_DR: putchar(v); break;
+		case TIM2_CR1: tim2.cr1 = v; break;
+		case TIM2_IER: tim2.ier = v; break;
+		case TIM2_SR1: tim2.sr1 &= v; break; // Flags are cleared by writing 0
+		case TIM2_PSCR: tim2.pscr = v; break;
+		case TIM2_ARRH: tim2.arr = (uint16_t)((v << 8) | (tim2.arr & 0xFF)); break;
+		case TIM2_ARRL: tim2.arr = (uint16_t)((tim2.arr & 0xFF00) | v); break;
+		case TIM2_CNTRH: tim2.cnt = (uint16_t)((v << 8) | (tim2.cnt & 0xFF)); break;
+		case TIM2_CNTRL: tim2.cnt = (uint16_t)((tim2.cnt & 0xFF00) | v); break;
+		case TIM2_EGR:
+			if(v & TIM2_EGR_UG) {
+				tim2.cnt = 0;
+				tim2.psc_cnt = 0;
+				tim2.psc = tim2.pscr & 0x0F;
+				tim2.sr1 |= TIM2_SR1_UIF;
+			}
+			break;
+	}
+
+	if(addr == (uint32_t)watch_addr) {
+		printf("cycles: %llu\n", cycles - watch_cycles);
+		watch_cycles = cycles;
+	}
+
+	mem[addr] = v;
+}
+
+/******************************************************************************/
+
+static uint8_t rd8(uint32_t addr) {
+	addr &= IMAGE_SIZE - 1;
+	if(io_enabled && ((addr >= 0x5000 && addr < 0x5800) || addr == (uint32_t)simif.addr)) return io_read(addr);
+	return mem[addr];
+}
+
+static void wr8(uint32_t addr, const uint8_t v) {
+	addr &= IMAGE_SIZE - 1;
+	if(io_enabled && ((addr >= 0x5000 && addr < 0x5800) || addr == (uint32_t)simif.addr || addr == (uint32_t)watch_addr)) {
+		io_write(addr, v);
+		return;
+	}
+	mem[addr] = v;
+}
+
+static uint16_t rd16(const uint32_t addr) {
+	return (uint16_t)((rd8(addr) << 8) | rd8(addr + 1));
+}
+
+static void wr16(const uint32_t addr, const uint16_t v) {
+	wr8(addr, v >> 8);
+	wr8(addr + 1, v & 0xFF);
+}
+
+static uint32_t rd24(const uint32_t addr) {
+	return ((uint32_t)rd8(addr) << 16) | rd16(addr + 1);
+}
+
+static uint8_t fetch8(void) {
+	const uint8_t v = rd8(cpu.pc);
+	cpu.pc = (cpu.pc + 1) & (IMAGE_SIZE - 1);
+	return v;
+}
+
+static uint16_t fetch16(void) {
+	const uint16_t v = (uint16_t)(fetch8() << 8);
+	return v | fetch8();
+}
+
+static uint32_t fetch24(void) {
+	const uint32_t v = (uint32_t)fetch8() << 16;
+	return v | fetch16();
+}
+
+static void push8(const uint8_t v) {
+	wr8(cpu.sp, v);
+	cpu.sp--;
+}
+
+static uint8_t pop8(void) {
+	cpu.sp++;
+	return rd8(cpu.sp);
+}
+
+static void push16(const uint16_t v) {
+	push8(v & 0xFF);
+	push8(v >> 8);
+}
+
+static uint16_t pop16(void) {
+	const uint16_t v = (uint16_t)(pop8() << 8);
+	return v | pop8();
+}
+
+/******************************************************************************/
+
+static void set_flag(const uint8_t flag, const bool set) {
+	if(set) {
+		cpu.cc |= flag;
+	} else {
+		cpu.cc &= ~flag;
+	}
+}
+
+static void set_nz8(const uint8_t v) {
+	set_flag(CC_N, v & 0x80);
+	set_flag(CC_Z, v == 0);
+}
+
+static void set_nz16(const uint16_t v) {
+	set_flag(CC_N, v & 0x8000);
+	set_flag(CC_Z, v == 0);
+}
+
+// Byte arithmetic and logic operations of the ALU group (low nibble of opcode).
+// Returns the result, which the caller discards for CP and BCP.
+static uint8_t alu8(const uint8_t op, const uint8_t a, const uint8_t m) {
+	const unsigned int c = cpu.cc & CC_C;
+	unsigned int r;
+
+	switch(op) {
+		case 0x0: // SUB
+		case 0x1: // CP
+		case 0x2: // SBC
+			r = (unsigned int)a - m - (op == 0x2 ? c : 0);
+			set_flag(CC_V, (a ^ m) & (a ^ r) & 0x80);
+			set_flag(CC_C, r > 0xFF);
+			break;
+		case 0x9: // ADC
+		case 0xB: // ADD
+			r = (unsigned int)a + m + (op == 0x9 ? c : 0);
+			set_flag(CC_V, ~(a ^ m) & (a ^ r) & 0x80);
+			set_flag(CC_H, (a & 0x0F) + (m & 0x0F) + (op == 0x9 ? c : 0) > 0x0F);
+			set_flag(CC_C, r > 0xFF);
+			break;
+		case 0x4: // AND
+		case 0x5: // BCP
+			r = a & m;
+			break;
+		case 0x8: // XOR
+			r = a ^ m;
+			break;
+		case 0xA: // OR
+			r = a | m;
+			break;
+		default: // LD
+			r = m;
+			break;
+	}
+
+	set_nz8((uint8_t)r);
+
+	return (uint8_t)r;
+}
+
+static uint16_t addw(const uint16_t a, const uint16_t m) {
+	const uint32_t r = (uint32_t)a + m;
+	set_flag(CC_V, ~(a ^ m) & (a ^ r) & 0x8000);
+	set_flag(CC_H, (a & 0xFF) + (m & 0xFF) > 0xFF);
+	set_flag(CC_C, r > 0xFFFF);
+	set_nz16((uint16_t)r);
+	return (uint16_t)r;
+}
+
+// Also used for CPW, which leaves H alone.
+static uint16_t subw(const uint16_t a, const uint16_t m, const bool cpw) {
+	const uint32_t r = (uint32_t)a - m;
+	set_flag(CC_V, (a ^ m) & (a ^ r) & 0x8000);
+	if(!cpw) set_flag(CC_H, (a & 0xFF) < (m & 0xFF));
+	set_flag(CC_C, a < m);
+	set_nz16((uint16_t)r);
+	return (uint16_t)r;
+}
+
+// Byte read-modify-write operations (low nibble of opcode).
+static uint8_t rmw8(const uint8_t op, const uint8_t v) {
+	const uint8_t c = cpu.cc & CC_C;
+	uint8_t r;
+
+	switch(op) {
+		case 0x0: // NEG
+			r = (uint8_t)-v;
+			set_flag(CC_V, v == 0x80);
+			set_flag(CC_C, r != 0);
+			break;
+		case 0x3: // CPL
+			r = (uint8_t)~v;
+			set_flag(CC_C, true);
+			break;
+		case 0x4: // SRL
+			r = v >> 1;
+			set_flag(CC_C, v & 0x01);
+			break;
+		case 0x6: // RRC
+			r = (uint8_t)((v >> 1) | (c << 7));
+			set_flag(CC_C, v & 0x01);
+			break;
+		case 0x7: // SRA
+			r = (uint8_t)((v >> 1) | (v & 0x80));
+			set_flag(CC_C, v & 0x01);
+			break;
+		case 0x8: // SLL
+			r = (uint8_t)(v << 1);
+			set_flag(CC_C, v & 0x80);
+			break;
+		case 0x9: // RLC
+			r = (uint8_t)((v << 1) | c);
+			set_flag(CC_C, v & 0x80);
+			break;
+		case 0xA: // DEC
+			r = v - 1;
+			set_flag(CC_V, v == 0x80);
+			break;
+		case 0xC: // INC
+			r = v + 1;
+			set_flag(CC_V, v == 0x7F);
+			break;
+		case 0xE: // SWAP
+			r = (uint8_t)((v << 4) | (v >> 4));
+			break;
+		case 0xF: // CLR
+			r = 0;
+			break;
+		default: // TNZ
+			r = v;
+			break;
+	}
+
+	set_nz8(r);
+
+	return r;
+}
+
+// Word read-modify-write operations on X or Y (low nibble of opcode).
+static uint16_t rmw16(const uint8_t op, const uint16_t v) {
+	const uint16_t c = cpu.cc & CC_C;
+	uint16_t r;
+
+	switch(op) {
+		case 0x0: // NEGW
+			r = (uint16_t)-v;
+			set_flag(CC_V, v == 0x8000);
+			set_flag(CC_C, r != 0);
+			break;
+		case 0x3: // CPLW
+			r = (uint16_t)~v;
+			set_flag(CC_C, true);
+			break;
+		case 0x4: // SRLW
+			r = v >> 1;
+			set_flag(CC_C, v & 0x0001);
+			break;
+		case 0x6: // RRCW
+			r = (uint16_t)((v >> 1) | (c << 15));
+			set_flag(CC_C, v & 0x0001);
+			break;
+		case 0x7: // SRAW
+			r = (uint16_t)((v >> 1) | (v & 0x8000));
+			set_flag(CC_C, v & 0x0001);
+			break;
+		case 0x8: // SLLW
+			r = (uint16_t)(v << 1);
+			set_flag(CC_C, v & 0x8000);
+			break;
+		case 0x9: // RLCW
+			r = (uint16_t)((v << 1) | c);
+			set_flag(CC_C, v & 0x8000);
+			break;
+		case 0xA: // DECW
+			r = v - 1;
+			set_flag(CC_V, v == 0x8000);
+			break;
+		case 0xC: // INCW
+			r = v + 1;
+			set_flag(CC_V, v == 0x7FFF);
+			break;
+		case 0xE: // SWAPW
+			r = (uint16_t)((v << 8) | (v >> 8));
+			break;
+		case 0xF: // CLRW
+			r = 0;
+			break;
+		default: // TNZW
+			r = v;
+			break;
+	}
+
+	set_nz16(r);
+
+	return r;
+}
+
+/******************************************************************************/
+
+// Interrupts are taken when their software priority (always level 3 here, the
+// reset value) is higher than the current level given by I1:I0 in CC.
+static bool irq_enabled(void) {
+	return (cpu.cc & (CC_I1 | CC_I0)) != (CC_I1 | CC_I0);
+}
+
+static void interrupt(const uint32_t vector) {
+	push8(cpu.pc & 0xFF);
+	push8((cpu.pc >> 8) & 0xFF);
+	push8((cpu.pc >> 16) & 0xFF);
+	push16(cpu.y);
+	push16(cpu.x);
+	push8(cpu.a);
+	push8(cpu.cc);
+	cpu.cc |= CC_I1 | CC_I0;
+	cpu.pc = vector;
+	cycles += 9;
+}
+
+static void jump_rel(const int8_t rel) {
+	cpu.pc = (cpu.pc + rel) & (IMAGE_SIZE - 1);
+}
+
+// Jumps and calls with 16-bit addresses stay within the current 64K section.
+static void jump_near(const uint32_t addr) {
+	cpu.pc = (cpu.pc & 0xFF0000) | (addr & 0xFFFF);
+}
+
+static void call_near(const uint32_t addr) {
+	push16(cpu.pc & 0xFFFF);
+	jump_near(addr);
+}
+
+static void call_far(const uint32_t addr) {
+	push16(cpu.pc & 0xFFFF);
+	push8((cpu.pc >> 16) & 0xFF);
+	cpu.pc = addr;
+}
+
+static bool jr_cond(const uint8_t pre, const uint8_t op) {
+	const uint8_t cc = cpu.cc;
+	const bool c = cc & CC_C, z = cc & CC_Z, n = cc & CC_N, v = cc & CC_V;
+	bool taken;
+
+	if(pre == 0x90) {
+		switch(op & 0x0E) {
+			case 0x8: taken = !(cc & CC_H); break; // JRNH
+			case 0xC: taken = !((cc & (CC_I1 | CC_I0)) == (CC_I1 | CC_I0)); break; // JRNM
+			case 0xE: taken = false; break; // JRIL (no interrupt line)
+			default: stop = STOP_ILLEGAL; return false;
+		}
+	} else {
+		switch(op & 0x0E) {
+			case 0x0: taken = true; break; // JRA
+			case 0x2: taken = !(c || z); break; // JRUGT
+			case 0x4: taken = !c; break; // JRNC
+			case 0x6: taken = !z; break; // JRNE
+			case 0x8: taken = !v; break; // JRNV
+			case 0xA: taken = !n; break; // JRPL
+			case 0xC: taken = !z && (n == v); break; // JRSGT
+			default: taken = (n == v); break; // JRSGE
+		}
+	}
+
+	// Odd opcodes test the inverse condition (JRF, JRULE, JRC, etc.).
+	return (op & 0x01) ? !taken : taken;
+}
+
+/******************************************************************************/
+
+// Effective address of the memory operand of an instruction in rows B to F of
+// the opcode map, for the prefix given. Indirect modes take the pointer from
+// the address that follows. Returns false for an invalid combination.
+static bool alu_addr(const uint8_t pre, const uint8_t row, uint32_t *addr, bool *indirect) {
+	const uint16_t idx = (pre == 0x90 || pre == 0x91) ? cpu.y : cpu.x;
+
+	*indirect = (pre == 0x72 || pre == 0x91 || pre == 0x92);
+	switch(row) {
+		case 0xB: // shortmem
+			if(*indirect) return false;
+			*addr = fetch8();
+			return true;
+		case 0xC: // longmem, [shortptr.w], [longptr.w]
+			if(pre == 0x72) *addr = rd16(fetch16());
+			else if(*indirect) *addr = rd16(fetch8());
+			else *addr = fetch16();
+			return true;
+		case 0xD: // (longoff,X), ([shortptr.w],X), ([longptr.w],X)
+			if(pre == 0x72) *addr = rd16(fetch16()) + (uint32_t)idx;
+			else if(*indirect) *addr = rd16(fetch8()) + (uint32_t)idx;
+			else *addr = fetch16() + (uint32_t)idx;
+			return true;
+		case 0xE: // (shortoff,X)
+			if(*indirect) return false;
+			*addr = fetch8() + (uint32_t)idx;
+			return true;
+		case 0xF: // (X)
+			if(*indirect) return false;
+			*addr = idx;
+			return true;
+	}
+
+	return false;
+}
+
+// Instructions of rows 1 and A to F of the opcode map: byte and word loads,
+// arithmetic and logic with A, and jumps and calls, plus the far loads, jumps
+// and calls, and the word additions and subtractions, that fill gaps there.
+static void exec_alu(const uint8_t pre, const uint8_t op) {
+	const uint8_t row = op >> 4, col = op & 0x0F;
+	const bool use_y = (pre == 0x90 || pre == 0x91);
+	uint16_t * const reg = use_y ? &cpu.y : &cpu.x; // Index register
+	uint16_t * const other = use_y ? &cpu.x : &cpu.y;
+	uint32_t addr;
+	bool indirect;
+
+	// Word additions and subtractions on X and Y.
+	if(pre == 0x72 && (row == 0xA || row == 0xB || row == 0xF) && (col == 0x0 || col == 0x2 || col == 0x9 || col == 0xB)) {
+		uint16_t * const r = (col == 0x0 || col == 0xB) ? &cpu.x : &cpu.y;
+		uint16_t m;
+		if(row == 0xA) {
+			if(col != 0x2 && col != 0x9) goto illegal;
+			m = fetch16();
+		} else if(row == 0xB) {
+			m = rd16(fetch16());
+		} else {
+			m = rd16((uint16_t)(cpu.sp + fetch8()));
+		}
+		*r = (col == 0x9 || col == 0xB) ? addw(*r, m) : subw(*r, m, false);
+		cycles += 2;
+		return;
+	}
+
+	// Far loads, jumps and calls.
+	if((row == 0xA && (col == 0x7 || col == 0xF || col == 0xC)) || (row == 0xB && (col == 0xC || col == 0xD))) {
+		const bool ptr = (pre == 0x91 || pre == 0x92);
+		if(pre == 0x72 || (pre == 0x90 && row == 0xB) || (pre == 0x91 && col != 0x7 && col != 0xF) || (pre == 0x90 && col == 0xC)) goto illegal;
+		if(row == 0xA && col == 0xC) { // JPF
+			cpu.pc = ptr ? rd24(fetch16()) : fetch24();
+			cycles += ptr ? 6 : 2;
+			return;
+		}
+		if(row == 0xA) { // (extoff,X), ([longptr.e],X)
+			addr = (ptr ? rd24(fetch16()) : fetch24()) + *reg;
+		} else { // extmem, [longptr.e]
+			addr = ptr ? rd24(fetch16()) : fetch24();
+		}
+		if(col == 0x7 || col == 0xD) {
+			wr8(addr, cpu.a);
+		} else {
+			cpu.a = rd8(addr);
+		}
+		set_nz8(cpu.a);
+		cycles += ptr ? 5 : 1;
+		return;
+	}
+
+	// Immediate operands.
+	if(row == 0xA) {
+		if(pre != 0 && pre != 0x90) goto illegal;
+		switch(col) {
+			case 0x3: // CPW
+				subw(*reg, fetch16(), true);
+				cycles += 2;
+				return;
+			case 0xD: // CALLR
+				if(pre) goto illegal;
+				{
+					const int8_t rel = (int8_t)fetch8();
+					push16(cpu.pc & 0xFFFF);
+					jump_rel(rel);
+				}
+				cycles += 4;
+				return;
+			case 0xE: // LDW
+				*reg = fetch16();
+				set_nz16(*reg);
+				cycles += 2;
+				return;
+			default:
+				if(pre) goto illegal;
+				{
+					const uint8_t r = alu8(col, cpu.a, fetch8());
+					if(col != 0x1 && col != 0x5) cpu.a = r;
+				}
+				cycles += 1;
+				return;
+		}
+	}
+
+	// Stack pointer relative operands.
+	if(row == 0x1) {
+		if(pre) goto illegal;
+		switch(col) {
+			case 0x3: // CPW X,(off,SP)
+				subw(cpu.x, rd16((uint16_t)(cpu.sp + fetch8())), true);
+				cycles += 2;
+				return;
+			case 0x6: // LDW Y,(off,SP)
+			case 0xE: // LDW X,(off,SP)
+				{
+					uint16_t * const r = (col == 0x6) ? &cpu.y : &cpu.x;
+					*r = rd16((uint16_t)(cpu.sp + fetch8()));
+					set_nz16(*r);
+				}
+				cycles += 2;
+				return;
+			case 0x7: // LDW (off,SP),Y
+			case 0xF: // LDW (off,SP),X
+				{
+					const uint16_t v = (col == 0x7) ? cpu.y : cpu.x;
+					wr16((uint16_t)(cpu.sp + fetch8()), v);
+					set_nz16(v);
+				}
+				cycles += 2;
+				return;
+			case 0xC: // ADDW X,#word
+				cpu.x = addw(cpu.x, fetch16());
+				cycles += 2;
+				return;
+			case 0xD: // SUBW X,#word
+				cpu.x = subw(cpu.x, fetch16(), false);
+				cycles += 2;
+				return;
+			default:
+				{
+					const uint8_t r = alu8(col, cpu.a, rd8((uint16_t)(cpu.sp + fetch8())));
+					if(col != 0x1 && col != 0x5) cpu.a = r;
+				}
+				cycles += 1;
+				return;
+		}
+	}
+
+	if(!alu_addr(pre, row, &addr, &indirect)) goto illegal;
+
+	switch(col) {
+		case 0x3: // CPW
+			subw((row >= 0xD) ? *other : *reg, rd16(addr), true);
+			cycles += indirect ? 5 : 2;
+			return;
+		case 0x7: // LD mem,A
+			wr8(addr, cpu.a);
+			set_nz8(cpu.a);
+			cycles += indirect ? 4 : 1;
+			return;
+		case 0xC: // JP
+			if(row == 0xB) goto illegal;
+			jump_near(addr);
+			cycles += indirect ? 5 : 1;
+			return;
+		case 0xD: // CALL
+			if(row == 0xB) goto illegal;
+			call_near(addr);
+			cycles += indirect ? 6 : 4;
+			return;
+		case 0xE: // LDW
+			*reg = rd16(addr);
+			set_nz16(*reg);
+			cycles += indirect ? 5 : 2;
+			return;
+		case 0xF: // LDW mem,X/Y
+			{
+				const uint16_t v = (row >= 0xD) ? *other : *reg;
+				wr16(addr, v);
+				set_nz16(v);
+			}
+			cycles += indirect ? 5 : 2;
+			return;
+		default:
+			{
+				const uint8_t r = alu8(col, cpu.a, rd8(addr));
+				if(col != 0x1 && col != 0x5) cpu.a = r;
+			}
+			cycles += indirect ? 4 : 1;
+			return;
+	}
+
+illegal:
+	stop = STOP_ILLEGAL;
+}
+
+// Instructions of rows 0 and 3 to 7 of the opcode map: read-modify-write
+// operations on memory, A, X and Y, plus the miscellaneous instructions that
+// fill gaps there.
+static void exec_rmw(const uint8_t pre, const uint8_t op) {
+	const uint8_t row = op >> 4, col = op & 0x0F;
+	uint16_t * const reg = (pre == 0x90) ? &cpu.y : &cpu.x;
+	uint32_t addr;
+	bool indirect = false;
+
+	if(col == 0x1 || col == 0x2 || col == 0x5 || col == 0xB) {
+		if(pre && !(pre == 0x90 && (op == 0x01 || op == 0x02 || op == 0x42 || op == 0x62))) goto illegal;
+		switch(op) {
+			case 0x01: // RRWA
+				{
+					const uint8_t a = cpu.a;
+					cpu.a = *reg & 0xFF;
+					*reg = (uint16_t)((a << 8) | (*reg >> 8));
+					set_nz16(*reg);
+				}
+				cycles += 1;
+				return;
+			case 0x02: // RLWA
+				{
+					const uint8_t a = cpu.a;
+					cpu.a = *reg >> 8;
+					*reg = (uint16_t)((*reg << 8) | a);
+					set_nz16(*reg);
+				}
+				cycles += 1;
+				return;
+			case 0x31: // EXG A,longmem
+				{
+					const uint8_t a = cpu.a;
+					addr = fetch16();
+					cpu.a = rd8(addr);
+					wr8(addr, a);
+				}
+				cycles += 3;
+				return;
+			case 0x32: // POP longmem
+				addr = fetch16();
+				wr8(addr, pop8());
+				cycles += 1;
+				return;
+			case 0x35: // MOV longmem,#byte
+				{
+					const uint8_t v = fetch8();
+					wr8(fetch16(), v);
+				}
+				cycles += 1;
+				return;
+			case 0x3B: // PUSH longmem
+				push8(rd8(fetch16()));
+				cycles += 1;
+				return;
+			case 0x41: // EXG A,XL
+			case 0x61: // EXG A,YL
+				{
+					uint16_t * const r = (op == 0x41) ? &cpu.x : &cpu.y;
+					const uint8_t a = cpu.a;
+					cpu.a = *r & 0xFF;
+					*r = (*r & 0xFF00) | a;
+				}
+				cycles += 1;
+				return;
+			case 0x42: // MUL
+				*reg = (uint16_t)((*reg & 0xFF) * cpu.a);
+				set_flag(CC_H, false);
+				set_flag(CC_C, false);
+				cycles += 4;
+				return;
+			case 0x45: // MOV shortmem,shortmem
+				{
+					const uint8_t v = rd8(fetch8());
+					wr8(fetch8(), v);
+				}
+				cycles += 1;
+				return;
+			case 0x4B: // PUSH #byte
+				push8(fetch8());
+				cycles += 1;
+				return;
+			case 0x51: // EXGW X,Y
+				{
+					const uint16_t x = cpu.x;
+					cpu.x = cpu.y;
+					cpu.y = x;
+				}
+				cycles += 1;
+				return;
+			case 0x52: // SUB SP,#byte
+				cpu.sp -= fetch8();
+				cycles += 1;
+				return;
+			case 0x55: // MOV longmem,longmem
+				{
+					const uint8_t v = rd8(fetch16());
+					wr8(fetch16(), v);
+				}
+				cycles += 1;
+				return;
+			case 0x5B: // ADDW SP,#byte
+				cpu.sp += fetch8();
+				cycles += 2;
+				return;
+			case 0x62: // DIV
+			case 0x65: // DIVW X,Y
+				{
+					const uint16_t d = (op == 0x62) ? cpu.a : cpu.y;
+					cpu.cc &= ~(CC_V | CC_H | CC_N | CC_Z | CC_C);
+					if(d == 0) {
+						cpu.cc |= CC_C;
+					} else {
+						const uint16_t q = *reg / d, r = *reg % d;
+						*reg = q;
+						if(op == 0x62) cpu.a = (uint8_t)r;
+						else cpu.y = r;
+						set_flag(CC_Z, q == 0);
+					}
+				}
+				cycles += 17; // Manual gives 2 to 17; the worst case is assumed
+				return;
+			case 0x6B: // LD (off,SP),A
+				wr8((uint16_t)(cpu.sp + fetch8()), cpu.a);
+				set_nz8(cpu.a);
+				cycles += 1;
+				return;
+			case 0x7B: // LD A,(off,SP)
+				cpu.a = rd8((uint16_t)(cpu.sp + fetch8()));
+				set_nz8(cpu.a);
+				cycles += 1;
+				return;
+		}
+		goto illegal;
+	}
+
+	// Word operations on X or Y.
+	if(row == 0x5 && (pre == 0 || pre == 0x90)) {
+		*reg = rmw16(col, *reg);
+		switch(col) {
+			case 0xA: case 0xC: case 0xE: case 0xF: cycles += 1; break;
+			default: cycles += 2; break;
+		}
+		return;
+	}
+
+	// Byte operations on A.
+	if(row == 0x4 && pre == 0) {
+		cpu.a = rmw8(col, cpu.a);
+		cycles += 1;
+		return;
+	}
+
+	switch(pre) {
+		case 0x00:
+			switch(row) {
+				case 0x0: addr = (uint16_t)(cpu.sp + fetch8()); break;
+				case 0x3: addr = fetch8(); break;
+				case 0x6: addr = fetch8() + (uint32_t)cpu.x; break;
+				default: addr = cpu.x; break;
+			}
+			break;
+		case 0x90:
+			switch(row) {
+				case 0x4: addr = fetch16() + (uint32_t)cpu.y; break;
+				case 0x6: addr = fetch8() + (uint32_t)cpu.y; break;
+				case 0x7: addr = cpu.y; break;
+				default: goto illegal;
+			}
+			break;
+		case 0x72:
+			switch(row) {
+				case 0x3: addr = rd16(fetch16()); indirect = true; break;
+				case 0x4: addr = fetch16() + (uint32_t)cpu.x; break;
+				case 0x5: addr = fetch16(); break;
+				case 0x6: addr = rd16(fetch16()) + (uint32_t)cpu.x; indirect = true; break;
+				default: goto illegal;
+			}
+			break;
+		case 0x92:
+			switch(row) {
+				case 0x3: addr = rd16(fetch8()); indirect = true; break;
+				case 0x6: addr = rd16(fetch8()) + (uint32_t)cpu.x; indirect = true; break;
+				default: goto illegal;
+			}
+			break;
+		default: // 0x91
+			if(row != 0x6) goto illegal;
+			addr = rd16(fetch8()) + (uint32_t)cpu.y;
+			indirect = true;
+			break;
+	}
+
+	{
+		const uint8_t v = rmw8(col, rd8(addr));
+		if(col != 0xD) wr8(addr, v);
+	}
+	cycles += indirect ? 4 : 1;
+	return;
+
+illegal:
+	stop = STOP_ILLEGAL;
+}
+
+// Execute one instruction.
+static void step(void) {
+	uint8_t pre = 0, op;
+
+	insn_pc = cpu.pc;
+	op = fetch8();
+	if(op == 0x72 || op == 0x90 || op == 0x91 || op == 0x92) {
+		pre = op;
+		op = fetch8();
+	}
+
+	switch(op >> 4) {
+		case 0x0:
+			if(pre == 0x72) { // BTJT, BTJF
+				const uint8_t mask = 1 << ((op >> 1) & 0x07);
+				const uint8_t v = rd8(fetch16());
+				const int8_t rel = (int8_t)fetch8();
+				const bool set = (v & mask);
+				set_flag(CC_C, set);
+				if(set == !(op & 0x01)) {
+					jump_rel(rel);
+					cycles += 3;
+				} else {
+					cycles += 2;
+				}
+				return;
+			}
+			exec_rmw(pre, op);
+			return;
+		case 0x1:
+			if(pre == 0x72 || pre == 0x90) { // BSET, BRES, BCPL, BCCM
+				const uint8_t mask = 1 << ((op >> 1) & 0x07);
+				const uint32_t addr = fetch16();
+				uint8_t v = rd8(addr);
+				if(pre == 0x72) {
+					v = (op & 0x01) ? (v & ~mask) : (v | mask);
+				} else if(!(op & 0x01)) {
+					v ^= mask;
+				} else {
+					v = (cpu.cc & CC_C) ? (v | mask) : (v & ~mask);
+				}
+				wr8(addr, v);
+				cycles += 1;
+				return;
+			}
+			exec_alu(pre, op);
+			return;
+		case 0x2: // JRxx
+			{
+				const int8_t rel = (int8_t)fetch8();
+				if(pre != 0 && pre != 0x90) {
+					stop = STOP_ILLEGAL;
+				} else if(jr_cond(pre, op)) {
+					jump_rel(rel);
+					if(cpu.pc == insn_pc) stop = STOP_LOOP;
+					cycles += 2;
+				} else {
+					cycles += 1;
+				}
+			}
+			return;
+		case 0x3: case 0x4: case 0x5: case 0x6: case 0x7:
+			exec_rmw(pre, op);
+			return;
+		case 0x8:
+			if(pre && !(pre == 0x90 && (op == 0x85 || op == 0x89)) && !(pre == 0x92 && op == 0x8D) && !(pre == 0x72 && op == 0x8F)) break;
+			switch(op) {
+				case 0x80: // IRET
+					cpu.cc = pop8();
+					cpu.a = pop8();
+					cpu.x = pop16();
+					cpu.y = pop16();
+					cpu.pc = (uint32_t)pop8() << 16;
+					cpu.pc |= pop16();
+					cycles += 11;
+					return;
+				case 0x81: // RET
+					jump_near(pop16());
+					cycles += 4;
+					return;
+				case 0x82: // INT
+					cpu.pc = fetch24();
+					cycles += 2;
+					return;
+				case 0x83: // TRAP
+					interrupt(TRAP_VECTOR);
+					return;
+				case 0x84: // POP A
+					cpu.a = pop8();
+					cycles += 1;
+					return;
+				case 0x85: // POPW
+					*((pre == 0x90) ? &cpu.y : &cpu.x) = pop16();
+					cycles += 2;
+					return;
+				case 0x86: // POP CC
+					cpu.cc = pop8();
+					cycles += 1;
+					return;
+				case 0x87: // RETF
+					cpu.pc = (uint32_t)pop8() << 16;
+					cpu.pc |= pop16();
+					cycles += 5;
+					return;
+				case 0x88: // PUSH A
+					push8(cpu.a);
+					cycles += 1;
+					return;
+				case 0x89: // PUSHW
+					push16((pre == 0x90) ? cpu.y : cpu.x);
+					cycles += 2;
+					return;
+				case 0x8A: // PUSH CC
+					push8(cpu.cc);
+					cycles += 1;
+					return;
+				case 0x8B: // BREAK
+					stop = STOP_BREAK;
+					cycles += 1;
+					return;
+				case 0x8C: // CCF
+					cpu.cc ^= CC_C;
+					cycles += 1;
+					return;
+				case 0x8D: // CALLF
+					call_far((pre == 0x92) ? rd24(fetch16()) : fetch24());
+					cycles += (pre == 0x92) ? 8 : 5;
+					return;
+				case 0x8E: // HALT
+					stop = STOP_HALT;
+					cycles += 10;
+					return;
+				case 0x8F: // WFI, WFE
+					cpu.cc = (cpu.cc & ~CC_I0) | CC_I1;
+					cycles += 10;
+					// Wait for an interrupt, if there is one that could come.
+					if(pre == 0x72 || !io_enabled || !(tim2_irq() || ((tim2.cr1 & TIM2_CR1_CEN) && (tim2.ier & TIM2_IER_UIE)))) {
+						stop = STOP_LOOP;
+					} else {
+						waiting = true;
+					}
+					return;
+			}
+			break;
+		case 0x9:
+			if(pre && !(pre == 0x90 && ((op >= 0x93 && op <= 0x97) || op >= 0x9E))) break;
+			{
+				uint16_t * const reg = (pre == 0x90) ? &cpu.y : &cpu.x;
+				switch(op) {
+					case 0x93: *reg = (pre == 0x90) ? cpu.x : cpu.y; break; // LDW X,Y
+					case 0x94: cpu.sp = *reg; break; // LDW SP,X
+					case 0x95: *reg = (uint16_t)((cpu.a << 8) | (*reg & 0xFF)); break; // LD XH,A
+					case 0x96: *reg = cpu.sp; break; // LDW X,SP
+					case 0x97: *reg = (*reg & 0xFF00) | cpu.a; break; // LD XL,A
+					case 0x98: cpu.cc &= ~CC_C; break; // RCF
+					case 0x99: cpu.cc |= CC_C; break; // SCF
+					case 0x9A: cpu.cc = (cpu.cc & ~CC_I0) | CC_I1; break; // RIM
+					case 0x9B: cpu.cc |= CC_I1 | CC_I0; break; // SIM
+					case 0x9C: cpu.cc &= ~CC_V; break; // RVF
+					case 0x9D: break; // NOP
+					case 0x9E: cpu.a = *reg >> 8; break; // LD A,XH
+					case 0x9F: cpu.a = *reg & 0xFF; break; // LD A,XL
+					default: stop = STOP_ILLEGAL; return;
+				}
+				cycles += 1;
+			}
+			return;
+		default:
+			exec_alu(pre, op);
+			return;
+	}
+
+	stop = STOP_ILLEGAL;
+}
+
+// Run until stopped, or (when given) until the PC reaches the given address.
+static void run(const long until) {
+	while(stop == STOP_NONE) {
+		unsigned long long before = cycles;
+
+		if(cpu.pc == (uint32_t)until) break;
+		if(waiting) {
+			cycles++;
+		} else {
+			step();
+		}
+		if(io_enabled) {
+			tim2_tick((unsigned int)(cycles - before));
+			if(stop == STOP_NONE && tim2_irq() && irq_enabled()) {
+				waiting = false;
+				before = cycles;
+				interrupt(IRQ_VECTOR(TIM2_OVF_IRQ));
+				tim2_tick((unsigned int)(cycles - before));
+			}
+		}
+		if(cycle_limit != 0 && cycles >= cycle_limit && stop == STOP_NONE) stop = STOP_LIMIT;
+	}
+}
+
+static void reset(const uint16_t sp) {
+	memset(&cpu, 0, sizeof(cpu));
+	cpu.sp = sp;
+	cpu.cc = CC_RESET;
+	cpu.pc = RESET_VECTOR;
+}
+
+/******************************************************************************/
+
+// Parse μCsim's interface option, e.g. "if=rom[0x5800],in=file,out=file".
+static bool parse_if_opt(char *opt) {
+	for(char *tok = strtok(opt, ","); tok != NULL; tok = strtok(NULL, ",")) {
+		if(strncmp(tok, "if=rom[", 7) == 0) {
+			char *end;
+			simif.addr = strtol(tok + 7, &end, 0);
+			if(end == tok + 7 || strcmp(end, "]") != 0) return false;
+		} else if(strncmp(tok, "in=", 3) == 0) {
+			if((simif.fin = fopen(tok + 3, "rb")) == NULL) {
+				perror(tok + 3);
+				exit(EXIT_FAILURE);
+			}
+			simif.fin_next = fgetc(simif.fin);
+		} else if(strncmp(tok, "out=", 4) == 0) {
+			if((simif.fout = fopen(tok + 4, "wb")) == NULL) {
+				perror(tok + 4);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static int run_firmware(const uint16_t sp) {
+	reset(sp);
+	io_enabled = true;
+	run(-1);
+
+	fflush(stdout);
+	if(simif.fin != NULL) fclose(simif.fin);
+	if(simif.fout != NULL && fclose(simif.fout) != 0) {
+		perror("output file");
+		return EXIT_FAILURE;
+	}
+
+	if(verbose || stop == STOP_ILLEGAL || stop == STOP_LIMIT) {
+		fprintf(stderr, "%s at PC 0x%06X after %llu cycles\n", stop_reasons[stop], insn_pc, cycles);
+	}
+
+	return (stop == STOP_ILLEGAL || stop == STOP_LIMIT) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+static bool load_file(const uint32_t addr, const char *path) {
+	FILE *f;
+	size_t len;
+
+	if((f = fopen(path, "rb")) == NULL) {
+		perror(path);
+		return false;
+	}
+	len = fread(mem + addr, 1, IMAGE_SIZE - addr, f);
+	if(fgetc(f) != EOF) {
+		fprintf(stderr, "%s: Error: file too large to load at 0x%06X\n", path, addr);
+		fclose(f);
+		return false;
+	}
+	fclose(f);
+	if(verbose) fprintf(stderr, "loaded %zu bytes at 0x%06X from %s\n", len, addr, path);
+
+	return true;
+}
+
+static int run_call(const uint16_t sp, const uint32_t entry, const bool far, const long main_addr, const bool pass_len, const bool pass_arg, const uint32_t arg, const uint32_t dst, uint32_t src, const char *in_path, const char *out_path) {
+	unsigned long long startup_cycles = 0;
+	uint32_t end, src_len = 0;
+	uint16_t args_len = 4;
+	size_t len;
+	FILE *f;
+
+	// Read the input into memory.
+	if((f = fopen(in_path, "rb")) == NULL) {
+		perror(in_path);
+		return EXIT_FAILURE;
+	}
+	if(src == 0) {
+		len = fread(mem + CALL_SRC_END / 2, 1, CALL_SRC_END / 2, f);
+		src = CALL_SRC_END - (uint32_t)len;
+		memmove(mem + src, mem + CALL_SRC_END / 2, len);
+	} else {
+		len = fread(mem + src, 1, IMAGE_SIZE - src, f);
+	}
+	src_len = (uint32_t)len;
+	if(fgetc(f) != EOF || src + src_len > 0x10000) {
+		fprintf(stderr, "%s: Error: file too large for input buffer\n", in_path);
+		fclose(f);
+		return EXIT_FAILURE;
+	}
+	fclose(f);
+	if(src <= dst && src + src_len > dst) {
+		fprintf(stderr, "Error: input buffer (0x%04X-0x%04X) overlaps output buffer\n", src, src + src_len - 1);
+		return EXIT_FAILURE;
+	}
+
+	reset(sp);
+
+	// Run the startup code up to main, to initialise global variables.
+	if(main_addr >= 0) {
+		run(main_addr);
+		if(stop != STOP_NONE) {
+			fprintf(stderr, "Error: startup code did not reach main (%s at PC 0x%06X)\n", stop_reasons[stop], insn_pc);
+			return EXIT_FAILURE;
+		}
+		startup_cycles = cycles;
+		if(verbose) fprintf(stderr, "startup code took %llu cycles\n", startup_cycles);
+		cpu.sp = sp;
+	}
+
+	// Load any other files, after the startup code, so that it cannot overwrite
+	// them.
+	for(size_t i = 0; i < call_loads_count; i++) {
+		if(!load_file(call_loads[i].addr, call_loads[i].path)) return EXIT_FAILURE;
+	}
+
+	// Push the arguments as SDCC does, last first, then make the call, with a
+	// fake return address that is recognised as the end. A 32-bit value is held
+	// big-endian, so its low word is pushed first.
+	cycles = 0;
+	if(pass_arg) {
+		push16((uint16_t)arg);
+		push16((uint16_t)(arg >> 16));
+		args_len += 4;
+	}
+	if(pass_len) {
+		push16((uint16_t)src_len);
+		args_len += 2;
+	}
+	push16((uint16_t)src);
+	push16((uint16_t)dst);
+	cpu.pc = CALL_RETURN_ADDR;
+	if(far) {
+		call_far(entry);
+		cycles += 5;
+	} else {
+		call_near(entry);
+		cycles += 4;
+	}
+
+	if(cycle_limit == 0) cycle_limit = CALL_CYCLE_LIMIT;
+	run(CALL_RETURN_ADDR);
+	if(stop != STOP_NONE) {
+		fprintf(stderr, "Error: function did not return (%s at PC 0x%06X after %llu cycles)\n", stop_reasons[stop], insn_pc, cycles);
+		return EXIT_FAILURE;
+	}
+	if(cpu.sp != (uint16_t)(sp - args_len)) {
+		fprintf(stderr, "Error: stack pointer not restored on return (0x%04X)\n", cpu.sp);
+		return EXIT_FAILURE;
+	}
+
+	end = cpu.x;
+	printf("returned 0x%04X after %llu cycles", end, cycles);
+	if(end >= dst) {
+		const uint32_t out_len = end - dst;
+		printf("; output %u bytes", out_len);
+		if(out_len > 0) printf(" (%.2f cycles per byte)", (double)cycles / out_len);
+		if(out_path != NULL) {
+			if((f = fopen(out_path, "wb")) == NULL || fwrite(mem + dst, 1, out_len, f) != out_len || fclose(f) != 0) {
+				putchar('\n');
+				perror(out_path);
+				return EXIT_FAILURE;
+			}
+		}
+	} else if(out_path != NULL) {
+		printf("\n");
+		fprintf(stderr, "Error: returned pointer is before output buffer; no output written\n");
+		return EXIT_FAILURE;
+	}
+	printf("\n");
+
+	return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
+
+int main(int argc, char *argv[]) {
+	const char *device = "STM8S208", *entry_name = NULL, *map_path = NULL;
+	uint32_t entry, dst = CALL_DST_DEFAULT, src = 0, value;
+	long main_addr = -1;
+	bool far = false, pass_len = false, pass_arg = false;
+	uint32_t arg = 0;
+	uint16_t sp = 0;
+	int opt;
+
+	while((opt = getopt(argc, argv, "t:X:I:Gb:l:e:m:fna:L:d:s:vh")) != -1) {
+		switch(opt) {
+			case 't': device = optarg; break;
+			case 'X': break;
+			case 'G': break;
+			case 'I':
+				if(!parse_if_opt(optarg)) {
+					fprintf(stderr, "Error: invalid interface option (expected if=rom[addr],in=file,out=file)\n");
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'b':
+				if(!parse_addr(optarg, &value)) {
+					fprintf(stderr, "Error: invalid address '%s'\n", optarg);
+					return EXIT_FAILURE;
+				}
+				watch_addr = (long)value;
+				break;
+			case 'l': cycle_limit = strtoull(optarg, NULL, 0); break;
+			case 'e': entry_name = optarg; break;
+			case 'm': map_path = optarg; break;
+			case 'f': far = true; break;
+			case 'n': pass_len = true; break;
+			case 'a':
+				if(!parse_addr(optarg, &arg)) {
+					fprintf(stderr, "Error: invalid address '%s'\n", optarg);
+					return EXIT_FAILURE;
+				}
+				pass_arg = true;
+				break;
+			case 'L':
+				if(!parse_load_opt(optarg)) {
+					fprintf(stderr, "Error: invalid load option (expected addr:file, at most %d)\n", CALL_LOADS_MAX);
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'd':
+			case 's':
+				if(!parse_addr(optarg, (opt == 'd') ? &dst : &src) || ((opt == 'd') ? dst : src) > 0xFFFF) {
+					fprintf(stderr, "Error: invalid buffer address '%s' (must be below 0x10000)\n", optarg);
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'v': verbose = true; break;
+			default: usage(argv[0]); return EXIT_FAILURE;
+		}
+	}
+	if(entry_name == NULL ? (optind != argc - 1) : (optind != argc - 2 && optind != argc - 3)) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	for(size_t i = 0; i < sizeof(devices) / sizeof(devices[0]); i++) {
+		if(strcmp(device, devices[i].name) == 0) sp = devices[i].sp_reset;
+	}
+	if(sp == 0) {
+		fprintf(stderr, "Error: unknown device type '%s'\n", device);
+		return EXIT_FAILURE;
+	}
+
+	mem = calloc(IMAGE_SIZE, 1);
+	if(mem == NULL) {
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+	if(!load_program(argv[optind])) return EXIT_FAILURE;
+
+	if(entry_name == NULL) return run_firmware(sp);
+
+	if(!parse_addr(entry_name, &entry)) {
+		if(map_path == NULL || !find_symbol(map_path, entry_name, &entry)) {
+			fprintf(stderr, "Error: function '%s' not found (give an address, or a map file with -m)\n", entry_name);
+			return EXIT_FAILURE;
+		}
+	}
+	if(!far && entry > 0xFFFF) {
+		fprintf(stderr, "Error: function at 0x%06X is beyond 64K, so must be called with -f\n", entry);
+		return EXIT_FAILURE;
+	}
+	if(map_path != NULL && find_symbol(map_path, "_main", &value)) main_addr = (long)value;
+
+	return run_call(sp, entry, far, main_addr, pass_len, pass_arg, arg, dst, src, argv[optind + 1], (optind + 2 < argc) ? argv[optind + 2] : NULL);
+}
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * lzsa_filter.c - Host tool to apply inverse of output filter before compression
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Prepares data for decompression with lzsa2_decompress_block_filter() by
+// applying the inverse of the chosen output filter. The result should then be
+// compressed as normal with the LZSA tool, e.g.:
+//
+//   lzsa_filter delta16 samples.bin samples.raw
+//   lzsa -f2 -r samples.raw samples.lzsa2
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -o lzsa_filter lzsa_filter.c
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_DATA_LEN 65536
+
+/******************************************************************************/
+
+static uint8_t data_in[MAX_DATA_LEN];
+static uint8_t data_out[MAX_DATA_LEN];
+static uint8_t lut[256];
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s <filter> <input_file> <output_file>\n", name);
+	fprintf(stderr, "Filters:\n");
+	fprintf(stderr, "  delta8        8-bit delta encode\n");
+	fprintf(stderr, "  delta16       16-bit little-endian delta encode\n");
+	fprintf(stderr, "  xor:<key>     XOR with key byte (e.g. xor:0x5A)\n");
+	fprintf(stderr, "  lut:<file>    reverse lookup through 256-byte table file\n");
+}
+
+static size_t read_file(const char *path, uint8_t *buf, const size_t max) {
+	FILE *f;
+	size_t len;
+
+	if((f = fopen(path, "rb")) == NULL) {
+		perror(path);
+		exit(EXIT_FAILURE);
+	}
+	len = fread(buf, 1, max, f);
+	if(fgetc(f) != EOF) {
+		fprintf(stderr, "%s: file too large (max. %zu bytes)\n", path, max);
+		exit(EXIT_FAILURE);
+	}
+	fclose(f);
+
+	return len;
+}
+
+static void delta8_encode(uint8_t *dst, const uint8_t *src, const size_t len) {
+	uint8_t prev = 0;
+
+	for(size_t i = 0; i < len; i++) {
+		dst[i] = src[i] - prev;
+		prev = src[i];
+	}
+}
+
+static void delta16_encode(uint8_t *dst, const uint8_t *src, const size_t len) {
+	uint16_t prev = 0, word;
+
+	for(size_t i = 0; i + 1 < len; i += 2) {
+		word = src[i] | ((uint16_t)src[i + 1] << 8);
+		dst[i] = (uint8_t)(word - prev);
+		dst[i + 1] = (uint8_t)((uint16_t)(word - prev) >> 8);
+		prev = word;
+	}
+
+	// An odd trailing byte is delta encoded against the low byte of the last
+	// whole word only.
+	if(len & 1) dst[len - 1] = src[len - 1] - (uint8_t)prev;
+}
+
+static void xor_encode(uint8_t *dst, const uint8_t *src, const size_t len, const uint8_t key) {
+	for(size_t i = 0; i < len; i++) dst[i] = src[i] ^ key;
+}
+
+static bool lut_encode(uint8_t *dst, const uint8_t *src, const size_t len, const uint8_t *table) {
+	int16_t rev[256];
+
+	// Build reverse table. Where the table maps more than one index to the same
+	// value, the first is used. Values that do not appear cannot be encoded.
+	for(size_t i = 0; i < 256; i++) rev[i] = -1;
+	for(size_t i = 0; i < 256; i++) {
+		if(rev[table[i]] < 0) rev[table[i]] = (int16_t)i;
+	}
+
+	for(size_t i = 0; i < len; i++) {
+		if(rev[src[i]] < 0) {
+			fprintf(stderr, "Byte 0x%02X at offset %zu does not appear in LUT\n", src[i], i);
+			return false;
+		}
+		dst[i] = (uint8_t)rev[src[i]];
+	}
+
+	return true;
+}
+
+int main(int argc, char *argv[]) {
+	const char *filter;
+	size_t len;
+	FILE *f;
+
+	if(argc != 4) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	filter = argv[1];
+	len = read_file(argv[2], data_in, sizeof(data_in));
+
+	if(strcmp(filter, "delta8") == 0) {
+		delta8_encode(data_out, data_in, len);
+	} else if(strcmp(filter, "delta16") == 0) {
+		delta16_encode(data_out, data_in, len);
+	} else if(strncmp(filter, "xor:", 4) == 0) {
+		xor_encode(data_out, data_in, len, (uint8_t)strtoul(filter + 4, NULL, 0));
+	} else if(strncmp(filter, "lut:", 4) == 0) {
+		if(read_file(filter + 4, lut, sizeof(lut)) != sizeof(lut)) {
+			fprintf(stderr, "%s: LUT file must be exactly 256 bytes\n", filter + 4);
+			return EXIT_FAILURE;
+		}
+		if(!lut_encode(data_out, data_in, len, lut)) return EXIT_FAILURE;
+	} else {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if((f = fopen(argv[3], "wb")) == NULL) {
+		perror(argv[3]);
+		return EXIT_FAILURE;
+	}
+	fwrite(data_out, 1, len, f);
+	fclose(f);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,466 @@
+/*******************************************************************************
+ *
+ * lzsa_initpack.c - Host tool to compress initialised data of a linked program
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Compresses the initialised data of a linked program, for decompression at
+// startup by lzsa_init.s. The contents of the INITIALIZER area (the initial
+// values of global and static variables, which the SDCC startup code would
+// copy into the INITIALIZED area in RAM) are replaced in the program's Intel
+// HEX file by a raw LZSA1 block, and the remainder of the area is dropped. For
+// example:
+//
+//   lzsa_initpack program.ihx program.map program-packed.ihx
+//
+// The linker's map file gives the address and size of the INITIALIZER and
+// INITIALIZED areas, and is checked to make sure the program was linked with
+// lzsa_init.rel (otherwise the stock startup code would copy compressed data
+// into RAM). Flash is only saved if the INITIALIZER area is at the end of the
+// program, which is the case when lzsa_init.rel is the first object file given
+// to the linker; a warning is given if not.
+//
+// Compression is done by running the LZSA command-line tool. The compressed
+// data is checked by decompressing it with the reference C implementation.
+// The flash saved is reported, as is the number of cycles the startup code is
+// predicted to take to decompress the data, compared with the stock copy loop.
+// The prediction is optimistic (see lzsa_cycles.c).
+//
+// Build with any hosted C99 compiler on a POSIX system, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_initpack lzsa_initpack.c lzsa_cycles.c ../lzsa_ref.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "lzsa_ref.h"
+#include "lzsa_cycles.h"
+
+#define IMAGE_SIZE 0x1000000UL // 24-bit address space of STM8
+#define LINE_MAX_LEN 1024
+#define HEX_RECORD_LEN 16
+
+// Cycles per byte taken by the copy loop of the SDCC startup code:
+// ld a, (s_INITIALIZER-1, x); ld (s_INITIALIZED-1, x), a; decw x; jrne.
+#define STOCK_COPY_CYCLES_PER_BYTE 5
+
+typedef struct {
+	uint32_t addr;
+	uint32_t size;
+	bool found;
+} area_t;
+
+/******************************************************************************/
+
+static const char *lzsa_path = "lzsa";
+static const char *lzsa_opts = ""; // Extra compressor option, e.g. "-m4"
+static bool verbose = false;
+
+static uint8_t *image;
+static uint8_t *image_used;
+
+/******************************************************************************/
+
+static uint8_t * read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if(f == NULL) return NULL;
+	if(fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(size > 0 ? (size_t)size : 1);
+		if(data != NULL && fread(data, 1, (size_t)size, f) == (size_t)size) {
+			*len = (size_t)size;
+		} else {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+
+	return data;
+}
+
+static bool write_file(const char *path, const uint8_t *data, const size_t len) {
+	FILE *f = fopen(path, "wb");
+	bool ok;
+
+	if(f == NULL) return false;
+	ok = (fwrite(data, 1, len, f) == len);
+	if(fclose(f) != 0) ok = false;
+
+	return ok;
+}
+
+/******************************************************************************/
+
+// Find the INITIALIZER and INITIALIZED areas in the area listing of an sdld map
+// file, where each line looks like:
+//
+//   INITIALIZER                         000080A3    00000046 =          70. bytes (REL,CON)
+//
+// Also check that the startup hook is defined by the lzsa_init module.
+static bool read_map(const char *path, area_t *initializer, area_t *initialized) {
+	char line[LINE_MAX_LEN], name[64];
+	unsigned long addr, size;
+	bool have_hook = false;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		if(sscanf(line, "%63s %lx %lx =", name, &addr, &size) == 3) {
+			area_t *area = NULL;
+			if(strcmp(name, "INITIALIZER") == 0) area = initializer;
+			if(strcmp(name, "INITIALIZED") == 0) area = initialized;
+			if(area != NULL && !area->found) {
+				area->addr = (uint32_t)addr;
+				area->size = (uint32_t)size;
+				area->found = true;
+			}
+		}
+		if(strstr(line, "___sdcc_external_startup") != NULL && strstr(line, "lzsa_init") != NULL) {
+			have_hook = true;
+		}
+	}
+
+	fclose(f);
+
+	if(!initializer->found || !initialized->found) {
+		fprintf(stderr, "%s: Error: INITIALIZER and INITIALIZED areas not found (is this an sdld map file?)\n", path);
+		return false;
+	}
+	if(!have_hook) {
+		fprintf(stderr, "%s: Error: __sdcc_external_startup() not defined by lzsa_init (was lzsa_init.rel linked?)\n", path);
+		return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+static int hex_byte(const char *s) {
+	int v = 0;
+	for(int i = 0; i < 2; i++) {
+		const char c = s[i];
+		v <<= 4;
+		if(c >= '0' && c <= '9') v |= c - '0';
+		else if(c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+		else if(c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+		else return -1;
+	}
+	return v;
+}
+
+// Read an Intel HEX file into the image. Data (00), end of file (01) and
+// extended segment/linear address (02/04) records are understood; start
+// address records (03/05) are ignored, as the STM8 starts from its reset
+// vector.
+static bool read_hex(const char *path) {
+	char line[LINE_MAX_LEN];
+	uint8_t rec[256 + 5];
+	uint32_t base = 0;
+	unsigned int line_num = 0;
+	bool ok = false;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		size_t len, rec_len;
+		uint8_t sum = 0;
+		uint16_t offset;
+
+		line_num++;
+		len = strcspn(line, "\r\n");
+		if(len == 0) continue;
+		if(line[0] != ':' || len < 11 || (len - 1) % 2 != 0) goto bad_record;
+		rec_len = (len - 1) / 2;
+		for(size_t i = 0; i < rec_len; i++) {
+			const int v = hex_byte(&line[1 + i * 2]);
+			if(v < 0) goto bad_record;
+			rec[i] = (uint8_t)v;
+			sum += rec[i];
+		}
+		if(sum != 0 || rec_len != (size_t)rec[0] + 5) goto bad_record;
+
+		offset = (uint16_t)((rec[1] << 8) | rec[2]);
+		switch(rec[3]) {
+			case 0x00:
+				for(size_t i = 0; i < rec[0]; i++) {
+					const uint32_t addr = (base + offset + i) % IMAGE_SIZE;
+					image[addr] = rec[4 + i];
+					image_used[addr] = 1;
+				}
+				break;
+			case 0x01:
+				ok = true;
+				goto done;
+			case 0x02:
+				if(rec[0] != 2) goto bad_record;
+				base = (uint32_t)((rec[4] << 8) | rec[5]) << 4;
+				break;
+			case 0x04:
+				if(rec[0] != 2) goto bad_record;
+				base = (uint32_t)((rec[4] << 8) | rec[5]) << 16;
+				break;
+			case 0x03:
+			case 0x05:
+				break;
+			default:
+				goto bad_record;
+		}
+	}
+
+	fprintf(stderr, "%s: Error: missing end of file record\n", path);
+	goto done;
+
+bad_record:
+	fprintf(stderr, "%s:%u: Error: invalid record\n", path, line_num);
+
+done:
+	fclose(f);
+
+	return ok;
+}
+
+static void write_hex_record(FILE *f, const uint8_t type, const uint16_t offset, const uint8_t *data, const uint8_t len) {
+	uint8_t sum = len + (offset >> 8) + (offset & 0xFF) + type;
+
+	fprintf(f, ":%02X%04X%02X", len, offset, type);
+	for(uint8_t i = 0; i < len; i++) {
+		fprintf(f, "%02X", data[i]);
+		sum += data[i];
+	}
+	fprintf(f, "%02X\n", (uint8_t)-sum);
+}
+
+// Write the image as an Intel HEX file, with a record for each run of up to 16
+// used bytes. Runs do not cross a 64K boundary, and an extended linear address
+// record is written before the first run in each 64K segment above the first.
+static bool write_hex(const char *path) {
+	uint32_t segment = 0;
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	for(uint32_t addr = 0; addr < IMAGE_SIZE; ) {
+		uint8_t len = 0;
+
+		if(!image_used[addr]) {
+			addr++;
+			continue;
+		}
+		if((addr >> 16) != segment) {
+			const uint8_t upper[2] = { (uint8_t)(addr >> 24), (uint8_t)(addr >> 16) };
+			segment = addr >> 16;
+			write_hex_record(f, 0x04, 0, upper, 2);
+		}
+		while(len < HEX_RECORD_LEN && image_used[addr + len] && ((addr + len) >> 16) == segment) len++;
+		write_hex_record(f, 0x00, (uint16_t)addr, &image[addr], len);
+		addr += len;
+	}
+	write_hex_record(f, 0x01, 0, NULL, 0);
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+// Compress the given data to a raw LZSA1 block by running the LZSA tool on
+// temporary files.
+static uint8_t * compress(const uint8_t *plain, const size_t plain_len, size_t *comp_len) {
+	char in_path[64], out_path[64];
+	uint8_t *comp = NULL;
+	int wstatus;
+	pid_t pid;
+
+	snprintf(in_path, sizeof(in_path), "lzsa_initpack.%d.in.tmp", (int)getpid());
+	snprintf(out_path, sizeof(out_path), "lzsa_initpack.%d.out.tmp", (int)getpid());
+
+	if(!write_file(in_path, plain, plain_len)) {
+		perror(in_path);
+		remove(in_path);
+		return NULL;
+	}
+
+	if(verbose) printf("Compressing %zu bytes of initialised data as LZSA1\n", plain_len);
+
+	fflush(stdout);
+	pid = fork();
+	if(pid < 0) {
+		perror("fork");
+		remove(in_path);
+		return NULL;
+	}
+	if(pid == 0) {
+		if(freopen("/dev/null", "w", stdout) == NULL) _exit(127);
+		if(*lzsa_opts != '\0') {
+			execlp(lzsa_path, lzsa_path, "-f1", "-r", lzsa_opts, in_path, out_path, (char *)NULL);
+		} else {
+			execlp(lzsa_path, lzsa_path, "-f1", "-r", in_path, out_path, (char *)NULL);
+		}
+		_exit(127);
+	}
+
+	if(waitpid(pid, &wstatus, 0) < 0) {
+		perror("waitpid");
+	} else if(!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+		fprintf(stderr, "Error: compressing initialised data failed (is '%s' the LZSA tool?)\n", lzsa_path);
+	} else if((comp = read_file(out_path, comp_len)) == NULL) {
+		perror(out_path);
+	}
+
+	remove(in_path);
+	remove(out_path);
+
+	return comp;
+}
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] <input.ihx> <input.map> <output.ihx>\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -l <path>     path to LZSA tool (default %s)\n", lzsa_path);
+	fprintf(stderr, "  -m <option>   extra option to pass to LZSA tool (e.g. -m4)\n");
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+int main(int argc, char *argv[]) {
+	area_t initializer = { 0 }, initialized = { 0 };
+	uint8_t *plain, *comp, *check;
+	size_t comp_len = 0, check_len;
+	uint32_t image_end = 0, cycles_stock, cycles_lzsa;
+	int opt;
+
+	while((opt = getopt(argc, argv, "l:m:vh")) != -1) {
+		switch(opt) {
+			case 'l': lzsa_path = optarg; break;
+			case 'm': lzsa_opts = optarg; break;
+			case 'v': verbose = true; break;
+			default: usage(argv[0]); return EXIT_FAILURE;
+		}
+	}
+	if(optind != argc - 3) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if(!read_map(argv[optind + 1], &initializer, &initialized)) return EXIT_FAILURE;
+	if(initializer.size != initialized.size) {
+		fprintf(stderr, "Error: INITIALIZER area size (%u) differs from INITIALIZED area size (%u)\n", initializer.size, initialized.size);
+		return EXIT_FAILURE;
+	}
+	if(initializer.size == 0) {
+		fprintf(stderr, "Error: INITIALIZER area is empty; nothing to compress\n");
+		return EXIT_FAILURE;
+	}
+	// The startup code reads the compressed data using 16-bit pointers.
+	if(initializer.addr + initializer.size > 0x10000) {
+		fprintf(stderr, "Error: INITIALIZER area (0x%06X) must be within the first 64K of the address space\n", initializer.addr);
+		return EXIT_FAILURE;
+	}
+
+	image = calloc(IMAGE_SIZE, 1);
+	image_used = calloc(IMAGE_SIZE + HEX_RECORD_LEN, 1);
+	plain = malloc(initializer.size);
+	// Decompressed data is checked in a buffer with a little room at the end,
+	// so that output that runs past the expected size is caught.
+	check = malloc((size_t)initializer.size + 256);
+	if(image == NULL || image_used == NULL || plain == NULL || check == NULL) {
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+
+	if(!read_hex(argv[optind])) return EXIT_FAILURE;
+	for(uint32_t i = 0; i < initializer.size; i++) {
+		if(!image_used[initializer.addr + i]) {
+			fprintf(stderr, "Error: INITIALIZER area (0x%06X, %u bytes) is not all present in %s (already packed?)\n", initializer.addr, initializer.size, argv[optind]);
+			return EXIT_FAILURE;
+		}
+	}
+	memcpy(plain, &image[initializer.addr], initializer.size);
+
+	if((comp = compress(plain, initializer.size, &comp_len)) == NULL) return EXIT_FAILURE;
+
+	check_len = (uint8_t *)lzsa1_decompress_block_ref(check, comp) - check;
+	if(check_len != initializer.size || memcmp(check, plain, check_len) != 0) {
+		fprintf(stderr, "Error: compressed initialised data does not decompress correctly\n");
+		return EXIT_FAILURE;
+	}
+	if(comp_len >= initializer.size) {
+		fprintf(stderr, "Error: initialised data does not compress (%zu bytes compressed to %zu)\n", (size_t)initializer.size, comp_len);
+		return EXIT_FAILURE;
+	}
+
+	// Warn if anything follows the INITIALIZER area, as the space freed in the
+	// middle of the program is not reclaimed.
+	for(uint32_t addr = 0; addr < IMAGE_SIZE; addr++) {
+		if(image_used[addr]) image_end = addr + 1;
+	}
+	if(image_end > initializer.addr + initializer.size) {
+		fprintf(stderr, "Warning: INITIALIZER area is not at end of program (ends at 0x%06X, program at 0x%06X); was lzsa_init.rel linked first?\n", initializer.addr + initializer.size, image_end);
+	}
+
+	memcpy(&image[initializer.addr], comp, comp_len);
+	memset(&image_used[initializer.addr + comp_len], 0, initializer.size - comp_len);
+
+	if(!write_hex(argv[optind + 2])) return EXIT_FAILURE;
+
+	cycles_stock = initializer.size * STOCK_COPY_CYCLES_PER_BYTE;
+	cycles_lzsa = predict_lzsa1_cycles(comp);
+	printf("INITIALIZER: 0x%06X, %u bytes -> %zu bytes (%.1f%%), %zu bytes of flash saved\n", initializer.addr, initializer.size, comp_len, comp_len * 100.0 / initializer.size, (size_t)initializer.size - comp_len);
+	printf("Startup cycles (predicted): %u for stock copy loop, %u for LZSA1 decompression (%+ld)\n", cycles_stock, cycles_lzsa, (long)cycles_lzsa - (long)cycles_stock);
+
+	free(plain);
+	free(check);
+	free(comp);
+	free(image);
+	free(image_used);
+
+	return EXIT_SUCCESS;
+}
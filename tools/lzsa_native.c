@@ -0,0 +1,437 @@
+/*******************************************************************************
+ *
+ * lzsa_native.c - Host tool to transcode LZSA blocks to the STM8-native format
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Transcodes a raw LZSA1 or LZSA2 block into the STM8-native format decoded by
+// lzsa_native_decompress_block(), without loss (i.e. it decompresses to the
+// same data), e.g.:
+//
+//   lzsa -f2 -r logo.bin logo.lzsa2
+//   lzsa_native -f 2 logo.lzsa2 logo.native
+//
+// The matches and literals of the input are kept as they are, only re-encoded.
+// Runs of literals, or matches, longer than 256 bytes are split, with matches
+// continued using the repeat offset code. Both blocks are checked by
+// decompressing them with the reference C implementation. The sizes of both,
+// along with the predicted number of cycles to decompress each with the
+// assembly routines, are reported.
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_native lzsa_native.c lzsa_cycles.c ../lzsa_ref.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "lzsa_ref.h"
+#include "lzsa_cycles.h"
+
+#define BLOCK_MAX 65536
+#define PLAIN_MAX 65536
+
+// Worst-case growth of native over LZSA encoding is a few bytes per sequence,
+// so allow for a generous amount.
+#define NATIVE_MAX (BLOCK_MAX * 2)
+
+#define NATIVE_RUN_MAX 256
+#define NATIVE_TOKEN_LIT_LEN_MAX 14
+#define NATIVE_TOKEN_LIT_LEN_BYTE 15
+#define NATIVE_TOKEN_MATCH_LEN_MIN 2
+#define NATIVE_TOKEN_MATCH_LEN_MAX 7
+#define NATIVE_TOKEN_MATCH_LEN_BYTE 7
+#define NATIVE_TOKEN_16B_OFFSET 0x08
+#define NATIVE_TOKEN_REPEAT_MATCH 0x08
+#define NATIVE_OFFSET_8B_MIN (-256)
+
+// One LZSA sequence: a run of literals, then a match (with a length of zero
+// for the last sequence of the block, which has none).
+typedef struct {
+	const uint8_t *lit;
+	uint16_t lit_len;
+	uint16_t match_len;
+	int32_t match_off;
+} sequence_t;
+
+typedef struct {
+	const uint8_t *data;
+	size_t len;
+	size_t pos;
+	bool ok;
+} reader_t;
+
+typedef struct {
+	uint8_t *data;
+	size_t len;
+} writer_t;
+
+/******************************************************************************/
+
+static uint8_t block_in[BLOCK_MAX];
+static uint8_t block_out[NATIVE_MAX];
+static uint8_t plain_lzsa[PLAIN_MAX + NATIVE_RUN_MAX];
+static uint8_t plain_native[PLAIN_MAX + NATIVE_RUN_MAX];
+static bool verbose = false;
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] <input_file> <output_file>\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -f <1|2>      format of input block (default 2)\n");
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+static size_t read_file(const char *path, uint8_t *buf, const size_t max) {
+	FILE *f;
+	size_t len;
+
+	if((f = fopen(path, "rb")) == NULL) {
+		perror(path);
+		exit(EXIT_FAILURE);
+	}
+	len = fread(buf, 1, max, f);
+	if(fgetc(f) != EOF) {
+		fprintf(stderr, "%s: file too large (max. %zu bytes)\n", path, max);
+		exit(EXIT_FAILURE);
+	}
+	fclose(f);
+
+	return len;
+}
+
+// Input is read through these, which flag (rather than overrun) a truncated
+// block.
+static uint8_t read_byte(reader_t *r) {
+	if(r->pos >= r->len) {
+		r->ok = false;
+		return 0;
+	}
+	return r->data[r->pos++];
+}
+
+static const uint8_t * read_run(reader_t *r, const size_t len) {
+	const uint8_t *run = r->data + r->pos;
+	if(len > r->len - r->pos) {
+		r->ok = false;
+		return r->data;
+	}
+	r->pos += len;
+	return run;
+}
+
+static uint8_t lzsa2_read_nibble(reader_t *r, int16_t *pending) {
+	uint8_t n;
+	if(*pending >= 0) {
+		n = (uint8_t)*pending;
+		*pending = -1;
+	} else {
+		n = read_byte(r);
+		*pending = n & 0x0F;
+		n >>= 4;
+	}
+	return n;
+}
+
+/******************************************************************************/
+
+// Parse the next sequence of an LZSA1 block. Returns false when the block is
+// truncated; the last sequence is the one with no match.
+static bool lzsa1_parse(reader_t *r, sequence_t *seq) {
+	const uint8_t token = read_byte(r);
+	uint16_t len;
+	uint8_t n;
+
+	len = (token >> 4) & 0x07;
+	if(len == 7) {
+		n = read_byte(r);
+		if(n == 250) {
+			len = 256 + read_byte(r);
+		} else if(n == 249) {
+			len = read_byte(r);
+			len |= (uint16_t)(read_byte(r) << 8);
+		} else {
+			len += n;
+		}
+	}
+	seq->lit_len = len;
+	seq->lit = read_run(r, len);
+
+	seq->match_off = read_byte(r);
+	if(token & 0x80) {
+		seq->match_off |= (int32_t)read_byte(r) << 8;
+	} else {
+		seq->match_off |= 0xFF00;
+	}
+	seq->match_off -= 0x10000;
+
+	len = token & 0x0F;
+	if(len == 15) {
+		n = read_byte(r);
+		if(n == 239) {
+			len = 256 + read_byte(r);
+		} else if(n == 238) {
+			len = read_byte(r);
+			len |= (uint16_t)(read_byte(r) << 8);
+		} else {
+			len += n + 3;
+		}
+	} else {
+		len += 3;
+	}
+	seq->match_len = len;
+
+	return r->ok;
+}
+
+// Parse the next sequence of an LZSA2 block. The nibble cache and previous
+// offset (for repeat matches) are kept between calls by the caller.
+static bool lzsa2_parse(reader_t *r, sequence_t *seq, int16_t *pending, int32_t *prev_off) {
+	const uint8_t token = read_byte(r);
+	uint16_t len;
+	uint8_t n;
+
+	len = (token >> 3) & 0x03;
+	if(len == 3) {
+		len += lzsa2_read_nibble(r, pending);
+		if(len == 18) {
+			n = read_byte(r);
+			if(n == 239) {
+				len = read_byte(r);
+				len |= (uint16_t)(read_byte(r) << 8);
+			} else {
+				len += n;
+			}
+		}
+	}
+	seq->lit_len = len;
+	seq->lit = read_run(r, len);
+
+	switch(token & 0xE0) {
+		case 0x00: case 0x20:
+			n = lzsa2_read_nibble(r, pending);
+			*prev_off = (int32_t)(0xFFE0 | (n << 1) | ((token & 0x20) ? 0 : 1)) - 0x10000;
+			break;
+		case 0x40: case 0x60:
+			*prev_off = (int32_t)(((token & 0x20) ? 0xFE00 : 0xFF00) | read_byte(r)) - 0x10000;
+			break;
+		case 0x80: case 0xA0:
+			n = lzsa2_read_nibble(r, pending);
+			*prev_off = (int32_t)(0xE000 | (((n << 1) | ((token & 0x20) ? 0 : 1)) << 8) | read_byte(r)) - 512 - 0x10000;
+			break;
+		case 0xC0:
+			*prev_off = (int32_t)(read_byte(r) << 8);
+			*prev_off = (int32_t)(*prev_off | read_byte(r)) - 0x10000;
+			break;
+		default:
+			break;
+	}
+	seq->match_off = *prev_off;
+
+	len = (token & 0x07) + 2;
+	if(len == 9) {
+		len += lzsa2_read_nibble(r, pending);
+		if(len == 24) {
+			n = read_byte(r);
+			if(n == 233) {
+				len = read_byte(r);
+				len |= (uint16_t)(read_byte(r) << 8);
+			} else if(n < 232) {
+				len += n;
+			} else {
+				len = 0;
+			}
+		}
+	}
+	seq->match_len = len;
+
+	return r->ok;
+}
+
+/******************************************************************************/
+
+static void write_byte(writer_t *w, const uint8_t b) {
+	if(w->len < NATIVE_MAX) w->data[w->len] = b;
+	w->len++;
+}
+
+// Write a native sequence. The literal run and match length must each be
+// 1-256 bytes, or zero for none.
+static void native_write(writer_t *w, const uint8_t *lit, const uint16_t lit_len, const uint16_t match_len, const int32_t match_off, const bool repeat) {
+	uint8_t token = 0;
+
+	token = (uint8_t)((lit_len > NATIVE_TOKEN_LIT_LEN_MAX ? NATIVE_TOKEN_LIT_LEN_BYTE : lit_len) << 4);
+	if(match_len > 0) {
+		if(repeat) {
+			token |= NATIVE_TOKEN_REPEAT_MATCH;
+		} else {
+			token |= (match_len >= NATIVE_TOKEN_MATCH_LEN_MIN && match_len <= NATIVE_TOKEN_MATCH_LEN_MAX ? match_len - (NATIVE_TOKEN_MATCH_LEN_MIN - 1) : NATIVE_TOKEN_MATCH_LEN_BYTE);
+			if(match_off < NATIVE_OFFSET_8B_MIN) token |= NATIVE_TOKEN_16B_OFFSET;
+		}
+	}
+	write_byte(w, token);
+
+	if(lit_len > NATIVE_TOKEN_LIT_LEN_MAX) write_byte(w, (uint8_t)lit_len);
+	for(uint16_t i = 0; i < lit_len; i++) write_byte(w, lit[i]);
+
+	if(match_len > 0) {
+		if((token & 0x07) == 0 || (token & 0x07) == NATIVE_TOKEN_MATCH_LEN_BYTE) write_byte(w, (uint8_t)match_len);
+		if(!repeat) {
+			if(token & NATIVE_TOKEN_16B_OFFSET) write_byte(w, (uint8_t)((match_off + 0x10000) >> 8));
+			write_byte(w, (uint8_t)(match_off + 0x10000));
+		}
+	}
+}
+
+// Write a sequence of any lengths, splitting off runs of literals of the
+// maximum length on their own, and continuing a long match with repeat
+// matches. A repeat match is also used whenever the offset is the same as the
+// previous one.
+static void native_write_sequence(writer_t *w, const sequence_t *seq, int32_t *prev_off) {
+	const uint8_t *lit = seq->lit;
+	uint16_t lit_len = seq->lit_len;
+	uint16_t match_len = seq->match_len;
+	uint16_t n;
+
+	while(lit_len > NATIVE_RUN_MAX || (lit_len > 0 && match_len == 0)) {
+		n = (lit_len > NATIVE_RUN_MAX ? NATIVE_RUN_MAX : lit_len);
+		native_write(w, lit, n, 0, 0, false);
+		lit += n;
+		lit_len -= n;
+	}
+
+	while(match_len > 0) {
+		n = (match_len > NATIVE_RUN_MAX ? NATIVE_RUN_MAX : match_len);
+		native_write(w, lit, lit_len, n, seq->match_off, (seq->match_off == *prev_off));
+		*prev_off = seq->match_off;
+		lit_len = 0;
+		match_len -= n;
+	}
+}
+
+// Transcode the given LZSA block, checking each match refers to data already
+// decompressed. Returns the decompressed length, or zero if the block is
+// invalid.
+static size_t transcode(const uint8_t *src, const size_t src_len, const unsigned int format, writer_t *w) {
+	reader_t r = { .data = src, .len = src_len, .pos = 0, .ok = true };
+	sequence_t seq;
+	int32_t lzsa2_off = 0, native_off = 0;
+	int16_t pending = -1;
+	size_t plain_len = 0;
+
+	while(1) {
+		if(!(format == 1 ? lzsa1_parse(&r, &seq) : lzsa2_parse(&r, &seq, &pending, &lzsa2_off))) {
+			fprintf(stderr, "Error: block is truncated\n");
+			return 0;
+		}
+		plain_len += seq.lit_len;
+		if(seq.match_len > 0 && (seq.match_off >= 0 || -seq.match_off > (int32_t)plain_len)) {
+			fprintf(stderr, "Error: match at offset %ld is before start of data\n", (long)seq.match_off);
+			return 0;
+		}
+		native_write_sequence(w, &seq, &native_off);
+		plain_len += seq.match_len;
+		if(plain_len > PLAIN_MAX) {
+			fprintf(stderr, "Error: block decompresses to more than %u bytes\n", PLAIN_MAX);
+			return 0;
+		}
+		if(verbose) printf("lit_len = %u, match_len = %u, match_off = %ld\n", seq.lit_len, seq.match_len, (long)seq.match_off);
+		if(seq.match_len == 0) break;
+	}
+
+	write_byte(w, 0x00);
+
+	if(r.pos != src_len) fprintf(stderr, "Warning: %zu bytes after end of block ignored\n", src_len - r.pos);
+
+	return plain_len;
+}
+
+int main(int argc, char *argv[]) {
+	writer_t w = { .data = block_out, .len = 0 };
+	unsigned int format = 2;
+	size_t in_len, plain_len;
+	uint32_t lzsa_cycles, native_cycles;
+	FILE *f;
+	int opt;
+
+	while((opt = getopt(argc, argv, "f:v")) != -1) {
+		switch(opt) {
+			case 'f':
+				format = (unsigned int)strtoul(optarg, NULL, 10);
+				if(format != 1 && format != 2) {
+					usage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'v':
+				verbose = true;
+				break;
+			default:
+				usage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if(argc - optind != 2) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	in_len = read_file(argv[optind], block_in, sizeof(block_in));
+	if((plain_len = transcode(block_in, in_len, format, &w)) == 0) return EXIT_FAILURE;
+	if(w.len > NATIVE_MAX) {
+		fprintf(stderr, "Error: transcoded block is too large\n");
+		return EXIT_FAILURE;
+	}
+
+	// Having been parsed without error, the input block is safe to decompress.
+	// Both must give the same data.
+	if((uint8_t *)(format == 1 ? lzsa1_decompress_block_ref(plain_lzsa, block_in) : lzsa2_decompress_block_ref(plain_lzsa, block_in)) - plain_lzsa != (ptrdiff_t)plain_len ||
+		(uint8_t *)lzsa_native_decompress_block_ref(plain_native, block_out) - plain_native != (ptrdiff_t)plain_len ||
+		memcmp(plain_lzsa, plain_native, plain_len) != 0
+	) {
+		fprintf(stderr, "Error: transcoded block does not decompress to the same data\n");
+		return EXIT_FAILURE;
+	}
+
+	if((f = fopen(argv[optind + 1], "wb")) == NULL) {
+		perror(argv[optind + 1]);
+		return EXIT_FAILURE;
+	}
+	fwrite(block_out, 1, w.len, f);
+	fclose(f);
+
+	lzsa_cycles = (format == 1 ? predict_lzsa1_cycles(block_in) : predict_lzsa2_cycles(block_in));
+	native_cycles = predict_lzsa_native_cycles(block_out);
+	printf("%s: %zu bytes plain, LZSA%u %zu bytes -> native %zu bytes (%+.1f%%), %lu -> %lu cycles (%.1f -> %.1f/byte)\n",
+		argv[optind], plain_len, format, in_len, w.len, ((double)w.len - (double)in_len) * 100.0 / (double)in_len,
+		(unsigned long)lzsa_cycles, (unsigned long)native_cycles, (double)lzsa_cycles / (double)plain_len, (double)native_cycles / (double)plain_len);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,657 @@
+/*******************************************************************************
+ *
+ * lzsa_overlay.c - Host tool to build store of compressed code overlays
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Builds a store of LZSA1-compressed code overlays for loading into RAM with
+// lzsa_overlay_load(). Overlays come from one of two kinds of input.
+//
+// Overlays linked to run in RAM are taken from a linked program. Each is an
+// area of the program (e.g. code compiled with '--codeseg OVL_CALIB') that was
+// placed by the linker at the address of the RAM region (e.g. with
+// '-Wl-bOVL_CALIB=0x0100'). The areas are found using the linker's map file,
+// and their contents are removed from the program's Intel HEX file. The store
+// is then added to the HEX file at the given flash address, which must be
+// unused. For example:
+//
+//   lzsa_overlay -i prog.ihx -M prog.map -a 0xF000 -o prog-ovl.ihx OVL_CALIB:_calib_run OVL_DIAG
+//
+// Each overlay is given by its area name, optionally followed by the symbol of
+// its entry point; by default, the entry point is the start of the area.
+//
+// As the areas all occupy the same addresses, the HEX file has data for each
+// at the same addresses, which is told apart by the order the linker wrote it
+// in. For this to work, each overlay must be compiled from a single source
+// file of its own.
+//
+// Position-independent overlays are taken from binary files, with the entry
+// point at the start. The store is written as a binary file or, with the -c
+// option, as a C source file defining a const array of the given name. For
+// example:
+//
+//   lzsa_overlay -c overlays -o overlays.c selftest.bin
+//
+// Overlay IDs are in the order given. Compression is done by running the LZSA
+// command-line tool, and the compressed data is checked by decompressing it
+// with the reference C implementation.
+//
+// Build with any hosted C99 compiler on a POSIX system, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_overlay lzsa_overlay.c lzsa_cycles.c ../lzsa_ref.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "lzsa_ref.h"
+#include "lzsa_overlay.h"
+#include "lzsa_cycles.h"
+
+#define OVERLAYS_MAX 255
+#define OVERLAY_MAX_LEN 32768
+#define STORE_MAX_LEN 65535
+#define IMAGE_SIZE 0x1000000UL // 24-bit address space of STM8
+#define LINE_MAX_LEN 1024
+#define HEX_RECORD_LEN 16
+
+typedef struct {
+	char name[64];       // Area name or file path
+	char entry[64];      // Entry point symbol, if any
+	uint32_t addr;       // Area address
+	uint32_t entry_addr; // Entry point symbol address
+	bool area_found;
+	bool entry_found;
+	uint8_t *plain;
+	uint8_t *filled;     // Which bytes of area have been read
+	size_t plain_len;
+	uint16_t entry_off;
+	uint8_t *comp;
+	size_t comp_len;
+	size_t offset;
+} overlay_t;
+
+/******************************************************************************/
+
+static const char *lzsa_path = "lzsa";
+static const char *lzsa_opts = ""; // Extra compressor option, e.g. "-m4"
+static bool verbose = false;
+
+static overlay_t overlays[OVERLAYS_MAX];
+static size_t overlay_count = 0;
+
+// Overlays in the order their areas appear in the map file.
+static overlay_t *overlays_by_area[OVERLAYS_MAX];
+static size_t area_count = 0;
+
+static uint8_t *image;
+static uint8_t *image_used;
+
+static uint8_t store[STORE_MAX_LEN];
+
+/******************************************************************************/
+
+static uint8_t * read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if(f == NULL) return NULL;
+	if(fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(size > 0 ? (size_t)size : 1);
+		if(data != NULL && fread(data, 1, (size_t)size, f) == (size_t)size) {
+			*len = (size_t)size;
+		} else {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+
+	return data;
+}
+
+static bool write_file(const char *path, const uint8_t *data, const size_t len) {
+	FILE *f = fopen(path, "wb");
+	bool ok;
+
+	if(f == NULL) return false;
+	ok = (fwrite(data, 1, len, f) == len);
+	if(fclose(f) != 0) ok = false;
+
+	return ok;
+}
+
+static void put16(uint8_t *p, const size_t v) {
+	p[0] = (uint8_t)(v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+/******************************************************************************/
+
+// Find the overlays' areas and entry point symbols in an sdld map file. Area
+// lines give the name, address and size, e.g.:
+//
+//   OVL_CALIB                           00000100    000001A2 =         418. bytes (REL,CON)
+//
+// Symbol lines give the address and name, e.g.:
+//
+//        00000100  _calib_run                         calib
+static bool read_map(const char *path) {
+	char line[LINE_MAX_LEN], name[64];
+	unsigned long addr, size;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		if(sscanf(line, "%63s %lx %lx =", name, &addr, &size) == 3) {
+			for(size_t i = 0; i < overlay_count; i++) {
+				if(!overlays[i].area_found && strcmp(name, overlays[i].name) == 0) {
+					overlays[i].addr = (uint32_t)addr;
+					overlays[i].plain_len = (size_t)size;
+					overlays[i].area_found = true;
+					overlays_by_area[area_count++] = &overlays[i];
+				}
+			}
+		} else if(sscanf(line, "%lx %63s", &addr, name) == 2) {
+			for(size_t i = 0; i < overlay_count; i++) {
+				if(!overlays[i].entry_found && overlays[i].entry[0] != '\0' && strcmp(name, overlays[i].entry) == 0) {
+					overlays[i].entry_addr = (uint32_t)addr;
+					overlays[i].entry_found = true;
+				}
+			}
+		}
+	}
+
+	fclose(f);
+
+	for(size_t i = 0; i < overlay_count; i++) {
+		overlay_t *o = &overlays[i];
+		if(!o->area_found) {
+			fprintf(stderr, "%s: Error: area '%s' not found\n", path, o->name);
+			return false;
+		}
+		if(o->entry[0] == '\0') {
+			o->entry_addr = o->addr;
+		} else if(!o->entry_found) {
+			fprintf(stderr, "%s: Error: symbol '%s' not found\n", path, o->entry);
+			return false;
+		}
+		if(o->entry_addr < o->addr || o->entry_addr >= o->addr + o->plain_len) {
+			fprintf(stderr, "%s: Error: symbol '%s' is not in area '%s'\n", path, o->entry, o->name);
+			return false;
+		}
+		o->entry_off = (uint16_t)(o->entry_addr - o->addr);
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+static int hex_byte(const char *s) {
+	int v = 0;
+	for(int i = 0; i < 2; i++) {
+		const char c = s[i];
+		v <<= 4;
+		if(c >= '0' && c <= '9') v |= c - '0';
+		else if(c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+		else if(c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+		else return -1;
+	}
+	return v;
+}
+
+// Place a byte read from the HEX file. The overlays' areas all occupy the same
+// addresses, so a byte within them belongs to the first overlay (in the order
+// the linker placed the areas, and so wrote their contents) that does not yet
+// have that byte. Anything else is part of the rest of the program.
+static bool place_byte(const uint32_t addr, const uint8_t value) {
+	bool in_area = false;
+
+	for(size_t i = 0; i < area_count; i++) {
+		overlay_t *o = overlays_by_area[i];
+		if(addr < o->addr || addr >= o->addr + o->plain_len) continue;
+		if(!o->filled[addr - o->addr]) {
+			o->plain[addr - o->addr] = value;
+			o->filled[addr - o->addr] = 1;
+			return true;
+		}
+		in_area = true;
+	}
+	if(in_area) {
+		fprintf(stderr, "Error: more data at 0x%06X than overlay areas there\n", addr);
+		return false;
+	}
+
+	image[addr] = value;
+	image_used[addr] = 1;
+
+	return true;
+}
+
+// Read an Intel HEX file, placing its data in the overlays and the image. Data
+// (00), end of file (01) and extended segment/linear address (02/04) records
+// are understood; start address records (03/05) are ignored, as the STM8
+// starts from its reset vector.
+static bool read_hex(const char *path) {
+	char line[LINE_MAX_LEN];
+	uint8_t rec[256 + 5];
+	uint32_t base = 0;
+	unsigned int line_num = 0;
+	bool ok = false;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		size_t len, rec_len;
+		uint8_t sum = 0;
+		uint16_t offset;
+
+		line_num++;
+		len = strcspn(line, "\r\n");
+		if(len == 0) continue;
+		if(line[0] != ':' || len < 11 || (len - 1) % 2 != 0) goto bad_record;
+		rec_len = (len - 1) / 2;
+		for(size_t i = 0; i < rec_len; i++) {
+			const int v = hex_byte(&line[1 + i * 2]);
+			if(v < 0) goto bad_record;
+			rec[i] = (uint8_t)v;
+			sum += rec[i];
+		}
+		if(sum != 0 || rec_len != (size_t)rec[0] + 5) goto bad_record;
+
+		offset = (uint16_t)((rec[1] << 8) | rec[2]);
+		switch(rec[3]) {
+			case 0x00:
+				for(size_t i = 0; i < rec[0]; i++) {
+					if(!place_byte((base + offset + i) % IMAGE_SIZE, rec[4 + i])) goto done;
+				}
+				break;
+			case 0x01:
+				ok = true;
+				goto done;
+			case 0x02:
+				if(rec[0] != 2) goto bad_record;
+				base = (uint32_t)((rec[4] << 8) | rec[5]) << 4;
+				break;
+			case 0x04:
+				if(rec[0] != 2) goto bad_record;
+				base = (uint32_t)((rec[4] << 8) | rec[5]) << 16;
+				break;
+			case 0x03:
+			case 0x05:
+				break;
+			default:
+				goto bad_record;
+		}
+	}
+
+	fprintf(stderr, "%s: Error: missing end of file record\n", path);
+	goto done;
+
+bad_record:
+	fprintf(stderr, "%s:%u: Error: invalid record\n", path, line_num);
+
+done:
+	fclose(f);
+
+	return ok;
+}
+
+static void write_hex_record(FILE *f, const uint8_t type, const uint16_t offset, const uint8_t *data, const uint8_t len) {
+	uint8_t sum = len + (offset >> 8) + (offset & 0xFF) + type;
+
+	fprintf(f, ":%02X%04X%02X", len, offset, type);
+	for(uint8_t i = 0; i < len; i++) {
+		fprintf(f, "%02X", data[i]);
+		sum += data[i];
+	}
+	fprintf(f, "%02X\n", (uint8_t)-sum);
+}
+
+// Write the image as an Intel HEX file, with a record for each run of up to 16
+// used bytes. Runs do not cross a 64K boundary, and an extended linear address
+// record is written before the first run in each 64K segment above the first.
+static bool write_hex(const char *path) {
+	uint32_t segment = 0;
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	for(uint32_t addr = 0; addr < IMAGE_SIZE; ) {
+		uint8_t len = 0;
+
+		if(!image_used[addr]) {
+			addr++;
+			continue;
+		}
+		if((addr >> 16) != segment) {
+			const uint8_t upper[2] = { (uint8_t)(addr >> 24), (uint8_t)(addr >> 16) };
+			segment = addr >> 16;
+			write_hex_record(f, 0x04, 0, upper, 2);
+		}
+		while(len < HEX_RECORD_LEN && image_used[addr + len] && ((addr + len) >> 16) == segment) len++;
+		write_hex_record(f, 0x00, (uint16_t)addr, &image[addr], len);
+		addr += len;
+	}
+	write_hex_record(f, 0x01, 0, NULL, 0);
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+
+static bool write_source(const char *path, const char *name, const size_t len) {
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	fprintf(f, "// Generated by lzsa_overlay. Do not edit.\n\n");
+	fprintf(f, "#include <stdint.h>\n\n");
+	fprintf(f, "// Overlays (ID, decompressed length, compressed length, entry offset):\n");
+	for(size_t i = 0; i < overlay_count; i++) {
+		fprintf(f, "// %3zu %5zu %5zu %5u %s\n", i, overlays[i].plain_len, overlays[i].comp_len, overlays[i].entry_off, overlays[i].name);
+	}
+	fprintf(f, "const uint8_t %s[%zu] = {", name, len);
+	for(size_t i = 0; i < len; i++) {
+		fprintf(f, "%s0x%02x%s", (i % 12 == 0 ? "\n\t" : ""), store[i], (i < len - 1 ? (i % 12 == 11 ? "," : ", ") : ""));
+	}
+	fprintf(f, "\n};\n");
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+// Compress an overlay to a raw LZSA1 block by running the LZSA tool on
+// temporary files, and check it decompresses correctly.
+static bool compress(overlay_t *o) {
+	static uint8_t check[OVERLAY_MAX_LEN + 256];
+	char in_path[64], out_path[64];
+	int wstatus;
+	pid_t pid;
+
+	snprintf(in_path, sizeof(in_path), "lzsa_overlay.%d.in.tmp", (int)getpid());
+	snprintf(out_path, sizeof(out_path), "lzsa_overlay.%d.out.tmp", (int)getpid());
+
+	if(!write_file(in_path, o->plain, o->plain_len)) {
+		perror(in_path);
+		remove(in_path);
+		return false;
+	}
+
+	if(verbose) printf("Compressing %s (%zu bytes)\n", o->name, o->plain_len);
+
+	fflush(stdout);
+	pid = fork();
+	if(pid < 0) {
+		perror("fork");
+		remove(in_path);
+		return false;
+	}
+	if(pid == 0) {
+		if(freopen("/dev/null", "w", stdout) == NULL) _exit(127);
+		if(*lzsa_opts != '\0') {
+			execlp(lzsa_path, lzsa_path, "-f1", "-r", lzsa_opts, in_path, out_path, (char *)NULL);
+		} else {
+			execlp(lzsa_path, lzsa_path, "-f1", "-r", in_path, out_path, (char *)NULL);
+		}
+		_exit(127);
+	}
+
+	o->comp = NULL;
+	if(waitpid(pid, &wstatus, 0) < 0) {
+		perror("waitpid");
+	} else if(!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+		fprintf(stderr, "Error: compressing %s failed (is '%s' the LZSA tool?)\n", o->name, lzsa_path);
+	} else if((o->comp = read_file(out_path, &o->comp_len)) == NULL) {
+		perror(out_path);
+	}
+
+	remove(in_path);
+	remove(out_path);
+
+	if(o->comp == NULL) return false;
+
+	if((size_t)((uint8_t *)lzsa1_decompress_block_ref(check, o->comp) - check) != o->plain_len || memcmp(check, o->plain, o->plain_len) != 0) {
+		fprintf(stderr, "Error: compressed data for %s does not decompress correctly\n", o->name);
+		return false;
+	}
+
+	return true;
+}
+
+// Allocate each overlay's contents, to be filled in from the HEX file. Every
+// area must be at the same (non-zero) address, that of the RAM region.
+static bool alloc_areas(uint16_t *region_addr) {
+	for(size_t i = 0; i < overlay_count; i++) {
+		overlay_t *o = &overlays[i];
+
+		if(o->addr != overlays[0].addr) {
+			fprintf(stderr, "Error: area '%s' is at 0x%06X, not 0x%06X like '%s'\n", o->name, o->addr, overlays[0].addr, overlays[0].name);
+			return false;
+		}
+		if(o->plain_len == 0 || o->plain_len > OVERLAY_MAX_LEN) {
+			fprintf(stderr, "Error: area '%s' must be 1 to %u bytes long\n", o->name, OVERLAY_MAX_LEN);
+			return false;
+		}
+		if((o->plain = malloc(o->plain_len)) == NULL || (o->filled = calloc(o->plain_len, 1)) == NULL) {
+			perror("malloc");
+			return false;
+		}
+	}
+
+	if(overlays[0].addr == 0 || overlays[0].addr > 0xFFFF) {
+		fprintf(stderr, "Error: overlay region address (0x%06X) must be non-zero and within the first 64K\n", overlays[0].addr);
+		return false;
+	}
+	*region_addr = (uint16_t)overlays[0].addr;
+
+	return true;
+}
+
+static bool check_areas(void) {
+	for(size_t i = 0; i < overlay_count; i++) {
+		const overlay_t *o = &overlays[i];
+		for(size_t j = 0; j < o->plain_len; j++) {
+			if(!o->filled[j]) {
+				fprintf(stderr, "Error: area '%s' (0x%06X, %zu bytes) is not all present in program\n", o->name, o->addr, o->plain_len);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] -i <input.ihx> -M <input.map> -a <address> -o <output.ihx> <area>[:<symbol>]...\n", name);
+	fprintf(stderr, "       %s [options] -o <output_file> <file>...\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -c <name>     write C source defining array of given name (files only)\n");
+	fprintf(stderr, "  -l <path>     path to LZSA tool (default %s)\n", lzsa_path);
+	fprintf(stderr, "  -m <option>   extra option to pass to LZSA tool (e.g. -m4)\n");
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+int main(int argc, char *argv[]) {
+	const char *out_path = NULL, *array_name = NULL, *hex_path = NULL, *map_path = NULL;
+	unsigned long store_addr = 0;
+	uint16_t region_addr = 0;
+	size_t len, max_len = 0, total_plain = 0;
+	bool have_addr = false;
+	int opt;
+
+	while((opt = getopt(argc, argv, "o:c:i:M:a:l:m:vh")) != -1) {
+		switch(opt) {
+			case 'o': out_path = optarg; break;
+			case 'c': array_name = optarg; break;
+			case 'i': hex_path = optarg; break;
+			case 'M': map_path = optarg; break;
+			case 'a': store_addr = strtoul(optarg, NULL, 0); have_addr = true; break;
+			case 'l': lzsa_path = optarg; break;
+			case 'm': lzsa_opts = optarg; break;
+			case 'v': verbose = true; break;
+			default: usage(argv[0]); return EXIT_FAILURE;
+		}
+	}
+	if(out_path == NULL || optind >= argc || (hex_path != NULL) != (map_path != NULL) || (hex_path != NULL) != have_addr || (hex_path != NULL && array_name != NULL)) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+	if(argc - optind > OVERLAYS_MAX) {
+		fprintf(stderr, "Error: too many overlays (max. %u)\n", OVERLAYS_MAX);
+		return EXIT_FAILURE;
+	}
+
+	for(; optind < argc; optind++) {
+		overlay_t *o = &overlays[overlay_count++];
+		const char *sep = (hex_path != NULL ? strchr(argv[optind], ':') : NULL);
+		const size_t name_len = (sep != NULL ? (size_t)(sep - argv[optind]) : strlen(argv[optind]));
+
+		if(name_len == 0 || name_len >= sizeof(o->name) || (sep != NULL && (sep[1] == '\0' || strlen(sep + 1) >= sizeof(o->entry)))) {
+			fprintf(stderr, "Error: invalid overlay '%s'\n", argv[optind]);
+			return EXIT_FAILURE;
+		}
+		memcpy(o->name, argv[optind], name_len);
+		o->name[name_len] = '\0';
+		if(sep != NULL) strcpy(o->entry, sep + 1);
+	}
+
+	if(hex_path != NULL) {
+		image = calloc(IMAGE_SIZE, 1);
+		image_used = calloc(IMAGE_SIZE + HEX_RECORD_LEN, 1);
+		if(image == NULL || image_used == NULL) {
+			perror("calloc");
+			return EXIT_FAILURE;
+		}
+		if(!read_map(map_path) || !alloc_areas(&region_addr) || !read_hex(hex_path) || !check_areas()) return EXIT_FAILURE;
+	} else {
+		for(size_t i = 0; i < overlay_count; i++) {
+			overlay_t *o = &overlays[i];
+			if((o->plain = read_file(o->name, &o->plain_len)) == NULL) {
+				fprintf(stderr, "Error: could not read '%s'\n", o->name);
+				return EXIT_FAILURE;
+			}
+			if(o->plain_len == 0 || o->plain_len > OVERLAY_MAX_LEN) {
+				fprintf(stderr, "Error: '%s' must be 1 to %u bytes long\n", o->name, OVERLAY_MAX_LEN);
+				return EXIT_FAILURE;
+			}
+		}
+	}
+
+	// Lay out header, then table, then data in ID order.
+	len = LZSA_OVERLAY_HEADER_LEN + (overlay_count * LZSA_OVERLAY_ENTRY_LEN);
+	for(size_t i = 0; i < overlay_count; i++) {
+		overlay_t *o = &overlays[i];
+		if(!compress(o)) return EXIT_FAILURE;
+		o->offset = len;
+		len += o->comp_len;
+		if(len > STORE_MAX_LEN) {
+			fprintf(stderr, "Error: store too large (max. %u bytes)\n", STORE_MAX_LEN);
+			return EXIT_FAILURE;
+		}
+		if(o->plain_len > max_len) max_len = o->plain_len;
+		total_plain += o->plain_len;
+	}
+
+	memcpy(store, LZSA_OVERLAY_MAGIC, 4);
+	store[4] = LZSA_OVERLAY_VERSION;
+	store[5] = (uint8_t)overlay_count;
+	put16(store + 6, region_addr);
+	put16(store + 8, max_len);
+	for(size_t i = 0; i < overlay_count; i++) {
+		uint8_t *d = store + LZSA_OVERLAY_HEADER_LEN + (i * LZSA_OVERLAY_ENTRY_LEN);
+		put16(d, overlays[i].offset);
+		put16(d + 2, overlays[i].plain_len);
+		put16(d + 4, overlays[i].entry_off);
+		memcpy(store + overlays[i].offset, overlays[i].comp, overlays[i].comp_len);
+	}
+
+	if(hex_path != NULL) {
+		// The store is read through 16-bit data pointers, so must be within the
+		// first 64K, and must not overwrite any of the program.
+		if(store_addr + len > 0x10000) {
+			fprintf(stderr, "Error: store (0x%06lX, %zu bytes) must be within the first 64K\n", store_addr, len);
+			return EXIT_FAILURE;
+		}
+		for(size_t i = 0; i < len; i++) {
+			if(image_used[store_addr + i]) {
+				fprintf(stderr, "Error: store (0x%06lX, %zu bytes) overlaps program at 0x%06lX\n", store_addr, len, store_addr + i);
+				return EXIT_FAILURE;
+			}
+		}
+		memcpy(&image[store_addr], store, len);
+		memset(&image_used[store_addr], 1, len);
+		if(!write_hex(out_path)) return EXIT_FAILURE;
+	} else if(array_name != NULL) {
+		if(!write_source(out_path, array_name, len)) return EXIT_FAILURE;
+	} else if(!write_file(out_path, store, len)) {
+		perror(out_path);
+		return EXIT_FAILURE;
+	}
+
+	for(size_t i = 0; i < overlay_count; i++) {
+		const overlay_t *o = &overlays[i];
+		printf("%3zu %-24s %6zu -> %6zu bytes (%3zu%%), entry +%u, %8lu cycles to load\n", i, o->name, o->plain_len, o->comp_len,
+			(o->comp_len * 100) / o->plain_len, o->entry_off, (unsigned long)predict_lzsa1_cycles(o->comp));
+	}
+	printf("%zu overlays, %zu bytes decompressed, %zu bytes store, region of %zu bytes", overlay_count, total_plain, len, max_len);
+	if(region_addr != 0) printf(" at 0x%04X", region_addr);
+	printf("\n");
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,355 @@
+/*******************************************************************************
+ *
+ * lzsa_patch.c - Delta firmware patch generator
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Makes a patch for updating a device's firmware from an old image to a new
+// one, to be applied with lzsa_patch_init() and lzsa_patch_next(). The new
+// image is split into blocks, and each is compressed with the old image as a
+// dictionary, so anything unchanged (or only moved) becomes back-references
+// into the old image, which the device reads from flash. For example:
+//
+//   lzsa_patch -f 2 -b 1024 -o update.bin fw-1.0.bin fw-1.1.bin
+//
+// An LZSA match offset can reach back at most 65535 bytes, so when the old
+// image is larger than that, each block gets a window of the old image centred
+// on its own position in the new image. Code and data that moved further than
+// half the window are no longer found, so a large change early in a big image
+// makes the rest of the patch larger.
+//
+// The patch is written as a binary file or, with the -c option, as a C source
+// file defining a const array of the given name. Compression is done by running
+// the LZSA command-line tool with its -D (dictionary) option, and every block
+// is checked by decompressing it with the reference C implementation.
+//
+// Build with any hosted C99 compiler on a POSIX system, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_patch lzsa_patch.c ../lzsa_ref.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "lzsa_ref.h"
+#include "lzsa_patch.h"
+
+#define BLOCK_SIZE_DEFAULT 1024
+#define BLOCK_SIZE_MAX 32768
+#define MATCH_OFFSET_MAX 65535
+
+/******************************************************************************/
+
+static const char *lzsa_path = "lzsa";
+static const char *lzsa_opts = ""; // Extra compressor option, e.g. "-m4"
+static bool verbose = false;
+
+static uint8_t *patch;
+static size_t patch_len = 0;
+
+/******************************************************************************/
+
+static uint8_t * read_file(const char *path, size_t *len) {
+	FILE *f = fopen(path, "rb");
+	uint8_t *data = NULL;
+	long size;
+
+	if(f == NULL) return NULL;
+	if(fseek(f, 0, SEEK_END) == 0 && (size = ftell(f)) >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+		data = malloc(size > 0 ? (size_t)size : 1);
+		if(data != NULL && fread(data, 1, (size_t)size, f) == (size_t)size) {
+			*len = (size_t)size;
+		} else {
+			free(data);
+			data = NULL;
+		}
+	}
+	fclose(f);
+
+	return data;
+}
+
+static bool write_file(const char *path, const uint8_t *data, const size_t len) {
+	FILE *f = fopen(path, "wb");
+	bool ok;
+
+	if(f == NULL) return false;
+	ok = (fwrite(data, 1, len, f) == len);
+	if(fclose(f) != 0) ok = false;
+
+	return ok;
+}
+
+static void put16(uint8_t *p, const size_t v) {
+	p[0] = (uint8_t)(v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static void put32(uint8_t *p, const size_t v) {
+	put16(p, (v >> 16) & 0xFFFF);
+	put16(p + 2, v & 0xFFFF);
+}
+
+// CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF).
+static uint16_t crc16(const uint8_t *data, size_t len) {
+	uint16_t crc = 0xFFFF;
+
+	while(len--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for(int i = 0; i < 8; i++) {
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
+
+static bool write_source(const char *path, const char *name, const size_t old_len, const size_t new_len) {
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	fprintf(f, "// Generated by lzsa_patch. Do not edit.\n\n");
+	fprintf(f, "#include <stdint.h>\n\n");
+	fprintf(f, "// Patch from %zu-byte to %zu-byte image.\n", old_len, new_len);
+	fprintf(f, "const uint8_t %s[%zu] = {", name, patch_len);
+	for(size_t i = 0; i < patch_len; i++) {
+		fprintf(f, "%s0x%02x%s", (i % 12 == 0 ? "\n\t" : ""), patch[i], (i < patch_len - 1 ? (i % 12 == 11 ? "," : ", ") : ""));
+	}
+	fprintf(f, "\n};\n");
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+// Choose the part of the old image to use as dictionary for the block at the
+// given offset in the new image, returning its length and setting the offset of
+// its end. The whole window must be within reach of a match from the last byte
+// of the block.
+static size_t choose_window(const size_t old_len, const size_t offset, const size_t block_len, size_t *dict_end) {
+	const size_t window = MATCH_OFFSET_MAX - block_len;
+	size_t end;
+
+	if(old_len <= window) {
+		*dict_end = old_len;
+		return old_len;
+	}
+
+	end = offset + block_len + (window / 2);
+	if(end < window) end = window;
+	if(end > old_len) end = old_len;
+	*dict_end = end;
+
+	return window;
+}
+
+// Compress a block with the given dictionary (which may be empty), appending
+// the compressed data to the patch. Returns its length, or zero on failure.
+static size_t compress(const int format, const uint8_t *block, const size_t block_len, const uint8_t *dict, const size_t dict_len) {
+	static uint8_t check[BLOCK_SIZE_MAX];
+	char in_path[64], out_path[64], dict_path[64], format_opt[8];
+	uint8_t *comp = NULL;
+	size_t comp_len = 0;
+	int wstatus;
+	pid_t pid;
+
+	snprintf(in_path, sizeof(in_path), "lzsa_patch.%d.in.tmp", (int)getpid());
+	snprintf(out_path, sizeof(out_path), "lzsa_patch.%d.out.tmp", (int)getpid());
+	snprintf(dict_path, sizeof(dict_path), "lzsa_patch.%d.dict.tmp", (int)getpid());
+	snprintf(format_opt, sizeof(format_opt), "-f%d", format);
+
+	if(!write_file(in_path, block, block_len) || (dict_len > 0 && !write_file(dict_path, dict, dict_len))) {
+		perror("write_file");
+		remove(in_path);
+		remove(dict_path);
+		return 0;
+	}
+
+	fflush(stdout);
+	pid = fork();
+	if(pid < 0) {
+		perror("fork");
+		remove(in_path);
+		remove(dict_path);
+		return 0;
+	}
+	if(pid == 0) {
+		const char *argv[8];
+		int argc = 0;
+
+		if(freopen("/dev/null", "w", stdout) == NULL) _exit(127);
+		argv[argc++] = lzsa_path;
+		argv[argc++] = format_opt;
+		argv[argc++] = "-r";
+		if(*lzsa_opts != '\0') argv[argc++] = lzsa_opts;
+		if(dict_len > 0) {
+			argv[argc++] = "-D";
+			argv[argc++] = dict_path;
+		}
+		argv[argc++] = in_path;
+		argv[argc++] = out_path;
+		argv[argc] = NULL;
+		execvp(lzsa_path, (char * const *)argv);
+		_exit(127);
+	}
+
+	if(waitpid(pid, &wstatus, 0) < 0) {
+		perror("waitpid");
+	} else if(!WIFEXITED(wstatus) || WEXITSTATUS(wstatus) != 0) {
+		fprintf(stderr, "Error: compressing block failed (is '%s' the LZSA tool?)\n", lzsa_path);
+	} else if((comp = read_file(out_path, &comp_len)) == NULL) {
+		perror(out_path);
+	}
+
+	remove(in_path);
+	remove(out_path);
+	remove(dict_path);
+
+	if(comp == NULL) return 0;
+
+	if(comp_len == 0 || comp_len > 0xFFFF) {
+		fprintf(stderr, "Error: compressed block is too large\n");
+		free(comp);
+		return 0;
+	}
+
+	const uint8_t *end = (format == 1 ?
+		lzsa1_decompress_block_dict_ref(check, comp, dict + dict_len) :
+		lzsa2_decompress_block_dict_ref(check, comp, dict + dict_len));
+	if((size_t)(end - check) != block_len || memcmp(check, block, block_len) != 0) {
+		fprintf(stderr, "Error: compressed block does not decompress correctly\n");
+		free(comp);
+		return 0;
+	}
+
+	memcpy(patch + patch_len, comp, comp_len);
+	patch_len += comp_len;
+	free(comp);
+
+	return comp_len;
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] -o <output_file> <old_image> <new_image>\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -f <1|2>      LZSA format to compress with (default 2)\n");
+	fprintf(stderr, "  -b <size>     block size (1 to %u, default %u)\n", BLOCK_SIZE_MAX, BLOCK_SIZE_DEFAULT);
+	fprintf(stderr, "  -c <name>     write C source defining array of given name\n");
+	fprintf(stderr, "  -l <path>     path to LZSA tool (default %s)\n", lzsa_path);
+	fprintf(stderr, "  -m <option>   extra option to pass to LZSA tool (e.g. -m4)\n");
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+int main(int argc, char *argv[]) {
+	const char *out_path = NULL, *array_name = NULL;
+	uint8_t *old_image, *new_image;
+	size_t old_len, new_len, block_size = BLOCK_SIZE_DEFAULT, blocks = 0;
+	int format = 2, opt;
+
+	while((opt = getopt(argc, argv, "o:c:f:b:l:m:vh")) != -1) {
+		switch(opt) {
+			case 'o': out_path = optarg; break;
+			case 'c': array_name = optarg; break;
+			case 'f': format = atoi(optarg); break;
+			case 'b': block_size = strtoul(optarg, NULL, 0); break;
+			case 'l': lzsa_path = optarg; break;
+			case 'm': lzsa_opts = optarg; break;
+			case 'v': verbose = true; break;
+			default: usage(argv[0]); return EXIT_FAILURE;
+		}
+	}
+	if(out_path == NULL || argc - optind != 2 || (format != 1 && format != 2) || block_size < 1 || block_size > BLOCK_SIZE_MAX) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if((old_image = read_file(argv[optind], &old_len)) == NULL) {
+		fprintf(stderr, "Error: could not read '%s'\n", argv[optind]);
+		return EXIT_FAILURE;
+	}
+	if((new_image = read_file(argv[optind + 1], &new_len)) == NULL) {
+		fprintf(stderr, "Error: could not read '%s'\n", argv[optind + 1]);
+		return EXIT_FAILURE;
+	}
+	if(new_len == 0 || old_len > 0xFFFFFFUL || new_len > 0xFFFFFFUL) {
+		fprintf(stderr, "Error: images must be 1 byte to 16 MB long (new image may not be empty)\n");
+		return EXIT_FAILURE;
+	}
+
+	// Worst case is every block growing a little when compressed.
+	patch = malloc(LZSA_PATCH_HEADER_LEN + new_len + (((new_len / block_size) + 1) * (LZSA_PATCH_RECORD_LEN + 64)));
+	if(patch == NULL) {
+		perror("malloc");
+		return EXIT_FAILURE;
+	}
+
+	memcpy(patch, LZSA_PATCH_MAGIC, 4);
+	patch[4] = LZSA_PATCH_VERSION;
+	patch[5] = (uint8_t)format;
+	put16(patch + 6, block_size);
+	put32(patch + 8, old_len);
+	put32(patch + 12, new_len);
+	put16(patch + 16, crc16(new_image, new_len));
+	patch_len = LZSA_PATCH_HEADER_LEN;
+
+	for(size_t offset = 0; offset < new_len; offset += block_size) {
+		const size_t block_len = (new_len - offset < block_size ? new_len - offset : block_size);
+		const size_t record = patch_len;
+		size_t dict_end, dict_len, comp_len;
+
+		dict_len = choose_window(old_len, offset, block_len, &dict_end);
+		patch_len += LZSA_PATCH_RECORD_LEN;
+		comp_len = compress(format, new_image + offset, block_len, old_image + dict_end - dict_len, dict_len);
+		if(comp_len == 0) return EXIT_FAILURE;
+		put32(patch + record, dict_end);
+		put16(patch + record + 4, comp_len);
+		blocks++;
+
+		if(verbose) printf("Block at 0x%06zX: %5zu -> %5zu bytes, dictionary 0x%06zX-0x%06zX\n", offset, block_len, comp_len, dict_end - dict_len, dict_end);
+	}
+
+	if(array_name != NULL) {
+		if(!write_source(out_path, array_name, old_len, new_len)) return EXIT_FAILURE;
+	} else if(!write_file(out_path, patch, patch_len)) {
+		perror(out_path);
+		return EXIT_FAILURE;
+	}
+
+	printf("%zu blocks, %zu -> %zu bytes image, %zu bytes patch (%zu%% of new image)\n", blocks, old_len, new_len, patch_len, (patch_len * 100) / new_len);
+
+	return EXIT_SUCCESS;
+}
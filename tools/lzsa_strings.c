@@ -0,0 +1,869 @@
+/*******************************************************************************
+ *
+ * lzsa_strings.c - Host tool to build compressed string table
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Builds a compressed string table for printing with lzsa_str_print(). Strings
+// are read from a text file, grouped in order into small blocks, and each
+// block compressed (as a raw LZSA1 or LZSA2 block) so that only the one block
+// containing a string needs to be decompressed to print it. To make up for the
+// loss in compression from using small blocks, all blocks share a dictionary
+// of common substrings, chosen by how much each shrinks the whole table. The
+// dictionary is placed in front of each block when decompressing, so that
+// matches may refer back into it. For example:
+//
+//   lzsa_strings -o strings.c -H strings.h strings.txt
+//
+// Each line of the input gives a string's name (which must be a valid C
+// identifier) and then, after whitespace, its text. Escape sequences '\n',
+// '\r', '\t', '\\' and '\xHH' may be used in the text. Blank lines and lines
+// starting with '#' are ignored. For example:
+//
+//   MENU_MAIN    Main Menu
+//   ERR_SENSOR   Error: sensor not responding.\n
+//
+// The generated header defines an ID for each string, named by the string's
+// name with a prefix (by default 'STR_'), and declares the table.
+//
+// Blocks are compressed by the tool itself, with an optimal parse (for the
+// estimated cost of each sequence) that is feasible only because blocks are
+// small. Every block is checked by decompressing it with the reference C
+// implementation. Building the dictionary compresses every block many times
+// over, so takes some seconds.
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_strings lzsa_strings.c ../lzsa_ref.c
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include "lzsa_ref.h"
+#include "lzsa_str.h"
+
+#define STRINGS_MAX 4096
+#define STRING_MAX_LEN 255
+#define NAME_MAX_LEN 64
+#define LINE_MAX_LEN 1024
+#define BLOCKS_MAX STRINGS_MAX
+#define BLOCK_MAX_LEN 255
+#define DICT_MAX_LEN 1024
+#define COMP_MAX_LEN 1024
+#define DICT_SUBSTR_MIN 4
+#define DICT_SUBSTR_MAX 24
+#define DICT_CANDIDATES 128
+#define BLOCK_TABLE_COST 4 // Bytes of block_offsets and block_first entries
+#define COST_INFINITE UINT32_MAX
+
+typedef struct {
+	char name[NAME_MAX_LEN];
+	uint8_t text[STRING_MAX_LEN];
+	size_t len;
+	unsigned int line;
+} string_t;
+
+typedef struct {
+	size_t first;     // Index of first string
+	size_t count;     // Number of strings
+	size_t plain_len;
+	uint8_t comp[COMP_MAX_LEN];
+	size_t comp_len;
+} block_t;
+
+typedef struct {
+	uint8_t text[DICT_SUBSTR_MAX];
+	size_t len;
+	size_t score;
+} dict_candidate_t;
+
+// A step of a parse: the literals from lit_start up to a match of the given
+// length and offset (or to the end of the block when length is zero).
+typedef struct {
+	uint32_t cost;
+	uint16_t prev;
+	uint16_t lit_start;
+	uint16_t match_len;
+	uint16_t match_off;
+	uint16_t rep_off; // Offset of the match ending here, for a repeat match
+} parse_node_t;
+
+/******************************************************************************/
+
+static const char *prefix = "STR_";
+static uint8_t format = LZSA_STR_FORMAT_LZSA2;
+static size_t block_max = 255;
+static size_t dict_max = 128;
+static bool verbose = false;
+
+static string_t strings[STRINGS_MAX];
+static size_t string_count = 0;
+static block_t blocks[BLOCKS_MAX];
+static size_t block_count = 0;
+static uint8_t dict[DICT_MAX_LEN];
+static size_t dict_len = 0;
+
+/******************************************************************************/
+
+static bool is_identifier(const char *s) {
+	if(!isalpha((unsigned char)*s) && *s != '_') return false;
+	while(*++s) {
+		if(!isalnum((unsigned char)*s) && *s != '_') return false;
+	}
+	return true;
+}
+
+static int hex_digit(const char c) {
+	if(c >= '0' && c <= '9') return c - '0';
+	if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+	if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+	return -1;
+}
+
+// Parse text with escape sequences into a string's data. Returns false if
+// there is a bad escape sequence or the text is too long.
+static bool parse_text(const char *text, string_t *s) {
+	s->len = 0;
+
+	while(*text) {
+		uint8_t c = (uint8_t)*text++;
+		if(c == '\\') {
+			switch(*text++) {
+				case 'n': c = '\n'; break;
+				case 'r': c = '\r'; break;
+				case 't': c = '\t'; break;
+				case '\\': c = '\\'; break;
+				case 'x':
+					if(hex_digit(text[0]) < 0 || hex_digit(text[1]) < 0) return false;
+					c = (uint8_t)((hex_digit(text[0]) << 4) | hex_digit(text[1]));
+					text += 2;
+					break;
+				default: return false;
+			}
+		}
+		if(s->len >= STRING_MAX_LEN) return false;
+		s->text[s->len++] = c;
+	}
+
+	return true;
+}
+
+static bool read_strings(const char *path) {
+	char line[LINE_MAX_LEN], *name, *text, *end;
+	unsigned int line_num = 0;
+	FILE *f = fopen(path, "r");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	while(fgets(line, sizeof(line), f) != NULL) {
+		string_t *s;
+
+		line_num++;
+		line[strcspn(line, "\r\n")] = '\0';
+		name = line + strspn(line, " \t");
+		if(*name == '\0' || *name == '#') continue;
+
+		text = name + strcspn(name, " \t");
+		if(*text != '\0') *text++ = '\0';
+		text += strspn(text, " \t");
+		end = text + strlen(text);
+		while(end > text && (end[-1] == ' ' || end[-1] == '\t')) *--end = '\0';
+
+		if(string_count >= STRINGS_MAX) {
+			fprintf(stderr, "%s:%u: Error: too many strings (max. %u)\n", path, line_num, STRINGS_MAX);
+			fclose(f);
+			return false;
+		}
+		s = &strings[string_count];
+		if(!is_identifier(name) || strlen(name) >= NAME_MAX_LEN) {
+			fprintf(stderr, "%s:%u: Error: invalid name '%s'\n", path, line_num, name);
+			fclose(f);
+			return false;
+		}
+		for(size_t i = 0; i < string_count; i++) {
+			if(strcmp(strings[i].name, name) == 0) {
+				fprintf(stderr, "%s:%u: Error: duplicate name '%s' (first on line %u)\n", path, line_num, name, strings[i].line);
+				fclose(f);
+				return false;
+			}
+		}
+		if(!parse_text(text, s) || s->len > block_max) {
+			fprintf(stderr, "%s:%u: Error: bad escape sequence, or text longer than block size (%zu)\n", path, line_num, block_max);
+			fclose(f);
+			return false;
+		}
+		strcpy(s->name, name);
+		s->line = line_num;
+		string_count++;
+	}
+
+	fclose(f);
+
+	if(string_count == 0) {
+		fprintf(stderr, "%s: Error: no strings\n", path);
+		return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+static uint32_t lit_len_cost(const size_t len) {
+	if(format == LZSA_STR_FORMAT_LZSA1) {
+		if(len < 7) return 0;
+		if(len < 256) return 8;
+		if(len < 512) return 16;
+		return 24;
+	} else {
+		if(len < 3) return 0;
+		if(len < 18) return 4;
+		if(len < 256) return 12;
+		return 28;
+	}
+}
+
+// Cost of a match, where a repeat match (LZSA2 only) is one whose offset is
+// the same as the previous match's, so the offset need not be given again.
+static uint32_t match_cost(const size_t off, const size_t len, const bool rep) {
+	if(format == LZSA_STR_FORMAT_LZSA1) {
+		uint32_t cost = (off <= 256 ? 8 : 16);
+		if(len >= 18) cost += (len < 256 ? 8 : (len < 512 ? 16 : 24));
+		return cost;
+	} else {
+		uint32_t cost = (rep ? 0 : (off <= 32 ? 4 : (off <= 512 ? 8 : (off <= 8704 ? 12 : 16))));
+		if(len >= 9) cost += (len < 24 ? 4 : (len < 256 ? 12 : 28));
+		return cost;
+	}
+}
+
+static uint32_t eod_cost(void) {
+	return (format == LZSA_STR_FORMAT_LZSA1 ? 32 : 12);
+}
+
+// Emit helpers for encoding a block. Nibbles are for LZSA2 only.
+typedef struct {
+	uint8_t *out;
+	size_t len;
+	ptrdiff_t nibble_pos;
+} writer_t;
+
+static void emit(writer_t *w, const uint8_t b) {
+	w->out[w->len++] = b;
+}
+
+static void emit_nibble(writer_t *w, const uint8_t n) {
+	if(w->nibble_pos >= 0) {
+		w->out[w->nibble_pos] |= (n & 0x0F);
+		w->nibble_pos = -1;
+	} else {
+		w->nibble_pos = (ptrdiff_t)w->len;
+		emit(w, (uint8_t)(n << 4));
+	}
+}
+
+static void encode_lzsa1_seq(writer_t *w, const uint8_t *lits, const size_t lit_len, const size_t off, const size_t match_len) {
+	const uint16_t neg_off = (uint16_t)-(int)(off ? off : 1);
+	const bool eod = (match_len == 0);
+	const bool long_off = (!eod && off > 256);
+	uint8_t token = (long_off ? 0x80 : 0x00);
+
+	token |= (lit_len < 7 ? lit_len : 7) << 4;
+	token |= (!eod && match_len < 18 ? match_len - 3 : 15);
+	emit(w, token);
+	if(lit_len >= 7) {
+		if(lit_len < 256) {
+			emit(w, (uint8_t)(lit_len - 7));
+		} else if(lit_len < 512) {
+			emit(w, 250);
+			emit(w, (uint8_t)(lit_len - 256));
+		} else {
+			emit(w, 249);
+			emit(w, (uint8_t)lit_len);
+			emit(w, (uint8_t)(lit_len >> 8));
+		}
+	}
+	for(size_t i = 0; i < lit_len; i++) emit(w, lits[i]);
+	emit(w, (uint8_t)neg_off);
+	if(long_off) emit(w, (uint8_t)(neg_off >> 8));
+	if(eod) {
+		emit(w, 238);
+		emit(w, 0);
+		emit(w, 0);
+	} else if(match_len >= 18) {
+		if(match_len < 256) {
+			emit(w, (uint8_t)(match_len - 18));
+		} else if(match_len < 512) {
+			emit(w, 239);
+			emit(w, (uint8_t)(match_len - 256));
+		} else {
+			emit(w, 238);
+			emit(w, (uint8_t)match_len);
+			emit(w, (uint8_t)(match_len >> 8));
+		}
+	}
+}
+
+static void encode_lzsa2_seq(writer_t *w, const uint8_t *lits, const size_t lit_len, const size_t off, const size_t match_len, size_t *prev_off) {
+	const uint16_t neg_off = (uint16_t)-(int)off;
+	const bool eod = (match_len == 0);
+	const bool rep = (eod || off == *prev_off);
+	uint8_t token = 0;
+
+	token |= (lit_len < 3 ? lit_len : 3) << 3;
+	token |= (!eod && match_len < 9 ? match_len - 2 : 7);
+	if(rep) {
+		token |= 0xE0;
+	} else if(off <= 32) {
+		token |= 0x00 | ((neg_off & 0x01) ? 0x00 : 0x20);
+	} else if(off <= 512) {
+		token |= 0x40 | ((neg_off & 0x100) ? 0x00 : 0x20);
+	} else if(off <= 8704) {
+		token |= 0x80 | (((uint16_t)(neg_off + 512) & 0x100) ? 0x00 : 0x20);
+	} else {
+		token |= 0xC0;
+	}
+	emit(w, token);
+
+	if(lit_len >= 3) {
+		if(lit_len < 18) {
+			emit_nibble(w, (uint8_t)(lit_len - 3));
+		} else if(lit_len < 256) {
+			emit_nibble(w, 15);
+			emit(w, (uint8_t)(lit_len - 18));
+		} else {
+			emit_nibble(w, 15);
+			emit(w, 239);
+			emit(w, (uint8_t)lit_len);
+			emit(w, (uint8_t)(lit_len >> 8));
+		}
+	}
+	for(size_t i = 0; i < lit_len; i++) emit(w, lits[i]);
+
+	if(!rep) {
+		if(off <= 32) {
+			emit_nibble(w, (neg_off >> 1) & 0x0F);
+		} else if(off <= 512) {
+			emit(w, (uint8_t)neg_off);
+		} else if(off <= 8704) {
+			emit_nibble(w, ((uint16_t)(neg_off + 512) >> 9) & 0x0F);
+			emit(w, (uint8_t)(neg_off + 512));
+		} else {
+			emit(w, (uint8_t)(neg_off >> 8));
+			emit(w, (uint8_t)neg_off);
+		}
+		*prev_off = off;
+	}
+
+	if(eod) {
+		emit_nibble(w, 15);
+		emit(w, 232);
+	} else if(match_len >= 9) {
+		if(match_len < 24) {
+			emit_nibble(w, (uint8_t)(match_len - 9));
+		} else if(match_len < 256) {
+			emit_nibble(w, 15);
+			emit(w, (uint8_t)(match_len - 24));
+		} else {
+			emit_nibble(w, 15);
+			emit(w, 233);
+			emit(w, (uint8_t)match_len);
+			emit(w, (uint8_t)(match_len >> 8));
+		}
+	}
+}
+
+static void set_node(parse_node_t *node, const uint32_t cost, const size_t lit_start, const size_t match_len, const size_t match_off) {
+	node->cost = cost;
+	node->prev = (uint16_t)lit_start;
+	node->lit_start = (uint16_t)lit_start;
+	node->match_len = (uint16_t)match_len;
+	node->match_off = (uint16_t)match_off;
+	node->rep_off = (uint16_t)match_off;
+}
+
+// Compress a block of data that follows the dictionary in the window. Finds
+// the cheapest parse, where each step is a literal run followed by a match,
+// by dynamic programming over the positions at which a step can end. For each
+// match length, only the nearest match is considered, as that has the
+// cheapest offset. With LZSA2, a match at the same offset as the one before
+// it in the cheapest parse so far is also considered, as a repeat match needs
+// no offset at all.
+static size_t compress_block(const uint8_t *window, const size_t start, const size_t len, uint8_t *out) {
+	static parse_node_t nodes[BLOCK_MAX_LEN + 1];
+	static uint16_t best_off[BLOCK_MAX_LEN + 1][BLOCK_MAX_LEN + 1];
+	static uint16_t max_len[BLOCK_MAX_LEN + 1];
+	static size_t path[BLOCK_MAX_LEN + 1];
+	const size_t min_match = (format == LZSA_STR_FORMAT_LZSA1 ? 3 : 2);
+	const bool is_lzsa2 = (format == LZSA_STR_FORMAT_LZSA2);
+	const uint8_t *data = window + start;
+	uint32_t end_cost = COST_INFINITE;
+	size_t end_from = 0, path_len = 0, prev_off = 0;
+	writer_t w = { .out = out, .len = 0, .nibble_pos = -1 };
+
+	// Find the nearest match of each length at each position. Matches may
+	// overlap the position being matched, as the decoder copies bytes forwards.
+	for(size_t k = 0; k < len; k++) {
+		max_len[k] = 0;
+		for(size_t j = start + k; j-- > 0; ) {
+			size_t l = 0;
+			while(k + l < len && window[j + l] == data[k + l]) l++;
+			for(size_t m = max_len[k] + 1; m <= l; m++) best_off[k][m] = (uint16_t)(start + k - j);
+			if(l > max_len[k]) max_len[k] = (uint16_t)l;
+		}
+	}
+
+	for(size_t p = 0; p <= len; p++) nodes[p].cost = COST_INFINITE;
+	nodes[0].cost = 0;
+	nodes[0].rep_off = 0;
+
+	for(size_t p = 0; p <= len; p++) {
+		if(nodes[p].cost == COST_INFINITE) continue;
+
+		// Finish the block with literals from here.
+		uint32_t cost = nodes[p].cost + 8 + lit_len_cost(len - p) + ((len - p) * 8) + eod_cost();
+		if(cost < end_cost) {
+			end_cost = cost;
+			end_from = p;
+		}
+
+		for(size_t k = p; k < len; k++) {
+			const uint32_t lit_cost = nodes[p].cost + 8 + lit_len_cost(k - p) + ((k - p) * 8);
+			for(size_t m = min_match; m <= max_len[k]; m++) {
+				cost = lit_cost + match_cost(best_off[k][m], m, (is_lzsa2 && best_off[k][m] == nodes[p].rep_off));
+				if(cost < nodes[k + m].cost) set_node(&nodes[k + m], cost, p, m, best_off[k][m]);
+			}
+
+			if(is_lzsa2 && nodes[p].rep_off != 0 && nodes[p].rep_off <= start + k) {
+				const size_t off = nodes[p].rep_off;
+				size_t l = 0;
+				while(k + l < len && window[start + k - off + l] == data[k + l]) l++;
+				for(size_t m = min_match; m <= l; m++) {
+					cost = lit_cost + match_cost(off, m, true);
+					if(cost < nodes[k + m].cost) set_node(&nodes[k + m], cost, p, m, off);
+				}
+			}
+		}
+	}
+
+	// Walk back from the end to recover the steps, then encode them in order.
+	for(size_t p = end_from; p > 0; p = nodes[p].prev) path[path_len++] = p;
+	while(path_len > 0) {
+		const parse_node_t *n = &nodes[path[--path_len]];
+		const size_t match_start = path[path_len] - n->match_len;
+		if(format == LZSA_STR_FORMAT_LZSA1) {
+			encode_lzsa1_seq(&w, data + n->lit_start, match_start - n->lit_start, n->match_off, n->match_len);
+		} else {
+			encode_lzsa2_seq(&w, data + n->lit_start, match_start - n->lit_start, n->match_off, n->match_len, &prev_off);
+		}
+	}
+	if(format == LZSA_STR_FORMAT_LZSA1) {
+		encode_lzsa1_seq(&w, data + end_from, len - end_from, 0, 0);
+	} else {
+		encode_lzsa2_seq(&w, data + end_from, len - end_from, 0, 0, &prev_off);
+	}
+
+	return w.len;
+}
+
+/******************************************************************************/
+
+// Total size of the dictionary plus every block compressed with it, with
+// strings grouped greedily into blocks of at most the maximum length. Used
+// to judge which substrings are worth adding to the dictionary.
+static size_t table_size(const uint8_t *d, const size_t d_len) {
+	static uint8_t window[DICT_MAX_LEN + BLOCK_MAX_LEN];
+	static uint8_t comp[COMP_MAX_LEN];
+	size_t total = d_len, len = 0;
+
+	memcpy(window, d, d_len);
+	for(size_t i = 0; i < string_count; i++) {
+		if(len + strings[i].len > block_max) {
+			total += compress_block(window, d_len, len, comp);
+			len = 0;
+		}
+		memcpy(window + d_len + len, strings[i].text, strings[i].len);
+		len += strings[i].len;
+	}
+
+	return total + compress_block(window, d_len, len, comp);
+}
+
+// Add a substring to the list of dictionary candidates, which holds only the
+// highest scoring, in descending order of score. A substring already in the
+// list is not added again.
+static void add_candidate(dict_candidate_t *cands, size_t *count, const uint8_t *text, const size_t len, const size_t score) {
+	size_t i;
+
+	for(i = 0; i < *count; i++) {
+		if(cands[i].len == len && memcmp(cands[i].text, text, len) == 0) return;
+	}
+	if(*count < DICT_CANDIDATES) {
+		(*count)++;
+	} else if(score <= cands[DICT_CANDIDATES - 1].score) {
+		return;
+	}
+	for(i = *count - 1; i > 0 && cands[i - 1].score < score; i--) cands[i] = cands[i - 1];
+	memcpy(cands[i].text, text, len);
+	cands[i].len = len;
+	cands[i].score = score;
+}
+
+// Build the dictionary a substring at a time. Each time, the substrings that
+// occur in the most strings, weighted by their length, are candidates, and
+// the one that most reduces the size of the whole table (by compressing every
+// block with it added) is chosen. Every occurrence of it is then blanked out
+// so that its parts are not candidates again. Building stops when no
+// candidate makes the table smaller, or the dictionary is full. Substrings
+// chosen first are the most valuable, so are kept at the end of the
+// dictionary, nearest to the block data, where they are reachable with the
+// shortest offsets.
+static void build_dictionary(void) {
+	static uint8_t text[STRINGS_MAX][STRING_MAX_LEN];
+	static bool used[STRINGS_MAX][STRING_MAX_LEN];
+	static dict_candidate_t cands[DICT_CANDIDATES];
+	static uint8_t trial[DICT_MAX_LEN];
+	size_t best_size;
+
+	for(size_t i = 0; i < string_count; i++) {
+		memcpy(text[i], strings[i].text, strings[i].len);
+		memset(used[i], 0, sizeof(used[i]));
+	}
+
+	dict_len = 0;
+	best_size = table_size(dict, dict_len);
+
+	while(dict_len + DICT_SUBSTR_MIN <= dict_max) {
+		const dict_candidate_t *best = NULL;
+		size_t cand_count = 0;
+
+		for(size_t i = 0; i < string_count; i++) {
+			for(size_t p = 0; p < strings[i].len; p++) {
+				for(size_t len = DICT_SUBSTR_MIN; len <= DICT_SUBSTR_MAX && p + len <= strings[i].len && dict_len + len <= dict_max; len++) {
+					size_t count = 0;
+					if(used[i][p + len - 1]) break;
+
+					// Count the occurrences of the substring (including this
+					// one) in parts of strings not already covered.
+					for(size_t j = 0; j < string_count; j++) {
+						for(size_t q = 0; q + len <= strings[j].len; q++) {
+							if(memcmp(text[j] + q, text[i] + p, len) == 0) {
+								bool clear = true;
+								for(size_t k = q; k < q + len && clear; k++) clear = !used[j][k];
+								if(clear) {
+									count++;
+									q += len - 1;
+								}
+							}
+						}
+					}
+
+					// Each use saves roughly the substring's length, less the
+					// cost of a match, and the substring costs its length in
+					// the dictionary.
+					if(count < 2) break;
+					if(count * (len - 2) <= len) continue;
+					add_candidate(cands, &cand_count, text[i] + p, len, (count * (len - 2)) - len);
+				}
+			}
+		}
+
+		// Try each candidate in front of the dictionary so far.
+		for(size_t c = 0; c < cand_count; c++) {
+			size_t size;
+			memcpy(trial, cands[c].text, cands[c].len);
+			memcpy(trial + cands[c].len, dict, dict_len);
+			size = table_size(trial, cands[c].len + dict_len);
+			if(size < best_size) {
+				best_size = size;
+				best = &cands[c];
+			}
+		}
+
+		if(best == NULL) break;
+
+		memmove(dict + best->len, dict, dict_len);
+		memcpy(dict, best->text, best->len);
+		dict_len += best->len;
+		for(size_t j = 0; j < string_count; j++) {
+			for(size_t q = 0; q + best->len <= strings[j].len; q++) {
+				if(memcmp(text[j] + q, best->text, best->len) == 0) {
+					for(size_t k = q; k < q + best->len; k++) used[j][k] = true;
+				}
+			}
+		}
+		if(verbose) printf("Dictionary: \"%.*s\" (table %zu bytes)\n", (int)best->len, (const char *)best->text, best_size);
+	}
+}
+
+// Group strings in order into blocks of at most the maximum length, then
+// compress each block and check it decompresses correctly. Where each block
+// starts is chosen by dynamic programming, working back from the last string,
+// so that the compressed blocks plus their entries in the block tables take
+// the least space.
+static bool build_blocks(void) {
+	static uint8_t window[DICT_MAX_LEN + BLOCK_MAX_LEN];
+	static uint8_t check[DICT_MAX_LEN + (BLOCK_MAX_LEN * 4)];
+	static uint8_t comp[COMP_MAX_LEN];
+	static size_t size[STRINGS_MAX + 1];
+	static size_t next[STRINGS_MAX + 1];
+
+	memcpy(window, dict, dict_len);
+	memcpy(check, dict, dict_len);
+
+	// Find the smallest size of the strings from each one onwards, and where
+	// the next block after the one starting with it begins.
+	size[string_count] = 0;
+	for(size_t i = string_count; i-- > 0; ) {
+		size_t len = 0;
+		size[i] = SIZE_MAX;
+		for(size_t j = i; j < string_count && len + strings[j].len <= block_max; j++) {
+			size_t s;
+			memcpy(window + dict_len + len, strings[j].text, strings[j].len);
+			len += strings[j].len;
+			s = compress_block(window, dict_len, len, comp) + BLOCK_TABLE_COST + size[j + 1];
+			if(s < size[i]) {
+				size[i] = s;
+				next[i] = j + 1;
+			}
+		}
+	}
+
+	for(size_t i = 0; i < string_count; i = next[i]) {
+		block_t *b = &blocks[block_count++];
+		b->first = i;
+		b->count = next[i] - i;
+		b->plain_len = 0;
+		for(size_t j = i; j < next[i]; j++) {
+			memcpy(window + dict_len + b->plain_len, strings[j].text, strings[j].len);
+			b->plain_len += strings[j].len;
+		}
+
+		b->comp_len = compress_block(window, dict_len, b->plain_len, b->comp);
+
+		uint8_t *end = (format == LZSA_STR_FORMAT_LZSA1 ? lzsa1_decompress_block_ref(check + dict_len, b->comp) : lzsa2_decompress_block_ref(check + dict_len, b->comp));
+		if(end != check + dict_len + b->plain_len || memcmp(check + dict_len, window + dict_len, b->plain_len) != 0) {
+			fprintf(stderr, "Error: block %zu failed to verify\n", block_count - 1);
+			return false;
+		}
+		if(verbose) printf("Block %zu: strings %zu-%zu, %zu -> %zu bytes\n", block_count - 1, b->first, b->first + b->count - 1, b->plain_len, b->comp_len);
+	}
+
+	return true;
+}
+
+static void make_guard(char *guard, const size_t size, const char *path) {
+	const char *base = strrchr(path, '/');
+	size_t i = 0;
+
+	for(base = (base != NULL ? base + 1 : path); *base && i < size - 2; base++) {
+		guard[i++] = (isalnum((unsigned char)*base) ? (char)toupper((unsigned char)*base) : '_');
+	}
+	guard[i++] = '_';
+	guard[i] = '\0';
+}
+
+static bool write_header(const char *path, const char *name) {
+	char guard[NAME_MAX_LEN + 2], upper_name[NAME_MAX_LEN];
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	make_guard(guard, sizeof(guard), path);
+	for(size_t i = 0; i < sizeof(upper_name); i++) {
+		upper_name[i] = (char)toupper((unsigned char)name[i]);
+		if(name[i] == '\0') break;
+	}
+	fprintf(f, "// Generated by lzsa_strings. Do not edit.\n\n");
+	fprintf(f, "#ifndef %s\n#define %s\n\n", guard, guard);
+	fprintf(f, "#include \"lzsa_str.h\"\n\n");
+	for(size_t i = 0; i < string_count; i++) {
+		fprintf(f, "#define %s%s %zu\n", prefix, strings[i].name, i);
+	}
+	fprintf(f, "\n#define %s_COUNT %zu\n\n", upper_name, string_count);
+	fprintf(f, "extern const lzsa_str_table_t %s;\n\n", name);
+	fprintf(f, "#endif // %s\n", guard);
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+static void write_array(FILE *f, const uint8_t *data, const size_t len) {
+	for(size_t i = 0; i < len; i++) {
+		fprintf(f, "%s0x%02x%s", (i % 12 == 0 ? "\n\t" : ""), data[i], (i < len - 1 ? (i % 12 == 11 ? "," : ", ") : ""));
+	}
+}
+
+static bool write_source(const char *path, const char *header_path, const char *name, const size_t window_len) {
+	const char *header_base = strrchr(header_path, '/');
+	size_t data_len = 0;
+	FILE *f = fopen(path, "w");
+
+	if(f == NULL) {
+		perror(path);
+		return false;
+	}
+
+	fprintf(f, "// Generated by lzsa_strings. Do not edit.\n\n");
+	fprintf(f, "#include <stddef.h>\n#include <stdint.h>\n#include \"lzsa_str.h\"\n#include \"%s\"\n\n", (header_base != NULL ? header_base + 1 : header_path));
+	fprintf(f, "#if LZSA_STR_WINDOW_LEN < %zu\n", window_len);
+	fprintf(f, "#error \"LZSA_STR_WINDOW_LEN must be at least %zu for this string table\"\n", window_len);
+	fprintf(f, "#endif\n\n");
+
+	fprintf(f, "static const uint8_t %s_dict[%zu] = {", name, (dict_len > 0 ? dict_len : 1));
+	write_array(f, dict, dict_len);
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "static const uint8_t %s_data[] = {", name);
+	for(size_t i = 0; i < block_count; i++) {
+		fprintf(f, "\n\t// Block %zu (strings %zu-%zu)", i, blocks[i].first, blocks[i].first + blocks[i].count - 1);
+		write_array(f, blocks[i].comp, blocks[i].comp_len);
+		if(i < block_count - 1) fprintf(f, ",");
+	}
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "static const uint16_t %s_block_offsets[%zu] = {", name, block_count);
+	for(size_t i = 0; i < block_count; i++) {
+		fprintf(f, "%s%zu%s", (i % 8 == 0 ? "\n\t" : ""), data_len, (i < block_count - 1 ? (i % 8 == 7 ? "," : ", ") : ""));
+		data_len += blocks[i].comp_len;
+	}
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "static const uint16_t %s_block_first[%zu] = {", name, block_count);
+	for(size_t i = 0; i < block_count; i++) {
+		fprintf(f, "%s%zu%s", (i % 8 == 0 ? "\n\t" : ""), blocks[i].first, (i < block_count - 1 ? (i % 8 == 7 ? "," : ", ") : ""));
+	}
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "static const uint8_t %s_ends[%zu] = {", name, string_count);
+	for(size_t i = 0, b = 0, pos = 0; i < string_count; i++) {
+		if(i == blocks[b].first + blocks[b].count) {
+			b++;
+			pos = 0;
+		}
+		pos += strings[i].len;
+		fprintf(f, "%s%zu%s", (i % 12 == 0 ? "\n\t" : ""), pos, (i < string_count - 1 ? (i % 12 == 11 ? "," : ", ") : ""));
+	}
+	fprintf(f, "\n};\n\n");
+
+	fprintf(f, "const lzsa_str_table_t %s = {\n", name);
+	fprintf(f, "\t.format = %u,\n", format);
+	fprintf(f, "\t.dict = %s_dict,\n", name);
+	fprintf(f, "\t.dict_len = %zu,\n", dict_len);
+	fprintf(f, "\t.data = %s_data,\n", name);
+	fprintf(f, "\t.block_offsets = %s_block_offsets,\n", name);
+	fprintf(f, "\t.block_first = %s_block_first,\n", name);
+	fprintf(f, "\t.block_count = %zu,\n", block_count);
+	fprintf(f, "\t.ends = %s_ends,\n", name);
+	fprintf(f, "\t.count = %zu,\n", string_count);
+	fprintf(f, "};\n");
+
+	if(fclose(f) != 0) {
+		perror(path);
+		return false;
+	}
+
+	return true;
+}
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] -o <output.c> -H <output.h> <input>\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -n <name>     name of table (default strings)\n");
+	fprintf(stderr, "  -p <prefix>   prefix for string IDs (default %s)\n", prefix);
+	fprintf(stderr, "  -f <1|2>      compress with LZSA1 or LZSA2 (default 2)\n");
+	fprintf(stderr, "  -b <bytes>    maximum block length, 1-%u (default %zu)\n", BLOCK_MAX_LEN, block_max);
+	fprintf(stderr, "  -d <bytes>    maximum dictionary length, 0-%u (default %zu)\n", DICT_MAX_LEN, dict_max);
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+int main(int argc, char *argv[]) {
+	const char *out_path = NULL, *header_path = NULL, *name = "strings", *in_path = NULL;
+	size_t plain_total = 0, comp_total, window_len = 0;
+
+	for(int i = 1; i < argc; i++) {
+		const char *arg = argv[i];
+		if(arg[0] == '-' && arg[1] != '\0' && arg[2] == '\0' && strchr("oHnpfbd", arg[1]) != NULL && i + 1 < argc) {
+			const char *val = argv[++i];
+			switch(arg[1]) {
+				case 'o': out_path = val; break;
+				case 'H': header_path = val; break;
+				case 'n': name = val; break;
+				case 'p': prefix = val; break;
+				case 'f': format = (uint8_t)strtoul(val, NULL, 0); break;
+				case 'b': block_max = strtoul(val, NULL, 0); break;
+				case 'd': dict_max = strtoul(val, NULL, 0); break;
+			}
+		} else if(strcmp(arg, "-v") == 0) {
+			verbose = true;
+		} else if(arg[0] != '-' && in_path == NULL) {
+			in_path = arg;
+		} else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if(in_path == NULL || out_path == NULL || header_path == NULL || !is_identifier(name) || strlen(name) >= NAME_MAX_LEN ||
+		(format != LZSA_STR_FORMAT_LZSA1 && format != LZSA_STR_FORMAT_LZSA2) ||
+		block_max < 1 || block_max > BLOCK_MAX_LEN || dict_max > DICT_MAX_LEN
+	) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if(!read_strings(in_path)) return EXIT_FAILURE;
+	build_dictionary();
+	if(!build_blocks()) return EXIT_FAILURE;
+
+	// Compare against the strings stored plainly as NUL-terminated arrays with
+	// a table of pointers to them.
+	comp_total = dict_len + (block_count * 4) + string_count;
+	for(size_t i = 0; i < block_count; i++) {
+		comp_total += blocks[i].comp_len;
+		if(dict_len + blocks[i].plain_len > window_len) window_len = dict_len + blocks[i].plain_len;
+	}
+	for(size_t i = 0; i < string_count; i++) plain_total += strings[i].len + 1 + 2;
+
+	if(!write_header(header_path, name) || !write_source(out_path, header_path, name, window_len)) return EXIT_FAILURE;
+
+	printf("%zu strings in %zu blocks, dictionary %zu bytes, window %zu bytes\n", string_count, block_count, dict_len, window_len);
+	printf("%zu bytes plain (with terminators and pointers) -> %zu bytes compressed (%zu%%)\n", plain_total, comp_total, (comp_total * 100) / plain_total);
+
+	return EXIT_SUCCESS;
+}
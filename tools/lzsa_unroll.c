@@ -0,0 +1,653 @@
+/*******************************************************************************
+ *
+ * lzsa_unroll.c - Host tool to generate straight-line decompression code for
+ *                 a single LZSA block
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Generates an STM8 assembly routine that writes out the decompressed data of
+// one raw LZSA1 or LZSA2 block, for a hot asset that is decompressed often
+// enough that the time spent parsing it matters more than flash, e.g.:
+//
+//   lzsa -f1 -r font.bin font.lzsa1
+//   lzsa_unroll -f 1 -n font_unpack -o font_unpack.s font.lzsa1
+//
+// The routine is declared as:
+//
+//   void * font_unpack(void *dst) __stack_args;
+//
+// and returns the same as lzsa1_decompress_block() would. It is assembled like
+// the library sources, with the prefix file for the memory model, e.g.:
+//
+//   sdasstm8 -ff -w -l -p -o font_unpack.rel lzsa_large.s font_unpack.s
+//
+// Nothing is parsed at run time. Literals, and matches no longer than the
+// match limit (as their contents are known anyway), are written as immediate
+// byte or word stores relative to the destination pointer. Longer matches are
+// copied by a short loop, which keeps the code from growing with them, or when
+// they repeat every one or two bytes, filled by one of word stores.
+//
+// If the generated code would be larger than the size limit, a routine is
+// generated instead that calls lzsa1_decompress_block() or
+// lzsa2_decompress_block() with the compressed block, which it includes, so
+// that callers need not change.
+//
+// Code size and cycle counts (per the STM8 programming manual, for the medium
+// memory model, and including the call and return) are reported against the
+// size of the block and the cycles predicted for the general routine.
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_unroll lzsa_unroll.c lzsa_cycles.c ../lzsa_ref.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include "lzsa_ref.h"
+#include "lzsa_cycles.h"
+
+#define BLOCK_MAX 65536
+#define PLAIN_MAX 65535
+
+#define MATCH_MAX_DEFAULT 16
+#define SIZE_MAX_DEFAULT 4096
+
+// Code size and cycles of the general routine's call from the fallback, and of
+// the return from either routine, for the medium (near) and large (far) memory
+// models.
+#define CALL_SIZE(far) ((far) ? 4 : 3)
+#define CALL_CYCLES(far) ((far) ? 5 : 4)
+#define RETURN_CYCLES(far) ((far) ? 5 : 4)
+
+// One LZSA sequence: a run of literals, then a match (with a length of zero
+// for the last sequence of the block, which has none).
+typedef struct {
+	const uint8_t *lit;
+	uint16_t lit_len;
+	uint16_t match_len;
+	int32_t match_off;
+} sequence_t;
+
+typedef struct {
+	const uint8_t *data;
+	size_t len;
+	size_t pos;
+	bool ok;
+} reader_t;
+
+// State of the generated code while it runs: the known contents of A and Y,
+// if any, which let loading the same value again be skipped.
+typedef struct {
+	int a;
+	int32_t y;
+	unsigned int labels;
+} regs_t;
+
+// Totals for generated code.
+typedef struct {
+	uint32_t size;
+	uint32_t cycles;
+} cost_t;
+
+/******************************************************************************/
+
+static uint8_t block_in[BLOCK_MAX];
+static uint8_t plain[PLAIN_MAX + 1];
+static sequence_t seqs[BLOCK_MAX];
+static bool verbose = false;
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s [options] <input_file>\n", name);
+	fprintf(stderr, "Options:\n");
+	fprintf(stderr, "  -f <1|2>      format of input block (default 2)\n");
+	fprintf(stderr, "  -n <name>     name of generated routine (required)\n");
+	fprintf(stderr, "  -o <file>     output assembly file (required)\n");
+	fprintf(stderr, "  -m <len>      longest match to store unrolled (default %u)\n", MATCH_MAX_DEFAULT);
+	fprintf(stderr, "  -s <bytes>    size limit for unrolled code (default %u)\n", SIZE_MAX_DEFAULT);
+	fprintf(stderr, "  -v            verbose output\n");
+}
+
+static size_t read_file(const char *path, uint8_t *buf, const size_t max) {
+	FILE *f;
+	size_t len;
+
+	if((f = fopen(path, "rb")) == NULL) {
+		perror(path);
+		exit(EXIT_FAILURE);
+	}
+	len = fread(buf, 1, max, f);
+	if(fgetc(f) != EOF) {
+		fprintf(stderr, "%s: file too large (max. %zu bytes)\n", path, max);
+		exit(EXIT_FAILURE);
+	}
+	fclose(f);
+
+	return len;
+}
+
+// Input is read through these, which flag (rather than overrun) a truncated
+// block.
+static uint8_t read_byte(reader_t *r) {
+	if(r->pos >= r->len) {
+		r->ok = false;
+		return 0;
+	}
+	return r->data[r->pos++];
+}
+
+static const uint8_t * read_run(reader_t *r, const size_t len) {
+	const uint8_t *run = r->data + r->pos;
+	if(len > r->len - r->pos) {
+		r->ok = false;
+		return r->data;
+	}
+	r->pos += len;
+	return run;
+}
+
+static uint8_t lzsa2_read_nibble(reader_t *r, int16_t *pending) {
+	uint8_t n;
+	if(*pending >= 0) {
+		n = (uint8_t)*pending;
+		*pending = -1;
+	} else {
+		n = read_byte(r);
+		*pending = n & 0x0F;
+		n >>= 4;
+	}
+	return n;
+}
+
+/******************************************************************************/
+
+// Parse the next sequence of an LZSA1 block. Returns false when the block is
+// truncated; the last sequence is the one with no match.
+static bool lzsa1_parse(reader_t *r, sequence_t *seq) {
+	const uint8_t token = read_byte(r);
+	uint16_t len;
+	uint8_t n;
+
+	len = (token >> 4) & 0x07;
+	if(len == 7) {
+		n = read_byte(r);
+		if(n == 250) {
+			len = 256 + read_byte(r);
+		} else if(n == 249) {
+			len = read_byte(r);
+			len |= (uint16_t)(read_byte(r) << 8);
+		} else {
+			len += n;
+		}
+	}
+	seq->lit_len = len;
+	seq->lit = read_run(r, len);
+
+	seq->match_off = read_byte(r);
+	if(token & 0x80) {
+		seq->match_off |= (int32_t)read_byte(r) << 8;
+	} else {
+		seq->match_off |= 0xFF00;
+	}
+	seq->match_off -= 0x10000;
+
+	len = token & 0x0F;
+	if(len == 15) {
+		n = read_byte(r);
+		if(n == 239) {
+			len = 256 + read_byte(r);
+		} else if(n == 238) {
+			len = read_byte(r);
+			len |= (uint16_t)(read_byte(r) << 8);
+		} else {
+			len += n + 3;
+		}
+	} else {
+		len += 3;
+	}
+	seq->match_len = len;
+
+	return r->ok;
+}
+
+// Parse the next sequence of an LZSA2 block. The nibble cache and previous
+// offset (for repeat matches) are kept between calls by the caller.
+static bool lzsa2_parse(reader_t *r, sequence_t *seq, int16_t *pending, int32_t *prev_off) {
+	const uint8_t token = read_byte(r);
+	uint16_t len;
+	uint8_t n;
+
+	len = (token >> 3) & 0x03;
+	if(len == 3) {
+		len += lzsa2_read_nibble(r, pending);
+		if(len == 18) {
+			n = read_byte(r);
+			if(n == 239) {
+				len = read_byte(r);
+				len |= (uint16_t)(read_byte(r) << 8);
+			} else {
+				len += n;
+			}
+		}
+	}
+	seq->lit_len = len;
+	seq->lit = read_run(r, len);
+
+	switch(token & 0xE0) {
+		case 0x00: case 0x20:
+			n = lzsa2_read_nibble(r, pending);
+			*prev_off = (int32_t)(0xFFE0 | (n << 1) | ((token & 0x20) ? 0 : 1)) - 0x10000;
+			break;
+		case 0x40: case 0x60:
+			*prev_off = (int32_t)(((token & 0x20) ? 0xFE00 : 0xFF00) | read_byte(r)) - 0x10000;
+			break;
+		case 0x80: case 0xA0:
+			n = lzsa2_read_nibble(r, pending);
+			*prev_off = (int32_t)(0xE000 | (((n << 1) | ((token & 0x20) ? 0 : 1)) << 8) | read_byte(r)) - 512 - 0x10000;
+			break;
+		case 0xC0:
+			*prev_off = (int32_t)(read_byte(r) << 8);
+			*prev_off = (int32_t)(*prev_off | read_byte(r)) - 0x10000;
+			break;
+		default:
+			break;
+	}
+	seq->match_off = *prev_off;
+
+	len = (token & 0x07) + 2;
+	if(len == 9) {
+		len += lzsa2_read_nibble(r, pending);
+		if(len == 24) {
+			n = read_byte(r);
+			if(n == 233) {
+				len = read_byte(r);
+				len |= (uint16_t)(read_byte(r) << 8);
+			} else if(n < 232) {
+				len += n;
+			} else {
+				len = 0;
+			}
+		}
+	}
+	seq->match_len = len;
+
+	return r->ok;
+}
+
+// Parse the whole block into seqs[], checking each match refers to data
+// already decompressed. Returns the number of sequences, or zero if the block
+// is invalid.
+static size_t parse(const uint8_t *src, const size_t src_len, const unsigned int format, size_t *plain_len) {
+	reader_t r = { .data = src, .len = src_len, .pos = 0, .ok = true };
+	int32_t lzsa2_off = 0;
+	int16_t pending = -1;
+	size_t count = 0;
+
+	*plain_len = 0;
+	while(1) {
+		sequence_t *seq = &seqs[count++];
+		if(!(format == 1 ? lzsa1_parse(&r, seq) : lzsa2_parse(&r, seq, &pending, &lzsa2_off))) {
+			fprintf(stderr, "Error: block is truncated\n");
+			return 0;
+		}
+		*plain_len += seq->lit_len;
+		if(seq->match_len > 0 && (seq->match_off >= 0 || -seq->match_off > (int32_t)*plain_len)) {
+			fprintf(stderr, "Error: match at offset %ld is before start of data\n", (long)seq->match_off);
+			return 0;
+		}
+		*plain_len += seq->match_len;
+		if(*plain_len > PLAIN_MAX) {
+			fprintf(stderr, "Error: block decompresses to more than %u bytes\n", PLAIN_MAX);
+			return 0;
+		}
+		if(seq->match_len == 0) break;
+	}
+
+	if(r.pos != src_len) fprintf(stderr, "Warning: %zu bytes after end of block ignored\n", src_len - r.pos);
+
+	return count;
+}
+
+/******************************************************************************/
+
+// Emit one instruction of the given size and cycle count. Nothing is written
+// when counting only (i.e. with no output file).
+static void emit(FILE *f, cost_t *cost, const unsigned int size, const unsigned int cycles, const char *fmt, ...) {
+	va_list args;
+
+	cost->size += size;
+	cost->cycles += cycles;
+	if(f != NULL) {
+		fputc('\t', f);
+		va_start(args, fmt);
+		vfprintf(f, fmt, args);
+		va_end(args);
+		fputc('\n', f);
+	}
+}
+
+// Size of an instruction indexed by X, which is one byte for no offset, two for
+// a short (8-bit) offset, or three for a long (16-bit) one.
+static unsigned int indexed_size(const uint16_t off) {
+	return (off == 0 ? 1 : (off <= 0xFF ? 2 : 3));
+}
+
+static void emit_indexed(FILE *f, cost_t *cost, const unsigned int cycles, const char *op, const uint16_t off, const char *reg) {
+	if(off == 0) {
+		emit(f, cost, indexed_size(off), cycles, "%s (x), %s", op, reg);
+	} else {
+		emit(f, cost, indexed_size(off), cycles, "%s (0x%04X, x), %s", op, off, reg);
+	}
+}
+
+// Store a run of known bytes of output with immediate values, using LD or LDW
+// for each one or two bytes, whichever takes less code (or, when the same, the
+// fewer cycles). Loading A or Y is skipped when it already holds the value.
+static void emit_stores(FILE *f, cost_t *cost, regs_t *regs, const uint16_t start, const uint16_t end) {
+	uint16_t i = start;
+
+	while(i < end) {
+		const uint8_t b0 = plain[i];
+		const unsigned int byte_size = (regs->a == b0 ? 0 : 2) + indexed_size(i);
+		const unsigned int byte_cycles = (regs->a == b0 ? 0 : 1) + 1;
+
+		if(i + 1 < end) {
+			const uint8_t b1 = plain[i + 1];
+			const uint16_t w = (uint16_t)((b0 << 8) | b1);
+			const unsigned int word_size = (regs->y == w ? 0 : 4) + indexed_size(i);
+			const unsigned int word_cycles = (regs->y == w ? 0 : 2) + 2;
+			const unsigned int pair_size = byte_size + (b0 == b1 ? 0 : 2) + indexed_size(i + 1);
+			const unsigned int pair_cycles = byte_cycles + (b0 == b1 ? 0 : 1) + 1;
+
+			if(word_size < pair_size || (word_size == pair_size && word_cycles < pair_cycles)) {
+				if(regs->y != w) {
+					emit(f, cost, 4, 2, "ldw y, #0x%04X", w);
+					regs->y = w;
+				}
+				emit_indexed(f, cost, 2, "ldw", i, "y");
+				i += 2;
+				continue;
+			}
+		}
+
+		if(regs->a != b0) {
+			emit(f, cost, 2, 1, "ld a, #0x%02X", b0);
+			regs->a = b0;
+		}
+		emit_indexed(f, cost, 1, "ld", i, "a");
+		i++;
+	}
+}
+
+// Copy a match with a loop, pointing X at the source and counting down the
+// length in Y, then put X back to the start of the destination. Copying one
+// byte at a time gives the right result for matches that overlap their own
+// output.
+static void emit_copy(FILE *f, cost_t *cost, regs_t *regs, const uint16_t pos, const int32_t match_off, const uint16_t len) {
+	const uint16_t src = (uint16_t)(pos + match_off);
+	const uint16_t dist = (uint16_t)-match_off;
+	const unsigned int label = regs->labels++;
+
+	if(src != 0) emit(f, cost, 3, 2, "addw x, #0x%04X", src);
+	emit(f, cost, 4, 2, "ldw y, #0x%04X", len);
+	if(f != NULL) fprintf(f, "%u$:\n", label);
+	cost->cycles += (uint32_t)(len - 1) * 6 + 5;
+	cost->size += 1 + indexed_size(dist) + 1 + 2 + 2;
+	if(f != NULL) {
+		fprintf(f, "\tld a, (x)\n");
+		fprintf(f, "\tld (0x%04X, x), a\n", dist);
+		fprintf(f, "\tincw x\n");
+		fprintf(f, "\tdecw y\n");
+		fprintf(f, "\tjrne %u$\n", label);
+	}
+	emit(f, cost, 3, 2, "subw x, #0x%04X", (uint16_t)(src + len));
+
+	regs->a = plain[pos + len - 1];
+	regs->y = 0;
+}
+
+// Fill a run of output that repeats every one or two bytes (i.e. a match at a
+// distance of one or two) with a loop of word stores, counted down in A, in
+// pieces of up to 255 words. An odd byte at the end is stored on its own.
+static void emit_fill(FILE *f, cost_t *cost, regs_t *regs, uint16_t pos, const uint16_t len) {
+	const uint16_t w = (uint16_t)((plain[pos] << 8) | plain[pos + 1]);
+	const uint16_t end = pos + len;
+	uint16_t words = len / 2;
+
+	while(words > 0) {
+		const uint8_t n = (words > 255 ? 255 : (uint8_t)words);
+		const unsigned int label = regs->labels++;
+
+		if(pos != 0) emit(f, cost, 3, 2, "addw x, #0x%04X", pos);
+		if(regs->y != w) {
+			emit(f, cost, 4, 2, "ldw y, #0x%04X", w);
+			regs->y = w;
+		}
+		emit(f, cost, 2, 1, "ld a, #%u", n);
+		if(f != NULL) fprintf(f, "%u$:\n", label);
+		cost->cycles += (uint32_t)n * 7 - 1;
+		cost->size += 1 + 1 + 1 + 1 + 2;
+		if(f != NULL) {
+			fprintf(f, "\tldw (x), y\n");
+			fprintf(f, "\tincw x\n");
+			fprintf(f, "\tincw x\n");
+			fprintf(f, "\tdec a\n");
+			fprintf(f, "\tjrne %u$\n", label);
+		}
+		pos += n * 2;
+		emit(f, cost, 3, 2, "subw x, #0x%04X", pos);
+		words -= n;
+	}
+
+	regs->a = 0;
+	if(pos < end) emit_stores(f, cost, regs, pos, end);
+}
+
+// Generate the straight-line routine, or with no output file, just count its
+// size and cycles.
+static void generate_unrolled(FILE *f, cost_t *cost, const size_t count, const size_t plain_len, const uint16_t match_max, const bool far) {
+	regs_t regs = { .a = -1, .y = -1, .labels = 0 };
+	uint16_t pos = 0, start = 0;
+
+	cost->cycles += CALL_CYCLES(far);
+	emit(f, cost, 2, 2, "ldw x, (ARGS_SP_OFFSET+0, sp)");
+
+	// Literals and short matches accumulate into one run of stores, which is
+	// written out before each long match and at the end.
+	for(size_t i = 0; i < count; i++) {
+		pos += seqs[i].lit_len;
+		if(seqs[i].match_len > match_max) {
+			if(f != NULL) fprintf(f, "\n\t; 0x%04X-0x%04X\n", start, pos - 1);
+			emit_stores(f, cost, &regs, start, pos);
+			if(f != NULL) fprintf(f, "\n\t; 0x%04X-0x%04X, match of %u at -%ld\n", pos, pos + seqs[i].match_len - 1, seqs[i].match_len, (long)-seqs[i].match_off);
+			if(seqs[i].match_off >= -2) {
+				emit_fill(f, cost, &regs, pos, seqs[i].match_len);
+			} else {
+				emit_copy(f, cost, &regs, pos, seqs[i].match_off, seqs[i].match_len);
+			}
+			start = pos + seqs[i].match_len;
+		}
+		pos += seqs[i].match_len;
+	}
+	if(start < pos) {
+		if(f != NULL) fprintf(f, "\n\t; 0x%04X-0x%04X\n", start, pos - 1);
+		emit_stores(f, cost, &regs, start, pos);
+	}
+
+	if(f != NULL) fprintf(f, "\n\t; Return pointer to end of output.\n");
+	if(plain_len > 0) emit(f, cost, 3, 2, "addw x, #0x%04X", (unsigned int)plain_len);
+	emit(f, cost, 1, RETURN_CYCLES(far), "return");
+}
+
+// Generate the fallback routine, which passes the included block to the
+// general routine. This leaves dst on the stack where the general routine
+// expects it, so only the block pointer needs pushing before it.
+static void generate_fallback(FILE *f, cost_t *cost, const char *name, const uint8_t *block, const size_t block_len, const unsigned int format, const bool far) {
+	emit(f, cost, 3, 2, "ldw x, #_%s_block", name);
+	emit(f, cost, 1, 2, "pushw x");
+	emit(f, cost, 2, 2, "ldw x, (ARGS_SP_OFFSET+2, sp)");
+	emit(f, cost, 1, 2, "pushw x");
+	emit(f, cost, CALL_SIZE(far), CALL_CYCLES(far), "call_abs _lzsa%u_decompress_block", format);
+	emit(f, cost, 2, 2, "addw sp, #4");
+	emit(f, cost, 1, RETURN_CYCLES(far), "return");
+
+	if(f != NULL) {
+		fprintf(f, "\n; The block is given to the general routine by a 16-bit pointer, so must be\n");
+		fprintf(f, "; placed in the first 64 KB, along with other constant data.\n\n");
+		fprintf(f, ".area CONST\n\n");
+		fprintf(f, "_%s_block:", name);
+		for(size_t i = 0; i < block_len; i++) {
+			fprintf(f, "%s0x%02X", (i % 12 == 0 ? "\n\t.db " : ", "), block[i]);
+		}
+		fprintf(f, "\n");
+	}
+	cost->size += (uint32_t)block_len;
+}
+
+static void write_header(FILE *f, const char *name, const char *input, const unsigned int format, const size_t plain_len, const bool fallback) {
+	fprintf(f, "; ------------------------------------------------------------------------------\n");
+	fprintf(f, "; Generated by lzsa_unroll from %s. Do not edit.\n", input);
+	fprintf(f, "; ------------------------------------------------------------------------------\n");
+	fprintf(f, ";\n");
+	fprintf(f, "; Function declaration:\n");
+	fprintf(f, ";     void * %s(void *dst)\n", name);
+	fprintf(f, "; Arguments:\n");
+	fprintf(f, ";     dst = pointer to destination buffer of at least %zu bytes\n", plain_len);
+	fprintf(f, "; Returns:\n");
+	fprintf(f, ";     Pointer to a position in the given destination buffer after the last byte\n");
+	fprintf(f, ";     of decompressed data.\n");
+	fprintf(f, ";\n");
+	if(fallback) {
+		fprintf(f, "; Decompresses the LZSA%u block with lzsa%u_decompress_block, as straight-line\n", format, format);
+		fprintf(f, "; code for it would have been over the size limit.\n");
+	} else {
+		fprintf(f, "; Writes the decompressed data of the LZSA%u block with straight-line code. X\n", format);
+		fprintf(f, "; holds the destination pointer throughout, except while a long match is\n");
+		fprintf(f, "; copied.\n");
+	}
+	fprintf(f, "\n.module %s\n", name);
+	fprintf(f, ".globl _%s\n", name);
+	if(fallback) fprintf(f, ".globl _lzsa%u_decompress_block\n", format);
+	fprintf(f, "\n.area CODE\n\n");
+	fprintf(f, "_%s:\n", name);
+}
+
+int main(int argc, char *argv[]) {
+	unsigned int format = 2;
+	const char *name = NULL, *out_path = NULL;
+	unsigned long match_max = MATCH_MAX_DEFAULT, size_max = SIZE_MAX_DEFAULT;
+	size_t in_len, plain_len, count;
+	cost_t unrolled[2] = { { 0, 0 }, { 0, 0 } }, fallback[2] = { { 0, 0 }, { 0, 0 } }, written = { 0, 0 };
+	uint32_t lzsa_cycles;
+	bool use_fallback;
+	FILE *f;
+	int opt;
+
+	while((opt = getopt(argc, argv, "f:n:o:m:s:v")) != -1) {
+		switch(opt) {
+			case 'f':
+				format = (unsigned int)strtoul(optarg, NULL, 10);
+				if(format != 1 && format != 2) {
+					usage(argv[0]);
+					return EXIT_FAILURE;
+				}
+				break;
+			case 'n':
+				name = optarg;
+				break;
+			case 'o':
+				out_path = optarg;
+				break;
+			case 'm':
+				match_max = strtoul(optarg, NULL, 10);
+				if(match_max > PLAIN_MAX) match_max = PLAIN_MAX;
+				break;
+			case 's':
+				size_max = strtoul(optarg, NULL, 10);
+				break;
+			case 'v':
+				verbose = true;
+				break;
+			default:
+				usage(argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if(argc - optind != 1 || name == NULL || out_path == NULL) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	in_len = read_file(argv[optind], block_in, sizeof(block_in));
+	if((count = parse(block_in, in_len, format, &plain_len)) == 0) return EXIT_FAILURE;
+
+	// Having been parsed without error, the block is safe to decompress. The
+	// stores are generated from its decompressed data.
+	if((uint8_t *)(format == 1 ? lzsa1_decompress_block_ref(plain, block_in) : lzsa2_decompress_block_ref(plain, block_in)) - plain != (ptrdiff_t)plain_len) {
+		fprintf(stderr, "Error: block does not decompress to the parsed length\n");
+		return EXIT_FAILURE;
+	}
+
+	// Count both routines for both memory models, which differ only in the
+	// call and return instructions.
+	for(unsigned int far = 0; far < 2; far++) {
+		generate_unrolled(NULL, &unrolled[far], count, plain_len, (uint16_t)match_max, far);
+		generate_fallback(NULL, &fallback[far], name, block_in, in_len, format, far);
+	}
+	use_fallback = (unrolled[0].size > size_max);
+
+	if((f = fopen(out_path, "w")) == NULL) {
+		perror(out_path);
+		return EXIT_FAILURE;
+	}
+	write_header(f, name, argv[optind], format, plain_len, use_fallback);
+	if(use_fallback) {
+		generate_fallback(f, &written, name, block_in, in_len, format, false);
+	} else {
+		generate_unrolled(f, &written, count, plain_len, (uint16_t)match_max, false);
+	}
+	fclose(f);
+
+	// Cycles predicted for the general routine include its call and return, so
+	// the fallback's total is its own cycles (with the call it makes) plus them.
+	lzsa_cycles = (format == 1 ? predict_lzsa1_cycles(block_in) : predict_lzsa2_cycles(block_in));
+	if(verbose) {
+		printf("sequences = %zu, unrolled size = %lu/%lu, fallback size = %lu/%lu (medium/large)\n",
+			count, (unsigned long)unrolled[0].size, (unsigned long)unrolled[1].size, (unsigned long)fallback[0].size, (unsigned long)fallback[1].size);
+	}
+	printf("%s: %zu bytes plain, LZSA%u %zu bytes; unrolled %lu bytes, %lu cycles (%.1f/byte); fallback %lu bytes, %lu cycles (%.1f/byte)%s\n",
+		argv[optind], plain_len, format, in_len,
+		(unsigned long)unrolled[0].size, (unsigned long)unrolled[0].cycles, (double)unrolled[0].cycles / (double)plain_len,
+		(unsigned long)fallback[0].size, (unsigned long)(fallback[0].cycles + lzsa_cycles), (double)(fallback[0].cycles + lzsa_cycles) / (double)plain_len,
+		(use_fallback ? " - over size limit, using fallback" : ""));
+
+	return EXIT_SUCCESS;
+}
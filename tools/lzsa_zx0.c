@@ -0,0 +1,377 @@
+/*******************************************************************************
+ *
+ * lzsa_zx0.c - Host tool to compress data in ZX0 format
+ *
+ * Copyright (c) 2022 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Compresses a file into a ZX0 (v2) block, as decoded by zx0_decompress_block(),
+// e.g.:
+//
+//   lzsa_zx0 logo.bin logo.zx0
+//
+// This is the encoder that the test corpus's ZX0 files are made with, so that
+// they can be remade exactly. Its output is in the same format as that of the
+// reference zx0 compressor (with default options), but is not byte-for-byte the
+// same, as the parse is found differently.
+//
+// The parse is found by dynamic programming over positions in the input, with
+// two sets of states at each: those ending in a literal run, and those ending
+// in a match. As a repeat match reuses the last offset, the cheapest state is
+// not enough, so each set keeps the cheapest state for each of up to
+// BEAM_WIDTH different last offsets. The output is checked by decompressing it
+// with the reference C implementation.
+//
+// Build with any hosted C99 compiler, e.g.:
+//
+//   cc -std=c99 -O2 -I.. -o lzsa_zx0 lzsa_zx0.c ../lzsa_ref.c
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "lzsa_ref.h"
+
+#define PLAIN_MAX 65536
+#define COMP_MAX (PLAIN_MAX + (PLAIN_MAX / 8) + 16)
+#define BEAM_WIDTH 24
+#define OFFSET_MAX 32640
+#define COST_INFINITE 0x3FFFFFFF
+
+typedef enum {
+	STEP_START,
+	STEP_LITERALS,
+	STEP_REPEAT,
+	STEP_NEW
+} step_kind_t;
+
+// A state of the parse: the step that reached it, from which state, and the
+// last offset at that point.
+typedef struct {
+	int32_t cost; // In bits
+	uint16_t off;
+	uint32_t prev_pos;
+	uint8_t prev_slot;
+	bool prev_is_match;
+	uint16_t len;
+	step_kind_t kind;
+} state_t;
+
+typedef struct {
+	state_t states[BEAM_WIDTH];
+	uint8_t count;
+} beam_t;
+
+typedef struct {
+	uint8_t *data;
+	size_t len;
+	size_t bit_index;
+	uint8_t bit_mask;
+	bool backtrack;
+} writer_t;
+
+/******************************************************************************/
+
+static uint8_t plain[PLAIN_MAX];
+static uint8_t comp[COMP_MAX];
+static uint8_t check[PLAIN_MAX];
+static beam_t *literal_beams, *match_beams;
+
+/******************************************************************************/
+
+static void usage(const char *name) {
+	fprintf(stderr, "Usage: %s <input_file> <output_file>\n", name);
+}
+
+static size_t read_file(const char *path, uint8_t *buf, const size_t max) {
+	FILE *f;
+	size_t len;
+
+	if((f = fopen(path, "rb")) == NULL) {
+		perror(path);
+		exit(EXIT_FAILURE);
+	}
+	len = fread(buf, 1, max, f);
+	if(fgetc(f) != EOF) {
+		fprintf(stderr, "%s: file too large (max. %zu bytes)\n", path, max);
+		exit(EXIT_FAILURE);
+	}
+	fclose(f);
+
+	return len;
+}
+
+// Number of bits in the Elias gamma code for a value.
+static int32_t gamma_bits(uint32_t v) {
+	int32_t bits = 1;
+	while(v > 1) {
+		v >>= 1;
+		bits += 2;
+	}
+	return bits;
+}
+
+// Add a state to a beam. It replaces a state with the same last offset if it
+// is cheaper, otherwise takes a free place, or else replaces the most costly
+// state if it is cheaper than that.
+static void beam_add(beam_t *beam, const state_t *s) {
+	uint8_t worst = 0;
+
+	for(uint8_t i = 0; i < beam->count; i++) {
+		if(beam->states[i].off == s->off) {
+			if(s->cost < beam->states[i].cost) beam->states[i] = *s;
+			return;
+		}
+	}
+	if(beam->count < BEAM_WIDTH) {
+		beam->states[beam->count++] = *s;
+		return;
+	}
+	for(uint8_t i = 1; i < BEAM_WIDTH; i++) {
+		if(beam->states[i].cost > beam->states[worst].cost) worst = i;
+	}
+	if(s->cost < beam->states[worst].cost) beam->states[worst] = *s;
+}
+
+static void add_state(beam_t *beam, const int32_t cost, const uint16_t off, const size_t prev_pos, const uint8_t prev_slot, const bool prev_is_match, const size_t len, const step_kind_t kind) {
+	const state_t s = {
+		.cost = cost,
+		.off = off,
+		.prev_pos = (uint32_t)prev_pos,
+		.prev_slot = prev_slot,
+		.prev_is_match = prev_is_match,
+		.len = (uint16_t)len,
+		.kind = kind
+	};
+	beam_add(beam, &s);
+}
+
+/******************************************************************************/
+
+static void write_byte(writer_t *w, const uint8_t b) {
+	w->data[w->len++] = b;
+}
+
+// Bits are packed MSB first into a byte placed in the output when its first
+// bit is written. After a new offset, the first bit of the match length is
+// instead held in the LSB of the offset's low byte.
+static void write_bit(writer_t *w, const bool bit) {
+	if(w->backtrack) {
+		if(bit) w->data[w->len - 1] |= 0x01;
+		w->backtrack = false;
+	} else {
+		if(w->bit_mask == 0) {
+			w->bit_mask = 0x80;
+			w->bit_index = w->len;
+			write_byte(w, 0);
+		}
+		if(bit) w->data[w->bit_index] |= w->bit_mask;
+		w->bit_mask >>= 1;
+	}
+}
+
+// Write an interleaved Elias gamma code, with the value bits inverted for the
+// MSB of a new offset.
+static void write_gamma(writer_t *w, const uint32_t v, const bool invert) {
+	uint32_t i;
+
+	for(i = 2; i <= v; i <<= 1);
+	i >>= 1;
+	while(i >>= 1) {
+		write_bit(w, false);
+		write_bit(w, (invert ? !(v & i) : (v & i) != 0));
+	}
+	write_bit(w, true);
+}
+
+/******************************************************************************/
+
+static size_t compress(const uint8_t *in, const size_t n, uint8_t *out) {
+	static const state_t *chain[PLAIN_MAX];
+	writer_t w = { .data = out, .len = 0, .bit_index = 0, .bit_mask = 0, .backtrack = false };
+	const state_t *s;
+	int32_t best_cost;
+	size_t chain_len = 0, pos = 0, i;
+	uint8_t best_slot;
+	bool best_is_match;
+
+	// The parse starts as if after a match at offset 1, so that the first
+	// step is literals.
+	add_state(&match_beams[0], 0, 1, 0, 0, false, 0, STEP_START);
+
+	for(size_t j = 0; j < n; j++) {
+		// Literal runs from states ending in a match. The first step of the
+		// block has no indicator bit.
+		for(uint8_t a = 0; a < match_beams[j].count; a++) {
+			const state_t *p = &match_beams[j].states[a];
+			const int32_t indicator = (j == 0 ? 0 : 1);
+			for(size_t k = 1; j + k <= n; k++) {
+				add_state(&literal_beams[j + k], p->cost + indicator + gamma_bits((uint32_t)k) + (8 * (int32_t)k), p->off, j, a, true, k, STEP_LITERALS);
+			}
+		}
+
+		// Repeat matches from states ending in literals.
+		for(uint8_t a = 0; a < literal_beams[j].count; a++) {
+			const state_t *p = &literal_beams[j].states[a];
+			if(p->off > j) continue;
+			for(size_t k = 1; j + k <= n && in[j + k - 1] == in[j + k - 1 - p->off]; k++) {
+				add_state(&match_beams[j + k], p->cost + 1 + gamma_bits((uint32_t)k), p->off, j, a, false, k, STEP_REPEAT);
+			}
+		}
+
+		// Matches at a new offset, from the cheapest state of either kind.
+		best_cost = COST_INFINITE;
+		best_slot = 0;
+		best_is_match = false;
+		s = NULL;
+		for(uint8_t a = 0; a < literal_beams[j].count; a++) {
+			if(literal_beams[j].states[a].cost < best_cost) {
+				s = &literal_beams[j].states[a];
+				best_cost = s->cost;
+				best_slot = a;
+				best_is_match = false;
+			}
+		}
+		if(j > 0) {
+			for(uint8_t a = 0; a < match_beams[j].count; a++) {
+				if(match_beams[j].states[a].cost < best_cost) {
+					s = &match_beams[j].states[a];
+					best_cost = s->cost;
+					best_slot = a;
+					best_is_match = true;
+				}
+			}
+		}
+		if(s == NULL) continue;
+		for(size_t off = 1; off <= j && off <= OFFSET_MAX; off++) {
+			size_t k = 0;
+			while(j + k < n && in[j + k] == in[j + k - off]) k++;
+			for(size_t m = 2; m <= k; m++) {
+				add_state(&match_beams[j + m], best_cost + 1 + gamma_bits((uint32_t)((off - 1) / 128) + 1) + 8 + gamma_bits((uint32_t)m - 1) - 1, (uint16_t)off, j, best_slot, best_is_match, m, STEP_NEW);
+			}
+		}
+	}
+
+	// Take the cheapest state at the end, and walk back from it to recover
+	// the steps.
+	best_cost = COST_INFINITE;
+	best_slot = 0;
+	best_is_match = false;
+	for(uint8_t a = 0; a < literal_beams[n].count; a++) {
+		if(literal_beams[n].states[a].cost < best_cost) {
+			best_cost = literal_beams[n].states[a].cost;
+			best_slot = a;
+			best_is_match = false;
+		}
+	}
+	for(uint8_t a = 0; a < match_beams[n].count; a++) {
+		if(match_beams[n].states[a].cost < best_cost && match_beams[n].states[a].kind != STEP_START) {
+			best_cost = match_beams[n].states[a].cost;
+			best_slot = a;
+			best_is_match = true;
+		}
+	}
+	i = n;
+	while(true) {
+		s = (best_is_match ? &match_beams[i] : &literal_beams[i])->states + best_slot;
+		if(s->kind == STEP_START) break;
+		chain[chain_len++] = s;
+		i = s->prev_pos;
+		best_slot = s->prev_slot;
+		best_is_match = s->prev_is_match;
+	}
+
+	while(chain_len > 0) {
+		s = chain[--chain_len];
+		switch(s->kind) {
+			case STEP_LITERALS:
+				if(pos > 0) write_bit(&w, false);
+				write_gamma(&w, s->len, false);
+				for(size_t k = 0; k < s->len; k++) write_byte(&w, in[pos++]);
+				break;
+			case STEP_REPEAT:
+				write_bit(&w, false);
+				write_gamma(&w, s->len, false);
+				pos += s->len;
+				break;
+			default:
+				write_bit(&w, true);
+				write_gamma(&w, ((s->off - 1) / 128) + 1, true);
+				write_byte(&w, (uint8_t)((127 - ((s->off - 1) % 128)) << 1));
+				w.backtrack = true;
+				write_gamma(&w, s->len - 1, false);
+				pos += s->len;
+				break;
+		}
+	}
+
+	// End marker: a new offset with an MSB of 256.
+	write_bit(&w, true);
+	write_gamma(&w, 256, true);
+
+	return w.len;
+}
+
+/******************************************************************************/
+
+int main(int argc, char *argv[]) {
+	size_t plain_len, comp_len;
+	FILE *f;
+
+	if(argc != 3) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	plain_len = read_file(argv[1], plain, sizeof(plain));
+	if(plain_len == 0) {
+		fprintf(stderr, "%s: file is empty\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	literal_beams = calloc(plain_len + 1, sizeof(beam_t));
+	match_beams = calloc(plain_len + 1, sizeof(beam_t));
+	if(literal_beams == NULL || match_beams == NULL) {
+		fprintf(stderr, "Error: out of memory\n");
+		return EXIT_FAILURE;
+	}
+
+	comp_len = compress(plain, plain_len, comp);
+
+	if((uint8_t *)zx0_decompress_block_ref(check, comp) - check != (ptrdiff_t)plain_len || memcmp(check, plain, plain_len) != 0) {
+		fprintf(stderr, "Error: compressed block does not decompress to the same data\n");
+		return EXIT_FAILURE;
+	}
+
+	if((f = fopen(argv[2], "wb")) == NULL) {
+		perror(argv[2]);
+		return EXIT_FAILURE;
+	}
+	fwrite(comp, 1, comp_len, f);
+	fclose(f);
+
+	printf("%s: %zu bytes -> %zu bytes (%.1f%%)\n", argv[1], plain_len, comp_len, (double)comp_len * 100.0 / (double)plain_len);
+
+	return EXIT_SUCCESS;
+}
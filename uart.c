@@ -51,6 +51,15 @@ const static uart_baud_cfg_t uart_baud_cfg[] = {
 	{ .brr1 = 0x04, .brr2 = 0x05 }, // 230400
 	{ .brr1 = 0x02, .brr2 = 0x03 }, // 460800
 	{ .brr1 = 0x01, .brr2 = 0x01 }  // 921600
+#elif defined(F_CPU) && F_CPU == 24000000UL
+	{ .brr1 = 0x71, .brr2 = 0x20 }, // 2400
+	{ .brr1 = 0x9C, .brr2 = 0x04 }, // 9600
+	{ .brr1 = 0x4E, .brr2 = 0x02 }, // 19200
+	{ .brr1 = 0x1A, .brr2 = 0x01 }, // 57600
+	{ .brr1 = 0x0D, .brr2 = 0x00 }, // 115200
+	{ .brr1 = 0x06, .brr2 = 0x08 }, // 230400
+	{ .brr1 = 0x03, .brr2 = 0x04 }, // 460800
+	{ .brr1 = 0x01, .brr2 = 0x0A }  // 921600
 #else
 #error "No UART BRR register values defined for current F_CPU value"
 #endif
@@ -92,6 +101,12 @@ void uart_init(const uart_baud_enum_t baud, uart_putchar_func_t put_func, uart_g
 	uart_getchar_func = get_func;
 }
 
+uart_putchar_func_t uart_set_putchar(uart_putchar_func_t put_func) {
+	uart_putchar_func_t prev_func = uart_putchar_func;
+	uart_putchar_func = put_func;
+	return prev_func;
+}
+
 int uart_putchar(int c) {
 	// When binary mode is not set and character to transmit is LF, send a CR
 	// preceding it.
@@ -42,6 +42,7 @@ typedef int (*uart_putchar_func_t)(int c);
 typedef int (*uart_getchar_func_t)(void);
 
 extern void uart_init(const uart_baud_enum_t baud, uart_putchar_func_t put_func, uart_getchar_func_t get_func);
+extern uart_putchar_func_t uart_set_putchar(uart_putchar_func_t put_func);
 extern int uart_putchar(int c);
 extern int uart_getchar(void);
 
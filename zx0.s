@@ -0,0 +1,264 @@
+; ------------------------------------------------------------------------------
+; ZX0 BLOCK DECOMPRESSION FOR STM8
+; ------------------------------------------------------------------------------
+;
+; zx0.s - ZX0 decompression routine
+;
+; Copyright (c) 2022 Basil Hussain
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in all
+; copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+; SOFTWARE.
+;
+; ------------------------------------------------------------------------------
+;
+; Function declaration:
+;     void * zx0_decompress_block(void *dst, const void *src)
+; Arguments:
+;     dst = pointer to destination decompression buffer
+;     src = pointer to source compressed data
+; Returns:
+;     Pointer to a position in the given destination buffer after the last byte
+;     of decompressed data.
+;
+; NOTE: this function is not re-entrant, due to use of static variables.
+;
+; Supports the current (v2) ZX0 format only, as produced by the ZX0 compressor
+; without the classic (-c) or backwards (-b) options.
+;
+; Inspiration for algorithm and structure taken from the standard decompression
+; routine for Z80 microprocessor by Einar Saukas.
+; https://github.com/einar-saukas/ZX0
+;
+; ZX0 format documentation:
+; https://github.com/einar-saukas/ZX0/blob/main/README.md
+
+.module zx0
+.globl _zx0_decompress_block
+
+; ------------------------------------------------------------------------------
+; Static global variables (plus MSB/LSB aliases for convenience)
+; ------------------------------------------------------------------------------
+
+.area DATA
+
+bits: .blkb 1
+
+length: .blkw 1
+length_msb .equ (length+0)
+length_lsb .equ (length+1)
+
+match_off: .blkw 1
+match_off_msb .equ (match_off+0)
+match_off_lsb .equ (match_off+1)
+
+; ------------------------------------------------------------------------------
+; Macros
+; ------------------------------------------------------------------------------
+
+; Read the next bit of the bit stream into the C flag. The bits variable holds
+; the remaining bits of the current byte, followed by a single set 'sentinel'
+; bit. When shifting out a bit leaves the variable empty, the bit shifted out
+; was the sentinel, so load the next byte from the source and rotate the
+; sentinel back in at the bottom, which shifts out the byte's first bit into C.
+; Clobbers A reg.
+.macro zx0_read_bit ?have_bit
+	sll bits
+	jrne have_bit
+	ld a, (x)
+	incw x
+	rlc a
+	ld bits, a
+have_bit:
+.endm
+
+; ------------------------------------------------------------------------------
+; Function code
+; ------------------------------------------------------------------------------
+
+.area CODE
+
+_zx0_decompress_block:
+	; Load source pointer to X reg and destination pointer to Y reg.
+	ldw x, (ARGS_SP_OFFSET+2, sp)
+	ldw y, (ARGS_SP_OFFSET+0, sp)
+
+	; Initialise the bit stream as empty (i.e. only the sentinel bit), and the
+	; last match offset to its default of 1.
+	mov bits, #0x80
+	clr match_off_msb
+	mov match_off_lsb, #1
+
+zx0_literals:
+	; Obtain the literal length (always at least 1).
+	call_abs zx0_elias
+
+zx0_copy_lit:
+	; Copy a single byte from source to destination.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Decrement length word variable in-place (without using X/Y registers and
+	; DECW instruction). Loop around to next byte if not yet zero.
+	ld a, length_lsb
+	sub a, #1
+	ld length_lsb, a
+	ld a, length_msb
+	sbc a, #0
+	ld length_msb, a
+	jrne zx0_copy_lit
+	tnz length_lsb
+	jrne zx0_copy_lit
+
+	; Next bit indicates whether a copy from a new offset (1) or from the last
+	; offset (0) follows. For the latter, obtain length and go ahead and copy.
+	zx0_read_bit
+	jrc zx0_new_offset
+	call_abs zx0_elias
+
+zx0_copy_match:
+	; Save current source pointer on stack. Copy current destination pointer to
+	; X reg and subtract match offset from it.
+	pushw x
+	ldw x, y
+	subw x, match_off
+
+zx0_copy_match_loop:
+	; Copy a single byte from source to destination.
+	ld a, (x)
+	incw x
+	ld (y), a
+	incw y
+
+	; Decrement length word variable in-place. Loop around to next byte if not
+	; yet zero.
+	ld a, length_lsb
+	sub a, #1
+	ld length_lsb, a
+	ld a, length_msb
+	sbc a, #0
+	ld length_msb, a
+	jrne zx0_copy_match_loop
+	tnz length_lsb
+	jrne zx0_copy_match_loop
+
+	; Restore source pointer from stack. Next bit indicates whether a copy from
+	; a new offset (1) or literals (0) follow.
+	popw x
+	zx0_read_bit
+	jrnc zx0_literals
+
+zx0_new_offset:
+	; Obtain the MSB part of new match offset (with inverted data bits). A value
+	; of 256 is the end-of-data (EOD) marker, so if MSB of length is non-zero,
+	; we're done.
+	call_abs zx0_elias_inv
+	tnz length_msb
+	jreq zx0_calc_offset
+
+	; Return current destination pointer in X reg.
+	ldw x, y
+	return
+
+zx0_calc_offset:
+	; Match offset is MSB part multiplied by 128 minus the top 7 bits of the
+	; following offset LSB byte. First, place MSB part shifted left by 7 bits
+	; into match offset word variable.
+	ld a, length_lsb
+	srl a
+	ld match_off_msb, a
+	clr a
+	rrc a
+	ld match_off_lsb, a
+
+	; Load the offset LSB byte from source and shift right by one bit. The bit
+	; shifted out into C is the first bit of the Elias gamma code for the match
+	; length, so save the flags on the stack.
+	ld a, (x)
+	incw x
+	srl a
+	push cc
+
+	; Subtract the shifted byte from the match offset word variable.
+	push a
+	ld a, match_off_lsb
+	sub a, (1, sp)
+	ld match_off_lsb, a
+	ld a, match_off_msb
+	sbc a, #0
+	ld match_off_msb, a
+	pop a
+
+	; Obtain the match length, continuing from the restored first bit. If that
+	; bit is set, length is simply 1. Otherwise, read the remainder of the code.
+	clr length_msb
+	mov length_lsb, #1
+	pop cc
+	jrc zx0_new_offset_len
+	call_abs zx0_elias_data
+
+zx0_new_offset_len:
+	; A match from a new offset is always at least 2 bytes long, so the encoded
+	; length is one less than actual. Increment the length word variable.
+	ld a, length_lsb
+	add a, #1
+	ld length_lsb, a
+	ld a, length_msb
+	adc a, #0
+	ld length_msb, a
+	jump_abs zx0_copy_match
+
+; ------------------------------------------------------------------------------
+
+zx0_elias:
+	; Decode an interlaced Elias gamma coded value into the length word variable.
+	; Value starts at 1. Each control bit of zero is followed by a data bit that
+	; is shifted into the value from the bottom; a control bit of one ends the
+	; value.
+	clr length_msb
+	mov length_lsb, #1
+
+zx0_elias_loop:
+	zx0_read_bit
+	jrnc zx0_elias_data
+	return
+
+zx0_elias_data:
+	zx0_read_bit
+	rlc length_lsb
+	rlc length_msb
+	jra zx0_elias_loop
+
+zx0_elias_inv:
+	; Same as above, but with inverted data bits, as used for the MSB part of
+	; match offsets.
+	clr length_msb
+	mov length_lsb, #1
+
+zx0_elias_inv_loop:
+	zx0_read_bit
+	jrnc zx0_elias_inv_data
+	return
+
+zx0_elias_inv_data:
+	zx0_read_bit
+	ccf
+	rlc length_lsb
+	rlc length_msb
+	jra zx0_elias_inv_loop